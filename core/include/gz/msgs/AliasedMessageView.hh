@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_MSGS_ALIASEDMESSAGEVIEW_HH_
+#define GZ_MSGS_ALIASEDMESSAGEVIEW_HH_
+
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include "gz/msgs/config.hh"
+
+namespace gz
+{
+namespace msgs
+{
+/// \brief Parse a serialized message without copying one of its bytes
+/// fields, which aliases the serialized buffer instead.
+///
+/// Messages such as Image, PointCloudPacked, OccupancyGrid and Dataframe
+/// carry their payload in a large "data" field. Parsing them normally
+/// copies the payload out of the receive buffer. The view parses every
+/// other field into a message, and exposes the payload as a read only
+/// range of the buffer, which must stay alive and unchanged while the view
+/// is used. CopyTo makes an owned copy when one is needed.
+///
+/// \code{.cpp}
+/// gz::msgs::AliasedMessageView<gz::msgs::Image> view;
+/// if (view.Parse(buffer, size))
+/// {
+///   const gz::msgs::Image &fields = view.Fields();
+///   std::string_view pixels = view.Data();
+/// }
+/// \endcode
+///
+/// \tparam MsgT Message type.
+template<typename MsgT>
+class AliasedMessageView
+{
+  /// \brief Constructor.
+  /// \param[in] _fieldName Name of the bytes or string field to alias.
+  public: explicit AliasedMessageView(const std::string &_fieldName = "data");
+
+  /// \brief Parse a serialized message. The aliased field of a previous
+  /// message is forgotten.
+  /// \param[in] _data Serialized message. Must outlive the view, or the
+  /// next call to Parse.
+  /// \param[in] _size Size of the serialized message.
+  /// \return False if the message is malformed or the field to alias isn't
+  /// a bytes or string field of MsgT.
+  public: bool Parse(const void *_data, size_t _size);
+
+  /// \brief Parse a serialized message.
+  /// \param[in] _data Serialized message. Must outlive the view, or the
+  /// next call to Parse.
+  /// \return False if the message is malformed or the field to alias isn't
+  /// a bytes or string field of MsgT.
+  public: bool Parse(std::string_view _data);
+
+  /// \brief Every field of the message except the aliased one, which is
+  /// empty.
+  /// \return The fields.
+  public: const MsgT &Fields() const;
+
+  /// \brief The aliased field.
+  /// \return Range of the serialized buffer holding the field, empty if
+  /// the message doesn't have it.
+  public: std::string_view Data() const;
+
+  /// \brief Copy the whole message, including the aliased field.
+  /// \param[out] _msg The message.
+  public: void CopyTo(MsgT &_msg) const;
+
+  /// \brief The parsed fields.
+  private: MsgT fields;
+
+  /// \brief The aliased field.
+  private: std::string_view data;
+
+  /// \brief Field to alias.
+  private: const google::protobuf::FieldDescriptor *field{nullptr};
+
+  /// \brief Serialized fields other than the aliased one, kept to reuse
+  /// its buffer.
+  private: std::string rest;
+};
+
+/////////////////////////////////////////////////
+template<typename MsgT>
+AliasedMessageView<MsgT>::AliasedMessageView(const std::string &_fieldName)
+{
+  const auto *descriptor = MsgT::descriptor()->FindFieldByName(_fieldName);
+  if (nullptr == descriptor || descriptor->is_repeated() ||
+      (descriptor->type() != google::protobuf::FieldDescriptor::TYPE_BYTES &&
+       descriptor->type() != google::protobuf::FieldDescriptor::TYPE_STRING))
+  {
+    std::cerr << "Message [" << MsgT::descriptor()->full_name()
+              << "] has no bytes field [" << _fieldName << "].\n";
+    return;
+  }
+  this->field = descriptor;
+}
+
+/////////////////////////////////////////////////
+template<typename MsgT>
+bool AliasedMessageView<MsgT>::Parse(const void *_data, size_t _size)
+{
+  using google::protobuf::internal::WireFormatLite;
+
+  this->fields.Clear();
+  this->data = std::string_view();
+  this->rest.clear();
+  if (nullptr == this->field)
+    return false;
+
+  if (_size > static_cast<size_t>(std::numeric_limits<int>::max()))
+  {
+    std::cerr << "Serialized message is too large.\n";
+    return false;
+  }
+
+  // Copy every field but the aliased one, which is only located. Like the
+  // regular parser, the last occurrence of the field wins.
+  const auto *bytes = static_cast<const uint8_t *>(_data);
+  google::protobuf::io::CodedInputStream input(bytes,
+      static_cast<int>(_size));
+  const uint32_t aliasTag = WireFormatLite::MakeTag(this->field->number(),
+      WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+  bool valid = true;
+  while (valid && static_cast<size_t>(input.CurrentPosition()) < _size)
+  {
+    const int start = input.CurrentPosition();
+    const uint32_t tag = input.ReadTag();
+    if (tag == aliasTag)
+    {
+      uint32_t length = 0;
+      valid = input.ReadVarint32(&length) &&
+          length <= _size - input.CurrentPosition();
+      if (valid)
+      {
+        this->data = std::string_view(reinterpret_cast<const char *>(bytes) +
+            input.CurrentPosition(), length);
+        input.Skip(static_cast<int>(length));
+      }
+      continue;
+    }
+
+    valid = tag != 0 && WireFormatLite::SkipField(&input, tag);
+    this->rest.append(reinterpret_cast<const char *>(bytes) + start,
+        input.CurrentPosition() - start);
+  }
+
+  if (!valid || !this->fields.ParseFromString(this->rest))
+  {
+    std::cerr << "Unable to parse message ["
+              << MsgT::descriptor()->full_name() << "].\n";
+    this->fields.Clear();
+    this->data = std::string_view();
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+template<typename MsgT>
+bool AliasedMessageView<MsgT>::Parse(std::string_view _data)
+{
+  return this->Parse(_data.data(), _data.size());
+}
+
+/////////////////////////////////////////////////
+template<typename MsgT>
+const MsgT &AliasedMessageView<MsgT>::Fields() const
+{
+  return this->fields;
+}
+
+/////////////////////////////////////////////////
+template<typename MsgT>
+std::string_view AliasedMessageView<MsgT>::Data() const
+{
+  return this->data;
+}
+
+/////////////////////////////////////////////////
+template<typename MsgT>
+void AliasedMessageView<MsgT>::CopyTo(MsgT &_msg) const
+{
+  _msg.CopyFrom(this->fields);
+  if (nullptr != this->field)
+  {
+    _msg.GetReflection()->SetString(&_msg, this->field,
+        std::string(this->data));
+  }
+}
+}
+}
+
+#endif
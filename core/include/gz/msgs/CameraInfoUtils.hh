@@ -0,0 +1,1017 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_MSGS_CAMERAINFOUTILS_HH_
+#define GZ_MSGS_CAMERAINFOUTILS_HH_
+
+#include <gz/msgs/camera_info.pb.h>
+#include <gz/msgs/image.pb.h>
+#include <gz/msgs/pointcloud_packed.pb.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "gz/msgs/config.hh"
+#include "gz/msgs/ImageUtils.hh"
+#include "gz/msgs/PointCloudPackedUtils.hh"
+#include "gz/msgs/detail/ImageUtils.hh"
+#include "gz/msgs/detail/ParallelFor.hh"
+
+namespace gz
+{
+namespace msgs
+{
+namespace detail
+{
+/// \brief Source position of a rectified pixel.
+struct RemapEntry
+{
+  /// \brief Column of the top left source pixel, or kInvalidRemap if the
+  /// rectified pixel has no source.
+  uint16_t x;
+
+  /// \brief Row of the top left source pixel.
+  uint16_t y;
+
+  /// \brief Horizontal weight of the right source pixels, in 1/128 units.
+  uint8_t fx;
+
+  /// \brief Vertical weight of the bottom source pixels, in 1/128 units.
+  uint8_t fy;
+};
+
+/// \brief Column of a RemapEntry without source.
+constexpr uint16_t kInvalidRemap = UINT16_MAX;
+
+/// \brief Subpixel resolution of a RemapEntry.
+constexpr int kRemapScale = 128;
+
+/// \brief Invert a 3x3 row-major matrix.
+/// \param[in] _m The matrix.
+/// \param[out] _inv The inverse.
+/// \return False if the matrix is singular.
+inline bool Invert3x3(const double (&_m)[9], double (&_inv)[9])
+{
+  const double c0 = _m[4] * _m[8] - _m[5] * _m[7];
+  const double c1 = _m[5] * _m[6] - _m[3] * _m[8];
+  const double c2 = _m[3] * _m[7] - _m[4] * _m[6];
+  const double det = _m[0] * c0 + _m[1] * c1 + _m[2] * c2;
+  if (!(std::abs(det) > 0.0) || !std::isfinite(det))
+    return false;
+
+  const double inv = 1.0 / det;
+  _inv[0] = c0 * inv;
+  _inv[1] = (_m[2] * _m[7] - _m[1] * _m[8]) * inv;
+  _inv[2] = (_m[1] * _m[5] - _m[2] * _m[4]) * inv;
+  _inv[3] = c1 * inv;
+  _inv[4] = (_m[0] * _m[8] - _m[2] * _m[6]) * inv;
+  _inv[5] = (_m[2] * _m[3] - _m[0] * _m[5]) * inv;
+  _inv[6] = c2 * inv;
+  _inv[7] = (_m[1] * _m[6] - _m[0] * _m[7]) * inv;
+  _inv[8] = (_m[0] * _m[4] - _m[1] * _m[3]) * inv;
+  return true;
+}
+
+/// \brief Apply a distortion model to a point of the normalized image
+/// plane, like OpenCV's undistortion maps do.
+/// \param[in] _model The distortion model.
+/// \param[in] _k Distortion coefficients, zero when missing. PLUMB_BOB
+/// uses k1, k2, p1, p2, k3; RATIONAL_POLYNOMIAL uses k1, k2, p1, p2, k3,
+/// k4, k5, k6; EQUIDISTANT uses k1, k2, k3, k4.
+/// \param[in] _x Undistorted x.
+/// \param[in] _y Undistorted y.
+/// \param[out] _xd Distorted x.
+/// \param[out] _yd Distorted y.
+inline void Distort(CameraInfo::Distortion::DistortionModelType _model,
+    const double (&_k)[8], double _x, double _y, double &_xd, double &_yd)
+{
+  const double r2 = _x * _x + _y * _y;
+  if (_model == CameraInfo::Distortion::EQUIDISTANT)
+  {
+    const double r = std::sqrt(r2);
+    const double theta = std::atan(r);
+    const double theta2 = theta * theta;
+    const double thetaD = theta * (1.0 + theta2 * (_k[0] + theta2 *
+        (_k[1] + theta2 * (_k[2] + theta2 * _k[3]))));
+    const double scale = r > 0.0 ? thetaD / r : 1.0;
+    _xd = _x * scale;
+    _yd = _y * scale;
+    return;
+  }
+
+  double radial = 1.0 + r2 * (_k[0] + r2 * (_k[1] + r2 * _k[4]));
+  if (_model == CameraInfo::Distortion::RATIONAL_POLYNOMIAL)
+    radial /= 1.0 + r2 * (_k[5] + r2 * (_k[6] + r2 * _k[7]));
+  const double xy = 2.0 * _x * _y;
+  _xd = _x * radial + _k[2] * xy + _k[3] * (r2 + 2.0 * _x * _x);
+  _yd = _y * radial + _k[2] * (r2 + 2.0 * _y * _y) + _k[3] * xy;
+}
+
+/// \brief Serialize the calibration of a camera, leaving out its header.
+/// \param[in] _info The camera information.
+/// \return The serialized width, height, distortion, intrinsics,
+/// projection and rectification matrix.
+inline std::string CalibrationKey(const CameraInfo &_info)
+{
+  CameraInfo calibration;
+  calibration.set_width(_info.width());
+  calibration.set_height(_info.height());
+  *calibration.mutable_distortion() = _info.distortion();
+  *calibration.mutable_intrinsics() = _info.intrinsics();
+  *calibration.mutable_projection() = _info.projection();
+  *calibration.mutable_rectification_matrix() =
+      _info.rectification_matrix();
+  std::string key;
+  calibration.SerializeToString(&key);
+  return key;
+}
+
+/// \brief Bilinearly sample one rectified row.
+/// \tparam Type Channel type.
+/// \tparam C Number of channels.
+/// \param[in] _src Start of the source data.
+/// \param[in] _srcStep Source row size.
+/// \param[in] _dx Offset from a source pixel to its right neighbor, zero
+/// for images one pixel wide.
+/// \param[in] _dy Offset from a source pixel to its bottom neighbor, zero
+/// for images one pixel high.
+/// \param[in] _map Source positions of the row.
+/// \param[in] _width Number of pixels of the row.
+/// \param[out] _dst Start of the rectified row.
+template<ChannelType Type, int C>
+void RemapRow(const unsigned char *_src, size_t _srcStep, size_t _dx,
+    size_t _dy, const RemapEntry *_map, size_t _width, unsigned char *_dst)
+{
+  constexpr size_t kBytes = Type == ChannelType::UINT8 ? 1 :
+      (Type == ChannelType::UINT16 || Type == ChannelType::FLOAT16) ? 2 : 4;
+  constexpr size_t kPixel = kBytes * C;
+  constexpr uint32_t kScale = kRemapScale;
+  constexpr uint32_t kShift = 14;
+  static_assert(kScale * kScale == 1u << kShift, "Unexpected remap scale");
+
+  for (size_t x = 0; x < _width; ++x)
+  {
+    const RemapEntry &e = _map[x];
+    const bool valid = e.x != kInvalidRemap;
+    const unsigned char *p00 =
+        _src + (valid ? e.y * _srcStep + e.x * kPixel : 0);
+    const unsigned char *p[4] = {p00, p00 + _dx, p00 + _dy, p00 + _dy + _dx};
+    const uint32_t w[4] = {
+        (kScale - e.fx) * (kScale - e.fy), e.fx * (kScale - e.fy),
+        (kScale - e.fx) * e.fy, uint32_t{e.fx} * e.fy};
+    unsigned char *out = _dst + x * kPixel;
+
+    for (int c = 0; c < C; ++c)
+    {
+      const size_t o = c * kBytes;
+      if constexpr (Type == ChannelType::UINT8 ||
+                    Type == ChannelType::UINT16)
+      {
+        using T = std::conditional_t<Type == ChannelType::UINT8,
+            uint8_t, uint16_t>;
+        uint32_t sum = 1u << (kShift - 1);
+        for (int i = 0; i < 4; ++i)
+        {
+          T v;
+          std::memcpy(&v, p[i] + o, sizeof(v));
+          sum += w[i] * v;
+        }
+        const T result = valid ? static_cast<T>(sum >> kShift) : T(0);
+        std::memcpy(out + o, &result, sizeof(result));
+      }
+      else
+      {
+        // Zero weights skip their pixel so that NaN doesn't spread
+        double sum = 0.0;
+        for (int i = 0; i < 4; ++i)
+        {
+          double v;
+          if constexpr (Type == ChannelType::UINT32)
+          {
+            uint32_t u;
+            std::memcpy(&u, p[i] + o, sizeof(u));
+            v = u;
+          }
+          else
+          {
+            v = LoadChannel(p[i] + o, Type, false);
+          }
+          sum += w[i] ? w[i] * v : 0.0;
+        }
+        sum = valid ? sum * (1.0 / (1u << kShift)) : 0.0;
+        if constexpr (Type == ChannelType::UINT32)
+        {
+          const uint32_t result = static_cast<uint32_t>(sum + 0.5);
+          std::memcpy(out + o, &result, sizeof(result));
+        }
+        else
+        {
+          StoreChannel(static_cast<float>(sum), Type, false, out + o);
+        }
+      }
+    }
+  }
+}
+
+/// \brief Remap row kernel for a channel type.
+/// \tparam Type Channel type.
+/// \param[in] _channels Number of channels.
+/// \return The kernel, or nullptr if there is none.
+template<ChannelType Type>
+void (*RemapKernel(int _channels))(const unsigned char *, size_t, size_t,
+    size_t, const RemapEntry *, size_t, unsigned char *)
+{
+  switch (_channels)
+  {
+    case 1:
+      return &RemapRow<Type, 1>;
+    case 3:
+      return &RemapRow<Type, 3>;
+    case 4:
+      return &RemapRow<Type, 4>;
+    default:
+      return nullptr;
+  }
+}
+
+/// \brief Remap row kernel for a pixel format.
+/// \param[in] _info Layout of the pixel format.
+/// \return The kernel, or nullptr for Bayer formats.
+inline void (*RemapKernel(const PixelFormatInfo &_info))(
+    const unsigned char *, size_t, size_t, size_t, const RemapEntry *,
+    size_t, unsigned char *)
+{
+  if (_info.bayerRedX >= 0)
+    return nullptr;
+
+  switch (_info.type)
+  {
+    case ChannelType::UINT8:
+      return RemapKernel<ChannelType::UINT8>(_info.channels);
+    case ChannelType::UINT16:
+      return RemapKernel<ChannelType::UINT16>(_info.channels);
+    case ChannelType::UINT32:
+      return RemapKernel<ChannelType::UINT32>(_info.channels);
+    case ChannelType::FLOAT16:
+      return RemapKernel<ChannelType::FLOAT16>(_info.channels);
+    case ChannelType::FLOAT32:
+      return RemapKernel<ChannelType::FLOAT32>(_info.channels);
+    default:
+      return nullptr;
+  }
+}
+
+/// \brief Invert a distortion model by fixed-point iteration, like
+/// cv::undistortPoints.
+/// \param[in] _model The distortion model.
+/// \param[in] _k Distortion coefficients, zero when missing.
+/// \param[in] _xd Distorted x.
+/// \param[in] _yd Distorted y.
+/// \param[out] _x Undistorted x.
+/// \param[out] _y Undistorted y.
+inline void Undistort(CameraInfo::Distortion::DistortionModelType _model,
+    const double (&_k)[8], double _xd, double _yd, double &_x, double &_y)
+{
+  _x = _xd;
+  _y = _yd;
+  for (int i = 0; i < 20; ++i)
+  {
+    double x = 0.0;
+    double y = 0.0;
+    Distort(_model, _k, _x, _y, x, y);
+    _x -= x - _xd;
+    _y -= y - _yd;
+  }
+}
+
+/// \brief Project one row of a depth image into points.
+/// \tparam DepthType Storage type of a depth value.
+/// \tparam Color True to write a packed rgb value after the coordinates.
+/// \param[in] _depth Start of the depth row.
+/// \param[in] _rayX X component of the ray of every pixel, at depth one.
+/// \param[in] _rayY Y component of the ray of every pixel, at depth one.
+/// \param[in] _width Number of pixels of the row.
+/// \param[in] _scale Metres per depth unit.
+/// \param[in] _color Start of the 8 bit color row, if Color is true.
+/// \param[in] _colorBytes Size of a color pixel.
+/// \param[in] _rgb Index of the red, green and blue channels of a color
+/// pixel.
+/// \param[out] _out Point data, with float coordinates at offset 0.
+/// \param[in] _pointStep Point step of the point data.
+/// \return Number of pixels with a valid depth.
+template<typename DepthType, bool Color>
+size_t ProjectDepthRow(const unsigned char *_depth, const float *_rayX,
+    const float *_rayY, size_t _width, float _scale,
+    const unsigned char *_color, size_t _colorBytes, const int (&_rgb)[3],
+    char *_out, size_t _pointStep)
+{
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const float inf = std::numeric_limits<float>::infinity();
+  size_t valid = 0;
+  for (size_t i = 0; i < _width; ++i)
+  {
+    DepthType raw;
+    std::memcpy(&raw, _depth + i * sizeof(DepthType), sizeof(DepthType));
+    const float d = static_cast<float>(raw) * _scale;
+    const bool ok = d > 0.0f && d < inf;
+    const float z = ok ? d : nan;
+    valid += ok;
+
+    const float point[3] = {z * _rayX[i], z * _rayY[i], z};
+    char *out = _out + i * _pointStep;
+    std::memcpy(out, point, sizeof(point));
+    if (Color)
+    {
+      const unsigned char *c = _color + i * _colorBytes;
+      const uint32_t rgb = static_cast<uint32_t>(c[_rgb[0]]) << 16 |
+          static_cast<uint32_t>(c[_rgb[1]]) << 8 | c[_rgb[2]];
+      std::memcpy(out + sizeof(point), &rgb, sizeof(rgb));
+    }
+  }
+  return valid;
+}
+}  // namespace detail
+
+/// \brief Undistorts and rectifies images using the calibration of a
+/// CameraInfo message.
+///
+/// The source position of every rectified pixel is computed once into a
+/// remap table, which is rebuilt only when the calibration changes. The
+/// calibration is identified by a hash of the width, height, distortion,
+/// intrinsics, projection and rectification matrix, so the header of the
+/// CameraInfo can change freely. Rectifying an image then only samples
+/// the source pixels, bilinearly with 1/128 pixel precision, optionally
+/// over several threads by row band.
+///
+/// The rectified image uses the projection matrix as its intrinsics, or
+/// the intrinsics when the projection is missing, and the rectification
+/// matrix, or the identity when it's missing. The distortion models follow
+/// OpenCV: PLUMB_BOB and RATIONAL_POLYNOMIAL like cv::undistort, and
+/// EQUIDISTANT like cv::fisheye.
+///
+/// \code{.cpp}
+/// gz::msgs::ImageRectifier rectifier;
+/// gz::msgs::Image rectified;
+/// ...
+/// if (rectifier.Rectify(cameraInfo, image, rectified))
+///   process(rectified);
+/// \endcode
+class ImageRectifier
+{
+  /// \brief Use the calibration of a camera, rebuilding the remap table if
+  /// the calibration changed.
+  /// \param[in] _info The camera information.
+  /// \return False if the intrinsics are missing or singular, or the
+  /// image size is zero or larger than 65535 pixels.
+  public: bool SetCameraInfo(const CameraInfo &_info);
+
+  /// \brief Rectify an image with the current calibration.
+  ///
+  /// The rectified image gets the header, size and pixel format of the
+  /// source image, and densely packed rows. Pixels with no source become
+  /// zero. Bayer images are demosaiced, rectified and mosaiced again.
+  ///
+  /// \param[in] _src Image to rectify, with the size of the calibration.
+  /// \param[out] _dst The rectified image. Must not be _src.
+  /// \param[in] _threads Maximum number of threads, zero for all cores.
+  /// \return False if there is no calibration, the image doesn't have the
+  /// calibrated size, the pixel format is unknown or the source data is
+  /// smaller than its width, height and step.
+  public: bool Rectify(const Image &_src, Image &_dst,
+              unsigned int _threads = 1) const;
+
+  /// \brief Use the calibration of a camera and rectify an image.
+  /// \param[in] _info The camera information.
+  /// \param[in] _src Image to rectify.
+  /// \param[out] _dst The rectified image. Must not be _src.
+  /// \param[in] _threads Maximum number of threads, zero for all cores.
+  /// \return False if SetCameraInfo or Rectify fail.
+  public: bool Rectify(const CameraInfo &_info, const Image &_src,
+              Image &_dst, unsigned int _threads = 1);
+
+  /// \brief Get the hash of the current calibration.
+  /// \return The hash, zero when there is no calibration.
+  public: size_t CalibrationHash() const;
+
+  /// \brief Get the remap table.
+  /// \return Source position of every rectified pixel, in row-major order.
+  public: const std::vector<detail::RemapEntry> &RemapTable() const;
+
+  /// \brief Build the remap table.
+  /// \param[in] _info The camera information.
+  /// \return False if the calibration is unusable.
+  private: bool BuildRemapTable(const CameraInfo &_info);
+
+  /// \brief Serialized calibration of the remap table.
+  private: std::string calibration;
+
+  /// \brief Hash of the calibration.
+  private: size_t hash{0};
+
+  /// \brief Calibrated width.
+  private: uint32_t width{0};
+
+  /// \brief Calibrated height.
+  private: uint32_t height{0};
+
+  /// \brief Source position of every rectified pixel.
+  private: std::vector<detail::RemapEntry> remap;
+};
+
+/////////////////////////////////////////////////
+inline bool ImageRectifier::SetCameraInfo(const CameraInfo &_info)
+{
+  std::string key = detail::CalibrationKey(_info);
+  const size_t keyHash = std::hash<std::string>()(key);
+  if (!this->remap.empty() && keyHash == this->hash &&
+      key == this->calibration)
+  {
+    return true;
+  }
+
+  if (!this->BuildRemapTable(_info))
+  {
+    this->remap.clear();
+    this->calibration.clear();
+    this->hash = 0;
+    this->width = 0;
+    this->height = 0;
+    return false;
+  }
+  this->calibration = std::move(key);
+  this->hash = keyHash;
+  return true;
+}
+
+/////////////////////////////////////////////////
+inline bool ImageRectifier::Rectify(const Image &_src, Image &_dst,
+    unsigned int _threads) const
+{
+  if (!detail::CheckImageSource(_src, _dst))
+    return false;
+
+  if (this->remap.empty())
+  {
+    std::cerr << "ImageRectifier has no camera calibration.\n";
+    return false;
+  }
+  if (_src.width() != this->width || _src.height() != this->height)
+  {
+    std::cerr << "Image size [" << _src.width() << " x " << _src.height()
+              << "] doesn't match the calibrated size [" << this->width
+              << " x " << this->height << "].\n";
+    return false;
+  }
+
+  const PixelFormatType format = _src.pixel_format_type();
+  const detail::PixelFormatInfo info = detail::FormatInfo(format);
+  if (info.bayerRedX >= 0)
+  {
+    Image rgb;
+    Image rectified;
+    return ConvertImage(_src, RGB_INT8, rgb) &&
+        this->Rectify(rgb, rectified, _threads) &&
+        ConvertImage(rectified, format, _dst);
+  }
+
+  detail::InitImage(_src, format, _dst);
+  const auto kernel = detail::RemapKernel(info);
+  const size_t pixelBytes = BytesPerPixel(format);
+  const size_t dx = this->width > 1 ? pixelBytes : 0;
+  const size_t dy = this->height > 1 ? _src.step() : 0;
+  const auto *src =
+      reinterpret_cast<const unsigned char *>(_src.data().data());
+  auto *dst = reinterpret_cast<unsigned char *>(&(*_dst.mutable_data())[0]);
+  const size_t dstStep = _dst.step();
+  const size_t srcStep = _src.step();
+  const size_t rowWidth = this->width;
+
+  detail::ParallelFor(this->height,
+      detail::ParallelRanges(this->remap.size(), _threads),
+      [&](size_t _begin, size_t _end, unsigned int)
+      {
+        for (size_t y = _begin; y < _end; ++y)
+        {
+          kernel(src, srcStep, dx, dy, &this->remap[y * rowWidth],
+              rowWidth, dst + y * dstStep);
+        }
+      });
+  return true;
+}
+
+/////////////////////////////////////////////////
+inline bool ImageRectifier::Rectify(const CameraInfo &_info,
+    const Image &_src, Image &_dst, unsigned int _threads)
+{
+  return this->SetCameraInfo(_info) &&
+      this->Rectify(_src, _dst, _threads);
+}
+
+/////////////////////////////////////////////////
+inline size_t ImageRectifier::CalibrationHash() const
+{
+  return this->hash;
+}
+
+/////////////////////////////////////////////////
+inline const std::vector<detail::RemapEntry> &
+ImageRectifier::RemapTable() const
+{
+  return this->remap;
+}
+
+/////////////////////////////////////////////////
+inline bool ImageRectifier::BuildRemapTable(const CameraInfo &_info)
+{
+  const uint32_t w = _info.width();
+  const uint32_t h = _info.height();
+  if (w == 0 || h == 0 || w >= detail::kInvalidRemap ||
+      h >= detail::kInvalidRemap)
+  {
+    std::cerr << "Unable to rectify images of [" << w << " x " << h
+              << "] pixels.\n";
+    return false;
+  }
+  if (_info.intrinsics().k_size() != 9)
+  {
+    std::cerr << "CameraInfo intrinsics must hold a 3x3 matrix.\n";
+    return false;
+  }
+
+  // Rectified pixel -> camera ray: inverse of (P * R), with the 3x3 part
+  // of P.
+  double k[9];
+  double p[9];
+  double r[9] = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+  for (int i = 0; i < 9; ++i)
+    k[i] = _info.intrinsics().k(i);
+  if (_info.projection().p_size() == 12)
+  {
+    for (int i = 0; i < 9; ++i)
+      p[i] = _info.projection().p(i / 3 * 4 + i % 3);
+  }
+  else
+  {
+    std::copy(k, k + 9, p);
+  }
+  if (_info.rectification_matrix_size() == 9)
+  {
+    for (int i = 0; i < 9; ++i)
+      r[i] = _info.rectification_matrix(i);
+  }
+
+  double pr[9];
+  for (int i = 0; i < 3; ++i)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      pr[i * 3 + j] = p[i * 3] * r[j] + p[i * 3 + 1] * r[3 + j] +
+          p[i * 3 + 2] * r[6 + j];
+    }
+  }
+  double inv[9];
+  if (!detail::Invert3x3(pr, inv))
+  {
+    std::cerr << "CameraInfo projection and rectification are singular.\n";
+    return false;
+  }
+
+  double coefficients[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  const auto &distortion = _info.distortion();
+  for (int i = 0; i < std::min(8, distortion.k_size()); ++i)
+    coefficients[i] = distortion.k(i);
+
+  this->width = w;
+  this->height = h;
+  this->remap.resize(static_cast<size_t>(w) * h);
+  const double maxX = w - 1.0;
+  const double maxY = h - 1.0;
+  detail::RemapEntry *entry = this->remap.data();
+  for (uint32_t v = 0; v < h; ++v)
+  {
+    for (uint32_t u = 0; u < w; ++u, ++entry)
+    {
+      const double rx = inv[0] * u + inv[1] * v + inv[2];
+      const double ry = inv[3] * u + inv[4] * v + inv[5];
+      const double rz = inv[6] * u + inv[7] * v + inv[8];
+      double xd = 0.0;
+      double yd = 0.0;
+      if (rz > 0.0)
+      {
+        detail::Distort(distortion.model(), coefficients, rx / rz,
+            ry / rz, xd, yd);
+      }
+      double sx = k[0] * xd + k[1] * yd + k[2];
+      double sy = k[4] * yd + k[5];
+
+      // Positions within half a pixel of the border are clamped
+      if (!(rz > 0.0 && sx >= -0.5 && sx <= maxX + 0.5 &&
+            sy >= -0.5 && sy <= maxY + 0.5))
+      {
+        *entry = {detail::kInvalidRemap, 0, 0, 0};
+        continue;
+      }
+      sx = std::clamp(sx, 0.0, maxX);
+      sy = std::clamp(sy, 0.0, maxY);
+      const double x0 = std::min(std::floor(sx), std::max(maxX - 1.0, 0.0));
+      const double y0 = std::min(std::floor(sy), std::max(maxY - 1.0, 0.0));
+      entry->x = static_cast<uint16_t>(x0);
+      entry->y = static_cast<uint16_t>(y0);
+      entry->fx = static_cast<uint8_t>(
+          std::lround((sx - x0) * detail::kRemapScale));
+      entry->fy = static_cast<uint8_t>(
+          std::lround((sy - y0) * detail::kRemapScale));
+    }
+  }
+  return true;
+}
+
+/// \brief Projects depth images into organized point clouds using the
+/// intrinsics of a CameraInfo message.
+///
+/// The ray through every pixel is computed once from the intrinsics and
+/// distortion, and only recomputed when the calibration changes, so
+/// projecting an image costs two multiplications per pixel. Rows are
+/// projected straight into the data buffer of the output cloud, which is
+/// reused across calls, optionally over several threads.
+///
+/// Points are in the optical frame of the camera: z forward, x right and y
+/// down. R_FLOAT32 depth is in metres; L_INT16 depth is in units of
+/// 1 / _depthScale metres, millimetres by default. Pixels with zero, NaN
+/// or infinite depth become NaN points. A registered color image of the
+/// same size adds an "rgb" field, packed as 0x00RRGGBB like PCL.
+///
+/// \code{.cpp}
+/// gz::msgs::DepthImageProjector projector;
+/// gz::msgs::PointCloudPacked cloud;
+/// ...
+/// if (projector.Project(cameraInfo, depth, cloud))
+///   process(cloud);
+/// \endcode
+class DepthImageProjector
+{
+  /// \brief Use the calibration of a camera, recomputing the rays if the
+  /// calibration changed.
+  /// \param[in] _info The camera information.
+  /// \return False if the intrinsics are missing or singular, or the
+  /// image size is zero.
+  public: bool SetCameraInfo(const CameraInfo &_info);
+
+  /// \brief Project a depth image into a cloud with FLOAT32 x, y and z
+  /// fields. The header of the cloud is copied from the image.
+  /// \param[in] _depth R_FLOAT32 or L_INT16 depth image, with the size of
+  /// the calibration.
+  /// \param[out] _cloud The organized cloud. Its data buffer is reused.
+  /// \param[in] _threads Maximum number of threads, zero for all cores.
+  /// \param[in] _depthScale L_INT16 depth units per metre.
+  /// \return False if there is no calibration, or the depth image has an
+  /// unsupported format, a different size or too little data.
+  public: bool Project(const Image &_depth, PointCloudPacked &_cloud,
+              unsigned int _threads = 1, double _depthScale = 1000.0);
+
+  /// \brief Project a depth image and a registered color image into a
+  /// cloud with FLOAT32 x, y, z and rgb fields.
+  /// \param[in] _depth R_FLOAT32 or L_INT16 depth image, with the size of
+  /// the calibration.
+  /// \param[in] _color Color image, with the size of the depth image.
+  /// Formats other than 8 bit RGB, BGR, RGBA, BGRA and L are converted
+  /// with ConvertImage first.
+  /// \param[out] _cloud The organized cloud. Its data buffer is reused.
+  /// \param[in] _threads Maximum number of threads, zero for all cores.
+  /// \param[in] _depthScale L_INT16 depth units per metre.
+  /// \return False if Project fails for the depth image, or the color
+  /// image has a different size or can't be read.
+  public: bool Project(const Image &_depth, const Image &_color,
+              PointCloudPacked &_cloud, unsigned int _threads = 1,
+              double _depthScale = 1000.0);
+
+  /// \brief Use the calibration of a camera and project a depth image.
+  /// \param[in] _info The camera information.
+  /// \param[in] _depth The depth image.
+  /// \param[out] _cloud The organized cloud.
+  /// \param[in] _threads Maximum number of threads, zero for all cores.
+  /// \return False if SetCameraInfo or Project fail.
+  public: bool Project(const CameraInfo &_info, const Image &_depth,
+              PointCloudPacked &_cloud, unsigned int _threads = 1);
+
+  /// \brief Get the hash of the current calibration.
+  /// \return The hash, zero when there is no calibration.
+  public: size_t CalibrationHash() const;
+
+  /// \brief Get the cached rays.
+  /// \return The x components of the ray through every pixel at a depth of
+  /// one, in row-major order, then the y components.
+  public: const std::vector<float> &Rays() const;
+
+  /// \brief Compute the rays.
+  /// \param[in] _info The camera information.
+  /// \return False if the calibration is unusable.
+  private: bool BuildRays(const CameraInfo &_info);
+
+  /// \brief Project a depth image, with or without color.
+  /// \param[in] _depth The depth image.
+  /// \param[in] _color The color image, or null.
+  /// \param[out] _cloud The organized cloud.
+  /// \param[in] _threads Maximum number of threads, zero for all cores.
+  /// \param[in] _depthScale L_INT16 depth units per metre.
+  /// \return False if the images can't be projected.
+  private: bool ProjectImpl(const Image &_depth, const Image *_color,
+              PointCloudPacked &_cloud, unsigned int _threads,
+              double _depthScale);
+
+  /// \brief Serialized calibration of the rays.
+  private: std::string calibration;
+
+  /// \brief Hash of the calibration.
+  private: size_t hash{0};
+
+  /// \brief Calibrated width.
+  private: uint32_t width{0};
+
+  /// \brief Calibrated height.
+  private: uint32_t height{0};
+
+  /// \brief Cached rays.
+  private: std::vector<float> rays;
+
+  /// \brief Buffer for color images that need a conversion.
+  private: Image convertedColor;
+};
+
+/////////////////////////////////////////////////
+inline bool DepthImageProjector::SetCameraInfo(const CameraInfo &_info)
+{
+  std::string key = detail::CalibrationKey(_info);
+  const size_t keyHash = std::hash<std::string>()(key);
+  if (!this->rays.empty() && keyHash == this->hash &&
+      key == this->calibration)
+  {
+    return true;
+  }
+
+  if (!this->BuildRays(_info))
+  {
+    this->rays.clear();
+    this->calibration.clear();
+    this->hash = 0;
+    this->width = 0;
+    this->height = 0;
+    return false;
+  }
+  this->calibration = std::move(key);
+  this->hash = keyHash;
+  return true;
+}
+
+/////////////////////////////////////////////////
+inline bool DepthImageProjector::Project(const Image &_depth,
+    PointCloudPacked &_cloud, unsigned int _threads, double _depthScale)
+{
+  return this->ProjectImpl(_depth, nullptr, _cloud, _threads, _depthScale);
+}
+
+/////////////////////////////////////////////////
+inline bool DepthImageProjector::Project(const Image &_depth,
+    const Image &_color, PointCloudPacked &_cloud, unsigned int _threads,
+    double _depthScale)
+{
+  return this->ProjectImpl(_depth, &_color, _cloud, _threads, _depthScale);
+}
+
+/////////////////////////////////////////////////
+inline bool DepthImageProjector::Project(const CameraInfo &_info,
+    const Image &_depth, PointCloudPacked &_cloud, unsigned int _threads)
+{
+  return this->SetCameraInfo(_info) &&
+      this->Project(_depth, _cloud, _threads);
+}
+
+/////////////////////////////////////////////////
+inline size_t DepthImageProjector::CalibrationHash() const
+{
+  return this->hash;
+}
+
+/////////////////////////////////////////////////
+inline const std::vector<float> &DepthImageProjector::Rays() const
+{
+  return this->rays;
+}
+
+/////////////////////////////////////////////////
+inline bool DepthImageProjector::ProjectImpl(const Image &_depth,
+    const Image *_color, PointCloudPacked &_cloud, unsigned int _threads,
+    double _depthScale)
+{
+  if (this->rays.empty())
+  {
+    std::cerr << "DepthImageProjector has no camera calibration.\n";
+    return false;
+  }
+
+  const PixelFormatType format = _depth.pixel_format_type();
+  if (format != R_FLOAT32 && format != L_INT16)
+  {
+    std::cerr << "Unsupported depth image format [" << format << "].\n";
+    return false;
+  }
+  if (_depth.width() != this->width || _depth.height() != this->height)
+  {
+    std::cerr << "Image size [" << _depth.width() << " x "
+              << _depth.height() << "] doesn't match the calibrated size ["
+              << this->width << " x " << this->height << "].\n";
+    return false;
+  }
+  if (!detail::ValidImageData(_depth, BytesPerPixel(format)))
+  {
+    std::cerr << "Image data is smaller than its width, height and step.\n";
+    return false;
+  }
+
+  const Image *color = _color;
+  detail::PixelFormatInfo colorInfo;
+  if (color)
+  {
+    if (color->width() != _depth.width() ||
+        color->height() != _depth.height())
+    {
+      std::cerr << "Color image size [" << color->width() << " x "
+                << color->height() << "] doesn't match the depth image.\n";
+      return false;
+    }
+    if (!detail::CheckImageSource(*color, this->convertedColor))
+      return false;
+
+    colorInfo = detail::FormatInfo(color->pixel_format_type());
+    if (colorInfo.type != detail::ChannelType::UINT8 ||
+        colorInfo.bayerRedX >= 0)
+    {
+      if (!ConvertImage(*color, RGB_INT8, this->convertedColor))
+        return false;
+      color = &this->convertedColor;
+      colorInfo = detail::FormatInfo(RGB_INT8);
+    }
+  }
+
+  const size_t fields = color ? 4u : 3u;
+  bool layoutMatches = _cloud.field_size() == static_cast<int>(fields) &&
+      _cloud.point_step() == fields * sizeof(float);
+  static const char *kNames[4] = {"x", "y", "z", "rgb"};
+  for (size_t i = 0; layoutMatches && i < fields; ++i)
+  {
+    const PointCloudPacked::Field &field = _cloud.field(static_cast<int>(i));
+    layoutMatches = field.name() == kNames[i] &&
+        field.offset() == i * sizeof(float) &&
+        field.datatype() == PointCloudPacked::Field::FLOAT32 &&
+        field.count() == 1;
+  }
+  if (!layoutMatches)
+  {
+    std::vector<std::pair<std::string, PointCloudPacked::Field::DataType>>
+        layout{{"xyz", PointCloudPacked::Field::FLOAT32}};
+    if (color)
+      layout.push_back({"rgb", PointCloudPacked::Field::FLOAT32});
+    InitPointCloudPacked(_cloud, "", false, layout);
+  }
+  *_cloud.mutable_header() = _depth.header();
+  _cloud.set_is_bigendian(false);
+  _cloud.set_width(this->width);
+  _cloud.set_height(this->height);
+  _cloud.set_row_step(_cloud.width() * _cloud.point_step());
+
+  const size_t pixels = static_cast<size_t>(this->width) * this->height;
+  const size_t step = _cloud.point_step();
+  std::string &data = *_cloud.mutable_data();
+  data.resize(pixels * step);
+
+  using Kernel = size_t (*)(const unsigned char *, const float *,
+      const float *, size_t, float, const unsigned char *, size_t,
+      const int (&)[3], char *, size_t);
+  static const Kernel kKernels[4] = {
+      detail::ProjectDepthRow<float, false>,
+      detail::ProjectDepthRow<float, true>,
+      detail::ProjectDepthRow<uint16_t, false>,
+      detail::ProjectDepthRow<uint16_t, true>};
+  const Kernel kernel =
+      kKernels[(format == L_INT16 ? 2 : 0) + (color ? 1 : 0)];
+  const float scale = format == L_INT16 ?
+      static_cast<float>(1.0 / _depthScale) : 1.0f;
+
+  const auto *depth =
+      reinterpret_cast<const unsigned char *>(_depth.data().data());
+  const auto *colorData = color ?
+      reinterpret_cast<const unsigned char *>(color->data().data()) :
+      nullptr;
+  const size_t colorBytes =
+      color ? BytesPerPixel(color->pixel_format_type()) : 0;
+  const int rgb[3] = {colorInfo.r, colorInfo.g, colorInfo.b};
+  const float *rayX = this->rays.data();
+  const float *rayY = rayX + pixels;
+  const size_t rowWidth = this->width;
+
+  const unsigned int ranges = detail::ParallelRanges(pixels, _threads);
+  std::vector<size_t> valid(ranges, 0);
+  detail::ParallelFor(this->height, ranges,
+      [&](size_t _begin, size_t _end, unsigned int _range)
+      {
+        for (size_t y = _begin; y < _end; ++y)
+        {
+          valid[_range] += kernel(depth + y * _depth.step(),
+              rayX + y * rowWidth, rayY + y * rowWidth, rowWidth, scale,
+              colorData ? colorData + y * color->step() : nullptr,
+              colorBytes, rgb, &data[y * rowWidth * step], step);
+        }
+      });
+
+  size_t total = 0;
+  for (size_t count : valid)
+    total += count;
+  _cloud.set_is_dense(total == pixels);
+  return true;
+}
+
+/////////////////////////////////////////////////
+inline bool DepthImageProjector::BuildRays(const CameraInfo &_info)
+{
+  const uint32_t w = _info.width();
+  const uint32_t h = _info.height();
+  if (w == 0 || h == 0)
+  {
+    std::cerr << "Unable to project depth images of [" << w << " x " << h
+              << "] pixels.\n";
+    return false;
+  }
+  if (_info.intrinsics().k_size() != 9)
+  {
+    std::cerr << "CameraInfo intrinsics must hold a 3x3 matrix.\n";
+    return false;
+  }
+
+  double k[9];
+  for (int i = 0; i < 9; ++i)
+    k[i] = _info.intrinsics().k(i);
+  double inv[9];
+  if (!detail::Invert3x3(k, inv))
+  {
+    std::cerr << "CameraInfo intrinsics are singular.\n";
+    return false;
+  }
+
+  double coefficients[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  bool distorted = false;
+  const auto &distortion = _info.distortion();
+  for (int i = 0; i < std::min(8, distortion.k_size()); ++i)
+  {
+    coefficients[i] = distortion.k(i);
+    distorted = distorted || std::fpclassify(coefficients[i]) != FP_ZERO;
+  }
+
+  this->width = w;
+  this->height = h;
+  const size_t pixels = static_cast<size_t>(w) * h;
+  this->rays.resize(2 * pixels);
+  float *rayX = this->rays.data();
+  float *rayY = rayX + pixels;
+  for (uint32_t v = 0; v < h; ++v)
+  {
+    for (uint32_t u = 0; u < w; ++u, ++rayX, ++rayY)
+    {
+      const double z = inv[6] * u + inv[7] * v + inv[8];
+      double x = (inv[0] * u + inv[1] * v + inv[2]) / z;
+      double y = (inv[3] * u + inv[4] * v + inv[5]) / z;
+      if (distorted)
+        detail::Undistort(distortion.model(), coefficients, x, y, x, y);
+      *rayX = static_cast<float>(x);
+      *rayY = static_cast<float>(y);
+    }
+  }
+  return true;
+}
+}
+}
+
+#endif
@@ -0,0 +1,440 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_MSGS_CHUNKUTILS_HH_
+#define GZ_MSGS_CHUNKUTILS_HH_
+
+#include <gz/msgs/header.pb.h>
+#include <gz/msgs/image.pb.h>
+#include <gz/msgs/pointcloud_packed.pb.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "gz/msgs/config.hh"
+#include "gz/msgs/detail/ChunkUtils.hh"
+
+namespace gz
+{
+namespace msgs
+{
+/// \brief Position of a chunk within a message that was split with
+/// SplitIntoChunks.
+///
+/// Images and organized clouds (height > 1) are split into whole rows, and
+/// unorganized clouds into whole points. The information travels in the
+/// header data of every chunk under the "chunk_sequence", "chunk_index",
+/// "chunk_count", "chunk_offset", "chunk_height" and "chunk_width" keys.
+struct ChunkInfo
+{
+  /// \brief Sequence number shared by the chunks of a message, and
+  /// different for every message split.
+  uint64_t sequence{0};
+
+  /// \brief Index of the chunk, from zero.
+  uint32_t index{0};
+
+  /// \brief Number of chunks the message was split into.
+  uint32_t count{0};
+
+  /// \brief First row, or first point of an unorganized cloud, that the
+  /// chunk holds.
+  uint32_t offset{0};
+
+  /// \brief Height of the whole message.
+  uint32_t height{0};
+
+  /// \brief Width of the whole message.
+  uint32_t width{0};
+};
+
+/// \brief Read the chunk information from a header.
+/// \param[in] _header Header of a chunk.
+/// \param[out] _info The chunk information.
+/// \return True if every chunk key was found and is a valid number.
+inline bool ChunkInfoFromHeader(const msgs::Header &_header,
+    ChunkInfo &_info)
+{
+  auto read = [&](const char *_key, auto &_value)
+  {
+    auto it = std::find_if(_header.data().begin(), _header.data().end(),
+        [&](const msgs::Header::Map &_data)
+        {
+          return _data.key() == _key && _data.value_size() > 0;
+        });
+    if (it == _header.data().end())
+      return false;
+
+    const std::string &str = it->value(0);
+    const char *end = str.data() + str.size();
+    auto result = std::from_chars(str.data(), end, _value);
+    return result.ec == std::errc() && result.ptr == end;
+  };
+
+  return read(detail::kChunkSequenceKey, _info.sequence) &&
+      read(detail::kChunkIndexKey, _info.index) &&
+      read(detail::kChunkCountKey, _info.count) &&
+      read(detail::kChunkOffsetKey, _info.offset) &&
+      read(detail::kChunkHeightKey, _info.height) &&
+      read(detail::kChunkWidthKey, _info.width);
+}
+
+namespace detail
+{
+/// \brief Number of rows, or of points of an unorganized cloud, of the
+/// whole message that a chunk belongs to.
+/// \param[in] _info Chunk information of the chunk.
+/// \return Number of units of the whole message.
+inline size_t ChunkUnits(const Image &, const ChunkInfo &_info)
+{
+  return _info.height;
+}
+
+/// \copydoc ChunkUnits(const Image &, const ChunkInfo &)
+inline size_t ChunkUnits(const PointCloudPacked &, const ChunkInfo &_info)
+{
+  return _info.height > 1 ? _info.height : _info.width;
+}
+
+/// \brief Check that a chunk agrees with the size of the whole message
+/// that its chunk information describes, before anything is allocated
+/// from that information. Every chunk but the last holds the same number
+/// of rows or points, so the data of any chunk bounds the message size.
+/// \param[in] _chunk The chunk.
+/// \param[in] _info Chunk information of _chunk.
+/// \return False if the chunk count exceeds the number of rows or points,
+/// the message size overflows, or the chunk data lies outside the message
+/// or is too small for its size.
+template<typename MsgT>
+bool ChunkFits(const MsgT &_chunk, const ChunkInfo &_info)
+{
+  const size_t units = ChunkUnits(_chunk, _info);
+  const size_t unitBytes = ChunkUnitBytes(_chunk, _info.height);
+  if (_info.count > std::max<size_t>(1u, units) || (unitBytes > 0 &&
+      units > std::numeric_limits<size_t>::max() / unitBytes))
+  {
+    std::cerr << "Chunk [" << _info.index << "] describes a message of ["
+              << units << "] rows or points of [" << unitBytes
+              << "] bytes in [" << _info.count << "] chunks.\n";
+    return false;
+  }
+
+  // The last row may lack its padding.
+  const size_t size = _chunk.data().size();
+  const size_t chunkUnits = unitBytes > 0 ?
+      (size + unitBytes - 1) / unitBytes : 0;
+  const bool last = _info.index + 1 == _info.count;
+  if ((unitBytes == 0 && size > 0) || _info.offset > units ||
+      chunkUnits > units - _info.offset ||
+      (last && _info.offset + chunkUnits != units) ||
+      (!last && (chunkUnits == 0 || (units - 1) / chunkUnits >= _info.count)))
+  {
+    std::cerr << "Chunk [" << _info.index << "] is out of bounds.\n";
+    return false;
+  }
+  return true;
+}
+
+/// \brief Implementation of SplitIntoChunks.
+/// \param[in] _msg Message to split.
+/// \param[in] _maxChunkBytes Maximum data size of a chunk.
+/// \param[in] _callback Function called with every chunk.
+/// \return False if the message can't be split.
+template<typename MsgT>
+bool SplitIntoChunks(const MsgT &_msg, size_t _maxChunkBytes,
+    const std::function<void(const MsgT &)> &_callback)
+{
+  const size_t units = ChunkUnits(_msg);
+  const size_t unitBytes = ChunkUnitBytes(_msg, _msg.height());
+  if (unitBytes == 0 || _maxChunkBytes == 0)
+  {
+    std::cerr << "Unable to split a message with a row size of ["
+              << unitBytes << "] bytes into chunks of [" << _maxChunkBytes
+              << "] bytes.\n";
+    return false;
+  }
+  if (units == 0 && !_msg.data().empty())
+  {
+    std::cerr << "Unable to split a message with [" << _msg.data().size()
+              << "] bytes of data but no rows or points.\n";
+    return false;
+  }
+
+  // Chunks always hold at least one row, even when a row is larger than
+  // the requested chunk size.
+  const size_t perChunk = std::max<size_t>(1u, _maxChunkBytes / unitBytes);
+  const size_t count = std::max<size_t>(1u,
+      (units + perChunk - 1) / perChunk);
+
+  MsgT chunk;
+  CopyChunkMetadata(_msg, chunk);
+  CopyHeaderWithoutChunkInfo(_msg.header(), *chunk.mutable_header());
+  auto addKey = [&](const char *_key, uint64_t _value)
+  {
+    Header::Map *data = chunk.mutable_header()->add_data();
+    data->set_key(_key);
+    data->add_value(std::to_string(_value));
+    return data->mutable_value(0);
+  };
+  addKey(kChunkSequenceKey, NextChunkSequence());
+  std::string *index = addKey(kChunkIndexKey, 0);
+  addKey(kChunkCountKey, count);
+  std::string *offset = addKey(kChunkOffsetKey, 0);
+  addKey(kChunkHeightKey, _msg.height());
+  addKey(kChunkWidthKey, _msg.width());
+
+  const std::string &data = _msg.data();
+  for (size_t i = 0; i < count; ++i)
+  {
+    const size_t begin = i * perChunk;
+    const size_t size = std::min(perChunk, units - begin);
+    SetChunkUnits(chunk, size, _msg.height());
+    *index = std::to_string(i);
+    *offset = std::to_string(begin);
+
+    // The last row may lack its padding.
+    const size_t byteBegin = std::min(begin * unitBytes, data.size());
+    const size_t byteEnd = std::min((begin + size) * unitBytes, data.size());
+    chunk.mutable_data()->assign(data, byteBegin, byteEnd - byteBegin);
+    _callback(chunk);
+  }
+  return true;
+}
+}  // namespace detail
+
+/// \brief Split an image into chunks of whole rows.
+///
+/// Every chunk is a valid image holding a band of rows, so consumers can
+/// process chunks as they arrive. The chunk position is stored in the
+/// header, see ChunkInfo. The same chunk message is reused for every call
+/// of _callback, which bounds the memory needed to send a large image.
+///
+/// \param[in] _msg Image to split.
+/// \param[in] _maxChunkBytes Maximum data size of a chunk. A chunk holds at
+/// least one row.
+/// \param[in] _callback Function called with every chunk, in order.
+/// \return False if the image has no row size, has data but no rows, or
+/// _maxChunkBytes is zero.
+inline bool SplitIntoChunks(const msgs::Image &_msg, size_t _maxChunkBytes,
+    const std::function<void(const msgs::Image &)> &_callback)
+{
+  return detail::SplitIntoChunks(_msg, _maxChunkBytes, _callback);
+}
+
+/// \brief Split a point cloud into chunks of whole rows, or of whole points
+/// if the cloud is unorganized.
+///
+/// Every chunk is a valid point cloud, so consumers can process chunks as
+/// they arrive. The chunk position is stored in the header, see ChunkInfo.
+/// The same chunk message is reused for every call of _callback, which
+/// bounds the memory needed to send a large cloud.
+///
+/// \param[in] _msg Point cloud to split.
+/// \param[in] _maxChunkBytes Maximum data size of a chunk. A chunk holds at
+/// least one row or point.
+/// \param[in] _callback Function called with every chunk, in order.
+/// \return False if the cloud has no row or point size, has data but no
+/// rows or points, or _maxChunkBytes is zero.
+inline bool SplitIntoChunks(const msgs::PointCloudPacked &_msg,
+    size_t _maxChunkBytes,
+    const std::function<void(const msgs::PointCloudPacked &)> &_callback)
+{
+  return detail::SplitIntoChunks(_msg, _maxChunkBytes, _callback);
+}
+
+/// \brief Split an image or a point cloud into chunks.
+/// \param[in] _msg Message to split.
+/// \param[in] _maxChunkBytes Maximum data size of a chunk.
+/// \return The chunks, or an empty vector on error.
+/// \sa SplitIntoChunks(const msgs::Image &, size_t,
+/// const std::function<void(const msgs::Image &)> &)
+template<typename MsgT>
+std::vector<MsgT> SplitIntoChunks(const MsgT &_msg, size_t _maxChunkBytes)
+{
+  std::vector<MsgT> chunks;
+  if (!SplitIntoChunks(_msg, _maxChunkBytes,
+      std::function<void(const MsgT &)>([&](const MsgT &_chunk)
+      {
+        chunks.push_back(_chunk);
+      })))
+  {
+    chunks.clear();
+  }
+  return chunks;
+}
+
+/// \brief Reassembles chunks created by SplitIntoChunks into a destination
+/// message, as they arrive.
+///
+/// Chunks can arrive in any order. The data of every chunk is copied in
+/// place into the destination message, whose data buffer is only
+/// reallocated if it's too small, so a destination reused across messages
+/// stays preallocated. A chunk of a different message (different sequence
+/// number, stamp, geometry or chunk count) starts a new reassembly. Chunks
+/// of a message that is already complete are rejected, so late duplicates
+/// leave the destination message intact.
+///
+/// \code{.cpp}
+/// gz::msgs::Image image;
+/// gz::msgs::ChunkReassembler<gz::msgs::Image> reassembler(image);
+/// ...
+/// if (reassembler.Add(chunk) && reassembler.Complete())
+///   process(image);
+/// \endcode
+///
+/// \tparam MsgT msgs::Image or msgs::PointCloudPacked.
+template<typename MsgT>
+class ChunkReassembler
+{
+  /// \brief Constructor.
+  /// \param[in] _dst Message to reassemble into. Must outlive this object.
+  public: explicit ChunkReassembler(MsgT &_dst);
+
+  /// \brief Copy a chunk into the destination message.
+  /// \param[in] _chunk The chunk.
+  /// \return False if the chunk has no valid chunk information, doesn't
+  /// fit in the message it belongs to, or belongs to a message that is
+  /// already complete.
+  public: bool Add(const MsgT &_chunk);
+
+  /// \brief Whether every chunk of the current message was added.
+  /// \return True if the destination message is complete.
+  public: bool Complete() const;
+
+  /// \brief Forget the chunks added so far.
+  public: void Reset();
+
+  /// \brief Start reassembling a new message.
+  /// \param[in] _chunk First chunk received of the message.
+  /// \param[in] _info Chunk information of _chunk.
+  private: void Start(const MsgT &_chunk, const ChunkInfo &_info);
+
+  /// \brief The destination message.
+  private: MsgT &dst;
+
+  /// \brief Chunk information of the first chunk of the current message.
+  private: ChunkInfo info;
+
+  /// \brief Size of a row, or of a point of an unorganized cloud.
+  private: size_t unitBytes{0};
+
+  /// \brief Which chunks were added.
+  private: std::vector<bool> received;
+
+  /// \brief Number of chunks not added yet.
+  private: size_t remaining{0};
+};
+
+/////////////////////////////////////////////////
+template<typename MsgT>
+ChunkReassembler<MsgT>::ChunkReassembler(MsgT &_dst)
+  : dst(_dst)
+{
+}
+
+/////////////////////////////////////////////////
+template<typename MsgT>
+bool ChunkReassembler<MsgT>::Add(const MsgT &_chunk)
+{
+  ChunkInfo chunkInfo;
+  if (!ChunkInfoFromHeader(_chunk.header(), chunkInfo) ||
+      chunkInfo.index >= chunkInfo.count)
+  {
+    std::cerr << "Message has no valid chunk information.\n";
+    return false;
+  }
+  if (!detail::ChunkFits(_chunk, chunkInfo))
+    return false;
+
+  const Header &header = this->dst.header();
+  const bool sameMessage = !this->received.empty() &&
+      chunkInfo.sequence == this->info.sequence &&
+      chunkInfo.count == this->info.count &&
+      chunkInfo.height == this->info.height &&
+      chunkInfo.width == this->info.width &&
+      _chunk.header().stamp().sec() == header.stamp().sec() &&
+      _chunk.header().stamp().nsec() == header.stamp().nsec() &&
+      detail::ChunkUnitBytes(_chunk, chunkInfo.height) == this->unitBytes;
+  if (sameMessage && this->Complete())
+    return false;
+  if (!sameMessage)
+    this->Start(_chunk, chunkInfo);
+
+  const size_t begin = chunkInfo.offset * this->unitBytes;
+  std::string &data = *this->dst.mutable_data();
+  if (begin > data.size() || _chunk.data().size() > data.size() - begin)
+  {
+    std::cerr << "Chunk [" << chunkInfo.index << "] is out of bounds.\n";
+    return false;
+  }
+  if (!_chunk.data().empty())
+    std::memcpy(&data[begin], _chunk.data().data(), _chunk.data().size());
+
+  if (!this->received[chunkInfo.index])
+  {
+    this->received[chunkInfo.index] = true;
+    --this->remaining;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+template<typename MsgT>
+bool ChunkReassembler<MsgT>::Complete() const
+{
+  return !this->received.empty() && this->remaining == 0;
+}
+
+/////////////////////////////////////////////////
+template<typename MsgT>
+void ChunkReassembler<MsgT>::Reset()
+{
+  this->received.clear();
+  this->remaining = 0;
+}
+
+/////////////////////////////////////////////////
+template<typename MsgT>
+void ChunkReassembler<MsgT>::Start(const MsgT &_chunk,
+    const ChunkInfo &_info)
+{
+  this->info = _info;
+  this->received.assign(_info.count, false);
+  this->remaining = _info.count;
+
+  detail::CopyChunkMetadata(_chunk, this->dst);
+  detail::CopyHeaderWithoutChunkInfo(_chunk.header(),
+      *this->dst.mutable_header());
+  this->dst.set_height(_info.height);
+  this->dst.set_width(_info.width);
+  const size_t units = detail::ChunkUnits(this->dst);
+  detail::SetChunkUnits(this->dst, units, _info.height);
+  this->unitBytes = detail::ChunkUnitBytes(this->dst, _info.height);
+  this->dst.mutable_data()->resize(units * this->unitBytes);
+}
+}
+}
+
+#endif
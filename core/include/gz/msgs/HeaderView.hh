@@ -0,0 +1,420 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_MSGS_HEADERVIEW_HH_
+#define GZ_MSGS_HEADERVIEW_HH_
+
+#include <gz/msgs/header.pb.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gz/msgs/config.hh"
+
+namespace gz
+{
+namespace msgs
+{
+/// \brief Keys of Header data that are used by many messages.
+enum class HeaderKey
+{
+  /// \brief "frame_id", the frame of the data.
+  FRAME_ID,
+
+  /// \brief "child_frame_id", the frame that a transform moves.
+  CHILD_FRAME_ID,
+
+  /// \brief "seq", the sequence number of the message.
+  SEQ
+};
+
+namespace detail
+{
+/// \brief Number of HeaderKey values.
+constexpr size_t kHeaderKeyCount = 3;
+
+/// \brief Names of the HeaderKey values.
+constexpr std::string_view kHeaderKeyNames[kHeaderKeyCount] = {
+    "frame_id", "child_frame_id", "seq"};
+
+/// \brief Find the HeaderKey of a key name.
+/// \param[in] _key The key name.
+/// \return Index of the HeaderKey, or -1 if the key isn't well known.
+inline int WellKnownHeaderKey(std::string_view _key)
+{
+  // The names have different lengths, so the length selects the candidate
+  switch (_key.size())
+  {
+    case 8:
+      return _key == kHeaderKeyNames[0] ? 0 : -1;
+    case 14:
+      return _key == kHeaderKeyNames[1] ? 1 : -1;
+    case 3:
+      return _key == kHeaderKeyNames[2] ? 2 : -1;
+    default:
+      return -1;
+  }
+}
+
+/// \brief Fingerprint of a key: its length and its first and last four
+/// bytes, which are cheap to compute and tell most keys apart.
+/// \param[in] _key The key.
+/// \return The fingerprint.
+inline uint64_t HeaderKeyFingerprint(std::string_view _key)
+{
+  uint32_t first = 0;
+  uint32_t last = 0;
+  if (_key.empty())
+    return 0;
+  const size_t bytes = std::min<size_t>(_key.size(), 4u);
+  std::memcpy(&first, _key.data(), bytes);
+  std::memcpy(&last, _key.data() + _key.size() - bytes, bytes);
+  return (static_cast<uint64_t>(first ^ (last << 1)) << 32) |
+      static_cast<uint32_t>(_key.size());
+}
+
+/// \brief Index entry of a key that isn't well known.
+struct HeaderIndexEntry
+{
+  /// \brief Fingerprint of the key.
+  uint64_t fingerprint;
+
+  /// \brief Index of the Header::Map in Header::data.
+  int index;
+};
+
+/// \brief Number of other keys that a HeaderIndex stores without
+/// allocating.
+constexpr size_t kHeaderIndexInline = 8;
+}  // namespace detail
+
+/// \brief Index of the keys of a Header, for lookups without string
+/// compares against every entry.
+///
+/// Building the index visits every entry once. Well known keys are
+/// interned into a fixed table, and other keys go into a compact array of
+/// fingerprints, stored inline for small headers, so a lookup compares a
+/// few integers and usually a single string.
+/// When a key appears more than once, the first entry wins, like a linear
+/// scan. Rebuild the index after the Header::data entries are added,
+/// removed or reordered; the storage of the index is reused.
+class HeaderIndex
+{
+  /// \brief Create an empty index.
+  public: HeaderIndex() = default;
+
+  /// \brief Create the index of a header.
+  /// \param[in] _header The header.
+  public: explicit HeaderIndex(const Header &_header);
+
+  /// \brief Rebuild the index for a header.
+  /// \param[in] _header The header.
+  public: void Build(const Header &_header);
+
+  /// \brief Find a key.
+  /// \param[in] _header The header the index was built for.
+  /// \param[in] _key The key.
+  /// \return Index of the first Header::Map with the key in the data of
+  /// the header, or -1 if there is none.
+  public: int Find(const Header &_header, std::string_view _key) const;
+
+  /// \brief Find a well known key.
+  /// \param[in] _key The key.
+  /// \return Index of the first Header::Map with the key, or -1.
+  public: int Find(HeaderKey _key) const;
+
+  /// \brief Index of the first entry of every well known key.
+  private: int wellKnown[detail::kHeaderKeyCount] = {-1, -1, -1};
+
+  /// \brief First entries of the other keys, in header order.
+  private: detail::HeaderIndexEntry inlineEntries[
+      detail::kHeaderIndexInline];
+
+  /// \brief Number of other keys.
+  private: size_t otherCount{0};
+
+  /// \brief Entries of the other keys after the inline ones.
+  private: std::vector<detail::HeaderIndexEntry> overflow;
+};
+
+/// \brief Read-only view of a Header with indexed key lookups.
+///
+/// \code{.cpp}
+/// gz::msgs::HeaderView header(msg.header());
+/// std::string_view frame = header.FrameId();
+/// std::string_view sensor = header.Value("sensor");
+/// \endcode
+///
+/// The view refers to the header, which must outlive it and must not
+/// change while it is used.
+class HeaderView
+{
+  /// \brief Create a view of a header.
+  /// \param[in] _header The header.
+  public: explicit HeaderView(const Header &_header);
+
+  /// \brief Find the entry of a key.
+  /// \param[in] _key The key.
+  /// \return The first entry with the key, or null.
+  public: const Header::Map *Find(std::string_view _key) const;
+
+  /// \brief Find the entry of a well known key.
+  /// \param[in] _key The key.
+  /// \return The first entry with the key, or null.
+  public: const Header::Map *Find(HeaderKey _key) const;
+
+  /// \brief Get the first value of a key.
+  /// \param[in] _key The key.
+  /// \param[in] _default Value returned when the key or its value is
+  /// missing.
+  /// \return The value.
+  public: std::string_view Value(std::string_view _key,
+              std::string_view _default = {}) const;
+
+  /// \brief Get the first value of a well known key.
+  /// \param[in] _key The key.
+  /// \param[in] _default Value returned when the key or its value is
+  /// missing.
+  /// \return The value.
+  public: std::string_view Value(HeaderKey _key,
+              std::string_view _default = {}) const;
+
+  /// \brief Get the frame id.
+  /// \return The first "frame_id" value, or an empty string.
+  public: std::string_view FrameId() const;
+
+  /// \brief Get the header.
+  /// \return The header of the view.
+  public: const Header &Data() const;
+
+  /// \brief Get the index.
+  /// \return The index of the header.
+  public: const HeaderIndex &Index() const;
+
+  /// \brief The header.
+  private: const Header *header;
+
+  /// \brief Index of the header.
+  private: HeaderIndex index;
+};
+
+/// \brief Set the value of a key, replacing the values of its first entry
+/// in place and removing later entries with the same key. An entry is
+/// added when the key is missing.
+/// \param[in, out] _header The header.
+/// \param[in] _key The key.
+/// \param[in] _value The value.
+/// \return The entry of the key.
+inline Header::Map *SetHeaderValue(Header &_header, std::string_view _key,
+    std::string_view _value)
+{
+  auto *data = _header.mutable_data();
+  int found = -1;
+  int kept = 0;
+  for (int i = 0; i < data->size(); ++i)
+  {
+    const std::string &key = data->Get(i).key();
+    if (key.size() == _key.size() && key == _key)
+    {
+      if (found >= 0)
+        continue;
+      found = kept;
+    }
+    if (kept != i)
+      data->SwapElements(kept, i);
+    ++kept;
+  }
+  if (kept < data->size())
+    data->DeleteSubrange(kept, data->size() - kept);
+
+  Header::Map *entry = nullptr;
+  if (found < 0)
+  {
+    entry = data->Add();
+    entry->set_key(_key.data(), _key.size());
+  }
+  else
+  {
+    entry = data->Mutable(found);
+  }
+
+  // Reuse the first value string instead of reallocating it
+  auto *values = entry->mutable_value();
+  if (values->empty())
+    values->Add();
+  else if (values->size() > 1)
+    values->DeleteSubrange(1, values->size() - 1);
+  values->Mutable(0)->assign(_value.data(), _value.size());
+  return entry;
+}
+
+/// \brief Set the value of a well known key.
+/// \param[in, out] _header The header.
+/// \param[in] _key The key.
+/// \param[in] _value The value.
+/// \return The entry of the key.
+inline Header::Map *SetHeaderValue(Header &_header, HeaderKey _key,
+    std::string_view _value)
+{
+  return SetHeaderValue(_header,
+      detail::kHeaderKeyNames[static_cast<size_t>(_key)], _value);
+}
+
+/// \brief Set the frame id of a header.
+/// \param[in, out] _header The header.
+/// \param[in] _frameId The frame id.
+inline void SetFrameId(Header &_header, std::string_view _frameId)
+{
+  SetHeaderValue(_header, HeaderKey::FRAME_ID, _frameId);
+}
+
+/////////////////////////////////////////////////
+inline HeaderIndex::HeaderIndex(const Header &_header)
+{
+  this->Build(_header);
+}
+
+/////////////////////////////////////////////////
+inline void HeaderIndex::Build(const Header &_header)
+{
+  for (int &index : this->wellKnown)
+    index = -1;
+  this->otherCount = 0;
+  this->overflow.clear();
+
+  for (int i = 0; i < _header.data_size(); ++i)
+  {
+    const std::string &key = _header.data(i).key();
+    const int known = detail::WellKnownHeaderKey(key);
+    if (known >= 0)
+    {
+      if (this->wellKnown[known] < 0)
+        this->wellKnown[known] = i;
+      continue;
+    }
+
+    const detail::HeaderIndexEntry entry{
+        detail::HeaderKeyFingerprint(key), i};
+    if (this->otherCount < detail::kHeaderIndexInline)
+      this->inlineEntries[this->otherCount] = entry;
+    else
+      this->overflow.push_back(entry);
+    ++this->otherCount;
+  }
+}
+
+/////////////////////////////////////////////////
+inline int HeaderIndex::Find(const Header &_header,
+    std::string_view _key) const
+{
+  const int known = detail::WellKnownHeaderKey(_key);
+  if (known >= 0)
+    return this->wellKnown[known];
+
+  const uint64_t fingerprint = detail::HeaderKeyFingerprint(_key);
+  auto matches = [&](const detail::HeaderIndexEntry &_entry)
+  {
+    return _entry.fingerprint == fingerprint &&
+        _entry.index < _header.data_size() &&
+        _header.data(_entry.index).key() == _key;
+  };
+
+  const size_t inlineCount =
+      std::min(this->otherCount, detail::kHeaderIndexInline);
+  for (size_t i = 0; i < inlineCount; ++i)
+  {
+    if (matches(this->inlineEntries[i]))
+      return this->inlineEntries[i].index;
+  }
+  for (const detail::HeaderIndexEntry &entry : this->overflow)
+  {
+    if (matches(entry))
+      return entry.index;
+  }
+  return -1;
+}
+
+/////////////////////////////////////////////////
+inline int HeaderIndex::Find(HeaderKey _key) const
+{
+  return this->wellKnown[static_cast<size_t>(_key)];
+}
+
+/////////////////////////////////////////////////
+inline HeaderView::HeaderView(const Header &_header)
+  : header(&_header), index(_header)
+{
+}
+
+/////////////////////////////////////////////////
+inline const Header::Map *HeaderView::Find(std::string_view _key) const
+{
+  const int i = this->index.Find(*this->header, _key);
+  return i < 0 ? nullptr : &this->header->data(i);
+}
+
+/////////////////////////////////////////////////
+inline const Header::Map *HeaderView::Find(HeaderKey _key) const
+{
+  const int i = this->index.Find(_key);
+  return i < 0 ? nullptr : &this->header->data(i);
+}
+
+/////////////////////////////////////////////////
+inline std::string_view HeaderView::Value(std::string_view _key,
+    std::string_view _default) const
+{
+  const Header::Map *entry = this->Find(_key);
+  return entry && entry->value_size() > 0 ?
+      std::string_view(entry->value(0)) : _default;
+}
+
+/////////////////////////////////////////////////
+inline std::string_view HeaderView::Value(HeaderKey _key,
+    std::string_view _default) const
+{
+  const Header::Map *entry = this->Find(_key);
+  return entry && entry->value_size() > 0 ?
+      std::string_view(entry->value(0)) : _default;
+}
+
+/////////////////////////////////////////////////
+inline std::string_view HeaderView::FrameId() const
+{
+  return this->Value(HeaderKey::FRAME_ID);
+}
+
+/////////////////////////////////////////////////
+inline const Header &HeaderView::Data() const
+{
+  return *this->header;
+}
+
+/////////////////////////////////////////////////
+inline const HeaderIndex &HeaderView::Index() const
+{
+  return this->index;
+}
+}
+}
+
+#endif
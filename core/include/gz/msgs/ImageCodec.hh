@@ -0,0 +1,704 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_MSGS_IMAGECODEC_HH_
+#define GZ_MSGS_IMAGECODEC_HH_
+
+#include <gz/msgs/image.pb.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "gz/msgs/config.hh"
+#include "gz/msgs/ImageUtils.hh"
+#include "gz/msgs/detail/EntropyCoder.hh"
+#include "gz/msgs/detail/ImageUtils.hh"
+
+namespace gz
+{
+namespace msgs
+{
+namespace detail
+{
+/// \brief Magic bytes at the start of an encoded Image.
+constexpr char kImageCodecMagic[4] = {'G', 'Z', 'I', 'M'};
+
+/// \brief Version of the encoded Image format.
+constexpr uint8_t kImageCodecVersion = 1;
+
+/// \brief Quantized depth of NaN values.
+constexpr int32_t kDepthNaN = std::numeric_limits<int32_t>::min();
+
+/// \brief Quantized depth of negative infinity.
+constexpr int32_t kDepthNegativeInf = kDepthNaN + 1;
+
+/// \brief Quantized depth of positive infinity.
+constexpr int32_t kDepthPositiveInf = std::numeric_limits<int32_t>::max();
+
+/// \brief Quantize a depth value. Non finite values get reserved codes.
+/// \param[in] _value Depth value.
+/// \param[in] _scale Inverse of the precision.
+/// \return Quantized value, clamped to the codes of finite values.
+inline uint32_t QuantizeDepth(float _value, double _scale)
+{
+  int32_t q;
+  if (std::isnan(_value))
+    q = kDepthNaN;
+  else if (std::isinf(_value))
+    q = _value > 0 ? kDepthPositiveInf : kDepthNegativeInf;
+  else
+  {
+    const double v = std::floor(_value * _scale + 0.5);
+    q = static_cast<int32_t>(std::max<double>(kDepthNegativeInf + 1,
+        std::min<double>(kDepthPositiveInf - 1, v)));
+  }
+  return static_cast<uint32_t>(q);
+}
+
+/// \brief Inverse of QuantizeDepth.
+/// \param[in] _code Quantized value.
+/// \param[in] _precision Precision of the quantized value.
+/// \return Depth value.
+inline float DequantizeDepth(uint32_t _code, double _precision)
+{
+  const int32_t q = static_cast<int32_t>(_code);
+  if (q == kDepthNaN)
+    return std::numeric_limits<float>::quiet_NaN();
+  if (q == kDepthNegativeInf)
+    return -std::numeric_limits<float>::infinity();
+  if (q == kDepthPositiveInf)
+    return std::numeric_limits<float>::infinity();
+  return static_cast<float>(q * _precision);
+}
+
+/// \brief Median edge detector of LOCO-I: predict a value from its left,
+/// upper and upper left neighbors. Written without branches, so loops over
+/// a row vectorize.
+/// \param[in] _a Left neighbor.
+/// \param[in] _b Upper neighbor.
+/// \param[in] _c Upper left neighbor.
+/// \return The prediction.
+template<typename T>
+T PredictMed(T _a, T _b, T _c)
+{
+  return std::min(std::max(static_cast<T>(_a + _b - _c), std::min(_a, _b)),
+      std::max(_a, _b));
+}
+
+/// \brief Signed type wide enough to predict values of type U.
+template<typename U>
+using PredictT = std::conditional_t<(sizeof(U) < 4), int32_t, int64_t>;
+
+/// \brief Store the zigzag coded difference between values and their
+/// predictions, split into byte planes.
+/// \param[in] _values Densely packed rows of values.
+/// \param[in] _rowSize Number of values in a row.
+/// \param[in] _rows Number of rows.
+/// \param[in] _left Distance to the left neighbor, in values.
+/// \param[in] _up Distance to the upper neighbor, in rows.
+/// \param[out] _planes sizeof(U) planes of _rowSize * _rows bytes each.
+template<typename U>
+void EncodeImageResiduals(const U *_values, size_t _rowSize, size_t _rows,
+    size_t _left, size_t _up, uint8_t *_planes)
+{
+  using P = PredictT<U>;
+  constexpr int kBits = sizeof(U) * 8;
+  const size_t count = _rowSize * _rows;
+  _left = std::min(_left, _rowSize);
+  for (size_t y = 0; y < _rows; ++y)
+  {
+    const U *row = _values + y * _rowSize;
+    const U *upRow = y >= _up ? row - _up * _rowSize : nullptr;
+    const size_t base = y * _rowSize;
+    auto store = [&](size_t _x, P _prediction)
+    {
+      const U delta = static_cast<U>(row[_x] - static_cast<U>(_prediction));
+      const U sign = static_cast<U>(0) - static_cast<U>(delta >> (kBits - 1));
+      const U zigzag = static_cast<U>(static_cast<U>(delta << 1) ^ sign);
+      for (size_t b = 0; b < sizeof(U); ++b)
+      {
+        _planes[b * count + base + _x] =
+            static_cast<uint8_t>(zigzag >> (8 * b));
+      }
+    };
+
+    for (size_t x = 0; x < _left; ++x)
+      store(x, upRow ? static_cast<P>(upRow[x]) : 0);
+
+    if (upRow)
+    {
+      for (size_t x = _left; x < _rowSize; ++x)
+      {
+        store(x, PredictMed<P>(row[x - _left], upRow[x],
+            upRow[x - _left]));
+      }
+    }
+    else
+    {
+      for (size_t x = _left; x < _rowSize; ++x)
+        store(x, row[x - _left]);
+    }
+  }
+}
+
+/// \brief Inverse of EncodeImageResiduals.
+/// \param[in] _planes sizeof(U) planes of _rowSize * _rows bytes each.
+/// \param[in] _rowSize Number of values in a row.
+/// \param[in] _rows Number of rows.
+/// \param[in] _left Distance to the left neighbor, in values.
+/// \param[in] _up Distance to the upper neighbor, in rows.
+/// \param[out] _values Densely packed rows of values.
+template<typename U>
+void DecodeImageResiduals(const uint8_t *_planes, size_t _rowSize,
+    size_t _rows, size_t _left, size_t _up, U *_values)
+{
+  using P = PredictT<U>;
+  const size_t count = _rowSize * _rows;
+  _left = std::min(_left, _rowSize);
+  for (size_t y = 0; y < _rows; ++y)
+  {
+    U *row = _values + y * _rowSize;
+    const U *upRow = y >= _up ? row - _up * _rowSize : nullptr;
+    const size_t base = y * _rowSize;
+    auto load = [&](size_t _x, P _prediction)
+    {
+      U zigzag = 0;
+      for (size_t b = 0; b < sizeof(U); ++b)
+        zigzag |= static_cast<U>(_planes[b * count + base + _x]) << (8 * b);
+      const U delta = static_cast<U>(
+          (zigzag >> 1) ^ (static_cast<U>(0) - (zigzag & 1)));
+      row[_x] = static_cast<U>(static_cast<U>(_prediction) + delta);
+    };
+
+    for (size_t x = 0; x < _left; ++x)
+      load(x, upRow ? static_cast<P>(upRow[x]) : 0);
+
+    if (upRow)
+    {
+      for (size_t x = _left; x < _rowSize; ++x)
+        load(x, PredictMed<P>(row[x - _left], upRow[x], upRow[x - _left]));
+    }
+    else
+    {
+      for (size_t x = _left; x < _rowSize; ++x)
+        load(x, row[x - _left]);
+    }
+  }
+}
+
+/// \brief Visit the bytes of an image's data that don't belong to any
+/// pixel (row padding and trailing bytes).
+/// \param[in, out] _data Start of the image data.
+/// \param[in] _size Size of the image data.
+/// \param[in] _rowBytes Size of the pixels of a row.
+/// \param[in] _step Distance between the start of two rows.
+/// \param[in] _rows Number of rows.
+/// \param[in] _func Callable taking (char *_start, size_t _size) for every
+/// gap.
+template<typename CharT, typename Func>
+void ForEachImageGap(CharT *_data, size_t _size, size_t _rowBytes,
+    size_t _step, size_t _rows, Func &&_func)
+{
+  size_t pos = 0;
+  for (size_t row = 0; row < _rows && _rowBytes > 0; ++row)
+  {
+    const size_t rowStart = row * _step;
+    if (rowStart > pos)
+      _func(_data + pos, rowStart - pos);
+    pos = rowStart + _rowBytes;
+  }
+  if (_size > pos)
+    _func(_data + pos, _size - pos);
+}
+
+/// \brief Prediction neighborhood of a pixel format.
+/// \param[in] _info Layout of the pixel format.
+/// \param[out] _left Distance to the left neighbor of the same channel, in
+/// values.
+/// \param[out] _up Distance to the upper neighbor of the same channel, in
+/// rows.
+inline void ImageNeighbors(const PixelFormatInfo &_info, size_t &_left,
+    size_t &_up)
+{
+  // Neighbors of the same color are two pixels away in Bayer mosaics
+  const bool bayer = _info.bayerRedX >= 0;
+  _left = bayer ? 2 : _info.channels;
+  _up = bayer ? 2 : 1;
+}
+
+/// \brief Gather the rows of an image, predict and entropy code them.
+/// \param[in] _msg The image.
+/// \param[in] _rowSize Number of values in a row.
+/// \param[in] _left Distance to the left neighbor, in values.
+/// \param[in] _up Distance to the upper neighbor, in rows.
+/// \param[in, out] _out Buffer to append the encoded pixels to.
+template<typename U>
+void EncodeImagePixels(const Image &_msg, size_t _rowSize, size_t _left,
+    size_t _up, std::string &_out)
+{
+  const size_t rows = _msg.height();
+  const size_t count = _rowSize * rows;
+  std::vector<U> values(count);
+  for (size_t y = 0; y < rows; ++y)
+  {
+    std::memcpy(values.data() + y * _rowSize,
+        _msg.data().data() + y * _msg.step(), _rowSize * sizeof(U));
+  }
+
+  std::vector<uint8_t> planes(count * sizeof(U));
+  EncodeImageResiduals<U>(values.data(), _rowSize, rows, _left, _up,
+      planes.data());
+  for (size_t b = 0; b < sizeof(U); ++b)
+    EntropyCoder::Encode(planes.data() + b * count, count, _out);
+}
+
+/// \brief Inverse of EncodeImagePixels.
+/// \param[in, out] _ptr Read position, advanced past the pixels.
+/// \param[in] _end End of the encoded buffer.
+/// \param[in] _rowSize Number of values in a row.
+/// \param[in] _left Distance to the left neighbor, in values.
+/// \param[in] _up Distance to the upper neighbor, in rows.
+/// \param[in, out] _msg The image, with its data already sized.
+/// \return False if the encoded pixels are malformed.
+template<typename U>
+bool DecodeImagePixels(const char *&_ptr, const char *_end, size_t _rowSize,
+    size_t _left, size_t _up, Image &_msg)
+{
+  const size_t rows = _msg.height();
+  const size_t count = _rowSize * rows;
+  std::vector<uint8_t> planes(count * sizeof(U));
+  for (size_t b = 0; b < sizeof(U); ++b)
+  {
+    if (!EntropyCoder::Decode(_ptr, _end, planes.data() + b * count, count))
+      return false;
+  }
+
+  std::vector<U> values(count);
+  DecodeImageResiduals<U>(planes.data(), _rowSize, rows, _left, _up,
+      values.data());
+  char *data = &(*_msg.mutable_data())[0];
+  for (size_t y = 0; y < rows; ++y)
+  {
+    std::memcpy(data + y * _msg.step(), values.data() + y * _rowSize,
+        _rowSize * sizeof(U));
+  }
+  return true;
+}
+
+/// \brief Check that a data size agrees with the header of an image. The
+/// data must hold every row, the last one possibly without its padding,
+/// and at most step * height bytes.
+/// \param[in] _msg The image.
+/// \param[in] _pixelBytes Size of a pixel.
+/// \param[in] _size Size of the image data.
+/// \return True if the size matches the header.
+inline bool ImageDataSizeValid(const Image &_msg, size_t _pixelBytes,
+    uint64_t _size)
+{
+  const uint64_t step = _msg.step();
+  const uint64_t maxSize = step * _msg.height();
+  if (maxSize != 0 && _size > maxSize)
+    return false;
+
+  const uint64_t rowBytes = static_cast<uint64_t>(_msg.width()) * _pixelBytes;
+  if (_msg.height() == 0 || rowBytes == 0)
+    return true;
+  return rowBytes <= step &&
+      (_msg.height() - 1) * step + rowBytes <= _size;
+}
+
+/// \brief Check the sizes declared by an encoded image before decoding it.
+/// Every stream must declare the size that the header implies and be long
+/// enough to hold it, which bounds the memory that the decoder allocates by
+/// the size of the input.
+/// \param[in] _msg Header of the image, with a valid data size.
+/// \param[in] _info Layout of the pixel format.
+/// \param[in] _dataSize Declared size of the image data.
+/// \param[in] _quantized True if depth values are quantized.
+/// \param[in] _ptr Start of the gap stream.
+/// \param[in] _end End of the encoded buffer.
+/// \return True if the streams can hold the declared data.
+inline bool EncodedImageSizesValid(const Image &_msg,
+    const PixelFormatInfo &_info, uint64_t _dataSize, bool _quantized,
+    const char *_ptr, const char *_end)
+{
+  const uint64_t pixels = static_cast<uint64_t>(_msg.width()) * _msg.height();
+  const uint64_t pixelBytes = BytesPerPixel(_msg.pixel_format_type());
+  uint64_t size = 0;
+  if (!EntropyCoder::Skip(_ptr, _end, size) ||
+      size != _dataSize - pixels * pixelBytes)
+  {
+    return false;
+  }
+  if (pixels == 0)
+    return true;
+
+  const uint64_t count = _quantized ? pixels : pixels * _info.channels;
+  const int planes = _quantized ? 4 : ChannelBytes(_info.type);
+  for (int b = 0; b < planes; ++b)
+  {
+    if (!EntropyCoder::Skip(_ptr, _end, size) || size != count)
+      return false;
+  }
+  return true;
+}
+
+/// \brief Shared implementation of the lossless and depth encoders.
+/// \param[in] _msg The image.
+/// \param[in] _precision Depth precision, or zero for lossless.
+/// \param[out] _blob Encoded image.
+/// \return False if the image can't be encoded.
+inline bool EncodeImageImpl(const Image &_msg, double _precision,
+    std::string &_blob)
+{
+  const bool quantize = _precision > 0.0;
+  const PixelFormatInfo info = FormatInfo(_msg.pixel_format_type());
+  if (info.channels == 0)
+  {
+    std::cerr << "Unsupported pixel format ["
+              << _msg.pixel_format_type() << "].\n";
+    return false;
+  }
+  if (quantize && (info.channels != 1 || !IsFloat(info.type)))
+  {
+    std::cerr << "Image must have a R_FLOAT16 or R_FLOAT32 pixel format to "
+              << "be quantized.\n";
+    return false;
+  }
+
+  const size_t pixelBytes = BytesPerPixel(_msg.pixel_format_type());
+  if (!ValidImageData(_msg, pixelBytes))
+  {
+    std::cerr << "Image data is smaller than its width, height and step.\n";
+    return false;
+  }
+  if (!ImageDataSizeValid(_msg, pixelBytes, _msg.data().size()))
+  {
+    std::cerr << "Image data size [" << _msg.data().size()
+              << "] is larger than step * height.\n";
+    return false;
+  }
+
+  Image metadata(_msg);
+  metadata.clear_data();
+  std::string serializedMetadata;
+  if (!metadata.SerializeToString(&serializedMetadata))
+    return false;
+
+  _blob.clear();
+  _blob.append(kImageCodecMagic, 4);
+  _blob.push_back(static_cast<char>(kImageCodecVersion));
+  _blob.push_back(static_cast<char>(quantize ? 1 : 0));
+  WriteVarint(serializedMetadata.size(), _blob);
+  _blob.append(serializedMetadata);
+  WriteVarint(_msg.data().size(), _blob);
+  if (quantize)
+    WriteFixed(_precision, _blob);
+
+  const size_t width = _msg.width();
+  const size_t height = _msg.height();
+  const size_t rowBytes = width * pixelBytes;
+  const size_t step = _msg.step();
+  std::string gaps;
+  ForEachImageGap(_msg.data().data(), _msg.data().size(), rowBytes, step,
+      height, [&](const char *_start, size_t _size)
+      {
+        gaps.append(_start, _size);
+      });
+  EntropyCoder::Encode(reinterpret_cast<const uint8_t *>(gaps.data()),
+      gaps.size(), _blob);
+
+  if (width * height == 0)
+    return true;
+
+  size_t left;
+  size_t up;
+  ImageNeighbors(info, left, up);
+  if (quantize)
+  {
+    const double scale = 1.0 / _precision;
+    const int channelBytes = ChannelBytes(info.type);
+    std::vector<uint32_t> values(width * height);
+    for (size_t y = 0; y < height; ++y)
+    {
+      const auto *row = reinterpret_cast<const unsigned char *>(
+          _msg.data().data() + y * step);
+      for (size_t x = 0; x < width; ++x)
+      {
+        values[y * width + x] = QuantizeDepth(
+            LoadChannel(row + x * channelBytes, info.type, false), scale);
+      }
+    }
+
+    std::vector<uint8_t> planes(values.size() * 4);
+    EncodeImageResiduals<uint32_t>(values.data(), width, height, left, up,
+        planes.data());
+    for (size_t b = 0; b < 4; ++b)
+    {
+      EntropyCoder::Encode(planes.data() + b * values.size(), values.size(),
+          _blob);
+    }
+    return true;
+  }
+
+  const size_t rowSize = width * info.channels;
+  switch (ChannelBytes(info.type))
+  {
+    case 1:
+      EncodeImagePixels<uint8_t>(_msg, rowSize, left, up, _blob);
+      break;
+    case 2:
+      EncodeImagePixels<uint16_t>(_msg, rowSize, left, up, _blob);
+      break;
+    default:
+      EncodeImagePixels<uint32_t>(_msg, rowSize, left, up, _blob);
+      break;
+  }
+  return true;
+}
+}  // namespace detail
+
+/// \brief Losslessly compress an Image message.
+///
+/// The encoded blob holds a small header with the message fields, followed
+/// by the pixel data. Every channel is predicted from its left, upper and
+/// upper left neighbors with the median edge detector of LOCO-I, and the
+/// prediction errors are split into byte planes and entropy coded. This
+/// works best on 8 and 16 bit formats, such as L_INT16 depth images and
+/// RGB_INT8 camera images. Floating point formats are stored losslessly
+/// but compress poorly; see the depth overload.
+///
+/// \code{.cpp}
+/// std::string blob;
+/// gz::msgs::EncodeImage(imageMsg, blob);
+/// gz::msgs::Image decoded;
+/// gz::msgs::DecodeImage(blob, decoded);
+/// \endcode
+///
+/// \param[in] _msg The image to compress.
+/// \param[out] _blob The compressed image.
+/// \return True on success. False if the pixel format is unknown, or the
+/// data is smaller than the width, height and step or larger than
+/// step * height.
+inline bool EncodeImage(const Image &_msg, std::string &_blob)
+{
+  return detail::EncodeImageImpl(_msg, 0.0, _blob);
+}
+
+/// \brief Compress a R_FLOAT16 or R_FLOAT32 depth image, quantizing depth
+/// values to a given precision.
+///
+/// Values are rounded to the nearest multiple of _depthPrecision, which
+/// compresses much better than lossless encoding. NaN and infinite values
+/// are preserved.
+///
+/// \param[in] _msg The image to compress.
+/// \param[in] _depthPrecision Quantization step, in the units of the image
+/// (usually meters, so 0.001 keeps millimeters). Must be positive.
+/// \param[out] _blob The compressed image.
+/// \return True on success. False if the precision isn't positive, the
+/// pixel format isn't R_FLOAT16 or R_FLOAT32, or the data is smaller than
+/// the width, height and step or larger than step * height.
+inline bool EncodeImage(const Image &_msg, double _depthPrecision,
+    std::string &_blob)
+{
+  if (!(_depthPrecision > 0.0) || !std::isfinite(_depthPrecision))
+  {
+    std::cerr << "Image depth precision must be positive, got ["
+              << _depthPrecision << "].\n";
+    return false;
+  }
+  return detail::EncodeImageImpl(_msg, _depthPrecision, _blob);
+}
+
+/// \brief Decompress an Image message compressed by EncodeImage.
+/// \param[in] _blob The compressed image.
+/// \param[out] _msg The decompressed image.
+/// \return True on success. False if the blob is malformed.
+inline bool DecodeImage(const std::string &_blob, Image &_msg)
+{
+  const char *ptr = _blob.data();
+  const char *end = ptr + _blob.size();
+
+  if (_blob.size() < 6 ||
+      std::memcmp(ptr, detail::kImageCodecMagic, 4) != 0)
+  {
+    std::cerr << "Data is not an encoded Image.\n";
+    return false;
+  }
+  ptr += 4;
+  const uint8_t version = static_cast<uint8_t>(*ptr++);
+  const uint8_t mode = static_cast<uint8_t>(*ptr++);
+  if (version != detail::kImageCodecVersion)
+  {
+    std::cerr << "Unsupported encoded Image version ["
+              << static_cast<int>(version) << "].\n";
+    return false;
+  }
+  if (mode > 1)
+  {
+    std::cerr << "Unsupported encoded Image mode ["
+              << static_cast<int>(mode) << "].\n";
+    return false;
+  }
+  const bool quantized = mode == 1;
+
+  uint64_t metadataSize = 0;
+  uint64_t dataSize = 0;
+  double precision = 0.0;
+  if (!detail::ReadVarint(ptr, end, metadataSize) ||
+      static_cast<uint64_t>(end - ptr) < metadataSize ||
+      !_msg.ParseFromArray(ptr, static_cast<int>(metadataSize)))
+  {
+    std::cerr << "Encoded Image header is malformed.\n";
+    return false;
+  }
+  ptr += metadataSize;
+  if (!detail::ReadVarint(ptr, end, dataSize) ||
+      (quantized && !detail::ReadFixed(ptr, end, precision)))
+  {
+    std::cerr << "Encoded Image header is malformed.\n";
+    return false;
+  }
+
+  const detail::PixelFormatInfo info =
+      detail::FormatInfo(_msg.pixel_format_type());
+  const size_t pixelBytes = BytesPerPixel(_msg.pixel_format_type());
+  if (info.channels == 0 ||
+      !detail::ImageDataSizeValid(_msg, pixelBytes, dataSize) ||
+      dataSize > std::numeric_limits<size_t>::max() ||
+      (quantized && (info.channels != 1 || !detail::IsFloat(info.type))))
+  {
+    std::cerr << "Encoded Image header is malformed.\n";
+    return false;
+  }
+  if (!detail::EncodedImageSizesValid(_msg, info, dataSize, quantized, ptr,
+        end))
+  {
+    std::cerr << "Encoded Image is truncated or its sizes are "
+              << "inconsistent.\n";
+    return false;
+  }
+
+  _msg.mutable_data()->resize(dataSize);
+  char *data = dataSize > 0 ? &(*_msg.mutable_data())[0] : nullptr;
+  const size_t width = _msg.width();
+  const size_t height = _msg.height();
+  const size_t rowBytes = width * pixelBytes;
+  const size_t step = _msg.step();
+
+  uint64_t gapSize = 0;
+  detail::EntropyCoder::PeekSize(ptr, end, gapSize);
+  std::string gaps(gapSize, '\0');
+  if (!detail::EntropyCoder::Decode(ptr, end,
+        reinterpret_cast<uint8_t *>(&gaps[0]), gaps.size()))
+  {
+    std::cerr << "Encoded Image is truncated.\n";
+    return false;
+  }
+  size_t gapPos = 0;
+  bool gapsValid = true;
+  detail::ForEachImageGap(data, dataSize, rowBytes, step, height,
+      [&](char *_start, size_t _size)
+      {
+        if (gapPos + _size > gaps.size())
+        {
+          gapsValid = false;
+          return;
+        }
+        std::memcpy(_start, gaps.data() + gapPos, _size);
+        gapPos += _size;
+      });
+  if (!gapsValid || gapPos != gaps.size())
+  {
+    std::cerr << "Encoded Image is malformed.\n";
+    return false;
+  }
+
+  if (width * height == 0)
+    return true;
+
+  size_t left;
+  size_t up;
+  detail::ImageNeighbors(info, left, up);
+  bool ok = false;
+  if (quantized)
+  {
+    const size_t count = width * height;
+    std::vector<uint8_t> planes(count * 4);
+    ok = true;
+    for (size_t b = 0; b < 4 && ok; ++b)
+    {
+      ok = detail::EntropyCoder::Decode(ptr, end, planes.data() + b * count,
+          count);
+    }
+    if (ok)
+    {
+      std::vector<uint32_t> values(count);
+      detail::DecodeImageResiduals<uint32_t>(planes.data(), width, height,
+          left, up, values.data());
+      const int channelBytes = detail::ChannelBytes(info.type);
+      for (size_t y = 0; y < height; ++y)
+      {
+        auto *row = reinterpret_cast<unsigned char *>(data + y * step);
+        for (size_t x = 0; x < width; ++x)
+        {
+          detail::StoreChannel(detail::DequantizeDepth(
+              values[y * width + x], precision), info.type, false,
+              row + x * channelBytes);
+        }
+      }
+    }
+  }
+  else
+  {
+    const size_t rowSize = width * info.channels;
+    switch (detail::ChannelBytes(info.type))
+    {
+      case 1:
+        ok = detail::DecodeImagePixels<uint8_t>(ptr, end, rowSize, left, up,
+            _msg);
+        break;
+      case 2:
+        ok = detail::DecodeImagePixels<uint16_t>(ptr, end, rowSize, left,
+            up, _msg);
+        break;
+      default:
+        ok = detail::DecodeImagePixels<uint32_t>(ptr, end, rowSize, left,
+            up, _msg);
+        break;
+    }
+  }
+
+  if (!ok)
+  {
+    std::cerr << "Encoded Image is truncated.\n";
+    return false;
+  }
+  return true;
+}
+}
+}
+
+#endif
@@ -0,0 +1,544 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_MSGS_IMAGEUTILS_HH_
+#define GZ_MSGS_IMAGEUTILS_HH_
+
+#include <gz/msgs/image.pb.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "gz/msgs/config.hh"
+#include "gz/msgs/detail/ImageUtils.hh"
+
+namespace gz
+{
+namespace msgs
+{
+/// \brief Size of a pixel of a pixel format.
+/// \param[in] _format The pixel format.
+/// \return Size in bytes, or 0 for UNKNOWN_PIXEL_FORMAT.
+inline size_t BytesPerPixel(msgs::PixelFormatType _format)
+{
+  const detail::PixelFormatInfo info = detail::FormatInfo(_format);
+  return static_cast<size_t>(info.channels) *
+      detail::ChannelBytes(info.type);
+}
+
+namespace detail
+{
+/// \brief Check that the data of an image holds its rows.
+/// \param[in] _image The image.
+/// \param[in] _pixelBytes Size of a pixel.
+/// \return True if the width, height and step fit the data.
+inline bool ValidImageData(const Image &_image, size_t _pixelBytes)
+{
+  const size_t rowBytes = _image.width() * _pixelBytes;
+  if (_image.height() == 0 || rowBytes == 0)
+    return true;
+  return rowBytes <= _image.step() &&
+      (_image.height() - 1) * static_cast<size_t>(_image.step()) + rowBytes
+      <= _image.data().size();
+}
+
+/// \brief Check that an image can be read by an operation writing to
+/// another image.
+/// \param[in] _src The image to read.
+/// \param[in] _dst The image to write.
+/// \return False if the pixel format is unknown, the data is smaller than
+/// the width, height and step, or _src is _dst.
+inline bool CheckImageSource(const Image &_src, const Image &_dst)
+{
+  if (&_src == &_dst)
+  {
+    std::cerr << "Source and destination images must differ.\n";
+    return false;
+  }
+
+  const size_t pixelBytes = BytesPerPixel(_src.pixel_format_type());
+  if (pixelBytes == 0)
+  {
+    std::cerr << "Unsupported pixel format ["
+              << _src.pixel_format_type() << "].\n";
+    return false;
+  }
+
+  if (!ValidImageData(_src, pixelBytes))
+  {
+    std::cerr << "Image data is smaller than its width, height and step.\n";
+    return false;
+  }
+  return true;
+}
+
+/// \brief Copy the header of an image and size the data of another image
+/// for densely packed rows.
+/// \param[in] _src Image whose header is copied.
+/// \param[in] _format Pixel format of the destination image.
+/// \param[in] _width Width of the destination image.
+/// \param[in] _height Height of the destination image.
+/// \param[out] _dst Destination image.
+inline void InitImage(const Image &_src, PixelFormatType _format,
+    unsigned int _width, unsigned int _height, Image &_dst)
+{
+  const size_t step = _width * BytesPerPixel(_format);
+  *_dst.mutable_header() = _src.header();
+  _dst.set_width(_width);
+  _dst.set_height(_height);
+  _dst.set_step(static_cast<uint32_t>(step));
+  _dst.set_pixel_format_type(_format);
+  _dst.mutable_data()->resize(step * _height);
+}
+
+/// \brief Copy the header and geometry of an image and size its data for
+/// densely packed rows of another pixel format.
+/// \param[in] _src Image to copy.
+/// \param[in] _format Pixel format of the destination image.
+/// \param[out] _dst Destination image.
+inline void InitImage(const Image &_src, PixelFormatType _format,
+    Image &_dst)
+{
+  InitImage(_src, _format, _src.width(), _src.height(), _dst);
+}
+}  // namespace detail
+
+/// \brief Convert an image to another pixel format.
+///
+/// The source rows may be padded, as given by step. The destination image
+/// gets the header and size of the source image, and densely packed rows.
+/// Its data buffer is reused when large enough.
+///
+/// - Conversions between the L, RGB, BGR, RGBA and BGRA 8 bit formats use
+///   dedicated kernels. Luminance is computed with the BT.601 weights, and
+///   alpha is set to 255 when the source has none.
+/// - Bayer images are demosaiced with bilinear interpolation.
+/// - Between single channel floating point (R_FLOAT16, R_FLOAT32) and single
+///   channel integer (L_INT8, L_INT16) formats, values are depth or range
+///   values scaled by _depthScale, e.g. meters to millimeters. Non finite
+///   and negative values become 0, and values saturate.
+/// - Other integer channels are normalized to their full range, and other
+///   floating point channels are expected in [0, 1].
+///
+/// \code{.cpp}
+/// gz::msgs::Image rgb;
+/// gz::msgs::ConvertImage(bayerImage, gz::msgs::RGB_INT8, rgb);
+/// \endcode
+///
+/// \param[in] _src Image to convert.
+/// \param[in] _format Pixel format of the converted image.
+/// \param[out] _dst The converted image. Must not be _src.
+/// \param[in] _depthScale Integer units per floating point unit in depth
+/// conversions.
+/// \return False if a pixel format is unknown, the source data is smaller
+/// than its width, height and step, or _dst is _src.
+inline bool ConvertImage(const msgs::Image &_src,
+    msgs::PixelFormatType _format, msgs::Image &_dst,
+    double _depthScale = 1000.0)
+{
+  const detail::PixelFormatInfo srcInfo =
+      detail::FormatInfo(_src.pixel_format_type());
+  const detail::PixelFormatInfo dstInfo = detail::FormatInfo(_format);
+  if (srcInfo.channels == 0 || dstInfo.channels == 0)
+  {
+    std::cerr << "Unable to convert an image from pixel format ["
+              << _src.pixel_format_type() << "] to [" << _format << "].\n";
+    return false;
+  }
+
+  if (&_src == &_dst)
+  {
+    std::cerr << "Source and destination images must differ.\n";
+    return false;
+  }
+
+  const size_t srcPixel = BytesPerPixel(_src.pixel_format_type());
+  if (!detail::ValidImageData(_src, srcPixel))
+  {
+    std::cerr << "Image data is smaller than its width, height and step.\n";
+    return false;
+  }
+
+  const size_t width = _src.width();
+  const size_t height = _src.height();
+  const size_t srcStep = _src.step();
+  const auto *src = reinterpret_cast<const unsigned char *>(
+      _src.data().data());
+
+  // Bayer images are demosaiced first
+  if (srcInfo.bayerRedX >= 0 && _format != _src.pixel_format_type())
+  {
+    Image rgb;
+    Image &target = _format == RGB_INT8 ? _dst : rgb;
+    detail::InitImage(_src, RGB_INT8, target);
+    if (width * height > 0)
+    {
+      detail::DebayerBilinear(src, srcStep, srcInfo, width, height,
+          reinterpret_cast<uint8_t *>(&(*target.mutable_data())[0]));
+    }
+    return _format == RGB_INT8 ? true :
+        ConvertImage(rgb, _format, _dst, _depthScale);
+  }
+
+  detail::InitImage(_src, _format, _dst);
+  if (width * height == 0)
+    return true;
+
+  const size_t dstStep = _dst.step();
+  auto *dst = reinterpret_cast<unsigned char *>(&(*_dst.mutable_data())[0]);
+
+  if (_format == _src.pixel_format_type())
+  {
+    for (size_t y = 0; y < height; ++y)
+      std::memcpy(dst + y * dstStep, src + y * srcStep, dstStep);
+    return true;
+  }
+
+  if (auto kernel = detail::Row8Kernel(_src.pixel_format_type(), _format))
+  {
+    for (size_t y = 0; y < height; ++y)
+      kernel(src + y * srcStep, dst + y * dstStep, width);
+    return true;
+  }
+
+  const bool srcDepth = srcInfo.channels == 1 && srcInfo.bayerRedX < 0;
+  const bool dstDepth = dstInfo.channels == 1 && dstInfo.bayerRedX < 0;
+  if (srcDepth && dstDepth &&
+      detail::IsFloat(srcInfo.type) != detail::IsFloat(dstInfo.type))
+  {
+    for (size_t y = 0; y < height; ++y)
+    {
+      detail::ConvertDepthRow(src + y * srcStep, srcInfo.type,
+          dst + y * dstStep, dstInfo.type, width, _depthScale);
+    }
+    return true;
+  }
+
+  std::vector<float> rgba(width * 4);
+  for (size_t y = 0; y < height; ++y)
+  {
+    detail::DecodeRow(src + y * srcStep, srcInfo, width, rgba.data());
+    detail::EncodeRow(rgba.data(), dstInfo, width, y, dst + y * dstStep);
+  }
+  return true;
+}
+
+namespace detail
+{
+/// \brief Resample the rows of an image with a given accumulator type.
+/// \tparam AccT Type of the weighted sums.
+/// \param[in] _src Source image.
+/// \param[in] _srcWidth Number of source columns to read.
+/// \param[in] _cols Horizontal taps.
+/// \param[in] _rows Vertical taps.
+/// \param[in] _channels Number of channels of a pixel.
+/// \param[in] _channelBytes Size of a channel.
+/// \param[in] _load Callable reading a channel as an AccT.
+/// \param[in] _store Callable writing an AccT to a channel.
+/// \param[in,out] _dst Destination image, already sized.
+template<typename AccT, typename Load, typename Store>
+void ResampleRows(const Image &_src, size_t _srcWidth,
+    const ResampleTaps &_cols, const ResampleTaps &_rows, size_t _channels,
+    size_t _channelBytes, Load &&_load, Store &&_store, Image &_dst)
+{
+  const auto *src = reinterpret_cast<const unsigned char *>(
+      _src.data().data());
+  auto *dst = reinterpret_cast<unsigned char *>(&(*_dst.mutable_data())[0]);
+
+  // Rows are first blended vertically, then each pixel horizontally
+  std::vector<AccT> acc(_srcWidth * _channels);
+  for (size_t y = 0; y < _dst.height(); ++y)
+  {
+    std::fill(acc.begin(), acc.end(), AccT(0));
+    for (size_t t = _rows.offset[y]; t < _rows.offset[y + 1]; ++t)
+    {
+      const unsigned char *row = src + _rows.index[t] * _src.step();
+      const AccT weight = static_cast<AccT>(_rows.weight[t]);
+      for (size_t i = 0; i < acc.size(); ++i)
+        acc[i] += weight * _load(row + i * _channelBytes);
+    }
+
+    unsigned char *out = dst + y * _dst.step();
+    for (size_t x = 0; x < _dst.width(); ++x)
+    {
+      for (size_t c = 0; c < _channels; ++c, out += _channelBytes)
+      {
+        AccT value = 0;
+        for (size_t t = _cols.offset[x]; t < _cols.offset[x + 1]; ++t)
+        {
+          value += static_cast<AccT>(_cols.weight[t]) *
+              acc[_cols.index[t] * _channels + c];
+        }
+        _store(value, out);
+      }
+    }
+  }
+}
+
+/// \brief Resample the top left _srcWidth x _srcHeight pixels of an image
+/// to the size of another image, one channel at a time. Bayer formats are
+/// not supported. 32 bit integer channels are accumulated in double, since
+/// float can't represent them exactly above 2^24.
+/// \param[in] _src Source image.
+/// \param[in] _srcWidth Number of source columns to read.
+/// \param[in] _srcHeight Number of source rows to read.
+/// \param[in,out] _dst Destination image, already sized.
+inline void ResampleImage(const Image &_src, size_t _srcWidth,
+    size_t _srcHeight, Image &_dst)
+{
+  const PixelFormatInfo info = FormatInfo(_src.pixel_format_type());
+  const size_t width = _dst.width();
+  const size_t height = _dst.height();
+  if (width * height == 0)
+    return;
+
+  ResampleTaps cols;
+  ResampleTaps rows;
+  ComputeResampleTaps(_srcWidth, width, cols);
+  ComputeResampleTaps(_srcHeight, height, rows);
+
+  const ChannelType type = info.type;
+  const size_t channelBytes = ChannelBytes(type);
+  if (type == ChannelType::UINT32)
+  {
+    ResampleRows<double>(_src, _srcWidth, cols, rows, info.channels,
+        channelBytes, [](const unsigned char *_channel)
+        {
+          uint32_t v;
+          std::memcpy(&v, _channel, sizeof(v));
+          return static_cast<double>(v);
+        },
+        [](double _value, unsigned char *_channel)
+        {
+          // NaN compares false and becomes zero
+          const uint32_t v = static_cast<uint32_t>(_value > 0 ?
+              std::min(std::floor(_value + 0.5), 4294967295.0) : 0.0);
+          std::memcpy(_channel, &v, sizeof(v));
+        }, _dst);
+    return;
+  }
+
+  ResampleRows<float>(_src, _srcWidth, cols, rows, info.channels,
+      channelBytes, [type](const unsigned char *_channel)
+      {
+        return LoadChannel(_channel, type, false);
+      },
+      [type](float _value, unsigned char *_channel)
+      {
+        StoreChannel(_value, type, false, _channel);
+      }, _dst);
+}
+}  // namespace detail
+
+/// \brief Copy a rectangular region of interest of an image.
+///
+/// Only the rows and columns of the region are copied. The destination
+/// image gets the header and pixel format of the source image, and densely
+/// packed rows. Its data buffer is reused when large enough. Cropping a
+/// Bayer image at an odd row or column changes its Bayer format to match
+/// the pixels of the region.
+///
+/// \param[in] _src Image to crop.
+/// \param[in] _x First column of the region.
+/// \param[in] _y First row of the region.
+/// \param[in] _width Width of the region.
+/// \param[in] _height Height of the region.
+/// \param[out] _dst The region. Must not be _src.
+/// \return False if the pixel format is unknown, the source data is smaller
+/// than its width, height and step, or the region is outside the image.
+inline bool CropImage(const msgs::Image &_src, unsigned int _x,
+    unsigned int _y, unsigned int _width, unsigned int _height,
+    msgs::Image &_dst)
+{
+  if (!detail::CheckImageSource(_src, _dst))
+    return false;
+
+  if (static_cast<size_t>(_x) + _width > _src.width() ||
+      static_cast<size_t>(_y) + _height > _src.height())
+  {
+    std::cerr << "Region of interest is outside the image.\n";
+    return false;
+  }
+
+  PixelFormatType format = _src.pixel_format_type();
+  const detail::PixelFormatInfo info = detail::FormatInfo(format);
+  if (info.bayerRedX >= 0)
+  {
+    format = detail::BayerFormat(
+        (info.bayerRedX + static_cast<int>(_x & 1u)) & 1,
+        (info.bayerRedY + static_cast<int>(_y & 1u)) & 1);
+  }
+
+  detail::InitImage(_src, format, _width, _height, _dst);
+  if (static_cast<size_t>(_width) * _height == 0)
+    return true;
+
+  const size_t rowBytes = _dst.step();
+  const size_t pixelBytes = BytesPerPixel(format);
+  const char *src = _src.data().data() + _y * static_cast<size_t>(
+      _src.step()) + _x * pixelBytes;
+  char *dst = &(*_dst.mutable_data())[0];
+  for (size_t y = 0; y < _height; ++y)
+    std::memcpy(dst + y * rowBytes, src + y * _src.step(), rowBytes);
+  return true;
+}
+
+/// \brief Downscale an image by an integer factor, averaging each block of
+/// _factor x _factor pixels.
+///
+/// The destination is width / _factor by height / _factor pixels, and
+/// trailing columns and rows that don't fill a block are ignored. Factors 2
+/// and 4 of 8, 16 and 32 bit integer and 32 bit float formats use
+/// dedicated kernels. Bayer images are demosaiced, downscaled and mosaiced
+/// again. The destination image gets the header and pixel format of the
+/// source image, and densely packed rows. Its data buffer is reused when
+/// large enough.
+///
+/// \code{.cpp}
+/// gz::msgs::Image preview;
+/// gz::msgs::DownscaleImage(imageMsg, 4, preview);
+/// \endcode
+///
+/// \param[in] _src Image to downscale.
+/// \param[in] _factor Downscaling factor, at least 1.
+/// \param[out] _dst The downscaled image. Must not be _src.
+/// \return False if the factor is 0, the pixel format is unknown or the
+/// source data is smaller than its width, height and step.
+inline bool DownscaleImage(const msgs::Image &_src, unsigned int _factor,
+    msgs::Image &_dst)
+{
+  if (!detail::CheckImageSource(_src, _dst))
+    return false;
+
+  if (_factor == 0)
+  {
+    std::cerr << "Downscaling factor must be at least 1.\n";
+    return false;
+  }
+
+  const PixelFormatType format = _src.pixel_format_type();
+  const detail::PixelFormatInfo info = detail::FormatInfo(format);
+  if (_factor == 1)
+    return ConvertImage(_src, format, _dst);
+
+  if (info.bayerRedX >= 0)
+  {
+    Image rgb;
+    Image small;
+    return ConvertImage(_src, RGB_INT8, rgb) &&
+        DownscaleImage(rgb, _factor, small) &&
+        ConvertImage(small, format, _dst);
+  }
+
+  const unsigned int width = _src.width() / _factor;
+  const unsigned int height = _src.height() / _factor;
+  detail::InitImage(_src, format, width, height, _dst);
+  if (static_cast<size_t>(width) * height == 0)
+    return true;
+
+  void (*kernel)(const unsigned char *, size_t, size_t, size_t,
+      unsigned char *, size_t) = nullptr;
+  if (_factor == 2)
+    kernel = detail::DownscaleBoxKernel<2>(info);
+  else if (_factor == 4)
+    kernel = detail::DownscaleBoxKernel<4>(info);
+
+  // Kernels read whole channels, which must be aligned
+  const auto *src = reinterpret_cast<const unsigned char *>(
+      _src.data().data());
+  const size_t channelBytes = detail::ChannelBytes(info.type);
+  if (nullptr != kernel && _src.step() % channelBytes == 0 &&
+      reinterpret_cast<uintptr_t>(src) % channelBytes == 0)
+  {
+    kernel(src, _src.step(), width, height,
+        reinterpret_cast<unsigned char *>(&(*_dst.mutable_data())[0]),
+        _dst.step());
+    return true;
+  }
+
+  detail::ResampleImage(_src, static_cast<size_t>(width) * _factor,
+      static_cast<size_t>(height) * _factor, _dst);
+  return true;
+}
+
+/// \brief Resize an image to any size.
+///
+/// Shrinking averages the source pixels covered by each destination pixel,
+/// weighted by their coverage. Enlarging interpolates linearly. Integer
+/// channels are rounded and saturated. Sizes that divide the source size
+/// by 2 or 4 use the kernels of DownscaleImage. Bayer images are
+/// demosaiced, resized and mosaiced again. The destination image gets the
+/// header and pixel format of the source image, and densely packed rows.
+/// Its data buffer is reused when large enough.
+///
+/// \param[in] _src Image to resize.
+/// \param[in] _width Width of the resized image.
+/// \param[in] _height Height of the resized image.
+/// \param[out] _dst The resized image. Must not be _src.
+/// \return False if the pixel format is unknown, the source data is smaller
+/// than its width, height and step, or a non empty image is requested from
+/// an empty one.
+inline bool ResizeImage(const msgs::Image &_src, unsigned int _width,
+    unsigned int _height, msgs::Image &_dst)
+{
+  if (!detail::CheckImageSource(_src, _dst))
+    return false;
+
+  const size_t srcWidth = _src.width();
+  const size_t srcHeight = _src.height();
+  const size_t dstPixels = static_cast<size_t>(_width) * _height;
+  if (srcWidth * srcHeight == 0 && dstPixels > 0)
+  {
+    std::cerr << "Unable to resize an empty image.\n";
+    return false;
+  }
+
+  const PixelFormatType format = _src.pixel_format_type();
+  if (_width == srcWidth && _height == srcHeight)
+    return ConvertImage(_src, format, _dst);
+
+  for (unsigned int factor : {2u, 4u})
+  {
+    if (srcWidth == static_cast<size_t>(_width) * factor &&
+        srcHeight == static_cast<size_t>(_height) * factor)
+    {
+      return DownscaleImage(_src, factor, _dst);
+    }
+  }
+
+  if (detail::FormatInfo(format).bayerRedX >= 0)
+  {
+    Image rgb;
+    Image resized;
+    return ConvertImage(_src, RGB_INT8, rgb) &&
+        ResizeImage(rgb, _width, _height, resized) &&
+        ConvertImage(resized, format, _dst);
+  }
+
+  detail::InitImage(_src, format, _width, _height, _dst);
+  detail::ResampleImage(_src, srcWidth, srcHeight, _dst);
+  return true;
+}
+}
+}
+
+#endif
@@ -0,0 +1,458 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_MSGS_IMAGEVIEW_HH_
+#define GZ_MSGS_IMAGEVIEW_HH_
+
+#include <gz/msgs/image.pb.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+
+#include "gz/msgs/config.hh"
+#include "gz/msgs/ImageUtils.hh"
+#include "gz/msgs/detail/ImageUtils.hh"
+
+namespace gz
+{
+namespace msgs
+{
+/// \brief Pixel of RGB_INT8, RGB_INT16, RGB_INT32, RGB_FLOAT16 and
+/// RGB_FLOAT32 images.
+/// \tparam T Type of a channel.
+template<typename T>
+struct RgbPixel
+{
+  /// \brief Red channel.
+  T r;
+
+  /// \brief Green channel.
+  T g;
+
+  /// \brief Blue channel.
+  T b;
+};
+
+/// \brief Pixel of BGR_INT8, BGR_INT16 and BGR_INT32 images.
+/// \tparam T Type of a channel.
+template<typename T>
+struct BgrPixel
+{
+  /// \brief Blue channel.
+  T b;
+
+  /// \brief Green channel.
+  T g;
+
+  /// \brief Red channel.
+  T r;
+};
+
+/// \brief Pixel of RGBA_INT8 images.
+/// \tparam T Type of a channel.
+template<typename T>
+struct RgbaPixel
+{
+  /// \brief Red channel.
+  T r;
+
+  /// \brief Green channel.
+  T g;
+
+  /// \brief Blue channel.
+  T b;
+
+  /// \brief Alpha channel.
+  T a;
+};
+
+/// \brief Pixel of BGRA_INT8 images.
+/// \tparam T Type of a channel.
+template<typename T>
+struct BgraPixel
+{
+  /// \brief Blue channel.
+  T b;
+
+  /// \brief Green channel.
+  T g;
+
+  /// \brief Red channel.
+  T r;
+
+  /// \brief Alpha channel.
+  T a;
+};
+
+/// \brief Channel of R_FLOAT16 and RGB_FLOAT16 images, stored as the bits
+/// of an IEEE 754 half precision float.
+struct HalfFloat
+{
+  /// \brief Convert to single precision.
+  /// \return The value.
+  float ToFloat() const
+  {
+    return detail::HalfToFloat(this->bits);
+  }
+
+  /// \brief Convert from single precision, rounding to nearest even.
+  /// \param[in] _value The value.
+  /// \return The half precision value.
+  static HalfFloat FromFloat(float _value)
+  {
+    return HalfFloat{detail::FloatToHalf(_value)};
+  }
+
+  /// \brief The bits of the half precision float.
+  uint16_t bits;
+};
+
+namespace detail
+{
+/// \brief Whether a pixel type can view an image of a pixel format.
+/// \tparam PixelT The pixel type.
+/// \param[in] _format The pixel format.
+/// \return True if the pixels of the format have the layout of PixelT.
+template<typename PixelT>
+constexpr bool PixelMatches(PixelFormatType _format)
+{
+  if constexpr (std::is_same_v<PixelT, uint8_t>)
+  {
+    return _format == L_INT8 || _format == BAYER_RGGB8 ||
+        _format == BAYER_BGGR8 || _format == BAYER_GBRG8 ||
+        _format == BAYER_GRBG8;
+  }
+  else if constexpr (std::is_same_v<PixelT, uint16_t>)
+    return _format == L_INT16;
+  else if constexpr (std::is_same_v<PixelT, HalfFloat>)
+    return _format == R_FLOAT16;
+  else if constexpr (std::is_same_v<PixelT, float>)
+    return _format == R_FLOAT32;
+  else if constexpr (std::is_same_v<PixelT, RgbPixel<uint8_t>>)
+    return _format == RGB_INT8;
+  else if constexpr (std::is_same_v<PixelT, RgbPixel<uint16_t>>)
+    return _format == RGB_INT16;
+  else if constexpr (std::is_same_v<PixelT, RgbPixel<uint32_t>>)
+    return _format == RGB_INT32;
+  else if constexpr (std::is_same_v<PixelT, RgbPixel<HalfFloat>>)
+    return _format == RGB_FLOAT16;
+  else if constexpr (std::is_same_v<PixelT, RgbPixel<float>>)
+    return _format == RGB_FLOAT32;
+  else if constexpr (std::is_same_v<PixelT, BgrPixel<uint8_t>>)
+    return _format == BGR_INT8;
+  else if constexpr (std::is_same_v<PixelT, BgrPixel<uint16_t>>)
+    return _format == BGR_INT16;
+  else if constexpr (std::is_same_v<PixelT, BgrPixel<uint32_t>>)
+    return _format == BGR_INT32;
+  else if constexpr (std::is_same_v<PixelT, RgbaPixel<uint8_t>>)
+    return _format == RGBA_INT8;
+  else if constexpr (std::is_same_v<PixelT, BgraPixel<uint8_t>>)
+    return _format == BGRA_INT8;
+  else
+    return false;
+}
+
+/// \brief Whether a type is the pixel type of any pixel format.
+/// \tparam PixelT The type.
+/// \return True if PixelT can view some image.
+template<typename PixelT>
+constexpr bool IsPixelType()
+{
+  for (int f = PixelFormatType_MIN; f <= PixelFormatType_MAX; ++f)
+  {
+    if (PixelMatches<PixelT>(static_cast<PixelFormatType>(f)))
+      return true;
+  }
+  return false;
+}
+}  // namespace detail
+
+/// \brief A contiguous run of pixels, such as one row of an image.
+/// \tparam T Pixel type, possibly const.
+template<typename T>
+class ImageRow
+{
+  /// \param[in] _data First pixel.
+  /// \param[in] _size Number of pixels.
+  public: ImageRow(T *_data, size_t _size)
+    : data(_data), size(_size)
+  {
+  }
+
+  /// \brief First pixel.
+  /// \return Pointer to the first pixel.
+  public: T *Data() const
+  {
+    return this->data;
+  }
+
+  /// \brief Number of pixels.
+  /// \return The number of pixels.
+  public: size_t Size() const
+  {
+    return this->size;
+  }
+
+  /// \brief Access a pixel.
+  /// \param[in] _index Index of the pixel, less than Size().
+  /// \return Reference to the pixel.
+  public: T &operator[](size_t _index) const
+  {
+    return this->data[_index];
+  }
+
+  /// \brief First pixel, for range-based for loops.
+  /// \return Pointer to the first pixel.
+  public: T *begin() const
+  {
+    return this->data;
+  }
+
+  /// \brief One past the last pixel, for range-based for loops.
+  /// \return Pointer past the last pixel.
+  public: T *end() const
+  {
+    return this->data + this->size;
+  }
+
+  /// \brief First pixel.
+  private: T *data;
+
+  /// \brief Number of pixels.
+  private: size_t size;
+};
+
+namespace detail
+{
+/// \brief Private base class for ImageView and ConstImageView.
+/// \tparam PixelT The pixel type.
+/// \tparam QualifiedPixelT PixelT, or const PixelT.
+/// \tparam RawDataType char, or const char.
+/// \tparam ImageType Image, or const Image.
+template<typename PixelT, typename QualifiedPixelT,
+    typename RawDataType, typename ImageType>
+class ImageViewBase
+{
+  static_assert(IsPixelType<PixelT>(), "Unsupported pixel type");
+
+  /// \param[in] _imageMsg The image to view.
+  public: explicit ImageViewBase(ImageType &_imageMsg);
+
+  /// \brief Whether the image matches the pixel type and its data holds
+  /// every row.
+  /// \return True if the view can be used.
+  public: bool Valid() const;
+
+  /// \brief Number of rows.
+  /// \return The height of the image.
+  public: size_t Height() const;
+
+  /// \brief Number of columns.
+  /// \return The width of the image.
+  public: size_t Width() const;
+
+  /// \brief Distance between the start of two rows.
+  /// \return The step of the image, in bytes.
+  public: size_t Step() const;
+
+  /// \brief Whether rows are stored without padding, so that the pixels
+  /// can be processed as a single array of Width() * Height() pixels
+  /// starting at Row(0).
+  /// \return True if the step is the size of a row.
+  public: bool Contiguous() const;
+
+  /// \brief Access a row.
+  /// \param[in] _row Row, less than Height().
+  /// \return Pointer to the first pixel of the row.
+  public: QualifiedPixelT *Row(size_t _row) const;
+
+  /// \brief Access a row as a range of pixels.
+  /// \param[in] _row Row, less than Height().
+  /// \return The pixels of the row.
+  public: ImageRow<QualifiedPixelT> RowSpan(size_t _row) const;
+
+  /// \brief Access a pixel.
+  /// \param[in] _row Row of the pixel, less than Height().
+  /// \param[in] _col Column of the pixel, less than Width().
+  /// \return Reference to the pixel.
+  public: QualifiedPixelT &operator()(size_t _row, size_t _col) const;
+
+  /// \brief Start of the first row.
+  private: RawDataType *data{nullptr};
+
+  /// \brief Number of rows.
+  private: size_t height{0};
+
+  /// \brief Number of columns.
+  private: size_t width{0};
+
+  /// \brief Distance between the start of two rows, in bytes.
+  private: size_t step{0};
+};
+
+//////////////////////////////////////////////////
+template<typename PixelT, typename QualifiedPixelT,
+    typename RawDataType, typename ImageType>
+ImageViewBase<PixelT, QualifiedPixelT, RawDataType,
+    ImageType>::ImageViewBase(ImageType &_imageMsg)
+{
+  if (!PixelMatches<PixelT>(_imageMsg.pixel_format_type()))
+  {
+    std::cerr << "Pixel type does not match pixel format ["
+              << _imageMsg.pixel_format_type() << "].\n";
+    return;
+  }
+
+  if (_imageMsg.width() == 0 || _imageMsg.height() == 0)
+    return;
+
+  RawDataType *first = const_cast<RawDataType *>(_imageMsg.data().data());
+  if (!ValidImageData(_imageMsg, sizeof(PixelT)) ||
+      _imageMsg.step() % alignof(PixelT) != 0 ||
+      reinterpret_cast<uintptr_t>(first) % alignof(PixelT) != 0)
+  {
+    std::cerr << "Image data does not match its width, height and step.\n";
+    return;
+  }
+
+  this->data = first;
+  this->height = _imageMsg.height();
+  this->width = _imageMsg.width();
+  this->step = _imageMsg.step();
+}
+
+//////////////////////////////////////////////////
+template<typename PixelT, typename QualifiedPixelT,
+    typename RawDataType, typename ImageType>
+bool ImageViewBase<PixelT, QualifiedPixelT, RawDataType,
+    ImageType>::Valid() const
+{
+  return nullptr != this->data;
+}
+
+//////////////////////////////////////////////////
+template<typename PixelT, typename QualifiedPixelT,
+    typename RawDataType, typename ImageType>
+size_t ImageViewBase<PixelT, QualifiedPixelT, RawDataType,
+    ImageType>::Height() const
+{
+  return this->height;
+}
+
+//////////////////////////////////////////////////
+template<typename PixelT, typename QualifiedPixelT,
+    typename RawDataType, typename ImageType>
+size_t ImageViewBase<PixelT, QualifiedPixelT, RawDataType,
+    ImageType>::Width() const
+{
+  return this->width;
+}
+
+//////////////////////////////////////////////////
+template<typename PixelT, typename QualifiedPixelT,
+    typename RawDataType, typename ImageType>
+size_t ImageViewBase<PixelT, QualifiedPixelT, RawDataType,
+    ImageType>::Step() const
+{
+  return this->step;
+}
+
+//////////////////////////////////////////////////
+template<typename PixelT, typename QualifiedPixelT,
+    typename RawDataType, typename ImageType>
+bool ImageViewBase<PixelT, QualifiedPixelT, RawDataType,
+    ImageType>::Contiguous() const
+{
+  return this->step == this->width * sizeof(PixelT);
+}
+
+//////////////////////////////////////////////////
+template<typename PixelT, typename QualifiedPixelT,
+    typename RawDataType, typename ImageType>
+QualifiedPixelT *ImageViewBase<PixelT, QualifiedPixelT, RawDataType,
+    ImageType>::Row(size_t _row) const
+{
+  return reinterpret_cast<QualifiedPixelT *>(
+      this->data + _row * this->step);
+}
+
+//////////////////////////////////////////////////
+template<typename PixelT, typename QualifiedPixelT,
+    typename RawDataType, typename ImageType>
+ImageRow<QualifiedPixelT> ImageViewBase<PixelT, QualifiedPixelT,
+    RawDataType, ImageType>::RowSpan(size_t _row) const
+{
+  return ImageRow<QualifiedPixelT>(this->Row(_row), this->width);
+}
+
+//////////////////////////////////////////////////
+template<typename PixelT, typename QualifiedPixelT,
+    typename RawDataType, typename ImageType>
+QualifiedPixelT &ImageViewBase<PixelT, QualifiedPixelT, RawDataType,
+    ImageType>::operator()(size_t _row, size_t _col) const
+{
+  return this->Row(_row)[_col];
+}
+}  // namespace detail
+
+/// \brief Typed two dimensional access to the pixels of an Image message.
+///
+/// The pixel type is checked once against the pixel format, width, height
+/// and step of the image. Rows are then plain arrays of pixels, which
+/// loops can process at memory speed.
+///
+/// \code{.cpp}
+/// gz::msgs::ImageView<gz::msgs::RgbPixel<uint8_t>> view(imageMsg);
+/// for (size_t row = 0; row < view.Height(); ++row)
+///   for (auto &pixel : view.RowSpan(row))
+///     std::swap(pixel.r, pixel.b);
+/// \endcode
+///
+/// \tparam PixelT Pixel type: uint8_t, uint16_t, HalfFloat, float,
+/// RgbPixel, BgrPixel, RgbaPixel or BgraPixel.
+template<typename PixelT>
+class ImageView
+  : public detail::ImageViewBase<PixelT, PixelT, char, Image>
+{
+  // Documentation inherited
+  public: explicit ImageView(Image &_imageMsg)
+      : detail::ImageViewBase<PixelT, PixelT, char,
+        Image>::ImageViewBase(_imageMsg)
+  {
+  }
+};
+
+/// \brief Same as an ImageView but for const data.
+/// \tparam PixelT Pixel type.
+template<typename PixelT>
+class ConstImageView
+  : public detail::ImageViewBase<PixelT, const PixelT, const char,
+    const Image>
+{
+  // Documentation inherited
+  public: explicit ConstImageView(const Image &_imageMsg)
+      : detail::ImageViewBase<PixelT, const PixelT, const char,
+        const Image>::ImageViewBase(_imageMsg)
+  {
+  }
+};
+}
+}
+
+#endif
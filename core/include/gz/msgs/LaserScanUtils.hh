@@ -0,0 +1,619 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_MSGS_LASERSCANUTILS_HH_
+#define GZ_MSGS_LASERSCANUTILS_HH_
+
+#include <gz/msgs/laserscan.pb.h>
+#include <gz/msgs/pointcloud_packed.pb.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gz/math/Matrix3.hh>
+#include <gz/math/Pose3.hh>
+
+#include "gz/msgs/config.hh"
+#include "gz/msgs/PointCloudPackedUtils.hh"
+#include "gz/msgs/convert/Pose.hh"
+
+namespace gz
+{
+namespace msgs
+{
+/// \brief Options of LaserScanProjector::Project.
+struct LaserScanProjectOptions
+{
+  /// \brief True to create an organized cloud with one row per vertical
+  /// beam and one column per horizontal beam, in which filtered beams have
+  /// NaN coordinates. False to create a dense unorganized cloud holding
+  /// only the valid beams.
+  bool organized{false};
+
+  /// \brief True to transform the points by the world_pose of the scan.
+  bool applyWorldPose{false};
+
+  /// \brief True to add an "intensity" field when the scan has one
+  /// intensity per range.
+  bool intensities{true};
+};
+
+namespace detail
+{
+/// \brief Parameters of a scan that determine the beam directions.
+struct LaserScanGeometry
+{
+  /// \brief Angle of the first horizontal beam.
+  double angleMin{0};
+
+  /// \brief Angle between horizontal beams.
+  double angleStep{0};
+
+  /// \brief Number of horizontal beams.
+  uint32_t count{0};
+
+  /// \brief Angle of the first vertical beam.
+  double verticalAngleMin{0};
+
+  /// \brief Angle between vertical beams.
+  double verticalAngleStep{0};
+
+  /// \brief Number of vertical beams.
+  uint32_t verticalCount{0};
+
+  /// \brief Equality operator. Angles are compared exactly, since the
+  /// geometry is a cache key: any change must recompute the directions.
+  /// \param[in] _other Geometry to compare to.
+  /// \return True if every parameter is equal.
+  bool operator==(const LaserScanGeometry &_other) const
+  {
+    const std::equal_to<double> same;
+    return same(this->angleMin, _other.angleMin) &&
+        same(this->angleStep, _other.angleStep) &&
+        this->count == _other.count &&
+        same(this->verticalAngleMin, _other.verticalAngleMin) &&
+        same(this->verticalAngleStep, _other.verticalAngleStep) &&
+        this->verticalCount == _other.verticalCount;
+  }
+};
+
+/// \brief Get the geometry of a scan.
+/// \param[in] _scan The scan.
+/// \return The geometry. A vertical count of zero is treated as one.
+inline LaserScanGeometry ScanGeometry(const LaserScan &_scan)
+{
+  LaserScanGeometry geometry;
+  geometry.angleMin = _scan.angle_min();
+  geometry.angleStep = _scan.angle_step();
+  geometry.count = _scan.count();
+  geometry.verticalAngleMin = _scan.vertical_angle_min();
+  geometry.verticalAngleStep = _scan.vertical_angle_step();
+  geometry.verticalCount = std::max(1u, _scan.vertical_count());
+  return geometry;
+}
+
+/// \brief Project ranges into points.
+/// \tparam Transform True to transform the points by _m.
+/// \tparam Organized True to keep filtered beams as NaN points, false to
+/// drop them.
+/// \tparam Intensity True to write an intensity after the coordinates.
+/// \param[in] _ranges The ranges.
+/// \param[in] _intensities The intensities, if Intensity is true.
+/// \param[in] _dirs Unit direction of every beam, as all x components, then
+/// all y components, then all z components.
+/// \param[in] _points Number of beams.
+/// \param[in] _rangeMin Smallest valid range.
+/// \param[in] _rangeMax Largest valid range.
+/// \param[in] _m Row-major 3x4 transform.
+/// \param[out] _out Point data, with float coordinates at offset 0.
+/// \param[in] _pointStep Point step of the point data.
+/// \return Number of valid beams.
+template<bool Transform, bool Organized, bool Intensity>
+size_t ProjectRanges(const double *_ranges, const double *_intensities,
+    const float *_dirs, size_t _points, double _rangeMin, double _rangeMax,
+    const float (&_m)[12], char *_out, size_t _pointStep)
+{
+  const float *dx = _dirs;
+  const float *dy = _dirs + _points;
+  const float *dz = _dirs + 2 * _points;
+  constexpr size_t kSize = (Intensity ? 4 : 3) * sizeof(float);
+
+  // Invalid beams of unorganized clouds are written and then overwritten
+  // by the next beam, so that the loop has no data-dependent branch.
+  size_t kept = 0;
+  for (size_t i = 0; i < _points; ++i)
+  {
+    const double range = _ranges[i];
+    const bool valid = range >= _rangeMin && range <= _rangeMax;
+    const float r = valid ? static_cast<float>(range) :
+        std::numeric_limits<float>::quiet_NaN();
+    float p[4] = {r * dx[i], r * dy[i], r * dz[i], 0.0f};
+    if constexpr (Transform)
+    {
+      const float x = p[0];
+      const float y = p[1];
+      const float z = p[2];
+      p[0] = _m[0] * x + _m[1] * y + _m[2] * z + _m[3];
+      p[1] = _m[4] * x + _m[5] * y + _m[6] * z + _m[7];
+      p[2] = _m[8] * x + _m[9] * y + _m[10] * z + _m[11];
+    }
+    if constexpr (Intensity)
+      p[3] = static_cast<float>(_intensities[i]);
+
+    std::memcpy(_out + (Organized ? i : kept) * _pointStep, p, kSize);
+    kept += static_cast<size_t>(valid);
+  }
+  return kept;
+}
+
+/// \brief UINT16 packed value of +inf.
+constexpr uint16_t kPackedPositiveInf = 65535;
+
+/// \brief UINT16 packed value of -inf.
+constexpr uint16_t kPackedNegativeInf = 65534;
+
+/// \brief UINT16 packed value of NaN.
+constexpr uint16_t kPackedNaN = 65533;
+
+/// \brief Pack values.
+/// \param[in] _values The values.
+/// \param[in] _count Number of values.
+/// \param[in] _encoding Type of the packed values.
+/// \param[in] _resolution Value of one unit of a UINT16 value.
+/// \param[out] _packed The packed values.
+/// \return False if a finite value can't be represented as UINT16.
+inline bool PackValues(const double *_values, size_t _count,
+    LaserScan::Packed::Encoding _encoding, double _resolution,
+    LaserScan::Packed &_packed)
+{
+  _packed.set_encoding(_encoding);
+  std::string &data = *_packed.mutable_data();
+  if (_encoding == LaserScan::Packed::FLOAT32)
+  {
+    _packed.clear_resolution();
+    data.resize(_count * sizeof(float));
+    char *out = &data[0];
+    for (size_t i = 0; i < _count; ++i)
+    {
+      const float v = static_cast<float>(_values[i]);
+      std::memcpy(out + i * sizeof(float), &v, sizeof(v));
+    }
+    return true;
+  }
+
+  if (!(_resolution > 0.0) || !std::isfinite(_resolution))
+  {
+    std::cerr << "UINT16 packing requires a positive resolution, got ["
+              << _resolution << "].\n";
+    return false;
+  }
+  _packed.set_resolution(_resolution);
+  data.resize(_count * sizeof(uint16_t));
+  char *out = &data[0];
+
+  // Branch-free so that the compiler vectorizes the loop.
+  const double scale = 1.0 / _resolution;
+  const double limit = kPackedNaN;
+  uint8_t bad = 0;
+  for (size_t i = 0; i < _count; ++i)
+  {
+    const double v = _values[i];
+    const double scaled = v * scale + 0.5;
+    const bool inRange = scaled >= 0.0 && scaled < limit;
+    const uint16_t code = inRange ? static_cast<uint16_t>(scaled) :
+        std::isinf(v) && v > 0 ? kPackedPositiveInf :
+        std::isinf(v) ? kPackedNegativeInf : kPackedNaN;
+    bad |= static_cast<uint8_t>(!inRange && std::isfinite(v));
+    std::memcpy(out + i * sizeof(uint16_t), &code, sizeof(code));
+  }
+
+  if (bad)
+  {
+    std::cerr << "Values don't fit in UINT16 with a resolution of ["
+              << _resolution << "].\n";
+    return false;
+  }
+  return true;
+}
+
+/// \brief Get the number of packed values.
+/// \param[in] _packed The packed values.
+/// \param[out] _count Number of values.
+/// \return False if the packed values are malformed.
+inline bool PackedCount(const LaserScan::Packed &_packed, size_t &_count)
+{
+  const size_t size = _packed.encoding() == LaserScan::Packed::FLOAT32 ?
+      sizeof(float) : sizeof(uint16_t);
+  if ((_packed.encoding() != LaserScan::Packed::FLOAT32 &&
+       _packed.encoding() != LaserScan::Packed::UINT16) ||
+      _packed.data().size() % size != 0 ||
+      (_packed.encoding() == LaserScan::Packed::UINT16 &&
+       !(_packed.resolution() > 0.0)))
+  {
+    std::cerr << "LaserScan has malformed packed values.\n";
+    return false;
+  }
+  _count = _packed.data().size() / size;
+  return true;
+}
+
+/// \brief Unpack values.
+/// \param[in] _packed The packed values, checked with PackedCount.
+/// \param[out] _values The values, holding the number of values returned
+/// by PackedCount.
+inline void UnpackValues(const LaserScan::Packed &_packed, double *_values)
+{
+  const char *in = _packed.data().data();
+  if (_packed.encoding() == LaserScan::Packed::FLOAT32)
+  {
+    const size_t count = _packed.data().size() / sizeof(float);
+    for (size_t i = 0; i < count; ++i)
+    {
+      float v;
+      std::memcpy(&v, in + i * sizeof(float), sizeof(v));
+      _values[i] = v;
+    }
+    return;
+  }
+
+  const double resolution = _packed.resolution();
+  const double inf = std::numeric_limits<double>::infinity();
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const size_t count = _packed.data().size() / sizeof(uint16_t);
+  for (size_t i = 0; i < count; ++i)
+  {
+    uint16_t code;
+    std::memcpy(&code, in + i * sizeof(uint16_t), sizeof(code));
+    _values[i] = code == kPackedPositiveInf ? inf :
+        code == kPackedNegativeInf ? -inf :
+        code == kPackedNaN ? nan : code * resolution;
+  }
+}
+
+/// \brief Get the values of a repeated field or, if it's empty, of its
+/// packed counterpart.
+/// \param[in] _values The repeated field.
+/// \param[in] _hasPacked Whether the packed counterpart is set.
+/// \param[in] _packed The packed counterpart.
+/// \param[in,out] _buffer Buffer to unpack into.
+/// \param[out] _data The values.
+/// \param[out] _count Number of values.
+/// \return False if the packed values are malformed.
+inline bool ScanValues(const google::protobuf::RepeatedField<double> &_values,
+    bool _hasPacked, const LaserScan::Packed &_packed,
+    std::vector<double> &_buffer, const double *&_data, size_t &_count)
+{
+  _data = _values.data();
+  _count = static_cast<size_t>(_values.size());
+  if (_count > 0 || !_hasPacked)
+    return true;
+  if (!PackedCount(_packed, _count))
+    return false;
+  _buffer.resize(_count);
+  UnpackValues(_packed, _buffer.data());
+  _data = _buffer.data();
+  return true;
+}
+}  // namespace detail
+
+/// \brief Move the ranges and intensities of a scan into its compact
+/// packed_ranges and packed_intensities fields, clearing ranges and
+/// intensities.
+///
+/// FLOAT32 halves the size of the values. UINT16 quarters it, storing
+/// every value as a multiple of a resolution, e.g. millimeter ranges;
+/// infinite and NaN values are kept. Consumers that read ranges and
+/// intensities must call UnpackLaserScan first, while LaserScanProjector
+/// reads packed scans directly.
+///
+/// \code{.cpp}
+/// gz::msgs::PackLaserScan(scan, gz::msgs::LaserScan::Packed::UINT16,
+///     0.002);
+/// \endcode
+///
+/// \param[in,out] _scan The scan.
+/// \param[in] _encoding Type of the packed values.
+/// \param[in] _rangeResolution Value of one UINT16 range unit.
+/// \param[in] _intensityResolution Value of one UINT16 intensity unit.
+/// \return False if a finite value can't be represented with _encoding,
+/// e.g. a negative value or a value of 65533 or more units for UINT16. The
+/// scan isn't modified on failure.
+inline bool PackLaserScan(LaserScan &_scan,
+    LaserScan::Packed::Encoding _encoding, double _rangeResolution = 0.001,
+    double _intensityResolution = 1.0)
+{
+  LaserScan::Packed ranges;
+  LaserScan::Packed intensities;
+  if (!detail::PackValues(_scan.ranges().data(), _scan.ranges_size(),
+        _encoding, _rangeResolution, ranges) ||
+      !detail::PackValues(_scan.intensities().data(),
+        _scan.intensities_size(), _encoding, _intensityResolution,
+        intensities))
+  {
+    return false;
+  }
+
+  if (_scan.ranges_size() > 0)
+  {
+    _scan.mutable_packed_ranges()->Swap(&ranges);
+    _scan.clear_ranges();
+  }
+  if (_scan.intensities_size() > 0)
+  {
+    _scan.mutable_packed_intensities()->Swap(&intensities);
+    _scan.clear_intensities();
+  }
+  return true;
+}
+
+/// \brief Move the packed_ranges and packed_intensities of a scan back into
+/// its ranges and intensities fields. Packed values are dropped if the
+/// matching repeated field isn't empty.
+/// \param[in,out] _scan The scan.
+/// \return False if the packed values are malformed, in which case the scan
+/// isn't modified.
+inline bool UnpackLaserScan(LaserScan &_scan)
+{
+  size_t rangeCount = 0;
+  size_t intensityCount = 0;
+  if ((_scan.has_packed_ranges() &&
+       !detail::PackedCount(_scan.packed_ranges(), rangeCount)) ||
+      (_scan.has_packed_intensities() &&
+       !detail::PackedCount(_scan.packed_intensities(), intensityCount)))
+  {
+    return false;
+  }
+
+  if (_scan.ranges_size() == 0 && _scan.has_packed_ranges())
+  {
+    _scan.mutable_ranges()->Resize(static_cast<int>(rangeCount), 0.0);
+    detail::UnpackValues(_scan.packed_ranges(),
+        _scan.mutable_ranges()->mutable_data());
+  }
+  _scan.clear_packed_ranges();
+  if (_scan.intensities_size() == 0 && _scan.has_packed_intensities())
+  {
+    _scan.mutable_intensities()->Resize(
+        static_cast<int>(intensityCount), 0.0);
+    detail::UnpackValues(_scan.packed_intensities(),
+        _scan.mutable_intensities()->mutable_data());
+  }
+  _scan.clear_packed_intensities();
+  return true;
+}
+
+/// \brief Projects laser scans into point clouds.
+///
+/// The unit direction of every beam is computed once and cached, and only
+/// recomputed when the angles or beam counts of the scans change, so
+/// projecting a scan costs a multiplication per coordinate instead of
+/// trigonometric functions per beam. Reuse a projector, and the output
+/// cloud, across scans of the same sensor.
+///
+/// Ranges are stored with the vertical beam as the major index, i.e. range
+/// [v * count + h] belongs to horizontal beam h and vertical beam v. A
+/// beam with horizontal angle a and vertical angle b points along
+/// (cos(b) cos(a), cos(b) sin(a), sin(b)). Ranges outside of [range_min,
+/// range_max], NaN and infinite ranges are filtered. Scans whose ranges
+/// or intensities were packed with PackLaserScan are projected directly.
+///
+/// \code{.cpp}
+/// gz::msgs::LaserScanProjector projector;
+/// gz::msgs::PointCloudPacked cloud;
+/// ...
+/// if (projector.Project(scan, cloud))
+///   process(cloud);
+/// \endcode
+class LaserScanProjector
+{
+  /// \brief Project a scan into a cloud with FLOAT32 x, y and z fields,
+  /// followed by a FLOAT32 intensity field if requested. The header of the
+  /// cloud is copied from the scan.
+  /// \param[in] _scan The scan.
+  /// \param[out] _cloud The cloud. Its data buffer is reused.
+  /// \param[in] _options Projection options.
+  /// \return False if the scan doesn't have count * vertical_count ranges.
+  public: bool Project(const LaserScan &_scan, PointCloudPacked &_cloud,
+              const LaserScanProjectOptions &_options = {});
+
+  /// \brief Get the cached unit directions of the beams.
+  /// \return The x components of every beam, then the y components, then
+  /// the z components. Empty before the first projection.
+  public: const std::vector<float> &Directions() const;
+
+  /// \brief Compute the beam directions if the geometry changed.
+  /// \param[in] _geometry Geometry of the scan.
+  private: void UpdateDirections(const detail::LaserScanGeometry &_geometry);
+
+  /// \brief Geometry of the cached directions.
+  private: detail::LaserScanGeometry geometry;
+
+  /// \brief Cached beam directions.
+  private: std::vector<float> directions;
+
+  /// \brief Buffer for ranges of scans with packed ranges.
+  private: std::vector<double> unpackedRanges;
+
+  /// \brief Buffer for intensities of scans with packed intensities.
+  private: std::vector<double> unpackedIntensities;
+};
+
+/////////////////////////////////////////////////
+inline bool LaserScanProjector::Project(const LaserScan &_scan,
+    PointCloudPacked &_cloud, const LaserScanProjectOptions &_options)
+{
+  const double *ranges = nullptr;
+  const double *intensities = nullptr;
+  size_t rangeCount = 0;
+  size_t intensityCount = 0;
+  if (!detail::ScanValues(_scan.ranges(), _scan.has_packed_ranges(),
+        _scan.packed_ranges(), this->unpackedRanges, ranges, rangeCount) ||
+      !detail::ScanValues(_scan.intensities(),
+        _options.intensities && _scan.has_packed_intensities(),
+        _scan.packed_intensities(), this->unpackedIntensities, intensities,
+        intensityCount))
+  {
+    return false;
+  }
+
+  const detail::LaserScanGeometry scanGeometry = detail::ScanGeometry(_scan);
+  const size_t points =
+      static_cast<size_t>(scanGeometry.count) * scanGeometry.verticalCount;
+  if (rangeCount != points)
+  {
+    std::cerr << "LaserScan has [" << rangeCount
+              << "] ranges instead of count * vertical_count [" << points
+              << "].\n";
+    return false;
+  }
+  this->UpdateDirections(scanGeometry);
+
+  const bool intensity = _options.intensities && intensityCount == points;
+  const size_t fields = intensity ? 4u : 3u;
+  bool layoutMatches = _cloud.field_size() == static_cast<int>(fields) &&
+      _cloud.point_step() == fields * sizeof(float);
+  static const char *kNames[4] = {"x", "y", "z", "intensity"};
+  for (size_t i = 0; layoutMatches && i < fields; ++i)
+  {
+    const PointCloudPacked::Field &field = _cloud.field(static_cast<int>(i));
+    layoutMatches = field.name() == kNames[i] &&
+        field.offset() == i * sizeof(float) &&
+        field.datatype() == PointCloudPacked::Field::FLOAT32 &&
+        field.count() == 1;
+  }
+  if (!layoutMatches)
+  {
+    std::vector<std::pair<std::string, PointCloudPacked::Field::DataType>>
+        layout{{"xyz", PointCloudPacked::Field::FLOAT32}};
+    if (intensity)
+      layout.push_back({"intensity", PointCloudPacked::Field::FLOAT32});
+    InitPointCloudPacked(_cloud, "", false, layout);
+  }
+  *_cloud.mutable_header() = _scan.header();
+  _cloud.set_is_bigendian(false);
+
+  float m[12] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0};
+  if (_options.applyWorldPose)
+  {
+    const math::Pose3d pose = Convert(_scan.world_pose());
+    const math::Matrix3d rot(pose.Rot());
+    const double transform[12] = {
+        rot(0, 0), rot(0, 1), rot(0, 2), pose.Pos().X(),
+        rot(1, 0), rot(1, 1), rot(1, 2), pose.Pos().Y(),
+        rot(2, 0), rot(2, 1), rot(2, 2), pose.Pos().Z()};
+    for (int i = 0; i < 12; ++i)
+      m[i] = static_cast<float>(transform[i]);
+  }
+
+  const size_t step = _cloud.point_step();
+  std::string &data = *_cloud.mutable_data();
+  data.resize(points * step);
+
+  using Kernel = size_t (*)(const double *, const double *, const float *,
+      size_t, double, double, const float (&)[12], char *, size_t);
+  static const Kernel kKernels[8] = {
+      detail::ProjectRanges<false, false, false>,
+      detail::ProjectRanges<false, false, true>,
+      detail::ProjectRanges<false, true, false>,
+      detail::ProjectRanges<false, true, true>,
+      detail::ProjectRanges<true, false, false>,
+      detail::ProjectRanges<true, false, true>,
+      detail::ProjectRanges<true, true, false>,
+      detail::ProjectRanges<true, true, true>};
+  const Kernel kernel = kKernels[
+      (_options.applyWorldPose ? 4 : 0) + (_options.organized ? 2 : 0) +
+      (intensity ? 1 : 0)];
+
+  const size_t kept = points == 0 ? 0 : kernel(ranges,
+      intensity ? intensities : nullptr, this->directions.data(), points,
+      _scan.range_min(), _scan.range_max(), m, &data[0], step);
+
+  if (_options.organized)
+  {
+    _cloud.set_height(scanGeometry.verticalCount);
+    _cloud.set_width(scanGeometry.count);
+    _cloud.set_is_dense(kept == points);
+  }
+  else
+  {
+    data.resize(kept * step);
+    _cloud.set_height(1);
+    _cloud.set_width(static_cast<uint32_t>(kept));
+    _cloud.set_is_dense(true);
+  }
+  _cloud.set_row_step(_cloud.width() * _cloud.point_step());
+  return true;
+}
+
+/////////////////////////////////////////////////
+inline const std::vector<float> &LaserScanProjector::Directions() const
+{
+  return this->directions;
+}
+
+/////////////////////////////////////////////////
+inline void LaserScanProjector::UpdateDirections(
+    const detail::LaserScanGeometry &_geometry)
+{
+  const size_t points =
+      static_cast<size_t>(_geometry.count) * _geometry.verticalCount;
+  if (_geometry == this->geometry && this->directions.size() == 3 * points)
+    return;
+
+  this->geometry = _geometry;
+  this->directions.resize(3 * points);
+  float *dx = this->directions.data();
+  float *dy = dx + points;
+  float *dz = dy + points;
+
+  std::vector<double> cosH(_geometry.count);
+  std::vector<double> sinH(_geometry.count);
+  for (uint32_t h = 0; h < _geometry.count; ++h)
+  {
+    const double angle = _geometry.angleMin + h * _geometry.angleStep;
+    cosH[h] = std::cos(angle);
+    sinH[h] = std::sin(angle);
+  }
+
+  size_t i = 0;
+  for (uint32_t v = 0; v < _geometry.verticalCount; ++v)
+  {
+    const double angle =
+        _geometry.verticalAngleMin + v * _geometry.verticalAngleStep;
+    const double cosV = std::cos(angle);
+    const double sinV = std::sin(angle);
+    for (uint32_t h = 0; h < _geometry.count; ++h, ++i)
+    {
+      dx[i] = static_cast<float>(cosV * cosH[h]);
+      dy[i] = static_cast<float>(cosV * sinH[h]);
+      dz[i] = static_cast<float>(sinV);
+    }
+  }
+}
+}
+}
+
+#endif
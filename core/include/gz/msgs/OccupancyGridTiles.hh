@@ -0,0 +1,937 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_MSGS_OCCUPANCYGRIDTILES_HH_
+#define GZ_MSGS_OCCUPANCYGRIDTILES_HH_
+
+#include <gz/msgs/header.pb.h>
+#include <gz/msgs/occupancy_grid.pb.h>
+#include <gz/msgs/occupancy_grid_delta.pb.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "gz/msgs/config.hh"
+
+namespace gz
+{
+namespace msgs
+{
+namespace detail
+{
+/// \brief Value of an occupied cell.
+constexpr int8_t kOccupiedCell = 100;
+
+/// \brief Value of a free cell.
+constexpr int8_t kFreeCell = 0;
+
+/// \brief Value of an unknown cell.
+constexpr int8_t kUnknownCell = -1;
+
+/// \brief Number of tiles needed to cover a map dimension.
+/// \param[in] _cells Map width or height.
+/// \param[in] _tileSize Tile size.
+/// \return Number of tiles.
+inline uint32_t TileCount(uint32_t _cells, uint32_t _tileSize)
+{
+  return static_cast<uint32_t>(
+      (static_cast<uint64_t>(_cells) + _tileSize - 1) / _tileSize);
+}
+
+/// \brief Threshold a run of cells in place.
+/// \param[in,out] _cells The cells.
+/// \param[in] _count Number of cells.
+/// \param[in] _free Cells at or below this value become free.
+/// \param[in] _occupied Cells at or above this value become occupied.
+/// \return True if any cell changed.
+inline bool ThresholdCells(int8_t *_cells, size_t _count, int8_t _free,
+    int8_t _occupied)
+{
+  // Branch-free so that the compiler vectorizes the loop.
+  uint8_t changed = 0;
+  for (size_t i = 0; i < _count; ++i)
+  {
+    const int8_t cell = _cells[i];
+    const int8_t value = cell < 0 ? kUnknownCell :
+        cell >= _occupied ? kOccupiedCell :
+        cell <= _free ? kFreeCell : kUnknownCell;
+    changed |= static_cast<uint8_t>(value != cell);
+    _cells[i] = value;
+  }
+  return changed != 0;
+}
+
+/// \brief Mark the cells of a run that are hit as occupied.
+/// \param[in,out] _cells The cells.
+/// \param[in] _hit Non-zero for every cell to mark.
+/// \param[in] _count Number of cells.
+/// \return True if any cell changed.
+inline bool MarkOccupiedCells(int8_t *_cells, const uint8_t *_hit,
+    size_t _count)
+{
+  uint8_t changed = 0;
+  for (size_t i = 0; i < _count; ++i)
+  {
+    const int8_t cell = _cells[i];
+    const int8_t value = _hit[i] ? kOccupiedCell : cell;
+    changed |= static_cast<uint8_t>(value != cell);
+    _cells[i] = value;
+  }
+  return changed != 0;
+}
+
+/// \brief Distance along a row from every cell to the nearest obstacle of
+/// the row.
+/// \param[in] _cells Cells of the row.
+/// \param[in] _width Number of cells.
+/// \param[in] _occupied Cells at or above this value are obstacles.
+/// \param[in] _far Distance used for cells farther than _far - 1 from any
+/// obstacle.
+/// \param[out] _dist The distances.
+inline void RowObstacleDistance(const int8_t *_cells, size_t _width,
+    int8_t _occupied, uint16_t _far, uint16_t *_dist)
+{
+  size_t obstacles = 0;
+  for (size_t x = 0; x < _width; ++x)
+    obstacles += static_cast<size_t>(_cells[x] >= _occupied);
+
+  const size_t reach = _far - 1u;
+  if (obstacles * (2 * reach + 1) > 4 * _width)
+  {
+    // Dense rows: two sequential passes.
+    uint16_t d = _far;
+    for (size_t x = 0; x < _width; ++x)
+    {
+      d = _cells[x] >= _occupied ? 0 : std::min<uint16_t>(d + 1, _far);
+      _dist[x] = d;
+    }
+    d = _far;
+    for (size_t x = _width; x-- > 0;)
+    {
+      d = _cells[x] >= _occupied ? 0 : std::min<uint16_t>(d + 1, _far);
+      _dist[x] = std::min(_dist[x], d);
+    }
+    return;
+  }
+
+  // Sparse rows: stamp the distances around every obstacle.
+  std::fill(_dist, _dist + _width, _far);
+  for (size_t x = 0; obstacles > 0; ++x)
+  {
+    if (_cells[x] < _occupied)
+      continue;
+    --obstacles;
+    const size_t begin = x > reach ? x - reach : 0;
+    const size_t end = std::min(x + reach + 1, _width);
+    for (size_t i = begin; i < end; ++i)
+    {
+      const uint16_t d = static_cast<uint16_t>(i > x ? i - x : x - i);
+      _dist[i] = std::min(_dist[i], d);
+    }
+  }
+}
+
+/// \brief Set _hit for every cell whose distance is at most _limit.
+/// \param[in] _dist Distances computed by RowObstacleDistance.
+/// \param[in] _limit Maximum distance.
+/// \param[in] _count Number of cells.
+/// \param[in,out] _hit The hit flags.
+inline void HitWithin(const uint16_t *_dist, uint16_t _limit, size_t _count,
+    uint8_t *_hit)
+{
+  for (size_t i = 0; i < _count; ++i)
+    _hit[i] |= static_cast<uint8_t>(_dist[i] <= _limit);
+}
+}  // namespace detail
+
+/// \brief An OccupancyGrid split into square tiles, which tracks the tiles
+/// that changed so that only those need to be published.
+///
+/// Every function that modifies cells marks the tiles whose cells changed
+/// as dirty. MakeDelta turns the dirty tiles into an OccupancyGridDelta
+/// and clears them, and MakeKeyframe creates a delta holding every tile
+/// for subscribers that join late. OccupancyGridReconstructor applies the
+/// deltas to a plain OccupancyGrid on the receiving side.
+///
+/// \code{.cpp}
+/// gz::msgs::TiledOccupancyGrid grid(4000, 4000);
+/// grid.FillRect(100, 100, 20, 20, 100);
+/// gz::msgs::OccupancyGridDelta delta;
+/// if (grid.MakeDelta(delta))
+///   publisher.Publish(delta);
+/// \endcode
+class TiledOccupancyGrid
+{
+  /// \brief Default width and height of a tile (cells).
+  public: static constexpr uint32_t kDefaultTileSize = 64;
+
+  /// \brief Constructor. The map is copied. Missing cells are unknown and
+  /// extra cells are dropped.
+  /// \param[in] _map The map.
+  /// \param[in] _tileSize Width and height of a tile. Zero uses
+  /// kDefaultTileSize.
+  public: explicit TiledOccupancyGrid(const OccupancyGrid &_map,
+              uint32_t _tileSize = kDefaultTileSize);
+
+  /// \brief Constructor of a map of unknown cells.
+  /// \param[in] _width Map width (cells).
+  /// \param[in] _height Map height (cells).
+  /// \param[in] _tileSize Width and height of a tile. Zero uses
+  /// kDefaultTileSize.
+  public: TiledOccupancyGrid(uint32_t _width, uint32_t _height,
+              uint32_t _tileSize = kDefaultTileSize);
+
+  /// \brief Get the map.
+  /// \return The map.
+  public: const OccupancyGrid &Map() const;
+
+  /// \brief Get a mutable header, copied into every delta.
+  /// \return The header of the map.
+  public: Header &MutableHeader();
+
+  /// \brief Get mutable map metadata. The width and height must not be
+  /// changed.
+  /// \return The metadata of the map.
+  public: OccupancyGrid::MapMetaInfo &MutableInfo();
+
+  /// \brief Get the map width.
+  /// \return Width (cells).
+  public: uint32_t Width() const;
+
+  /// \brief Get the map height.
+  /// \return Height (cells).
+  public: uint32_t Height() const;
+
+  /// \brief Get the tile size.
+  /// \return Width and height of a tile (cells).
+  public: uint32_t TileSize() const;
+
+  /// \brief Get the number of tile columns.
+  /// \return Number of tiles along the width.
+  public: uint32_t TilesX() const;
+
+  /// \brief Get the number of tile rows.
+  /// \return Number of tiles along the height.
+  public: uint32_t TilesY() const;
+
+  /// \brief Get the version of the last delta created by MakeDelta.
+  /// \return The version, zero before the first delta.
+  public: uint64_t Version() const;
+
+  /// \brief Get the number of tiles changed since the last delta.
+  /// \return Number of dirty tiles.
+  public: size_t DirtyTileCount() const;
+
+  /// \brief Get a cell. The cell must be inside the map.
+  /// \param[in] _x Column of the cell.
+  /// \param[in] _y Row of the cell.
+  /// \return Value of the cell.
+  public: int8_t Cell(uint32_t _x, uint32_t _y) const;
+
+  /// \brief Set a cell. The cell must be inside the map.
+  /// \param[in] _x Column of the cell.
+  /// \param[in] _y Row of the cell.
+  /// \param[in] _value New value of the cell.
+  public: void SetCell(uint32_t _x, uint32_t _y, int8_t _value);
+
+  /// \brief Copy a rectangle of cells out of the map.
+  /// \param[in] _x First column.
+  /// \param[in] _y First row.
+  /// \param[in] _width Number of columns.
+  /// \param[in] _height Number of rows.
+  /// \param[out] _cells Destination, in row-major order, holding at least
+  /// _width * _height cells.
+  /// \return False if the rectangle is not inside the map.
+  public: bool ReadRect(uint32_t _x, uint32_t _y, uint32_t _width,
+              uint32_t _height, int8_t *_cells) const;
+
+  /// \brief Copy a rectangle of cells into the map.
+  /// \param[in] _x First column.
+  /// \param[in] _y First row.
+  /// \param[in] _width Number of columns.
+  /// \param[in] _height Number of rows.
+  /// \param[in] _cells Source, in row-major order, holding at least
+  /// _width * _height cells.
+  /// \return False if the rectangle is not inside the map.
+  public: bool WriteRect(uint32_t _x, uint32_t _y, uint32_t _width,
+              uint32_t _height, const int8_t *_cells);
+
+  /// \brief Set every cell of a rectangle to the same value.
+  /// \param[in] _x First column.
+  /// \param[in] _y First row.
+  /// \param[in] _width Number of columns.
+  /// \param[in] _height Number of rows.
+  /// \param[in] _value New value of the cells.
+  /// \return False if the rectangle is not inside the map.
+  public: bool FillRect(uint32_t _x, uint32_t _y, uint32_t _width,
+              uint32_t _height, int8_t _value);
+
+  /// \brief Mark every tile overlapping a rectangle as dirty.
+  /// \param[in] _x First column.
+  /// \param[in] _y First row.
+  /// \param[in] _width Number of columns.
+  /// \param[in] _height Number of rows.
+  /// \return False if the rectangle is not inside the map.
+  public: bool MarkDirty(uint32_t _x, uint32_t _y, uint32_t _width,
+              uint32_t _height);
+
+  /// \brief Turn the map into a trinary map, like the ROS map_server.
+  /// Cells at or above _occupied become occupied (100), cells at or below
+  /// _free become free (0), and every other cell becomes unknown (-1).
+  /// \param[in] _free Free threshold.
+  /// \param[in] _occupied Occupied threshold.
+  public: void Threshold(int8_t _free, int8_t _occupied);
+
+  /// \brief Inflate the obstacles of the map. Every cell within _radius
+  /// cells (Euclidean distance) of a cell at or above _occupied becomes
+  /// occupied (100), including unknown cells.
+  /// \param[in] _radius Inflation radius (cells).
+  /// \param[in] _occupied Cells at or above this value are obstacles.
+  public: void Inflate(uint32_t _radius, int8_t _occupied = 100);
+
+  /// \brief Create a delta holding the tiles changed since the previous
+  /// delta, and clear the dirty tiles.
+  /// \param[out] _delta The delta.
+  /// \return False if no tile changed, in which case _delta is unchanged
+  /// and the version is not increased.
+  public: bool MakeDelta(OccupancyGridDelta &_delta);
+
+  /// \brief Create a keyframe holding every tile at the current version.
+  /// The dirty tiles are not cleared.
+  /// \param[out] _keyframe The keyframe.
+  public: void MakeKeyframe(OccupancyGridDelta &_keyframe) const;
+
+  /// \brief Check that a rectangle is inside the map.
+  /// \param[in] _x First column.
+  /// \param[in] _y First row.
+  /// \param[in] _width Number of columns.
+  /// \param[in] _height Number of rows.
+  /// \return True if the rectangle is inside the map.
+  private: bool CheckRect(uint32_t _x, uint32_t _y, uint32_t _width,
+               uint32_t _height) const;
+
+  /// \brief Initialize the tiles after the map size is known.
+  /// \param[in] _tileSize Requested tile size.
+  private: void InitTiles(uint32_t _tileSize);
+
+  /// \brief Call a function with the run of every tile overlapping a row.
+  /// \param[in] _y The row.
+  /// \param[in] _x First column.
+  /// \param[in] _width Number of columns.
+  /// \param[in] _func Callable taking (uint32_t _begin, uint32_t _end,
+  /// size_t _tile), returning true if cells of the run changed.
+  private: template<typename Func>
+           void ForEachRun(uint32_t _y, uint32_t _x, uint32_t _width,
+               Func &&_func);
+
+  /// \brief Get a row of the map.
+  /// \param[in] _y The row.
+  /// \return First cell of the row.
+  private: int8_t *Row(uint32_t _y);
+
+  /// \brief Get a row of the map.
+  /// \param[in] _y The row.
+  /// \return First cell of the row.
+  private: const int8_t *Row(uint32_t _y) const;
+
+  /// \brief Copy a tile into a delta.
+  /// \param[in] _index Index of the tile.
+  /// \param[in,out] _delta The delta.
+  private: void AddTile(size_t _index, OccupancyGridDelta &_delta) const;
+
+  /// \brief Copy the header and metadata into a delta.
+  /// \param[out] _delta The delta.
+  private: void FillDelta(OccupancyGridDelta &_delta) const;
+
+  /// \brief The map.
+  private: OccupancyGrid map;
+
+  /// \brief Width and height of a tile.
+  private: uint32_t tileSize{kDefaultTileSize};
+
+  /// \brief Number of tile columns.
+  private: uint32_t tilesX{0};
+
+  /// \brief Number of tile rows.
+  private: uint32_t tilesY{0};
+
+  /// \brief Non-zero for every tile changed since the last delta, in
+  /// row-major order.
+  private: std::vector<uint8_t> dirty;
+
+  /// \brief Version of the last delta.
+  private: uint64_t version{0};
+};
+
+/// \brief Applies OccupancyGridDelta messages to an OccupancyGrid, in
+/// place.
+///
+/// The reconstructor starts from a keyframe. Every later delta must have
+/// a base version equal to the version of the last applied delta;
+/// otherwise a delta was lost, the delta is rejected and the reconstructor
+/// waits for the next keyframe.
+///
+/// \code{.cpp}
+/// gz::msgs::OccupancyGrid map;
+/// gz::msgs::OccupancyGridReconstructor reconstructor(map);
+/// ...
+/// if (reconstructor.Apply(delta))
+///   process(map);
+/// \endcode
+class OccupancyGridReconstructor
+{
+  /// \brief Constructor.
+  /// \param[in] _dst Map to update. Must outlive this object.
+  public: explicit OccupancyGridReconstructor(OccupancyGrid &_dst);
+
+  /// \brief Apply a delta to the destination map. The map is left
+  /// unchanged if the delta is rejected.
+  /// \param[in] _delta The delta.
+  /// \return False if the delta is malformed, doesn't match the map, or
+  /// doesn't follow the last applied version.
+  public: bool Apply(const OccupancyGridDelta &_delta);
+
+  /// \brief Whether a keyframe was applied and no delta was lost since.
+  /// \return True if the destination map is up to date.
+  public: bool Synced() const;
+
+  /// \brief Get the version of the destination map.
+  /// \return Version of the last applied delta.
+  public: uint64_t Version() const;
+
+  /// \brief Wait for the next keyframe.
+  public: void Reset();
+
+  /// \brief The destination map.
+  private: OccupancyGrid &dst;
+
+  /// \brief Tile size of the applied deltas.
+  private: uint32_t tileSize{0};
+
+  /// \brief Version of the last applied delta.
+  private: uint64_t version{0};
+
+  /// \brief Whether the destination map is up to date.
+  private: bool synced{false};
+};
+
+/////////////////////////////////////////////////
+inline TiledOccupancyGrid::TiledOccupancyGrid(const OccupancyGrid &_map,
+    uint32_t _tileSize)
+  : map(_map)
+{
+  const size_t size = static_cast<size_t>(this->map.info().width()) *
+      this->map.info().height();
+  if (this->map.data().size() != size)
+  {
+    std::cerr << "Occupancy grid has [" << this->map.data().size()
+              << "] cells instead of [" << size << "].\n";
+  }
+  this->map.mutable_data()->resize(size,
+      static_cast<char>(detail::kUnknownCell));
+  this->InitTiles(_tileSize);
+}
+
+/////////////////////////////////////////////////
+inline TiledOccupancyGrid::TiledOccupancyGrid(uint32_t _width,
+    uint32_t _height, uint32_t _tileSize)
+{
+  this->map.mutable_info()->set_width(_width);
+  this->map.mutable_info()->set_height(_height);
+  this->map.mutable_data()->assign(static_cast<size_t>(_width) * _height,
+      static_cast<char>(detail::kUnknownCell));
+  this->InitTiles(_tileSize);
+}
+
+/////////////////////////////////////////////////
+inline const OccupancyGrid &TiledOccupancyGrid::Map() const
+{
+  return this->map;
+}
+
+/////////////////////////////////////////////////
+inline Header &TiledOccupancyGrid::MutableHeader()
+{
+  return *this->map.mutable_header();
+}
+
+/////////////////////////////////////////////////
+inline OccupancyGrid::MapMetaInfo &TiledOccupancyGrid::MutableInfo()
+{
+  return *this->map.mutable_info();
+}
+
+/////////////////////////////////////////////////
+inline uint32_t TiledOccupancyGrid::Width() const
+{
+  return this->map.info().width();
+}
+
+/////////////////////////////////////////////////
+inline uint32_t TiledOccupancyGrid::Height() const
+{
+  return this->map.info().height();
+}
+
+/////////////////////////////////////////////////
+inline uint32_t TiledOccupancyGrid::TileSize() const
+{
+  return this->tileSize;
+}
+
+/////////////////////////////////////////////////
+inline uint32_t TiledOccupancyGrid::TilesX() const
+{
+  return this->tilesX;
+}
+
+/////////////////////////////////////////////////
+inline uint32_t TiledOccupancyGrid::TilesY() const
+{
+  return this->tilesY;
+}
+
+/////////////////////////////////////////////////
+inline uint64_t TiledOccupancyGrid::Version() const
+{
+  return this->version;
+}
+
+/////////////////////////////////////////////////
+inline size_t TiledOccupancyGrid::DirtyTileCount() const
+{
+  return static_cast<size_t>(std::count_if(this->dirty.begin(),
+      this->dirty.end(), [](uint8_t _dirty) { return _dirty != 0; }));
+}
+
+/////////////////////////////////////////////////
+inline int8_t TiledOccupancyGrid::Cell(uint32_t _x, uint32_t _y) const
+{
+  return this->Row(_y)[_x];
+}
+
+/////////////////////////////////////////////////
+inline void TiledOccupancyGrid::SetCell(uint32_t _x, uint32_t _y,
+    int8_t _value)
+{
+  int8_t &cell = this->Row(_y)[_x];
+  if (cell == _value)
+    return;
+  cell = _value;
+  this->dirty[static_cast<size_t>(_y / this->tileSize) * this->tilesX +
+      _x / this->tileSize] = 1;
+}
+
+/////////////////////////////////////////////////
+inline bool TiledOccupancyGrid::ReadRect(uint32_t _x, uint32_t _y,
+    uint32_t _width, uint32_t _height, int8_t *_cells) const
+{
+  if (!this->CheckRect(_x, _y, _width, _height))
+    return false;
+  for (uint32_t row = 0; row < _height; ++row)
+  {
+    std::memcpy(_cells + static_cast<size_t>(row) * _width,
+        this->Row(_y + row) + _x, _width);
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+inline bool TiledOccupancyGrid::WriteRect(uint32_t _x, uint32_t _y,
+    uint32_t _width, uint32_t _height, const int8_t *_cells)
+{
+  if (!this->CheckRect(_x, _y, _width, _height))
+    return false;
+  for (uint32_t row = 0; row < _height; ++row)
+  {
+    int8_t *dst = this->Row(_y + row);
+    const int8_t *src = _cells + static_cast<size_t>(row) * _width;
+    this->ForEachRun(_y + row, _x, _width,
+        [&](uint32_t _begin, uint32_t _end, size_t)
+        {
+          const size_t count = _end - _begin;
+          if (std::memcmp(dst + _begin, src + (_begin - _x), count) == 0)
+            return false;
+          std::memcpy(dst + _begin, src + (_begin - _x), count);
+          return true;
+        });
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+inline bool TiledOccupancyGrid::FillRect(uint32_t _x, uint32_t _y,
+    uint32_t _width, uint32_t _height, int8_t _value)
+{
+  if (!this->CheckRect(_x, _y, _width, _height))
+    return false;
+  for (uint32_t row = 0; row < _height; ++row)
+  {
+    int8_t *dst = this->Row(_y + row);
+    this->ForEachRun(_y + row, _x, _width,
+        [&](uint32_t _begin, uint32_t _end, size_t)
+        {
+          uint8_t changed = 0;
+          for (uint32_t x = _begin; x < _end; ++x)
+          {
+            changed |= static_cast<uint8_t>(dst[x] != _value);
+            dst[x] = _value;
+          }
+          return changed != 0;
+        });
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+inline bool TiledOccupancyGrid::MarkDirty(uint32_t _x, uint32_t _y,
+    uint32_t _width, uint32_t _height)
+{
+  if (!this->CheckRect(_x, _y, _width, _height))
+    return false;
+  if (_width == 0 || _height == 0)
+    return true;
+  for (uint32_t ty = _y / this->tileSize;
+       ty <= (_y + _height - 1) / this->tileSize; ++ty)
+  {
+    for (uint32_t tx = _x / this->tileSize;
+         tx <= (_x + _width - 1) / this->tileSize; ++tx)
+    {
+      this->dirty[static_cast<size_t>(ty) * this->tilesX + tx] = 1;
+    }
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+inline void TiledOccupancyGrid::Threshold(int8_t _free, int8_t _occupied)
+{
+  for (uint32_t y = 0; y < this->Height(); ++y)
+  {
+    int8_t *row = this->Row(y);
+    this->ForEachRun(y, 0, this->Width(),
+        [&](uint32_t _begin, uint32_t _end, size_t)
+        {
+          return detail::ThresholdCells(row + _begin, _end - _begin,
+              _free, _occupied);
+        });
+  }
+}
+
+/////////////////////////////////////////////////
+inline void TiledOccupancyGrid::Inflate(uint32_t _radius, int8_t _occupied)
+{
+  const uint32_t width = this->Width();
+  const uint32_t height = this->Height();
+  if (width == 0 || height == 0)
+    return;
+
+  // A cell is within the radius of an obstacle if, for some row offset
+  // dy, the nearest obstacle along row y + dy is at most
+  // sqrt(r^2 - dy^2) columns away. The distances along every row are
+  // computed once, from the cells before inflation, and kept in a ring
+  // buffer of 2r + 1 rows.
+  const uint32_t radius = std::min({_radius, std::max(width, height),
+      static_cast<uint32_t>(UINT16_MAX - 1)});
+  const uint32_t window = 2 * radius + 1;
+  std::vector<uint16_t> reach(window);
+  for (uint32_t i = 0; i < window; ++i)
+  {
+    const uint64_t dy = i > radius ? i - radius : radius - i;
+    uint64_t dx = 0;
+    while ((dx + 1) * (dx + 1) + dy * dy <=
+        static_cast<uint64_t>(radius) * radius)
+    {
+      ++dx;
+    }
+    reach[i] = static_cast<uint16_t>(dx);
+  }
+
+  const uint16_t far = static_cast<uint16_t>(radius + 1);
+  std::vector<uint16_t> dist(static_cast<size_t>(
+      std::min(window, height)) * width);
+  auto distRow = [&](uint32_t _y)
+  {
+    return dist.data() +
+        static_cast<size_t>(_y % std::min(window, height)) * width;
+  };
+
+  std::vector<uint8_t> hit(width);
+  uint32_t next = 0;
+  for (uint32_t y = 0; y < height; ++y)
+  {
+    // Rows below y are still unmodified.
+    for (; next < height && next <= y + radius; ++next)
+    {
+      detail::RowObstacleDistance(this->Row(next), width, _occupied, far,
+          distRow(next));
+    }
+
+    std::fill(hit.begin(), hit.end(), 0);
+    const uint32_t first = y > radius ? y - radius : 0;
+    const uint32_t last = std::min(height - 1, y + radius);
+    for (uint32_t row = first; row <= last; ++row)
+    {
+      detail::HitWithin(distRow(row), reach[row + radius - y], width,
+          hit.data());
+    }
+
+    int8_t *cells = this->Row(y);
+    this->ForEachRun(y, 0, width,
+        [&](uint32_t _begin, uint32_t _end, size_t)
+        {
+          return detail::MarkOccupiedCells(cells + _begin,
+              hit.data() + _begin, _end - _begin);
+        });
+  }
+}
+
+/////////////////////////////////////////////////
+inline bool TiledOccupancyGrid::MakeDelta(OccupancyGridDelta &_delta)
+{
+  if (std::none_of(this->dirty.begin(), this->dirty.end(),
+      [](uint8_t _dirty) { return _dirty != 0; }))
+  {
+    return false;
+  }
+
+  this->FillDelta(_delta);
+  _delta.set_keyframe(false);
+  _delta.set_base_version(this->version);
+  _delta.set_version(++this->version);
+  for (size_t i = 0; i < this->dirty.size(); ++i)
+  {
+    if (this->dirty[i])
+      this->AddTile(i, _delta);
+  }
+  std::fill(this->dirty.begin(), this->dirty.end(), 0);
+  return true;
+}
+
+/////////////////////////////////////////////////
+inline void TiledOccupancyGrid::MakeKeyframe(
+    OccupancyGridDelta &_keyframe) const
+{
+  this->FillDelta(_keyframe);
+  _keyframe.set_keyframe(true);
+  _keyframe.set_base_version(0);
+  _keyframe.set_version(this->version);
+  for (size_t i = 0; i < this->dirty.size(); ++i)
+    this->AddTile(i, _keyframe);
+}
+
+/////////////////////////////////////////////////
+inline bool TiledOccupancyGrid::CheckRect(uint32_t _x, uint32_t _y,
+    uint32_t _width, uint32_t _height) const
+{
+  if (_x > this->Width() || _width > this->Width() - _x ||
+      _y > this->Height() || _height > this->Height() - _y)
+  {
+    std::cerr << "Rectangle [" << _x << ", " << _y << ", " << _width
+              << ", " << _height << "] is outside of the ["
+              << this->Width() << " x " << this->Height() << "] map.\n";
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+inline void TiledOccupancyGrid::InitTiles(uint32_t _tileSize)
+{
+  this->tileSize = _tileSize == 0 ? kDefaultTileSize : _tileSize;
+  this->tilesX = detail::TileCount(this->Width(), this->tileSize);
+  this->tilesY = detail::TileCount(this->Height(), this->tileSize);
+  this->dirty.assign(static_cast<size_t>(this->tilesX) * this->tilesY, 0);
+}
+
+/////////////////////////////////////////////////
+template<typename Func>
+void TiledOccupancyGrid::ForEachRun(uint32_t _y, uint32_t _x,
+    uint32_t _width, Func &&_func)
+{
+  uint8_t *dirtyRow = this->dirty.data() +
+      static_cast<size_t>(_y / this->tileSize) * this->tilesX;
+  const uint32_t end = _x + _width;
+  for (uint32_t begin = _x; begin < end;)
+  {
+    const uint32_t tile = begin / this->tileSize;
+    const uint32_t runEnd = std::min(end, (tile + 1) * this->tileSize);
+    if (_func(begin, runEnd, tile))
+      dirtyRow[tile] = 1;
+    begin = runEnd;
+  }
+}
+
+/////////////////////////////////////////////////
+inline int8_t *TiledOccupancyGrid::Row(uint32_t _y)
+{
+  return reinterpret_cast<int8_t *>(this->map.mutable_data()->data()) +
+      static_cast<size_t>(_y) * this->Width();
+}
+
+/////////////////////////////////////////////////
+inline const int8_t *TiledOccupancyGrid::Row(uint32_t _y) const
+{
+  return reinterpret_cast<const int8_t *>(this->map.data().data()) +
+      static_cast<size_t>(_y) * this->Width();
+}
+
+/////////////////////////////////////////////////
+inline void TiledOccupancyGrid::AddTile(size_t _index,
+    OccupancyGridDelta &_delta) const
+{
+  const uint32_t tx = static_cast<uint32_t>(_index % this->tilesX);
+  const uint32_t ty = static_cast<uint32_t>(_index / this->tilesX);
+  const uint32_t x = tx * this->tileSize;
+  const uint32_t y = ty * this->tileSize;
+  const uint32_t w = std::min(this->tileSize, this->Width() - x);
+  const uint32_t h = std::min(this->tileSize, this->Height() - y);
+
+  OccupancyGridDelta::Tile *tile = _delta.add_tiles();
+  tile->set_x(tx);
+  tile->set_y(ty);
+  std::string &data = *tile->mutable_data();
+  data.resize(static_cast<size_t>(w) * h);
+  for (uint32_t row = 0; row < h; ++row)
+  {
+    std::memcpy(&data[static_cast<size_t>(row) * w], this->Row(y + row) + x,
+        w);
+  }
+}
+
+/////////////////////////////////////////////////
+inline void TiledOccupancyGrid::FillDelta(OccupancyGridDelta &_delta) const
+{
+  *_delta.mutable_header() = this->map.header();
+  *_delta.mutable_info() = this->map.info();
+  _delta.set_tile_size(this->tileSize);
+  _delta.clear_tiles();
+}
+
+/////////////////////////////////////////////////
+inline OccupancyGridReconstructor::OccupancyGridReconstructor(
+    OccupancyGrid &_dst)
+  : dst(_dst)
+{
+}
+
+/////////////////////////////////////////////////
+inline bool OccupancyGridReconstructor::Apply(
+    const OccupancyGridDelta &_delta)
+{
+  const uint32_t width = _delta.info().width();
+  const uint32_t height = _delta.info().height();
+  const uint32_t deltaTileSize = _delta.tile_size();
+  if (deltaTileSize == 0)
+  {
+    std::cerr << "Occupancy grid delta has no tile size.\n";
+    return false;
+  }
+
+  if (!_delta.keyframe())
+  {
+    if (!this->synced)
+      return false;
+    if (_delta.base_version() != this->version)
+    {
+      std::cerr << "Occupancy grid delta applies to version ["
+                << _delta.base_version() << "], but the map is at version ["
+                << this->version << "]. Waiting for a keyframe.\n";
+      this->synced = false;
+      return false;
+    }
+    if (width != this->dst.info().width() ||
+        height != this->dst.info().height() ||
+        deltaTileSize != this->tileSize)
+    {
+      std::cerr << "Occupancy grid delta doesn't match the size of the "
+                << "map. Waiting for a keyframe.\n";
+      this->synced = false;
+      return false;
+    }
+  }
+
+  // Check every tile before modifying the map.
+  const uint32_t tilesX = detail::TileCount(width, deltaTileSize);
+  const uint32_t tilesY = detail::TileCount(height, deltaTileSize);
+  for (const OccupancyGridDelta::Tile &tile : _delta.tiles())
+  {
+    if (tile.x() >= tilesX || tile.y() >= tilesY ||
+        tile.data().size() != static_cast<size_t>(
+        std::min(deltaTileSize, width - tile.x() * deltaTileSize)) *
+        std::min(deltaTileSize, height - tile.y() * deltaTileSize))
+    {
+      std::cerr << "Occupancy grid tile [" << tile.x() << ", " << tile.y()
+                << "] doesn't fit in the map.\n";
+      return false;
+    }
+  }
+
+  *this->dst.mutable_header() = _delta.header();
+  *this->dst.mutable_info() = _delta.info();
+  std::string &data = *this->dst.mutable_data();
+  if (_delta.keyframe())
+  {
+    data.assign(static_cast<size_t>(width) * height,
+        static_cast<char>(detail::kUnknownCell));
+    this->tileSize = deltaTileSize;
+  }
+
+  for (const OccupancyGridDelta::Tile &tile : _delta.tiles())
+  {
+    const uint32_t x = tile.x() * deltaTileSize;
+    const uint32_t y = tile.y() * deltaTileSize;
+    const uint32_t w = std::min(deltaTileSize, width - x);
+    const uint32_t h = std::min(deltaTileSize, height - y);
+    for (uint32_t row = 0; row < h; ++row)
+    {
+      std::memcpy(&data[static_cast<size_t>(y + row) * width + x],
+          tile.data().data() + static_cast<size_t>(row) * w, w);
+    }
+  }
+
+  this->version = _delta.version();
+  this->synced = true;
+  return true;
+}
+
+/////////////////////////////////////////////////
+inline bool OccupancyGridReconstructor::Synced() const
+{
+  return this->synced;
+}
+
+/////////////////////////////////////////////////
+inline uint64_t OccupancyGridReconstructor::Version() const
+{
+  return this->version;
+}
+
+/////////////////////////////////////////////////
+inline void OccupancyGridReconstructor::Reset()
+{
+  this->synced = false;
+}
+}
+}
+
+#endif
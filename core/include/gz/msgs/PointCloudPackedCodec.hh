@@ -0,0 +1,677 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_MSGS_POINTCLOUDPACKEDCODEC_HH_
+#define GZ_MSGS_POINTCLOUDPACKEDCODEC_HH_
+
+#include <gz/msgs/pointcloud_packed.pb.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "gz/msgs/config.hh"
+#include "gz/msgs/PointCloudPackedUtils.hh"
+#include "gz/msgs/detail/EntropyCoder.hh"
+
+namespace gz
+{
+namespace msgs
+{
+namespace detail
+{
+/// \brief Magic bytes at the start of an encoded PointCloudPacked.
+constexpr char kPointCloudPackedCodecMagic[4] = {'G', 'Z', 'P', 'C'};
+
+/// \brief Version of the encoded PointCloudPacked format.
+constexpr uint8_t kPointCloudPackedCodecVersion = 1;
+
+/// \brief Values of x, y and z that aren't finite are stored as this
+/// quantized value.
+constexpr int32_t kQuantizedNaN = std::numeric_limits<int32_t>::min();
+
+/// \brief A run of bytes of every point that is encoded as one value.
+struct PointCloudPackedColumn
+{
+  /// \brief Offset of the value within a point.
+  size_t offset{0};
+
+  /// \brief Size of the value in bytes (1, 2, 4 or 8).
+  size_t size{1};
+
+  /// \brief True if the value is a floating point position component that
+  /// is quantized before being encoded.
+  bool quantized{false};
+};
+
+/// \brief Split every point of a cloud into columns that are encoded
+/// independently.
+///
+/// Every field element becomes a column, and bytes that don't belong to any
+/// field (padding or overlapping fields) become single byte columns, so the
+/// columns always cover a point exactly once.
+/// \param[in] _msg The cloud.
+/// \param[in] _quantize True to quantize the x, y and z fields.
+/// \return The columns.
+inline std::vector<PointCloudPackedColumn> PointCloudPackedColumns(
+    const PointCloudPacked &_msg, bool _quantize)
+{
+  const size_t pointStep = _msg.point_step();
+  std::vector<bool> covered(pointStep, false);
+  std::vector<PointCloudPackedColumn> columns;
+
+  for (const auto &field : _msg.field())
+  {
+    const int typeSize = sizeOfPointField(field.datatype());
+    if (typeSize <= 0)
+      continue;
+
+    const bool quantized = _quantize &&
+        (field.name() == "x" || field.name() == "y" || field.name() == "z");
+    const size_t count = std::max(1u, field.count());
+    for (size_t c = 0; c < count; ++c)
+    {
+      const size_t offset = field.offset() + c * typeSize;
+      if (offset + typeSize > pointStep)
+        break;
+
+      bool free = true;
+      for (int b = 0; b < typeSize; ++b)
+        free = free && !covered[offset + b];
+      if (!free)
+        continue;
+
+      for (int b = 0; b < typeSize; ++b)
+        covered[offset + b] = true;
+      columns.push_back({offset, static_cast<size_t>(typeSize), quantized});
+    }
+  }
+
+  for (size_t b = 0; b < pointStep; ++b)
+  {
+    if (!covered[b])
+      columns.push_back({b, 1u, false});
+  }
+  return columns;
+}
+
+/// \brief Delta and zigzag encode a column and split it into byte planes.
+///
+/// Neighboring points hold similar values, so the deltas are small and
+/// their high bytes are almost always zero. Storing every byte of the value
+/// in its own plane groups those bytes together for the entropy coder.
+/// \tparam U Unsigned integer type as wide as the column.
+/// \param[in] _values Column values.
+/// \param[in] _count Number of values.
+/// \param[out] _planes sizeof(U) planes of _count bytes each.
+template<typename U>
+void EncodePlanes(const U *_values, size_t _count, uint8_t *_planes)
+{
+  constexpr int kBits = sizeof(U) * 8;
+  U prev = 0;
+  for (size_t i = 0; i < _count; ++i)
+  {
+    const U delta = static_cast<U>(_values[i] - prev);
+    prev = _values[i];
+    const U sign = static_cast<U>(0) - static_cast<U>(delta >> (kBits - 1));
+    const U zigzag = static_cast<U>(static_cast<U>(delta << 1) ^ sign);
+    for (size_t b = 0; b < sizeof(U); ++b)
+      _planes[b * _count + i] = static_cast<uint8_t>(zigzag >> (8 * b));
+  }
+}
+
+/// \brief Inverse of EncodePlanes.
+/// \tparam U Unsigned integer type as wide as the column.
+/// \param[in] _planes sizeof(U) planes of _count bytes each.
+/// \param[in] _count Number of values.
+/// \param[out] _values Column values.
+template<typename U>
+void DecodePlanes(const uint8_t *_planes, size_t _count, U *_values)
+{
+  U prev = 0;
+  for (size_t i = 0; i < _count; ++i)
+  {
+    U zigzag = 0;
+    for (size_t b = 0; b < sizeof(U); ++b)
+      zigzag |= static_cast<U>(_planes[b * _count + i]) << (8 * b);
+    const U delta = static_cast<U>(
+        (zigzag >> 1) ^ (static_cast<U>(0) - (zigzag & 1)));
+    prev = static_cast<U>(prev + delta);
+    _values[i] = prev;
+  }
+}
+
+/// \brief Quantize a floating point position component.
+/// \param[in] _value Value to quantize.
+/// \param[in] _scale Inverse of the precision.
+/// \return Quantized value, clamped to the int32 range.
+inline uint32_t Quantize(double _value, double _scale)
+{
+  if (!std::isfinite(_value))
+    return static_cast<uint32_t>(kQuantizedNaN);
+  const double limit = std::numeric_limits<int32_t>::max();
+  const double q = std::max(-limit, std::min(limit,
+      std::floor(_value * _scale + 0.5)));
+  return static_cast<uint32_t>(static_cast<int32_t>(q));
+}
+
+/// \brief Gather, transform and entropy code a single column.
+/// \param[in] _data Start of the cloud data.
+/// \param[in] _layout Layout of the cloud.
+/// \param[in] _column Column to encode.
+/// \param[in] _type Datatype of a quantized column.
+/// \param[in] _scale Inverse of the precision of a quantized column.
+/// \param[in, out] _values Scratch buffer.
+/// \param[in, out] _planes Scratch buffer.
+/// \param[in, out] _out Buffer to append the encoded column to.
+template<typename U>
+void EncodeColumn(const char *_data, const PointCloudPackedLayout &_layout,
+    const PointCloudPackedColumn &_column,
+    PointCloudPacked::Field::DataType _type, double _scale,
+    std::vector<uint64_t> &_values, std::vector<uint8_t> &_planes,
+    std::string &_out)
+{
+  const size_t count = _layout.rows * _layout.cols;
+  _values.resize((count * sizeof(U) + 7) / 8);
+  U *values = reinterpret_cast<U *>(_values.data());
+  const size_t offset = _column.offset;
+
+  if (!_column.quantized)
+  {
+    ForEachPoint(_data, _layout, [&](const char *_pt, size_t _i)
+    {
+      std::memcpy(&values[_i], _pt + offset, sizeof(U));
+    });
+  }
+  else if (_type == PointCloudPacked::Field::FLOAT32)
+  {
+    ForEachPoint(_data, _layout, [&](const char *_pt, size_t _i)
+    {
+      float v;
+      std::memcpy(&v, _pt + offset, sizeof(v));
+      values[_i] = static_cast<U>(Quantize(v, _scale));
+    });
+  }
+  else
+  {
+    ForEachPoint(_data, _layout, [&](const char *_pt, size_t _i)
+    {
+      double v;
+      std::memcpy(&v, _pt + offset, sizeof(v));
+      values[_i] = static_cast<U>(Quantize(v, _scale));
+    });
+  }
+
+  _planes.resize(count * sizeof(U));
+  EncodePlanes<U>(values, count, _planes.data());
+  for (size_t b = 0; b < sizeof(U); ++b)
+    EntropyCoder::Encode(_planes.data() + b * count, count, _out);
+}
+
+/// \brief Decode and scatter a single column.
+/// \param[in, out] _ptr Read position, advanced past the column.
+/// \param[in] _end End of the encoded buffer.
+/// \param[in, out] _data Start of the cloud data.
+/// \param[in] _layout Layout of the cloud.
+/// \param[in] _column Column to decode.
+/// \param[in] _type Datatype of a quantized column.
+/// \param[in] _precision Precision of a quantized column.
+/// \param[in, out] _values Scratch buffer.
+/// \param[in, out] _planes Scratch buffer.
+/// \return False if the encoded column is malformed.
+template<typename U>
+bool DecodeColumn(const char *&_ptr, const char *_end, char *_data,
+    const PointCloudPackedLayout &_layout,
+    const PointCloudPackedColumn &_column,
+    PointCloudPacked::Field::DataType _type, double _precision,
+    std::vector<uint64_t> &_values, std::vector<uint8_t> &_planes)
+{
+  const size_t count = _layout.rows * _layout.cols;
+  _planes.resize(count * sizeof(U));
+  for (size_t b = 0; b < sizeof(U); ++b)
+  {
+    if (!EntropyCoder::Decode(_ptr, _end, _planes.data() + b * count, count))
+      return false;
+  }
+
+  _values.resize((count * sizeof(U) + 7) / 8);
+  U *values = reinterpret_cast<U *>(_values.data());
+  DecodePlanes<U>(_planes.data(), count, values);
+
+  const size_t offset = _column.offset;
+  if (!_column.quantized)
+  {
+    ForEachPoint(_data, _layout, [&](char *_pt, size_t _i)
+    {
+      std::memcpy(_pt + offset, &values[_i], sizeof(U));
+    });
+    return true;
+  }
+
+  auto dequantize = [&](size_t _i)
+  {
+    const int32_t q = static_cast<int32_t>(values[_i]);
+    return q == kQuantizedNaN ? std::numeric_limits<double>::quiet_NaN() :
+        q * _precision;
+  };
+  if (_type == PointCloudPacked::Field::FLOAT32)
+  {
+    ForEachPoint(_data, _layout, [&](char *_pt, size_t _i)
+    {
+      const float v = static_cast<float>(dequantize(_i));
+      std::memcpy(_pt + offset, &v, sizeof(v));
+    });
+  }
+  else
+  {
+    ForEachPoint(_data, _layout, [&](char *_pt, size_t _i)
+    {
+      const double v = dequantize(_i);
+      std::memcpy(_pt + offset, &v, sizeof(v));
+    });
+  }
+  return true;
+}
+
+/// \brief Collect or restore the bytes of a cloud's data that don't belong
+/// to any point (row padding and trailing bytes).
+/// \param[in, out] _data Start of the cloud data.
+/// \param[in] _size Size of the cloud data.
+/// \param[in] _layout Layout of the cloud.
+/// \param[in] _func Callable taking (char *_start, size_t _size) for every
+/// gap.
+template<typename CharT, typename Func>
+void ForEachGap(CharT *_data, size_t _size,
+    const PointCloudPackedLayout &_layout, Func &&_func)
+{
+  size_t pos = 0;
+  const size_t rowBytes = _layout.cols * _layout.pointStep;
+  for (size_t row = 0; row < _layout.rows; ++row)
+  {
+    const size_t rowStart = row * _layout.rowStep;
+    if (rowStart > pos)
+      _func(_data + pos, rowStart - pos);
+    pos = rowStart + rowBytes;
+  }
+  if (_size > pos)
+    _func(_data + pos, _size - pos);
+}
+
+/// \brief Check that a data size agrees with the header of a cloud.
+/// Clouds with a row_step and a height must hold exactly row_step * height
+/// bytes, other clouds may hold any number of bytes.
+/// \param[in] _msg The cloud.
+/// \param[in] _size Size of the cloud data.
+/// \return True if the size matches the header.
+inline bool DataSizeMatchesHeader(const PointCloudPacked &_msg,
+    uint64_t _size)
+{
+  const uint64_t headerSize =
+      static_cast<uint64_t>(_msg.row_step()) * _msg.height();
+  return headerSize == 0 || _size == headerSize;
+}
+
+/// \brief Check the sizes declared by an encoded cloud before decoding it.
+/// Every stream must declare the size that the header implies and be long
+/// enough to hold it, which bounds the memory that the decoder allocates by
+/// the size of the input.
+/// \param[in] _msg Header of the cloud.
+/// \param[in] _dataSize Declared size of the cloud data.
+/// \param[in] _quantized True if x, y and z are quantized.
+/// \param[in] _ptr Start of the gap stream.
+/// \param[in] _end End of the encoded buffer.
+/// \return True if the streams can hold the declared data.
+inline bool EncodedSizesValid(const PointCloudPacked &_msg,
+    uint64_t _dataSize, bool _quantized, const char *_ptr, const char *_end)
+{
+  if (!DataSizeMatchesHeader(_msg, _dataSize) ||
+      _dataSize > std::numeric_limits<size_t>::max())
+  {
+    return false;
+  }
+
+  const PointCloudPackedLayout layout =
+      Layout(_msg, static_cast<size_t>(_dataSize));
+  const size_t count = layout.rows * layout.cols;
+  uint64_t size = 0;
+  if (!EntropyCoder::Skip(_ptr, _end, size) ||
+      size != _dataSize - count * layout.pointStep)
+  {
+    return false;
+  }
+  if (count == 0)
+    return true;
+
+  // Every column is at most 8 bytes wide and needs at least one stream of
+  // two bytes or more, which bounds the point step by the remaining input.
+  if (layout.pointStep / 8 > static_cast<size_t>(_end - _ptr) / 2)
+    return false;
+
+  for (const PointCloudPackedColumn &column :
+       PointCloudPackedColumns(_msg, _quantized))
+  {
+    const size_t planes = column.quantized ? sizeof(uint32_t) : column.size;
+    for (size_t b = 0; b < planes; ++b)
+    {
+      if (!EntropyCoder::Skip(_ptr, _end, size) || size != count)
+        return false;
+    }
+  }
+  return true;
+}
+
+/// \brief Shared implementation of the lossless and quantized encoders.
+/// \param[in] _msg The cloud.
+/// \param[in] _precision Position precision, or zero for lossless.
+/// \param[out] _blob Encoded cloud.
+/// \return False if the cloud can't be encoded.
+inline bool EncodePointCloudPackedImpl(const PointCloudPacked &_msg,
+    double _precision, std::string &_blob)
+{
+  if (!DataSizeMatchesHeader(_msg, _msg.data().size()))
+  {
+    std::cerr << "PointCloudPacked data size [" << _msg.data().size()
+              << "] doesn't match row_step * height.\n";
+    return false;
+  }
+
+  const bool quantize = _precision > 0.0;
+  PointCloudPacked::Field::DataType xyzType{PointCloudPacked::Field::FLOAT32};
+  if (quantize)
+  {
+    static const std::string kXyzNames[3] = {"x", "y", "z"};
+    size_t offsets[3];
+    if (!FindVectorFields(_msg, kXyzNames, offsets, xyzType))
+    {
+      std::cerr << "PointCloudPacked must have x, y and z fields of the same "
+                << "FLOAT32 or FLOAT64 datatype to be quantized.\n";
+      return false;
+    }
+  }
+
+  PointCloudPacked metadata(_msg);
+  metadata.clear_data();
+  std::string serializedMetadata;
+  if (!metadata.SerializeToString(&serializedMetadata))
+    return false;
+
+  _blob.clear();
+  _blob.append(kPointCloudPackedCodecMagic, 4);
+  _blob.push_back(static_cast<char>(kPointCloudPackedCodecVersion));
+  _blob.push_back(static_cast<char>(quantize ? 1 : 0));
+  WriteVarint(serializedMetadata.size(), _blob);
+  _blob.append(serializedMetadata);
+  WriteVarint(_msg.data().size(), _blob);
+  if (quantize)
+    WriteFixed(_precision, _blob);
+
+  const char *data = _msg.data().data();
+  const size_t size = _msg.data().size();
+  const PointCloudPackedLayout layout = Layout(_msg);
+
+  std::string gaps;
+  ForEachGap(data, size, layout, [&](const char *_start, size_t _size)
+  {
+    gaps.append(_start, _size);
+  });
+  EntropyCoder::Encode(reinterpret_cast<const uint8_t *>(gaps.data()),
+      gaps.size(), _blob);
+
+  if (layout.rows * layout.cols == 0)
+    return true;
+
+  const double scale = quantize ? 1.0 / _precision : 0.0;
+  std::vector<uint64_t> values;
+  std::vector<uint8_t> planes;
+  for (const PointCloudPackedColumn &column :
+       PointCloudPackedColumns(_msg, quantize))
+  {
+    if (column.quantized)
+    {
+      EncodeColumn<uint32_t>(data, layout, column, xyzType, scale, values,
+          planes, _blob);
+      continue;
+    }
+    switch (column.size)
+    {
+      case 1:
+        EncodeColumn<uint8_t>(data, layout, column, xyzType, scale, values,
+            planes, _blob);
+        break;
+      case 2:
+        EncodeColumn<uint16_t>(data, layout, column, xyzType, scale, values,
+            planes, _blob);
+        break;
+      case 4:
+        EncodeColumn<uint32_t>(data, layout, column, xyzType, scale, values,
+            planes, _blob);
+        break;
+      default:
+        EncodeColumn<uint64_t>(data, layout, column, xyzType, scale, values,
+            planes, _blob);
+        break;
+    }
+  }
+  return true;
+}
+}  // namespace detail
+
+/// \brief Losslessly compress a PointCloudPacked message.
+///
+/// The encoded blob holds a small header with the message fields, followed
+/// by the point data. Every field of the points is delta coded against the
+/// previous point, split into byte planes and entropy coded, which works
+/// well on clouds produced by sensors since neighboring points are similar.
+///
+/// \code{.cpp}
+/// std::string blob;
+/// gz::msgs::EncodePointCloudPacked(pcMsg, blob);
+/// gz::msgs::PointCloudPacked decoded;
+/// gz::msgs::DecodePointCloudPacked(blob, decoded);
+/// \endcode
+///
+/// \param[in] _msg The cloud to compress.
+/// \param[out] _blob The compressed cloud.
+/// \return True on success. False if the cloud has a row_step and a
+/// height but its data size isn't row_step * height.
+inline bool EncodePointCloudPacked(const PointCloudPacked &_msg,
+    std::string &_blob)
+{
+  return detail::EncodePointCloudPackedImpl(_msg, 0.0, _blob);
+}
+
+/// \brief Compress a PointCloudPacked message, quantizing the x, y and z
+/// fields to a given precision.
+///
+/// The x, y and z fields must share the same FLOAT32 or FLOAT64 datatype.
+/// They are rounded to the nearest multiple of _positionPrecision, which
+/// compresses much better than lossless encoding. Values that aren't finite
+/// are decoded as NaN. All other fields are compressed losslessly.
+///
+/// \param[in] _msg The cloud to compress.
+/// \param[in] _positionPrecision Quantization step of x, y and z, in the
+/// units of the cloud (usually meters). Must be positive.
+/// \param[out] _blob The compressed cloud.
+/// \return True on success. False if the precision isn't positive, the
+/// cloud doesn't have suitable x, y and z fields or its data size doesn't
+/// match row_step * height.
+inline bool EncodePointCloudPacked(const PointCloudPacked &_msg,
+    double _positionPrecision, std::string &_blob)
+{
+  if (!(_positionPrecision > 0.0) || !std::isfinite(_positionPrecision))
+  {
+    std::cerr << "PointCloudPacked position precision must be positive, got ["
+              << _positionPrecision << "].\n";
+    return false;
+  }
+  return detail::EncodePointCloudPackedImpl(_msg, _positionPrecision, _blob);
+}
+
+/// \brief Decompress a PointCloudPacked message compressed by
+/// EncodePointCloudPacked.
+/// \param[in] _blob The compressed cloud.
+/// \param[out] _msg The decompressed cloud.
+/// \return True on success. False if the blob is malformed.
+inline bool DecodePointCloudPacked(const std::string &_blob,
+    PointCloudPacked &_msg)
+{
+  const char *ptr = _blob.data();
+  const char *end = ptr + _blob.size();
+
+  if (_blob.size() < 6 ||
+      std::memcmp(ptr, detail::kPointCloudPackedCodecMagic, 4) != 0)
+  {
+    std::cerr << "Data is not an encoded PointCloudPacked.\n";
+    return false;
+  }
+  ptr += 4;
+  const uint8_t version = static_cast<uint8_t>(*ptr++);
+  const uint8_t mode = static_cast<uint8_t>(*ptr++);
+  if (version != detail::kPointCloudPackedCodecVersion)
+  {
+    std::cerr << "Unsupported encoded PointCloudPacked version ["
+              << static_cast<int>(version) << "].\n";
+    return false;
+  }
+  if (mode > 1)
+  {
+    std::cerr << "Unsupported encoded PointCloudPacked mode ["
+              << static_cast<int>(mode) << "].\n";
+    return false;
+  }
+  const bool quantized = mode == 1;
+
+  uint64_t metadataSize = 0;
+  uint64_t dataSize = 0;
+  double precision = 0.0;
+  if (!detail::ReadVarint(ptr, end, metadataSize) ||
+      static_cast<uint64_t>(end - ptr) < metadataSize ||
+      !_msg.ParseFromArray(ptr, static_cast<int>(metadataSize)))
+  {
+    std::cerr << "Encoded PointCloudPacked header is malformed.\n";
+    return false;
+  }
+  ptr += metadataSize;
+  if (!detail::ReadVarint(ptr, end, dataSize) ||
+      (quantized && !detail::ReadFixed(ptr, end, precision)))
+  {
+    std::cerr << "Encoded PointCloudPacked header is malformed.\n";
+    return false;
+  }
+
+  PointCloudPacked::Field::DataType xyzType{PointCloudPacked::Field::FLOAT32};
+  if (quantized)
+  {
+    static const std::string kXyzNames[3] = {"x", "y", "z"};
+    size_t offsets[3];
+    if (!detail::FindVectorFields(_msg, kXyzNames, offsets, xyzType))
+    {
+      std::cerr << "Encoded PointCloudPacked header is malformed.\n";
+      return false;
+    }
+  }
+
+  if (!detail::EncodedSizesValid(_msg, dataSize, quantized, ptr, end))
+  {
+    std::cerr << "Encoded PointCloudPacked is truncated or its sizes are "
+              << "inconsistent.\n";
+    return false;
+  }
+
+  _msg.mutable_data()->resize(dataSize);
+  char *data = dataSize > 0 ? &(*_msg.mutable_data())[0] : nullptr;
+  const detail::PointCloudPackedLayout layout = detail::Layout(_msg);
+
+  uint64_t gapSize = 0;
+  detail::EntropyCoder::PeekSize(ptr, end, gapSize);
+  std::string gaps(gapSize, '\0');
+  if (!detail::EntropyCoder::Decode(ptr, end,
+        reinterpret_cast<uint8_t *>(&gaps[0]), gaps.size()))
+  {
+    std::cerr << "Encoded PointCloudPacked is truncated.\n";
+    return false;
+  }
+  size_t gapPos = 0;
+  bool gapsValid = true;
+  detail::ForEachGap(data, dataSize, layout, [&](char *_start, size_t _size)
+  {
+    if (gapPos + _size > gaps.size())
+    {
+      gapsValid = false;
+      return;
+    }
+    std::memcpy(_start, gaps.data() + gapPos, _size);
+    gapPos += _size;
+  });
+  if (!gapsValid || gapPos != gaps.size())
+  {
+    std::cerr << "Encoded PointCloudPacked is malformed.\n";
+    return false;
+  }
+
+  if (layout.rows * layout.cols == 0)
+    return true;
+
+  std::vector<uint64_t> values;
+  std::vector<uint8_t> planes;
+  for (const detail::PointCloudPackedColumn &column :
+       detail::PointCloudPackedColumns(_msg, quantized))
+  {
+    bool ok = false;
+    if (column.quantized)
+    {
+      ok = detail::DecodeColumn<uint32_t>(ptr, end, data, layout, column,
+          xyzType, precision, values, planes);
+    }
+    else if (column.size == 1)
+    {
+      ok = detail::DecodeColumn<uint8_t>(ptr, end, data, layout, column,
+          xyzType, precision, values, planes);
+    }
+    else if (column.size == 2)
+    {
+      ok = detail::DecodeColumn<uint16_t>(ptr, end, data, layout, column,
+          xyzType, precision, values, planes);
+    }
+    else if (column.size == 4)
+    {
+      ok = detail::DecodeColumn<uint32_t>(ptr, end, data, layout, column,
+          xyzType, precision, values, planes);
+    }
+    else
+    {
+      ok = detail::DecodeColumn<uint64_t>(ptr, end, data, layout, column,
+          xyzType, precision, values, planes);
+    }
+
+    if (!ok)
+    {
+      std::cerr << "Encoded PointCloudPacked is truncated.\n";
+      return false;
+    }
+  }
+  return true;
+}
+}
+}
+
+#endif
@@ -0,0 +1,626 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_MSGS_POINTCLOUDPACKEDFILTERS_HH_
+#define GZ_MSGS_POINTCLOUDPACKEDFILTERS_HH_
+
+#include <gz/msgs/pointcloud_packed.pb.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Vector3.hh>
+
+#include "gz/msgs/config.hh"
+#include "gz/msgs/detail/ParallelFor.hh"
+#include "gz/msgs/detail/PointCloudPackedUtils.hh"
+
+namespace gz
+{
+namespace msgs
+{
+/// \brief How VoxelGridPointCloudPacked reduces the points that fall in
+/// the same voxel.
+enum class VoxelGridMode
+{
+  /// \brief Keep the first point of every voxel, unmodified.
+  FIRST_POINT,
+
+  /// \brief Keep the first point of every voxel, with its x, y and z
+  /// replaced by the centroid of all the points in the voxel.
+  CENTROID
+};
+
+namespace detail
+{
+/// \brief Read the x, y and z of a point as doubles.
+/// \param[in] _pt Start of the point.
+/// \param[in] _offsets Offsets of x, y and z.
+/// \param[in] _type Datatype of x, y and z.
+/// \param[out] _xyz The coordinates.
+inline void ReadXyz(const char *_pt, const size_t (&_offsets)[3],
+    PointCloudPacked::Field::DataType _type, double (&_xyz)[3])
+{
+  if (_type == PointCloudPacked::Field::FLOAT32)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      float v;
+      std::memcpy(&v, _pt + _offsets[i], sizeof(v));
+      _xyz[i] = v;
+    }
+  }
+  else
+  {
+    for (int i = 0; i < 3; ++i)
+      std::memcpy(&_xyz[i], _pt + _offsets[i], sizeof(double));
+  }
+}
+
+/// \brief Write the x, y and z of a point.
+/// \param[in] _pt Start of the point.
+/// \param[in] _offsets Offsets of x, y and z.
+/// \param[in] _type Datatype of x, y and z.
+/// \param[in] _xyz The coordinates.
+inline void WriteXyz(char *_pt, const size_t (&_offsets)[3],
+    PointCloudPacked::Field::DataType _type, const double (&_xyz)[3])
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    if (_type == PointCloudPacked::Field::FLOAT32)
+    {
+      const float v = static_cast<float>(_xyz[i]);
+      std::memcpy(_pt + _offsets[i], &v, sizeof(v));
+    }
+    else
+    {
+      std::memcpy(_pt + _offsets[i], &_xyz[i], sizeof(double));
+    }
+  }
+}
+
+/// \brief Copy the points of a cloud that satisfy a predicate to an
+/// unorganized cloud, keeping their order.
+///
+/// Points are tested in parallel, and the selected points are copied in
+/// parallel to their final position after a prefix sum of the number of
+/// points selected by every thread.
+/// \param[in] _src The source cloud.
+/// \param[in] _keep Callable taking (const char *_point, size_t _index) and
+/// returning true for points to keep.
+/// \param[in] _isDense Value of the is_dense flag of the destination cloud.
+/// \param[in] _threads Maximum number of threads, zero for all cores.
+/// \param[out] _dst The destination cloud.
+template<typename Pred>
+void FilterPoints(const PointCloudPacked &_src, Pred &&_keep, bool _isDense,
+    unsigned int _threads, PointCloudPacked &_dst)
+{
+  const PointCloudPackedLayout layout = Layout(_src);
+  const size_t count = layout.rows * layout.cols;
+  const char *data = _src.data().data();
+
+  std::vector<uint8_t> keep(count);
+  const unsigned int ranges = ParallelRanges(count, _threads);
+  std::vector<size_t> kept(ranges + 1, 0);
+  ParallelFor(count, ranges,
+      [&](size_t _begin, size_t _end, unsigned int _range)
+  {
+    size_t n = 0;
+    for (size_t i = _begin; i < _end; ++i)
+    {
+      keep[i] = _keep(PointAt(data, layout, i), i) ? 1 : 0;
+      n += keep[i];
+    }
+    kept[_range + 1] = n;
+  });
+  for (unsigned int r = 0; r < ranges; ++r)
+    kept[r + 1] += kept[r];
+
+  InitFilteredCloud(_src, kept[ranges], _isDense, _dst);
+  if (kept[ranges] == 0)
+    return;
+
+  char *out = &(*_dst.mutable_data())[0];
+  const size_t step = layout.pointStep;
+  ParallelFor(count, ranges,
+      [&](size_t _begin, size_t _end, unsigned int _range)
+  {
+    char *dst = out + kept[_range] * step;
+    for (size_t i = _begin; i < _end; ++i)
+    {
+      if (keep[i])
+      {
+        std::memcpy(dst, PointAt(data, layout, i), step);
+        dst += step;
+      }
+    }
+  });
+}
+
+/// \brief Open addressing hash map from voxel keys to dense voxel ids.
+class VoxelMap
+{
+  /// \brief Key of empty slots.
+  public: static constexpr uint64_t kEmpty =
+      std::numeric_limits<uint64_t>::max();
+
+  /// \brief Constructor.
+  public: VoxelMap()
+  {
+    this->Rehash(1024);
+  }
+
+  /// \brief Find the id of a voxel, inserting it if it's new.
+  /// \param[in] _key The voxel key.
+  /// \param[in] _hash Mixed hash of the key.
+  /// \param[out] _inserted True if the voxel is new.
+  /// \return Id of the voxel. Ids are assigned in order of insertion.
+  public: size_t Insert(uint64_t _key, uint64_t _hash, bool &_inserted)
+  {
+    if ((this->size + 1) * 2 > this->keys.size())
+      this->Rehash(this->keys.size() * 2);
+
+    size_t slot = _hash & this->mask;
+    while (true)
+    {
+      if (this->keys[slot] == _key)
+      {
+        _inserted = false;
+        return this->ids[slot];
+      }
+      if (this->keys[slot] == kEmpty)
+      {
+        this->keys[slot] = _key;
+        this->ids[slot] = this->size;
+        _inserted = true;
+        return this->size++;
+      }
+      slot = (slot + 1) & this->mask;
+    }
+  }
+
+  /// \brief Mix the bits of a key so that neighboring voxels spread over
+  /// the table (splitmix64 finalizer).
+  /// \param[in] _key The voxel key.
+  /// \return The hash.
+  public: static uint64_t Hash(uint64_t _key)
+  {
+    _key ^= _key >> 30;
+    _key *= 0xbf58476d1ce4e5b9ULL;
+    _key ^= _key >> 27;
+    _key *= 0x94d049bb133111ebULL;
+    _key ^= _key >> 31;
+    return _key;
+  }
+
+  /// \brief Grow the table.
+  /// \param[in] _capacity New number of slots, a power of two.
+  private: void Rehash(size_t _capacity)
+  {
+    std::vector<uint64_t> oldKeys(_capacity, kEmpty);
+    std::vector<size_t> oldIds(_capacity, 0);
+    oldKeys.swap(this->keys);
+    oldIds.swap(this->ids);
+    this->mask = _capacity - 1;
+    for (size_t i = 0; i < oldKeys.size(); ++i)
+    {
+      if (oldKeys[i] == kEmpty)
+        continue;
+      size_t slot = Hash(oldKeys[i]) & this->mask;
+      while (this->keys[slot] != kEmpty)
+        slot = (slot + 1) & this->mask;
+      this->keys[slot] = oldKeys[i];
+      this->ids[slot] = oldIds[i];
+    }
+  }
+
+  /// \brief Keys of every slot.
+  private: std::vector<uint64_t> keys;
+
+  /// \brief Voxel id of every slot.
+  private: std::vector<size_t> ids;
+
+  /// \brief Slot index mask.
+  private: size_t mask{0};
+
+  /// \brief Number of voxels.
+  private: size_t size{0};
+};
+}  // namespace detail
+
+/// \brief Keep the points of a cloud that lie inside an axis aligned box.
+///
+/// All fields of the points inside the box (bounds included) are copied to
+/// an unorganized destination cloud, in their original order. Points with
+/// a NaN coordinate are never inside the box, so the destination cloud is
+/// dense.
+/// \param[in] _src The cloud to filter. x, y and z must share the same
+/// FLOAT32 or FLOAT64 datatype.
+/// \param[in] _box The box, e.g. converted from a msgs::AxisAlignedBox.
+/// \param[out] _dst The filtered cloud. Must not be _src.
+/// \param[in] _threads Maximum number of threads, zero for all cores.
+/// \return True on success. False if the cloud doesn't have suitable x, y
+/// and z fields.
+inline bool CropBoxPointCloudPacked(const PointCloudPacked &_src,
+    const math::AxisAlignedBox &_box, PointCloudPacked &_dst,
+    unsigned int _threads = 0)
+{
+  if (&_src == &_dst)
+  {
+    std::cerr << "Source and destination clouds must differ.\n";
+    return false;
+  }
+
+  static const std::string kXyzNames[3] = {"x", "y", "z"};
+  size_t offsets[3];
+  PointCloudPacked::Field::DataType type{PointCloudPacked::Field::FLOAT32};
+  if (!detail::FindVectorFields(_src, kXyzNames, offsets, type))
+  {
+    std::cerr << "PointCloudPacked must have x, y and z fields of the same "
+              << "FLOAT32 or FLOAT64 datatype to be cropped.\n";
+    return false;
+  }
+
+  const double min[3] = {_box.Min().X(), _box.Min().Y(), _box.Min().Z()};
+  const double max[3] = {_box.Max().X(), _box.Max().Y(), _box.Max().Z()};
+  detail::FilterPoints(_src, [&](const char *_pt, size_t)
+  {
+    double xyz[3];
+    detail::ReadXyz(_pt, offsets, type, xyz);
+    return xyz[0] >= min[0] && xyz[0] <= max[0] &&
+           xyz[1] >= min[1] && xyz[1] <= max[1] &&
+           xyz[2] >= min[2] && xyz[2] <= max[2];
+  }, true, _threads, _dst);
+  return true;
+}
+
+/// \brief Keep one point out of every _stride points of a cloud.
+///
+/// Organized clouds are decimated along both rows and columns, so the
+/// destination cloud stays organized with ceil(height / _stride) rows of
+/// ceil(width / _stride) points. Other clouds keep every _stride-th point.
+/// \param[in] _src The cloud to decimate.
+/// \param[in] _stride Decimation factor, at least 1.
+/// \param[out] _dst The decimated cloud. Must not be _src.
+/// \param[in] _threads Maximum number of threads, zero for all cores.
+/// \return True on success. False if _stride is zero.
+inline bool DecimatePointCloudPacked(const PointCloudPacked &_src,
+    unsigned int _stride, PointCloudPacked &_dst, unsigned int _threads = 0)
+{
+  if (&_src == &_dst)
+  {
+    std::cerr << "Source and destination clouds must differ.\n";
+    return false;
+  }
+  if (_stride == 0)
+  {
+    std::cerr << "PointCloudPacked decimation stride must be positive.\n";
+    return false;
+  }
+
+  const detail::PointCloudPackedLayout layout = detail::Layout(_src);
+  if (layout.rows <= 1)
+  {
+    detail::FilterPoints(_src, [&](const char *, size_t _index)
+    {
+      return _index % _stride == 0;
+    }, _src.is_dense(), _threads, _dst);
+    return true;
+  }
+
+  const size_t rows = (layout.rows + _stride - 1) / _stride;
+  const size_t cols = (layout.cols + _stride - 1) / _stride;
+  detail::InitFilteredCloud(_src, rows * cols, _src.is_dense(), _dst);
+  _dst.set_height(static_cast<uint32_t>(rows));
+  _dst.set_width(static_cast<uint32_t>(cols));
+  _dst.set_row_step(static_cast<uint32_t>(cols * layout.pointStep));
+
+  const char *data = _src.data().data();
+  char *out = &(*_dst.mutable_data())[0];
+  detail::ParallelFor(rows, detail::ParallelRanges(rows * cols, _threads),
+      [&](size_t _begin, size_t _end, unsigned int)
+  {
+    for (size_t row = _begin; row < _end; ++row)
+    {
+      const char *src = data + row * _stride * layout.rowStep;
+      char *dst = out + row * cols * layout.pointStep;
+      for (size_t col = 0; col < cols; ++col, dst += layout.pointStep)
+      {
+        std::memcpy(dst, src + col * _stride * layout.pointStep,
+            layout.pointStep);
+      }
+    }
+  });
+  return true;
+}
+
+/// \brief Downsample a cloud by keeping a single point per voxel of a
+/// regular grid.
+///
+/// All fields of the first point that falls in every voxel are copied to
+/// an unorganized destination cloud, ordered by the position of that first
+/// point in the source cloud. In CENTROID mode, its x, y and z are then
+/// replaced by the centroid of all the points in the voxel. Points with a
+/// NaN or infinite coordinate are dropped, so the destination is dense.
+///
+/// Voxel edges lie at integer multiples of the leaf size, so a point falls
+/// in the same voxel whatever the extent of the rest of the cloud.
+///
+/// Voxel keys are computed in parallel, and voxels are grouped with one
+/// hash map per thread, every thread owning a disjoint subset of the keys.
+/// \param[in] _src The cloud to downsample. x, y and z must share the same
+/// FLOAT32 or FLOAT64 datatype.
+/// \param[in] _leafSize Size of a voxel along every axis. All components
+/// must be positive.
+/// \param[in] _mode How the points of a voxel are reduced.
+/// \param[out] _dst The downsampled cloud. Must not be _src.
+/// \param[in] _threads Maximum number of threads, zero for all cores.
+/// \return True on success. False if the cloud doesn't have suitable x, y
+/// and z fields, or the leaf size is too small for the extent of the cloud.
+inline bool VoxelGridPointCloudPacked(const PointCloudPacked &_src,
+    const math::Vector3d &_leafSize, VoxelGridMode _mode,
+    PointCloudPacked &_dst, unsigned int _threads = 0)
+{
+  if (&_src == &_dst)
+  {
+    std::cerr << "Source and destination clouds must differ.\n";
+    return false;
+  }
+
+  static const std::string kXyzNames[3] = {"x", "y", "z"};
+  size_t offsets[3];
+  PointCloudPacked::Field::DataType type{PointCloudPacked::Field::FLOAT32};
+  if (!detail::FindVectorFields(_src, kXyzNames, offsets, type))
+  {
+    std::cerr << "PointCloudPacked must have x, y and z fields of the same "
+              << "FLOAT32 or FLOAT64 datatype to be downsampled.\n";
+    return false;
+  }
+  const double leaf[3] = {_leafSize.X(), _leafSize.Y(), _leafSize.Z()};
+  if (!(leaf[0] > 0 && leaf[1] > 0 && leaf[2] > 0))
+  {
+    std::cerr << "Voxel grid leaf size must be positive, got ["
+              << _leafSize << "].\n";
+    return false;
+  }
+
+  const detail::PointCloudPackedLayout layout = detail::Layout(_src);
+  const size_t count = layout.rows * layout.cols;
+  const char *data = _src.data().data();
+  const unsigned int ranges = detail::ParallelRanges(count, _threads);
+
+  // Bounds of the finite points.
+  const double inf = std::numeric_limits<double>::infinity();
+  std::vector<double> rangeMin(ranges * 3, inf);
+  std::vector<double> rangeMax(ranges * 3, -inf);
+  detail::ParallelFor(count, ranges,
+      [&](size_t _begin, size_t _end, unsigned int _range)
+  {
+    double *min = &rangeMin[_range * 3];
+    double *max = &rangeMax[_range * 3];
+    for (size_t i = _begin; i < _end; ++i)
+    {
+      double xyz[3];
+      detail::ReadXyz(detail::PointAt(data, layout, i), offsets, type, xyz);
+      if (!std::isfinite(xyz[0] + xyz[1] + xyz[2]))
+        continue;
+      for (int a = 0; a < 3; ++a)
+      {
+        min[a] = std::min(min[a], xyz[a]);
+        max[a] = std::max(max[a], xyz[a]);
+      }
+    }
+  });
+  // Index of the first voxel of the grid along every axis.
+  double origin[3] = {0, 0, 0};
+  double dims[3] = {1, 1, 1};
+  for (int a = 0; a < 3; ++a)
+  {
+    double min = inf;
+    double max = -inf;
+    for (unsigned int r = 0; r < ranges; ++r)
+    {
+      min = std::min(min, rangeMin[r * 3 + a]);
+      max = std::max(max, rangeMax[r * 3 + a]);
+    }
+    if (!std::isfinite(min))
+      break;
+    origin[a] = std::floor(min / leaf[a]);
+    dims[a] = std::floor(max / leaf[a]) - origin[a] + 1;
+  }
+  if (dims[0] * dims[1] * dims[2] >= 9.0e18)
+  {
+    std::cerr << "Voxel grid leaf size [" << _leafSize
+              << "] is too small for the extent of the cloud.\n";
+    return false;
+  }
+  const uint64_t nx = static_cast<uint64_t>(dims[0]);
+  const uint64_t nxy = nx * static_cast<uint64_t>(dims[1]);
+
+  // Linear voxel index of every point, and number of points of every
+  // range that fall in the voxels of every shard.
+  auto shardOf = [ranges](uint64_t _hash)
+  {
+    return static_cast<size_t>((_hash >> 40) % ranges);
+  };
+  std::vector<uint64_t> keys(count);
+  std::vector<size_t> shardCounts(ranges * ranges, 0);
+  detail::ParallelFor(count, ranges,
+      [&](size_t _begin, size_t _end, unsigned int _range)
+  {
+    size_t *counts = &shardCounts[_range * ranges];
+    for (size_t i = _begin; i < _end; ++i)
+    {
+      double xyz[3];
+      detail::ReadXyz(detail::PointAt(data, layout, i), offsets, type, xyz);
+      if (!std::isfinite(xyz[0] + xyz[1] + xyz[2]))
+      {
+        keys[i] = detail::VoxelMap::kEmpty;
+        continue;
+      }
+      uint64_t ijk[3];
+      for (int a = 0; a < 3; ++a)
+      {
+        const double index = std::floor(xyz[a] / leaf[a]) - origin[a];
+        ijk[a] = std::min(static_cast<uint64_t>(dims[a]) - 1,
+            static_cast<uint64_t>(std::max(0.0, index)));
+      }
+      keys[i] = ijk[0] + ijk[1] * nx + ijk[2] * nxy;
+      if (ranges > 1)
+        ++counts[shardOf(detail::VoxelMap::Hash(keys[i]))];
+    }
+  });
+
+  // Partition the points by shard, keeping their order within a shard, so
+  // that every thread only visits the points of the voxels it owns.
+  std::vector<size_t> shardBegin(ranges + 1, 0);
+  std::vector<size_t> order;
+  if (ranges > 1)
+  {
+    size_t pos = 0;
+    for (unsigned int s = 0; s < ranges; ++s)
+    {
+      shardBegin[s] = pos;
+      for (unsigned int r = 0; r < ranges; ++r)
+      {
+        const size_t n = shardCounts[r * ranges + s];
+        shardCounts[r * ranges + s] = pos;
+        pos += n;
+      }
+    }
+    shardBegin[ranges] = pos;
+    order.resize(pos);
+    detail::ParallelFor(count, ranges,
+        [&](size_t _begin, size_t _end, unsigned int _range)
+    {
+      size_t *next = &shardCounts[_range * ranges];
+      for (size_t i = _begin; i < _end; ++i)
+      {
+        if (keys[i] != detail::VoxelMap::kEmpty)
+          order[next[shardOf(detail::VoxelMap::Hash(keys[i]))]++] = i;
+      }
+    });
+  }
+  else
+  {
+    shardBegin[1] = count;
+  }
+
+  // Group points by voxel. Every thread owns the voxels of its shard, so
+  // no locking is needed.
+  struct Shard
+  {
+    detail::VoxelMap map;
+    std::vector<size_t> first;
+    std::vector<double> sums;
+    std::vector<size_t> counts;
+  };
+  std::vector<Shard> shards(ranges);
+  const bool centroid = _mode == VoxelGridMode::CENTROID;
+  detail::ParallelFor(ranges, ranges,
+      [&](size_t _begin, size_t _end, unsigned int)
+  {
+    for (size_t s = _begin; s < _end; ++s)
+    {
+      Shard &shard = shards[s];
+      for (size_t j = shardBegin[s]; j < shardBegin[s + 1]; ++j)
+      {
+        const size_t i = order.empty() ? j : order[j];
+        const uint64_t key = keys[i];
+        if (key == detail::VoxelMap::kEmpty)
+          continue;
+        const uint64_t hash = detail::VoxelMap::Hash(key);
+
+        bool inserted = false;
+        const size_t id = shard.map.Insert(key, hash, inserted);
+        if (inserted)
+        {
+          shard.first.push_back(i);
+          if (centroid)
+          {
+            shard.sums.resize(shard.sums.size() + 3, 0.0);
+            shard.counts.push_back(0);
+          }
+        }
+        if (centroid)
+        {
+          double xyz[3];
+          detail::ReadXyz(detail::PointAt(data, layout, i), offsets, type,
+              xyz);
+          shard.sums[id * 3] += xyz[0];
+          shard.sums[id * 3 + 1] += xyz[1];
+          shard.sums[id * 3 + 2] += xyz[2];
+          ++shard.counts[id];
+        }
+      }
+    }
+  });
+
+  // Order voxels by their first point so the output is deterministic.
+  struct Voxel
+  {
+    size_t first;
+    size_t shard;
+    size_t id;
+  };
+  std::vector<Voxel> voxels;
+  for (size_t s = 0; s < shards.size(); ++s)
+  {
+    for (size_t id = 0; id < shards[s].first.size(); ++id)
+      voxels.push_back({shards[s].first[id], s, id});
+  }
+  std::sort(voxels.begin(), voxels.end(),
+      [](const Voxel &_a, const Voxel &_b) { return _a.first < _b.first; });
+
+  detail::InitFilteredCloud(_src, voxels.size(), true, _dst);
+  if (voxels.empty())
+    return true;
+
+  char *out = &(*_dst.mutable_data())[0];
+  const size_t step = layout.pointStep;
+  detail::ParallelFor(voxels.size(),
+      detail::ParallelRanges(voxels.size(), _threads),
+      [&](size_t _begin, size_t _end, unsigned int)
+  {
+    for (size_t v = _begin; v < _end; ++v)
+    {
+      char *dst = out + v * step;
+      std::memcpy(dst, detail::PointAt(data, layout, voxels[v].first), step);
+      if (!centroid)
+        continue;
+
+      const Shard &shard = shards[voxels[v].shard];
+      const size_t id = voxels[v].id;
+      const double n = static_cast<double>(shard.counts[id]);
+      const double xyz[3] = {shard.sums[id * 3] / n,
+          shard.sums[id * 3 + 1] / n, shard.sums[id * 3 + 2] / n};
+      detail::WriteXyz(dst, offsets, type, xyz);
+    }
+  });
+  return true;
+}
+}
+}
+
+#endif
@@ -0,0 +1,425 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_MSGS_POINTCLOUDPACKEDSLICE_HH_
+#define GZ_MSGS_POINTCLOUDPACKEDSLICE_HH_
+
+#include <gz/msgs/pointcloud_packed.pb.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gz/msgs/config.hh"
+#include "gz/msgs/PointCloudPackedView.hh"
+#include "gz/msgs/detail/PointCloudPackedUtils.hh"
+
+namespace gz
+{
+namespace msgs
+{
+/// \brief A non-owning selection of the points of a PointCloudPacked
+/// message, either a band of rows or a list of point indices.
+///
+/// The slice references the data of the cloud, which must outlive it and
+/// must not be resized while the slice is used. Points are read through
+/// PointCloudPackedSliceIterator, or through a PointCloudPackedConstView for
+/// bands of rows, and copied to a new message only by Materialize().
+///
+/// E.g, to select the points of a segmentation label:
+///
+/// \code{.cpp}
+/// std::vector<uint32_t> indices;
+/// gz::msgs::PointCloudPackedConstIterator<uint32_t> label(pcMsg, "label");
+/// for (uint32_t i = 0; label != label.End(); ++label, ++i)
+///   if (*label == 7)
+///     indices.push_back(i);
+/// gz::msgs::PointCloudPackedSlice slice(pcMsg, std::move(indices));
+/// \endcode
+class PointCloudPackedSlice
+{
+  /// \brief Select a band of rows of an organized cloud. Unorganized clouds
+  /// have a single row.
+  /// \param[in] _cloud The cloud.
+  /// \param[in] _rowBegin First row.
+  /// \param[in] _rowEnd One past the last row.
+  public: PointCloudPackedSlice(const PointCloudPacked &_cloud,
+      size_t _rowBegin, size_t _rowEnd);
+
+  /// \brief Select points by index.
+  /// \param[in] _cloud The cloud.
+  /// \param[in] _indices Row major indices of the points, in the order they
+  /// are visited. Indices may repeat.
+  public: PointCloudPackedSlice(const PointCloudPacked &_cloud,
+      std::vector<uint32_t> _indices);
+
+  /// \brief Whether the rows or indices are within the cloud.
+  /// \return True if the slice can be used.
+  public: bool Valid() const;
+
+  /// \brief Whether the slice is a band of rows.
+  /// \return True for a band of rows, false for a list of indices.
+  public: bool IsRowRange() const;
+
+  /// \brief Number of points in the slice.
+  /// \return The number of points.
+  public: size_t Size() const;
+
+  /// \brief Index of a point of the slice in the cloud.
+  /// \param[in] _i Position of the point in the slice, less than Size().
+  /// \return Row major index of the point in the cloud.
+  public: size_t Index(size_t _i) const;
+
+  /// \brief Data of a point of the slice.
+  /// \param[in] _i Position of the point in the slice, less than Size().
+  /// \return Pointer to the first byte of the point.
+  public: const char *Point(size_t _i) const;
+
+  /// \brief The cloud the slice selects points of.
+  /// \return The cloud.
+  public: const PointCloudPacked &Cloud() const;
+
+  /// \brief Two dimensional view of a field over a band of rows.
+  /// \param[in] _fieldName The field.
+  /// \return The view, which is not valid if the slice is not a band of
+  /// rows.
+  public: template<typename FieldType>
+  PointCloudPackedConstView<FieldType> View(
+      const std::string &_fieldName) const;
+
+  /// \brief Copy the selected points to a new message. A band of rows of an
+  /// organized cloud stays organized, without row padding. Points selected
+  /// by index form an unorganized cloud.
+  /// \param[out] _dst The new message. Must not be the sliced cloud.
+  /// \return False if the slice is not valid.
+  public: bool Materialize(PointCloudPacked &_dst) const;
+
+  /// \brief The cloud.
+  private: const PointCloudPacked *cloud{nullptr};
+
+  /// \brief Layout of the cloud.
+  private: detail::PointCloudPackedLayout layout;
+
+  /// \brief First row of a band of rows.
+  private: size_t rowBegin{0};
+
+  /// \brief One past the last row of a band of rows.
+  private: size_t rowEnd{0};
+
+  /// \brief Selected indices, when not a band of rows.
+  private: std::vector<uint32_t> indices;
+
+  /// \brief Whether the slice is a band of rows.
+  private: bool rowRange{true};
+
+  /// \brief Whether the slice is within the cloud.
+  private: bool valid{false};
+};
+
+/// \brief Iterates over a field of the points of a PointCloudPackedSlice,
+/// with the same interface as PointCloudPackedConstIterator.
+///
+/// \code{.cpp}
+/// gz::msgs::PointCloudPackedSliceIterator<float> x(slice, "x");
+/// for (; x != x.End(); ++x)
+///   sum += *x;
+/// \endcode
+///
+/// \tparam FieldType Type of the element being iterated upon.
+template<typename FieldType>
+class PointCloudPackedSliceIterator
+{
+  /// \param[in] _slice The slice. Must outlive the iterator.
+  /// \param[in] _fieldName The field to iterate upon.
+  public: PointCloudPackedSliceIterator(const PointCloudPackedSlice &_slice,
+      const std::string &_fieldName);
+
+  /// \brief Access an element of the field of the current point.
+  /// \param[in] _i Index of the element.
+  /// \return Reference to the element.
+  public: const FieldType &operator[](size_t _i) const;
+
+  /// \brief Dereference the iterator.
+  /// \return Reference to the field of the current point.
+  public: const FieldType &operator*() const;
+
+  /// \brief Move to the next point.
+  /// \return Reference to this iterator.
+  public: PointCloudPackedSliceIterator &operator++();
+
+  /// \brief Iterator a number of points ahead.
+  /// \param[in] _i Number of points.
+  /// \return The new iterator.
+  public: PointCloudPackedSliceIterator operator+(int _i) const;
+
+  /// \brief Move a number of points ahead.
+  /// \param[in] _i Number of points.
+  /// \return Reference to this iterator.
+  public: PointCloudPackedSliceIterator &operator+=(int _i);
+
+  /// \brief Compare two iterators.
+  /// \param[in] _iter The other iterator.
+  /// \return True if the iterators point at different points.
+  public: bool operator!=(const PointCloudPackedSliceIterator &_iter) const;
+
+  /// \brief Compare two iterators.
+  /// \param[in] _iter The other iterator.
+  /// \return True if the iterators point at the same point.
+  public: bool operator==(const PointCloudPackedSliceIterator &_iter) const;
+
+  /// \brief Iterator past the last point of the slice.
+  /// \return The end iterator.
+  public: PointCloudPackedSliceIterator End() const;
+
+  /// \brief The slice.
+  private: const PointCloudPackedSlice *slice{nullptr};
+
+  /// \brief Offset of the field in a point.
+  private: size_t offset{0};
+
+  /// \brief Position of the current point in the slice.
+  private: size_t index{0};
+};
+
+//////////////////////////////////////////////////
+inline PointCloudPackedSlice::PointCloudPackedSlice(
+    const PointCloudPacked &_cloud, size_t _rowBegin, size_t _rowEnd)
+  : cloud(&_cloud), layout(detail::Layout(_cloud)), rowBegin(_rowBegin),
+    rowEnd(_rowEnd), rowRange(true)
+{
+  this->valid = _rowBegin <= _rowEnd && _rowEnd <= this->layout.rows;
+  if (!this->valid)
+  {
+    std::cerr << "Rows [" << _rowBegin << ", " << _rowEnd
+              << ") are out of the cloud.\n";
+  }
+}
+
+//////////////////////////////////////////////////
+inline PointCloudPackedSlice::PointCloudPackedSlice(
+    const PointCloudPacked &_cloud, std::vector<uint32_t> _indices)
+  : cloud(&_cloud), layout(detail::Layout(_cloud)),
+    indices(std::move(_indices)), rowRange(false)
+{
+  const size_t points = this->layout.rows * this->layout.cols;
+  this->valid = true;
+  for (uint32_t i : this->indices)
+  {
+    if (i >= points)
+    {
+      std::cerr << "Point index [" << i << "] is out of the cloud.\n";
+      this->valid = false;
+      break;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+inline bool PointCloudPackedSlice::Valid() const
+{
+  return this->valid;
+}
+
+//////////////////////////////////////////////////
+inline bool PointCloudPackedSlice::IsRowRange() const
+{
+  return this->rowRange;
+}
+
+//////////////////////////////////////////////////
+inline size_t PointCloudPackedSlice::Size() const
+{
+  if (!this->valid)
+    return 0;
+  if (this->rowRange)
+    return (this->rowEnd - this->rowBegin) * this->layout.cols;
+  return this->indices.size();
+}
+
+//////////////////////////////////////////////////
+inline size_t PointCloudPackedSlice::Index(size_t _i) const
+{
+  if (this->rowRange)
+    return this->rowBegin * this->layout.cols + _i;
+  return this->indices[_i];
+}
+
+//////////////////////////////////////////////////
+inline const char *PointCloudPackedSlice::Point(size_t _i) const
+{
+  return detail::PointAt(this->cloud->data().data(), this->layout,
+      this->Index(_i));
+}
+
+//////////////////////////////////////////////////
+inline const PointCloudPacked &PointCloudPackedSlice::Cloud() const
+{
+  return *this->cloud;
+}
+
+//////////////////////////////////////////////////
+template<typename FieldType>
+PointCloudPackedConstView<FieldType> PointCloudPackedSlice::View(
+    const std::string &_fieldName) const
+{
+  PointCloudPackedConstView<FieldType> view(*this->cloud, _fieldName);
+  if (!this->valid || !this->rowRange)
+    view.ClipRows(0, 0);
+  else
+    view.ClipRows(this->rowBegin, this->rowEnd);
+  return view;
+}
+
+//////////////////////////////////////////////////
+inline bool PointCloudPackedSlice::Materialize(PointCloudPacked &_dst) const
+{
+  if (!this->valid)
+  {
+    std::cerr << "Unable to materialize an invalid slice.\n";
+    return false;
+  }
+  if (&_dst == this->cloud)
+  {
+    std::cerr << "Unable to materialize a slice into its own cloud.\n";
+    return false;
+  }
+
+  const size_t points = this->Size();
+  const size_t pointStep = this->layout.pointStep;
+  detail::InitFilteredCloud(*this->cloud, points, this->cloud->is_dense(),
+      _dst);
+  if (points == 0)
+    return true;
+
+  const char *src = this->cloud->data().data();
+  char *dst = &(*_dst.mutable_data())[0];
+  if (!this->rowRange)
+  {
+    detail::GatherPoints(src, this->layout, this->indices.data(), points,
+        dst);
+    return true;
+  }
+
+  const size_t rowBytes = this->layout.cols * pointStep;
+  for (size_t row = this->rowBegin; row < this->rowEnd; ++row)
+  {
+    std::memcpy(dst, src + row * this->layout.rowStep, rowBytes);
+    dst += rowBytes;
+  }
+  if (this->cloud->height() > 1)
+  {
+    _dst.set_height(static_cast<uint32_t>(this->rowEnd - this->rowBegin));
+    _dst.set_width(static_cast<uint32_t>(this->layout.cols));
+    _dst.set_row_step(static_cast<uint32_t>(rowBytes));
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+template<typename FieldType>
+PointCloudPackedSliceIterator<FieldType>::PointCloudPackedSliceIterator(
+    const PointCloudPackedSlice &_slice, const std::string &_fieldName)
+  : slice(&_slice)
+{
+  const PointCloudPacked::Field *field =
+      detail::FindField(_slice.Cloud(), _fieldName);
+  if (nullptr == field)
+  {
+    std::cerr << "Field [" << _fieldName << "] does not exist.\n";
+    this->index = _slice.Size();
+    return;
+  }
+  this->offset = field->offset();
+}
+
+//////////////////////////////////////////////////
+template<typename FieldType>
+const FieldType &PointCloudPackedSliceIterator<FieldType>::operator[](
+    size_t _i) const
+{
+  return *(&**this + _i);
+}
+
+//////////////////////////////////////////////////
+template<typename FieldType>
+const FieldType &PointCloudPackedSliceIterator<FieldType>::operator*() const
+{
+  return *reinterpret_cast<const FieldType *>(
+      this->slice->Point(this->index) + this->offset);
+}
+
+//////////////////////////////////////////////////
+template<typename FieldType>
+PointCloudPackedSliceIterator<FieldType> &
+PointCloudPackedSliceIterator<FieldType>::operator++()
+{
+  ++this->index;
+  return *this;
+}
+
+//////////////////////////////////////////////////
+template<typename FieldType>
+PointCloudPackedSliceIterator<FieldType>
+PointCloudPackedSliceIterator<FieldType>::operator+(int _i) const
+{
+  PointCloudPackedSliceIterator<FieldType> res = *this;
+  res.index += _i;
+  return res;
+}
+
+//////////////////////////////////////////////////
+template<typename FieldType>
+PointCloudPackedSliceIterator<FieldType> &
+PointCloudPackedSliceIterator<FieldType>::operator+=(int _i)
+{
+  this->index += _i;
+  return *this;
+}
+
+//////////////////////////////////////////////////
+template<typename FieldType>
+bool PointCloudPackedSliceIterator<FieldType>::operator!=(
+    const PointCloudPackedSliceIterator<FieldType> &_iter) const
+{
+  return this->index != _iter.index;
+}
+
+//////////////////////////////////////////////////
+template<typename FieldType>
+bool PointCloudPackedSliceIterator<FieldType>::operator==(
+    const PointCloudPackedSliceIterator<FieldType> &_iter) const
+{
+  return this->index == _iter.index;
+}
+
+//////////////////////////////////////////////////
+template<typename FieldType>
+PointCloudPackedSliceIterator<FieldType>
+PointCloudPackedSliceIterator<FieldType>::End() const
+{
+  PointCloudPackedSliceIterator<FieldType> res = *this;
+  res.index = this->slice->Size();
+  return res;
+}
+}
+}
+
+#endif
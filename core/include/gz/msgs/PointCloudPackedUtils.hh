@@ -23,8 +23,10 @@
 
 #include <gz/msgs/pointcloud_packed.pb.h>
 
+#include <algorithm>
 #include <cstdarg>
 #include <functional>
+#include <map>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -33,6 +35,8 @@
 #include "gz/msgs/config.hh"
 #include "gz/msgs/detail/PointCloudPackedUtils.hh"
 #include <gz/math/Helpers.hh>
+#include <gz/math/Matrix3.hh>
+#include <gz/math/Pose3.hh>
 
 namespace gz
 {
@@ -216,6 +220,274 @@ inline int sizeOfPointField(
   }
   return -1;
 }
+
+/// \brief Apply a rigid transform in place to the x, y and z fields of
+/// every point in a PointCloudPacked message.
+///
+/// The x, y and z fields must share the same datatype, which must be either
+/// FLOAT32 or FLOAT64. Any point_step is supported, and the row_step
+/// padding of organized clouds is skipped. Optionally, the normal_x,
+/// normal_y and normal_z fields are rotated as well.
+///
+/// E.g, to move a cloud from the sensor frame to the world frame:
+///
+/// \code{.cpp}
+/// gz::msgs::TransformPointCloudPacked(pcMsg, sensorWorldPose);
+/// \endcode
+///
+/// \param[in, out] _msg The cloud to transform.
+/// \param[in] _pose The transform to apply.
+/// \param[in] _transformNormals True to also rotate the normal fields.
+/// \return True on success. False if the cloud doesn't have suitable x, y
+/// and z fields, or if _transformNormals is true and the cloud doesn't have
+/// suitable normal fields. The cloud is not modified on failure.
+inline bool TransformPointCloudPacked(msgs::PointCloudPacked &_msg,
+    const math::Pose3d &_pose, bool _transformNormals = false)
+{
+  static const std::string kXyzNames[3] = {"x", "y", "z"};
+  static const std::string kNormalNames[3] =
+      {"normal_x", "normal_y", "normal_z"};
+
+  size_t xyzOffsets[3];
+  PointCloudPacked::Field::DataType xyzType{PointCloudPacked::Field::FLOAT32};
+  if (!detail::FindVectorFields(_msg, kXyzNames, xyzOffsets, xyzType))
+  {
+    std::cerr << "PointCloudPacked must have x, y and z fields of the same "
+              << "FLOAT32 or FLOAT64 datatype to be transformed.\n";
+    return false;
+  }
+
+  size_t normalOffsets[3];
+  PointCloudPacked::Field::DataType normalType{
+      PointCloudPacked::Field::FLOAT32};
+  if (_transformNormals && !detail::FindVectorFields(
+        _msg, kNormalNames, normalOffsets, normalType))
+  {
+    std::cerr << "PointCloudPacked must have normal_x, normal_y and normal_z "
+              << "fields of the same FLOAT32 or FLOAT64 datatype to have its "
+              << "normals transformed.\n";
+    return false;
+  }
+
+  const detail::PointCloudPackedLayout layout = detail::Layout(_msg);
+  if (layout.rows == 0 || layout.cols == 0)
+    return true;
+
+  const math::Matrix3d rot(_pose.Rot());
+  const math::Vector3d &pos = _pose.Pos();
+  const double transform[12] = {
+      rot(0, 0), rot(0, 1), rot(0, 2), pos.X(),
+      rot(1, 0), rot(1, 1), rot(1, 2), pos.Y(),
+      rot(2, 0), rot(2, 1), rot(2, 2), pos.Z()};
+  const double rotation[12] = {
+      rot(0, 0), rot(0, 1), rot(0, 2), 0.0,
+      rot(1, 0), rot(1, 1), rot(1, 2), 0.0,
+      rot(2, 0), rot(2, 1), rot(2, 2), 0.0};
+
+  // Single precision clouds are transformed with a single precision matrix
+  // so that the kernel doesn't have to widen every component.
+  auto apply = [&](const size_t (&_offsets)[3],
+      PointCloudPacked::Field::DataType _type, const double (&_m)[12])
+  {
+    char *data = &(*_msg.mutable_data())[0];
+    if (_type == PointCloudPacked::Field::FLOAT32)
+    {
+      float m[12];
+      for (int i = 0; i < 12; ++i)
+        m[i] = static_cast<float>(_m[i]);
+      detail::TransformVectors<float>(data, layout, _offsets, m);
+    }
+    else
+    {
+      detail::TransformVectors<double>(data, layout, _offsets, _m);
+    }
+  };
+
+  apply(xyzOffsets, xyzType, transform);
+  if (_transformNormals)
+    apply(normalOffsets, normalType, rotation);
+
+  return true;
+}
+
+/// \brief Remove in place the points of a cloud that have a NaN or infinite
+/// x, y or z, turning it into a dense unorganized cloud.
+///
+/// The remaining points keep their order and are moved to the front of the
+/// data in a single pass. Afterwards the cloud has a height of 1, a width
+/// equal to the number of points kept, an updated row_step and is_dense set
+/// to true. Row padding of organized clouds is dropped.
+///
+/// \param[in, out] _msg The cloud to compact. x, y and z must share the same
+/// FLOAT32 or FLOAT64 datatype.
+/// \param[out] _indices If not null, receives for every point kept its row
+/// major index (row * width + column) in the original cloud, which maps
+/// points back to an organized layout.
+/// \return True on success. False if the cloud doesn't have suitable x, y
+/// and z fields, in which case it isn't modified.
+inline bool CompactPointCloudPacked(msgs::PointCloudPacked &_msg,
+    std::vector<uint32_t> *_indices = nullptr)
+{
+  static const std::string kXyzNames[3] = {"x", "y", "z"};
+  size_t offsets[3];
+  PointCloudPacked::Field::DataType type{PointCloudPacked::Field::FLOAT32};
+  if (!detail::FindVectorFields(_msg, kXyzNames, offsets, type))
+  {
+    std::cerr << "PointCloudPacked must have x, y and z fields of the same "
+              << "FLOAT32 or FLOAT64 datatype to be compacted.\n";
+    return false;
+  }
+
+  const detail::PointCloudPackedLayout layout = detail::Layout(_msg);
+  if (_indices)
+  {
+    _indices->clear();
+    _indices->reserve(layout.rows * layout.cols);
+  }
+
+  size_t kept = 0;
+  if (layout.rows * layout.cols > 0)
+  {
+    char *data = &(*_msg.mutable_data())[0];
+    if (type == PointCloudPacked::Field::FLOAT32)
+      kept = detail::CompactFinite<float>(data, layout, offsets, _indices);
+    else
+      kept = detail::CompactFinite<double>(data, layout, offsets, _indices);
+  }
+
+  _msg.mutable_data()->resize(kept * _msg.point_step());
+  _msg.set_height(1);
+  _msg.set_width(static_cast<uint32_t>(kept));
+  _msg.set_row_step(static_cast<uint32_t>(kept * _msg.point_step()));
+  _msg.set_is_dense(true);
+  return true;
+}
+
+/// \brief Copy a cloud while changing the datatype of some of its fields.
+///
+/// E.g, to halve the size of a cloud built with FLOAT64 coordinates:
+///
+/// \code{.cpp}
+/// gz::msgs::ConvertFieldTypes(doubleCloud, floatCloud,
+///     {{"xyz", gz::msgs::PointCloudPacked::Field::FLOAT32}});
+/// \endcode
+///
+/// The destination cloud keeps the fields of the source cloud in the same
+/// order, laid out like InitPointCloudPacked does: when _memoryAligned is
+/// true, the offset after every field, or after consecutive x, y and z
+/// fields, is rounded up to a multiple of sizeof(size_t), as is the
+/// point_step. Bytes that don't belong to any field and row padding are
+/// dropped. Values are converted with rounding to the nearest integer and
+/// saturation when the destination datatype is an integer.
+///
+/// \param[in] _src The cloud to convert.
+/// \param[out] _dst The converted cloud. Must not be _src.
+/// \param[in] _types New datatype of every field to convert, by name. The
+/// name "xyz" applies to the x, y and z fields.
+/// \param[in] _memoryAligned True to align fields like InitPointCloudPacked.
+/// \return True on success. False if a field to convert doesn't exist, or a
+/// datatype is invalid.
+inline bool ConvertFieldTypes(const msgs::PointCloudPacked &_src,
+    msgs::PointCloudPacked &_dst,
+    const std::map<std::string, msgs::PointCloudPacked::Field::DataType>
+    &_types, bool _memoryAligned = false)
+{
+  if (&_src == &_dst)
+  {
+    std::cerr << "ConvertFieldTypes requires distinct clouds.\n";
+    return false;
+  }
+
+  // Resolve the "xyz" shorthand and make sure every field exists.
+  std::map<std::string, msgs::PointCloudPacked::Field::DataType> types;
+  for (const auto &[name, type] : _types)
+  {
+    if (sizeOfPointField(type) <= 0)
+      return false;
+    const std::vector<std::string> names = name == "xyz" ?
+        std::vector<std::string>{"x", "y", "z"} :
+        std::vector<std::string>{name};
+    for (const std::string &fieldName : names)
+    {
+      if (nullptr == detail::FindField(_src, fieldName))
+      {
+        std::cerr << "Field [" << fieldName << "] does not exist.\n";
+        return false;
+      }
+      types[fieldName] = type;
+    }
+  }
+
+  // Lay out the destination fields.
+  const size_t alignment = sizeof(size_t);
+  size_t offset = 0;
+  _dst.clear_field();
+  for (int i = 0; i < _src.field_size(); ++i)
+  {
+    const PointCloudPacked::Field &srcField = _src.field(i);
+    auto it = types.find(srcField.name());
+    const PointCloudPacked::Field::DataType type =
+        it == types.end() ? srcField.datatype() : it->second;
+    const int typeSize = sizeOfPointField(type);
+    if (typeSize <= 0)
+      return false;
+
+    PointCloudPacked::Field *dstField = _dst.add_field();
+    *dstField = srcField;
+    dstField->set_datatype(type);
+    dstField->set_offset(static_cast<uint32_t>(offset));
+    offset += typeSize * std::max(1u, srcField.count());
+
+    // x, y and z are aligned as a group when consecutive.
+    const bool groupContinues = i + 1 < _src.field_size() &&
+        ((srcField.name() == "x" && _src.field(i + 1).name() == "y") ||
+         (srcField.name() == "y" && _src.field(i + 1).name() == "z"));
+    if (_memoryAligned && !groupContinues)
+      offset = (offset + alignment - 1) / alignment * alignment;
+  }
+  const size_t pointStep = offset;
+
+  const detail::PointCloudPackedLayout layout = detail::Layout(_src);
+  *_dst.mutable_header() = _src.header();
+  _dst.set_is_bigendian(_src.is_bigendian());
+  _dst.set_is_dense(_src.is_dense());
+  _dst.set_point_step(static_cast<uint32_t>(pointStep));
+  _dst.set_height(static_cast<uint32_t>(layout.rows));
+  _dst.set_width(static_cast<uint32_t>(layout.cols));
+  _dst.set_row_step(static_cast<uint32_t>(layout.cols * pointStep));
+  _dst.mutable_data()->assign(layout.rows * layout.cols * pointStep, '\0');
+  if (layout.rows * layout.cols == 0)
+    return true;
+
+  const char *src = _src.data().data();
+  char *dst = &(*_dst.mutable_data())[0];
+  for (int i = 0; i < _src.field_size(); ++i)
+  {
+    const PointCloudPacked::Field &srcField = _src.field(i);
+    const PointCloudPacked::Field &dstField = _dst.field(i);
+    const int srcSize = sizeOfPointField(srcField.datatype());
+    const int dstSize = sizeOfPointField(dstField.datatype());
+    for (size_t c = 0; c < std::max(1u, srcField.count()); ++c)
+    {
+      const size_t srcOffset = srcField.offset() + c * srcSize;
+      const size_t dstOffset = dstField.offset() + c * dstSize;
+      if (srcOffset + srcSize > layout.pointStep)
+        break;
+
+      detail::VisitFieldType(srcField.datatype(), [&](auto _srcValue)
+      {
+        detail::VisitFieldType(dstField.datatype(), [&](auto _dstValue)
+        {
+          using S = decltype(_srcValue);
+          using D = decltype(_dstValue);
+          detail::ConvertFieldElement<D, S>(src, layout, srcOffset, dst,
+              pointStep, dstOffset);
+        });
+      });
+    }
+  }
+  return true;
+}
 }
 }
 
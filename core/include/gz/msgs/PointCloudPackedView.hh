@@ -0,0 +1,318 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_MSGS_POINTCLOUDPACKEDVIEW_HH_
+#define GZ_MSGS_POINTCLOUDPACKEDVIEW_HH_
+
+#include <gz/msgs/pointcloud_packed.pb.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+#include "gz/msgs/config.hh"
+#include "gz/msgs/detail/ParallelFor.hh"
+#include "gz/msgs/detail/PointCloudPackedUtils.hh"
+
+namespace gz
+{
+namespace msgs
+{
+/// \brief A rectangular block of points of an organized cloud, visited by
+/// PointCloudPackedView::ForEachTile.
+///
+/// The core rows [rowBegin, rowEnd) and columns [colBegin, colEnd) are the
+/// points that the tile owns. The halo extends the core by the requested
+/// number of points on every side, clamped to the cloud, and holds the
+/// neighbors that a 2-D kernel may read.
+struct PointCloudPackedTile
+{
+  /// \brief First row of the core.
+  size_t rowBegin{0};
+
+  /// \brief One past the last row of the core.
+  size_t rowEnd{0};
+
+  /// \brief First column of the core.
+  size_t colBegin{0};
+
+  /// \brief One past the last column of the core.
+  size_t colEnd{0};
+
+  /// \brief First row of the halo.
+  size_t haloRowBegin{0};
+
+  /// \brief One past the last row of the halo.
+  size_t haloRowEnd{0};
+
+  /// \brief First column of the halo.
+  size_t haloColBegin{0};
+
+  /// \brief One past the last column of the halo.
+  size_t haloColEnd{0};
+};
+
+namespace detail
+{
+/// \brief Private base class for PointCloudPackedView and
+/// PointCloudPackedConstView.
+/// \tparam FieldType The type of the value of the field.
+/// \tparam QualifiedFieldType FieldType, or const FieldType.
+/// \tparam RawDataType char, or const char.
+/// \tparam PointCloudType PointCloudPacked, or const PointCloudPacked.
+template<typename FieldType, typename QualifiedFieldType,
+    typename RawDataType, typename PointCloudType>
+class PointCloudPackedViewBase
+{
+  /// \param[in] _cloudMsg The cloud to view.
+  /// \param[in] _fieldName The field to access.
+  public: PointCloudPackedViewBase(PointCloudType &_cloudMsg,
+      const std::string &_fieldName);
+
+  /// \brief Whether the field was found in the cloud.
+  /// \return True if the view can be used.
+  public: bool Valid() const;
+
+  /// \brief Number of rows.
+  /// \return The height of the cloud, or 1 for unorganized clouds.
+  public: size_t Height() const;
+
+  /// \brief Number of columns.
+  /// \return The width of the cloud.
+  public: size_t Width() const;
+
+  /// \brief Access the field of a point.
+  /// \param[in] _row Row of the point, less than Height().
+  /// \param[in] _col Column of the point, less than Width().
+  /// \return Reference to the first element of the field.
+  public: QualifiedFieldType &operator()(size_t _row, size_t _col) const;
+
+  /// \brief Access an element of the field of a point, for fields with a
+  /// count greater than one.
+  /// \param[in] _row Row of the point, less than Height().
+  /// \param[in] _col Column of the point, less than Width().
+  /// \param[in] _element Index of the element.
+  /// \return Reference to the element.
+  public: QualifiedFieldType &At(size_t _row, size_t _col,
+      size_t _element) const;
+
+  /// \brief Restrict the view to a band of rows. Row indices of the view
+  /// are then relative to _begin.
+  /// \param[in] _begin First row.
+  /// \param[in] _end One past the last row.
+  /// \return False if the band is not within the view, which is then left
+  /// unchanged.
+  public: bool ClipRows(size_t _begin, size_t _end);
+
+  /// \brief Visit the cloud in tiles, so that 2-D kernels reading the
+  /// neighbors of a point stay in cache.
+  ///
+  /// Tiles are visited in row-major order when _threads is 1. Otherwise,
+  /// tiles are distributed across threads and _func must only write to the
+  /// core of its tile.
+  ///
+  /// \param[in] _tileRows Number of rows in a tile core.
+  /// \param[in] _tileCols Number of columns in a tile core.
+  /// \param[in] _halo Number of neighboring points around the core.
+  /// \param[in] _func Callable taking a const PointCloudPackedTile &.
+  /// \param[in] _threads Maximum number of threads, or zero to use the
+  /// hardware concurrency.
+  public: template<typename Func>
+  void ForEachTile(size_t _tileRows, size_t _tileCols, size_t _halo,
+      Func &&_func, unsigned int _threads = 1) const;
+
+  /// \brief Start of the field in the first point.
+  private: RawDataType *data{nullptr};
+
+  /// \brief Layout of the cloud.
+  private: PointCloudPackedLayout layout;
+};
+
+//////////////////////////////////////////////////
+template<typename FieldType, typename QualifiedFieldType,
+    typename RawDataType, typename PointCloudType>
+PointCloudPackedViewBase<FieldType, QualifiedFieldType, RawDataType,
+    PointCloudType>::PointCloudPackedViewBase(PointCloudType &_cloudMsg,
+        const std::string &_fieldName)
+{
+  const PointCloudPacked::Field *field = FindField(_cloudMsg, _fieldName);
+  if (nullptr == field)
+  {
+    std::cerr << "Field [" << _fieldName << "] does not exist.\n";
+    return;
+  }
+
+  this->layout = Layout(_cloudMsg);
+  if (field->offset() + sizeof(FieldType) > this->layout.pointStep ||
+      this->layout.rows * this->layout.cols == 0)
+  {
+    this->layout = PointCloudPackedLayout();
+    return;
+  }
+
+  this->data = const_cast<RawDataType *>(_cloudMsg.data().data()) +
+      field->offset();
+}
+
+//////////////////////////////////////////////////
+template<typename FieldType, typename QualifiedFieldType,
+    typename RawDataType, typename PointCloudType>
+bool PointCloudPackedViewBase<FieldType, QualifiedFieldType, RawDataType,
+    PointCloudType>::Valid() const
+{
+  return nullptr != this->data;
+}
+
+//////////////////////////////////////////////////
+template<typename FieldType, typename QualifiedFieldType,
+    typename RawDataType, typename PointCloudType>
+size_t PointCloudPackedViewBase<FieldType, QualifiedFieldType, RawDataType,
+    PointCloudType>::Height() const
+{
+  return this->layout.rows;
+}
+
+//////////////////////////////////////////////////
+template<typename FieldType, typename QualifiedFieldType,
+    typename RawDataType, typename PointCloudType>
+size_t PointCloudPackedViewBase<FieldType, QualifiedFieldType, RawDataType,
+    PointCloudType>::Width() const
+{
+  return this->layout.cols;
+}
+
+//////////////////////////////////////////////////
+template<typename FieldType, typename QualifiedFieldType,
+    typename RawDataType, typename PointCloudType>
+QualifiedFieldType &PointCloudPackedViewBase<FieldType, QualifiedFieldType,
+    RawDataType, PointCloudType>::operator()(size_t _row, size_t _col) const
+{
+  return *reinterpret_cast<QualifiedFieldType *>(this->data +
+      _row * this->layout.rowStep + _col * this->layout.pointStep);
+}
+
+//////////////////////////////////////////////////
+template<typename FieldType, typename QualifiedFieldType,
+    typename RawDataType, typename PointCloudType>
+QualifiedFieldType &PointCloudPackedViewBase<FieldType, QualifiedFieldType,
+    RawDataType, PointCloudType>::At(size_t _row, size_t _col,
+        size_t _element) const
+{
+  return *(&(*this)(_row, _col) + _element);
+}
+
+//////////////////////////////////////////////////
+template<typename FieldType, typename QualifiedFieldType,
+    typename RawDataType, typename PointCloudType>
+bool PointCloudPackedViewBase<FieldType, QualifiedFieldType, RawDataType,
+    PointCloudType>::ClipRows(size_t _begin, size_t _end)
+{
+  if (_begin > _end || _end > this->layout.rows)
+    return false;
+
+  if (nullptr != this->data)
+    this->data += _begin * this->layout.rowStep;
+  this->layout.rows = _end - _begin;
+  return true;
+}
+
+//////////////////////////////////////////////////
+template<typename FieldType, typename QualifiedFieldType,
+    typename RawDataType, typename PointCloudType>
+template<typename Func>
+void PointCloudPackedViewBase<FieldType, QualifiedFieldType, RawDataType,
+    PointCloudType>::ForEachTile(size_t _tileRows, size_t _tileCols,
+        size_t _halo, Func &&_func, unsigned int _threads) const
+{
+  const size_t rows = this->layout.rows;
+  const size_t cols = this->layout.cols;
+  _tileRows = std::max<size_t>(1u, _tileRows);
+  _tileCols = std::max<size_t>(1u, _tileCols);
+  const size_t tilesPerRow = (cols + _tileCols - 1) / _tileCols;
+  const size_t tiles = tilesPerRow * ((rows + _tileRows - 1) / _tileRows);
+
+  const unsigned int ranges = static_cast<unsigned int>(std::min<size_t>(
+      ParallelRanges(rows * cols, _threads), std::max<size_t>(1u, tiles)));
+  ParallelFor(tiles, ranges,
+      [&](size_t _begin, size_t _end, unsigned int)
+      {
+        for (size_t t = _begin; t < _end; ++t)
+        {
+          PointCloudPackedTile tile;
+          tile.rowBegin = (t / tilesPerRow) * _tileRows;
+          tile.rowEnd = std::min(rows, tile.rowBegin + _tileRows);
+          tile.colBegin = (t % tilesPerRow) * _tileCols;
+          tile.colEnd = std::min(cols, tile.colBegin + _tileCols);
+          tile.haloRowBegin = tile.rowBegin - std::min(tile.rowBegin, _halo);
+          tile.haloRowEnd = std::min(rows, tile.rowEnd + _halo);
+          tile.haloColBegin = tile.colBegin - std::min(tile.colBegin, _halo);
+          tile.haloColEnd = std::min(cols, tile.colEnd + _halo);
+          _func(static_cast<const PointCloudPackedTile &>(tile));
+        }
+      });
+}
+}  // namespace detail
+
+/// \brief Two dimensional access to a field of a PointCloudPacked message.
+///
+/// Unlike PointCloudPackedIterator, the view honors the row_step padding of
+/// organized clouds, and addresses points by row and column. Unorganized
+/// clouds are viewed as a single row.
+///
+/// \code{.cpp}
+/// gz::msgs::PointCloudPackedView<float> z(pcMsg, "z");
+/// for (size_t row = 0; row < z.Height(); ++row)
+///   for (size_t col = 0; col < z.Width(); ++col)
+///     z(row, col) += 1.0f;
+/// \endcode
+///
+/// \tparam FieldType Type of the field.
+template<typename FieldType>
+class PointCloudPackedView
+  : public detail::PointCloudPackedViewBase<
+    FieldType, FieldType, char, PointCloudPacked>
+{
+  // Documentation inherited
+  public: PointCloudPackedView(PointCloudPacked &_cloudMsg,
+    const std::string &_fieldName)
+      : detail::PointCloudPackedViewBase<FieldType, FieldType, char,
+        PointCloudPacked>::PointCloudPackedViewBase(_cloudMsg, _fieldName)
+  {
+  }
+};
+
+/// \brief Same as a PointCloudPackedView but for const data.
+/// \tparam FieldType Type of the field.
+template<typename FieldType>
+class PointCloudPackedConstView
+  : public detail::PointCloudPackedViewBase<
+    FieldType, const FieldType, const char, const PointCloudPacked>
+{
+  // Documentation inherited
+  public: PointCloudPackedConstView(const PointCloudPacked &_cloudMsg,
+    const std::string &_fieldName)
+      : detail::PointCloudPackedViewBase<FieldType, const FieldType,
+        const char, const PointCloudPacked>::PointCloudPackedViewBase(
+            _cloudMsg, _fieldName)
+  {
+  }
+};
+}
+}
+
+#endif
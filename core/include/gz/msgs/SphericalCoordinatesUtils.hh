@@ -0,0 +1,532 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_MSGS_SPHERICALCOORDINATESUTILS_HH_
+#define GZ_MSGS_SPHERICALCOORDINATESUTILS_HH_
+
+#include <gz/msgs/navsat.pb.h>
+#include <gz/msgs/pose_v.pb.h>
+#include <gz/msgs/spherical_coordinates.pb.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#include <gz/math/Helpers.hh>
+#include <gz/math/SphericalCoordinates.hh>
+#include <gz/math/Vector3.hh>
+
+#include "gz/msgs/config.hh"
+#include "gz/msgs/detail/ParallelFor.hh"
+
+namespace gz
+{
+namespace msgs
+{
+namespace detail
+{
+/// \brief Number of points converted together by SphericalToLocalBlock.
+constexpr size_t kSphericalBlock = 64;
+
+/// \brief Largest latitude or longitude offset from the reference, in
+/// radians, for which SphericalToLocalBlock uses its polynomials instead
+/// of std::sin and std::cos. About 1600 km on Earth.
+constexpr double kSphericalMaxOffset = 0.25;
+
+/// \brief Everything a conversion from spherical to local coordinates
+/// needs that depends only on the reference.
+struct SphericalToLocalTransform
+{
+  /// \brief Equatorial axis of the surface, in meters.
+  double axisEquatorial;
+
+  /// \brief Square of the first eccentricity of the surface.
+  double eccentricity2;
+
+  /// \brief Square of the ratio of the polar and equatorial axes.
+  double axisRatio2;
+
+  /// \brief Reference latitude, in radians.
+  double latitude;
+
+  /// \brief Reference longitude, in radians.
+  double longitude;
+
+  /// \brief Sine and cosine of the reference latitude.
+  double sinLat, cosLat;
+
+  /// \brief Sine and cosine of the reference longitude.
+  double sinLon, cosLon;
+
+  /// \brief ECEF position of the reference.
+  double origin[3];
+
+  /// \brief Rotation from ECEF to the local frame, row major. It combines
+  /// the ECEF to East-North-Up rotation with the heading offset.
+  double rotation[9];
+};
+
+/// \brief Sine and cosine of a small angle, with polynomials that
+/// compilers can vectorize. Accurate to a few units in the last place for
+/// |_x| <= kSphericalMaxOffset.
+/// \param[in] _x The angle, in radians.
+/// \param[out] _sin Sine of the angle.
+/// \param[out] _cos Cosine of the angle.
+inline void SmallAngleSinCos(double _x, double &_sin, double &_cos)
+{
+  const double x2 = _x * _x;
+  _sin = _x * (1.0 + x2 * (-1.0 / 6 + x2 * (1.0 / 120 + x2 * (-1.0 / 5040 +
+      x2 * (1.0 / 362880 + x2 * (-1.0 / 39916800))))));
+  _cos = 1.0 + x2 * (-1.0 / 2 + x2 * (1.0 / 24 + x2 * (-1.0 / 720 +
+      x2 * (1.0 / 40320 + x2 * (-1.0 / 3628800 + x2 * (1.0 / 479001600))))));
+}
+
+/// \brief Convert kSphericalBlock points from spherical to local
+/// coordinates. The arrays are structures of arrays so that every loop
+/// runs a fixed number of times over contiguous doubles without branches,
+/// which compilers turn into SIMD code even at -O2. Points within
+/// kSphericalMaxOffset of the reference take their sines and cosines from
+/// the reference through the angle sum identities, and a block with a
+/// point further away falls back to std::sin and std::cos.
+/// \param[in] _t The transform.
+/// \param[in,out] _lat Latitudes in radians, overwritten.
+/// \param[in,out] _lon Longitudes in radians, overwritten.
+/// \param[in] _alt Altitudes in meters.
+/// \param[out] _x Local x coordinates.
+/// \param[out] _y Local y coordinates.
+/// \param[out] _z Local z coordinates.
+inline void SphericalToLocalBlock(const SphericalToLocalTransform &_t,
+    double *_lat, double *_lon, const double *_alt, double *_x, double *_y,
+    double *_z)
+{
+  // Local copies, so that compilers know the output doesn't alias them.
+  const double lat0 = _t.latitude;
+  const double lon0 = _t.longitude;
+  const double sinLat0 = _t.sinLat;
+  const double cosLat0 = _t.cosLat;
+  const double sinLon0 = _t.sinLon;
+  const double cosLon0 = _t.cosLon;
+  const double a = _t.axisEquatorial;
+  const double e2 = _t.eccentricity2;
+  const double ratio2 = _t.axisRatio2;
+  const double o[3] = {_t.origin[0], _t.origin[1], _t.origin[2]};
+  double r[9];
+  std::copy(_t.rotation, _t.rotation + 9, r);
+
+  double sinLat[kSphericalBlock], cosLat[kSphericalBlock];
+  double sinLon[kSphericalBlock], cosLon[kSphericalBlock];
+  double n[kSphericalBlock];
+
+  int far = 0;
+  for (size_t i = 0; i < kSphericalBlock; ++i)
+  {
+    _lat[i] -= lat0;
+    _lon[i] -= lon0;
+    far += std::abs(_lat[i]) > kSphericalMaxOffset;
+    far += std::abs(_lon[i]) > kSphericalMaxOffset;
+  }
+
+  if (far == 0)
+  {
+    for (size_t i = 0; i < kSphericalBlock; ++i)
+    {
+      double s, c;
+      SmallAngleSinCos(_lat[i], s, c);
+      sinLat[i] = sinLat0 * c + cosLat0 * s;
+      cosLat[i] = cosLat0 * c - sinLat0 * s;
+      SmallAngleSinCos(_lon[i], s, c);
+      sinLon[i] = sinLon0 * c + cosLon0 * s;
+      cosLon[i] = cosLon0 * c - sinLon0 * s;
+    }
+  }
+  else
+  {
+    for (size_t i = 0; i < kSphericalBlock; ++i)
+    {
+      sinLat[i] = std::sin(_lat[i] + lat0);
+      cosLat[i] = std::cos(_lat[i] + lat0);
+      sinLon[i] = std::sin(_lon[i] + lon0);
+      cosLon[i] = std::cos(_lon[i] + lon0);
+    }
+  }
+
+  // Radius of curvature of the prime vertical, a / sqrt(1 - e2 sin^2).
+  // std::sqrt may set errno, which keeps compilers from vectorizing it, so
+  // unless the surface is very flat the inverse square root starts from
+  // its binomial series and is refined with Newton steps.
+  if (e2 <= 0.5)
+  {
+    const int steps = e2 <= 0.01 ? 2 : 4;
+    for (size_t i = 0; i < kSphericalBlock; ++i)
+    {
+      const double u = e2 * sinLat[i] * sinLat[i];
+      n[i] = 1.0 + u * (0.5 + u * 0.375);
+    }
+    for (int step = 0; step < steps; ++step)
+    {
+      for (size_t i = 0; i < kSphericalBlock; ++i)
+      {
+        const double v = 1.0 - e2 * sinLat[i] * sinLat[i];
+        n[i] *= 1.5 - 0.5 * v * n[i] * n[i];
+      }
+    }
+    for (size_t i = 0; i < kSphericalBlock; ++i)
+      n[i] *= a;
+  }
+  else
+  {
+    for (size_t i = 0; i < kSphericalBlock; ++i)
+      n[i] = a / std::sqrt(1.0 - e2 * sinLat[i] * sinLat[i]);
+  }
+
+  for (size_t i = 0; i < kSphericalBlock; ++i)
+  {
+    const double ex = (_alt[i] + n[i]) * cosLat[i] * cosLon[i] - o[0];
+    const double ey = (_alt[i] + n[i]) * cosLat[i] * sinLon[i] - o[1];
+    const double ez = (ratio2 * n[i] + _alt[i]) * sinLat[i] - o[2];
+    _x[i] = r[0] * ex + r[1] * ey + r[2] * ez;
+    _y[i] = r[3] * ex + r[4] * ey + r[5] * ez;
+    _z[i] = r[6] * ex + r[7] * ey + r[8] * ez;
+  }
+}
+}  // namespace detail
+
+/// \brief Converts many spherical positions, such as NavSat fixes, to the
+/// local frame of a SphericalCoordinates reference. It matches
+/// math::SphericalCoordinates::LocalFromSphericalPosition, but computes
+/// the reference's ECEF position and rotation once, and converts points
+/// in blocks that avoid most of the per point trigonometry.
+///
+/// Latitudes and longitudes are in degrees and altitudes in meters. The
+/// local frame is East-North-Up rotated by the heading offset.
+class SphericalToLocalConverter
+{
+  /// \brief Constructor. The reference is at latitude, longitude and
+  /// elevation zero on WGS84.
+  public: SphericalToLocalConverter();
+
+  /// \brief Constructor.
+  /// \param[in] _reference The reference.
+  public: explicit SphericalToLocalConverter(
+              const SphericalCoordinates &_reference);
+
+  /// \brief Set the reference.
+  /// \param[in] _reference The reference.
+  /// \return False if the reference has a custom surface with invalid
+  /// axes. WGS84 is used instead, like math::SphericalCoordinates does.
+  public: bool SetReference(const SphericalCoordinates &_reference);
+
+  /// \brief Get the reference.
+  /// \return The reference.
+  public: const SphericalCoordinates &Reference() const;
+
+  /// \brief Convert one position.
+  /// \param[in] _latitude Latitude in degrees.
+  /// \param[in] _longitude Longitude in degrees.
+  /// \param[in] _altitude Altitude in meters.
+  /// \return The local position.
+  public: math::Vector3d Convert(double _latitude, double _longitude,
+              double _altitude) const;
+
+  /// \brief Convert positions stored as structures of arrays.
+  /// \param[in] _latitude Latitudes in degrees.
+  /// \param[in] _longitude Longitudes in degrees.
+  /// \param[in] _altitude Altitudes in meters.
+  /// \param[in] _count Number of positions.
+  /// \param[out] _local The local positions, _count of them.
+  /// \param[in] _threads Maximum number of threads, zero for all cores.
+  public: void Convert(const double *_latitude, const double *_longitude,
+              const double *_altitude, size_t _count,
+              math::Vector3d *_local, unsigned int _threads = 0) const;
+
+  /// \brief Convert positions.
+  /// \param[in] _latLonAlt Latitude and longitude in degrees, and altitude
+  /// in meters, in X, Y and Z.
+  /// \param[out] _local The local positions.
+  /// \param[in] _threads Maximum number of threads, zero for all cores.
+  public: void Convert(const std::vector<math::Vector3d> &_latLonAlt,
+              std::vector<math::Vector3d> &_local,
+              unsigned int _threads = 0) const;
+
+  /// \brief Convert the positions of NavSat fixes.
+  /// \param[in] _fixes The fixes.
+  /// \param[out] _local The local positions.
+  /// \param[in] _threads Maximum number of threads, zero for all cores.
+  public: void Convert(const std::vector<NavSat> &_fixes,
+              std::vector<math::Vector3d> &_local,
+              unsigned int _threads = 0) const;
+
+  /// \brief Convert the positions of NavSat fixes to poses with an
+  /// identity orientation. Existing poses in _poses are reused.
+  /// \param[in] _fixes The fixes.
+  /// \param[out] _poses The local poses.
+  /// \param[in] _threads Maximum number of threads, zero for all cores.
+  public: void Convert(const std::vector<NavSat> &_fixes, Pose_V &_poses,
+              unsigned int _threads = 0) const;
+
+  /// \brief Convert positions in blocks, spread over threads.
+  /// \param[in] _count Number of positions.
+  /// \param[in] _load Callable taking (size_t _index, double &_latitude,
+  /// double &_longitude, double &_altitude), in degrees and meters.
+  /// \param[in] _store Callable taking (size_t _index, double _x,
+  /// double _y, double _z).
+  /// \param[in] _threads Maximum number of threads, zero for all cores.
+  private: template<typename Load, typename Store>
+           void ConvertImpl(size_t _count, const Load &_load,
+               const Store &_store, unsigned int _threads) const;
+
+  /// \brief The reference.
+  private: SphericalCoordinates reference;
+
+  /// \brief Transform computed from the reference.
+  private: detail::SphericalToLocalTransform transform;
+};
+
+/////////////////////////////////////////////////
+inline SphericalToLocalConverter::SphericalToLocalConverter()
+{
+  this->SetReference(SphericalCoordinates());
+}
+
+/////////////////////////////////////////////////
+inline SphericalToLocalConverter::SphericalToLocalConverter(
+    const SphericalCoordinates &_reference)
+{
+  this->SetReference(_reference);
+}
+
+/////////////////////////////////////////////////
+inline bool SphericalToLocalConverter::SetReference(
+    const SphericalCoordinates &_reference)
+{
+  // Take the surface axes from math::SphericalCoordinates, so both agree
+  // on every gz-math version.
+  const math::SphericalCoordinates earth(
+      math::SphericalCoordinates::EARTH_WGS84);
+
+  this->reference = _reference;
+  bool valid = true;
+  double a = earth.SurfaceAxisEquatorial();
+  double b = earth.SurfaceAxisPolar();
+  if (_reference.surface_model() == SphericalCoordinates::MOON_SCS)
+  {
+    const math::SphericalCoordinates moon(
+        math::SphericalCoordinates::MOON_SCS);
+    a = moon.SurfaceAxisEquatorial();
+    b = moon.SurfaceAxisPolar();
+  }
+  else if (_reference.surface_model() == SphericalCoordinates::CUSTOM_SURFACE)
+  {
+    a = _reference.surface_axis_equatorial();
+    b = _reference.surface_axis_polar();
+    if (!(a > 0 && b > 0 && b <= a))
+    {
+      std::cerr << "Invalid custom surface axes [" << a << ", " << b
+                << "], using Earth WGS84 instead.\n";
+      a = earth.SurfaceAxisEquatorial();
+      b = earth.SurfaceAxisPolar();
+      valid = false;
+    }
+  }
+
+  detail::SphericalToLocalTransform &t = this->transform;
+  t.axisEquatorial = a;
+  t.axisRatio2 = (b * b) / (a * a);
+  t.eccentricity2 = 1.0 - t.axisRatio2;
+  t.latitude = _reference.latitude_deg() * GZ_PI / 180.0;
+  t.longitude = _reference.longitude_deg() * GZ_PI / 180.0;
+  t.sinLat = std::sin(t.latitude);
+  t.cosLat = std::cos(t.latitude);
+  t.sinLon = std::sin(t.longitude);
+  t.cosLon = std::cos(t.longitude);
+
+  const double elevation = _reference.elevation();
+  const double n = a / std::sqrt(1.0 - t.eccentricity2 * t.sinLat * t.sinLat);
+  t.origin[0] = (elevation + n) * t.cosLat * t.cosLon;
+  t.origin[1] = (elevation + n) * t.cosLat * t.sinLon;
+  t.origin[2] = (t.axisRatio2 * n + elevation) * t.sinLat;
+
+  // ECEF to East-North-Up, followed by the heading offset, which is
+  // negated like math::SphericalCoordinates does.
+  const double east[3] = {-t.sinLon, t.cosLon, 0.0};
+  const double north[3] = {-t.cosLon * t.sinLat, -t.sinLon * t.sinLat,
+                           t.cosLat};
+  const double up[3] = {t.cosLon * t.cosLat, t.sinLon * t.cosLat, t.sinLat};
+  const double heading = -_reference.heading_deg() * GZ_PI / 180.0;
+  const double cosHeading = std::cos(heading);
+  const double sinHeading = std::sin(heading);
+  for (int c = 0; c < 3; ++c)
+  {
+    t.rotation[c] = east[c] * cosHeading - north[c] * sinHeading;
+    t.rotation[3 + c] = east[c] * sinHeading + north[c] * cosHeading;
+    t.rotation[6 + c] = up[c];
+  }
+  return valid;
+}
+
+/////////////////////////////////////////////////
+inline const SphericalCoordinates &SphericalToLocalConverter::Reference()
+    const
+{
+  return this->reference;
+}
+
+/////////////////////////////////////////////////
+inline math::Vector3d SphericalToLocalConverter::Convert(double _latitude,
+    double _longitude, double _altitude) const
+{
+  math::Vector3d local;
+  this->Convert(&_latitude, &_longitude, &_altitude, 1, &local, 1);
+  return local;
+}
+
+/////////////////////////////////////////////////
+inline void SphericalToLocalConverter::Convert(const double *_latitude,
+    const double *_longitude, const double *_altitude, size_t _count,
+    math::Vector3d *_local, unsigned int _threads) const
+{
+  this->ConvertImpl(_count,
+      [&](size_t _i, double &_lat, double &_lon, double &_alt)
+      {
+        _lat = _latitude[_i];
+        _lon = _longitude[_i];
+        _alt = _altitude[_i];
+      },
+      [&](size_t _i, double _x, double _y, double _z)
+      {
+        _local[_i].Set(_x, _y, _z);
+      }, _threads);
+}
+
+/////////////////////////////////////////////////
+inline void SphericalToLocalConverter::Convert(
+    const std::vector<math::Vector3d> &_latLonAlt,
+    std::vector<math::Vector3d> &_local, unsigned int _threads) const
+{
+  _local.resize(_latLonAlt.size());
+  this->ConvertImpl(_latLonAlt.size(),
+      [&](size_t _i, double &_lat, double &_lon, double &_alt)
+      {
+        _lat = _latLonAlt[_i].X();
+        _lon = _latLonAlt[_i].Y();
+        _alt = _latLonAlt[_i].Z();
+      },
+      [&](size_t _i, double _x, double _y, double _z)
+      {
+        _local[_i].Set(_x, _y, _z);
+      }, _threads);
+}
+
+/////////////////////////////////////////////////
+inline void SphericalToLocalConverter::Convert(
+    const std::vector<NavSat> &_fixes, std::vector<math::Vector3d> &_local,
+    unsigned int _threads) const
+{
+  _local.resize(_fixes.size());
+  this->ConvertImpl(_fixes.size(),
+      [&](size_t _i, double &_lat, double &_lon, double &_alt)
+      {
+        _lat = _fixes[_i].latitude_deg();
+        _lon = _fixes[_i].longitude_deg();
+        _alt = _fixes[_i].altitude();
+      },
+      [&](size_t _i, double _x, double _y, double _z)
+      {
+        _local[_i].Set(_x, _y, _z);
+      }, _threads);
+}
+
+/////////////////////////////////////////////////
+inline void SphericalToLocalConverter::Convert(
+    const std::vector<NavSat> &_fixes, Pose_V &_poses,
+    unsigned int _threads) const
+{
+  // Adding poses isn't thread safe, so size the message first.
+  auto *poses = _poses.mutable_pose();
+  const int size = static_cast<int>(_fixes.size());
+  if (poses->size() > size)
+    poses->DeleteSubrange(size, poses->size() - size);
+  poses->Reserve(size);
+  while (poses->size() < size)
+    poses->Add();
+
+  this->ConvertImpl(_fixes.size(),
+      [&](size_t _i, double &_lat, double &_lon, double &_alt)
+      {
+        _lat = _fixes[_i].latitude_deg();
+        _lon = _fixes[_i].longitude_deg();
+        _alt = _fixes[_i].altitude();
+      },
+      [&](size_t _i, double _x, double _y, double _z)
+      {
+        Pose *pose = poses->Mutable(static_cast<int>(_i));
+        Vector3d *position = pose->mutable_position();
+        position->set_x(_x);
+        position->set_y(_y);
+        position->set_z(_z);
+        Quaternion *orientation = pose->mutable_orientation();
+        orientation->set_w(1.0);
+        orientation->set_x(0.0);
+        orientation->set_y(0.0);
+        orientation->set_z(0.0);
+      }, _threads);
+}
+
+/////////////////////////////////////////////////
+template<typename Load, typename Store>
+void SphericalToLocalConverter::ConvertImpl(size_t _count,
+    const Load &_load, const Store &_store, unsigned int _threads) const
+{
+  const size_t blocks = (_count + detail::kSphericalBlock - 1) /
+      detail::kSphericalBlock;
+  const unsigned int ranges = detail::ParallelRanges(blocks, _threads,
+      std::max<size_t>(1, detail::kMinParallelItems / detail::kSphericalBlock));
+  detail::ParallelFor(blocks, ranges,
+      [&](size_t _begin, size_t _end, unsigned int)
+      {
+        const size_t n = detail::kSphericalBlock;
+        double lat[n], lon[n], alt[n], x[n], y[n], z[n];
+        for (size_t block = _begin; block < _end; ++block)
+        {
+          const size_t first = block * n;
+          const size_t count = std::min(n, _count - first);
+          for (size_t i = 0; i < count; ++i)
+          {
+            _load(first + i, lat[i], lon[i], alt[i]);
+            lat[i] = lat[i] * GZ_PI / 180.0;
+            lon[i] = lon[i] * GZ_PI / 180.0;
+          }
+
+          // Pad the last block with the reference.
+          for (size_t i = count; i < n; ++i)
+          {
+            lat[i] = this->transform.latitude;
+            lon[i] = this->transform.longitude;
+            alt[i] = 0.0;
+          }
+          detail::SphericalToLocalBlock(this->transform, lat, lon, alt,
+              x, y, z);
+          for (size_t i = 0; i < count; ++i)
+            _store(first + i, x[i], y[i], z[i]);
+        }
+      });
+}
+}
+}
+#endif
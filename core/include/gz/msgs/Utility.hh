@@ -22,6 +22,7 @@
 #include <gz/msgs/convert/Color.hh>
 #include <gz/msgs/convert/Inertial.hh>
 #include <gz/msgs/convert/Plane.hh>
+#include <gz/msgs/convert/PointCloud.hh>
 #include <gz/msgs/convert/Pose.hh>
 #include <gz/msgs/convert/Quaternion.hh>
 #include <gz/msgs/convert/SphericalCoordinates.hh>
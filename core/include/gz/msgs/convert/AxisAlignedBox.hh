@@ -21,6 +21,8 @@
 #include <gz/msgs/convert/Vector3.hh>
 
 // Message Headers
+#include <google/protobuf/arena.h>
+#include "gz/msgs/detail/ArenaUtils.hh"
 #include "gz/msgs/axis_aligned_box.pb.h"
 
 // Data Headers
@@ -52,6 +54,14 @@ inline gz::msgs::AxisAlignedBox Convert(const gz::math::AxisAlignedBox &_data)
   return ret;
 }
 
+inline gz::msgs::AxisAlignedBox *Convert(const gz::math::AxisAlignedBox &_data,
+                                         google::protobuf::Arena *_arena)
+{
+  auto *ret = detail::CreateOnArena<gz::msgs::AxisAlignedBox>(_arena);
+  Set(ret, _data);
+  return ret;
+}
+
 inline gz::math::AxisAlignedBox Convert(const gz::msgs::AxisAlignedBox &_msg)
 {
   gz::math::AxisAlignedBox ret;
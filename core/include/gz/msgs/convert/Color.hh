@@ -20,6 +20,8 @@
 #include <gz/msgs/config.hh>
 
 // Message Headers
+#include <google/protobuf/arena.h>
+#include "gz/msgs/detail/ArenaUtils.hh"
 #include "gz/msgs/color.pb.h"
 
 // Data Headers
@@ -50,6 +52,14 @@ inline gz::msgs::Color Convert(const gz::math::Color &_data)
   return ret;
 }
 
+inline gz::msgs::Color *Convert(const gz::math::Color &_data,
+                                google::protobuf::Arena *_arena)
+{
+  auto *ret = detail::CreateOnArena<gz::msgs::Color>(_arena);
+  Set(ret, _data);
+  return ret;
+}
+
 inline gz::math::Color Convert(const gz::msgs::Color &_msg)
 {
   gz::math::Color ret;
@@ -19,62 +19,36 @@
 
 #include <gz/msgs/config.hh>
 
+#include "gz/msgs/detail/EnumTables.hh"
+
 // Message Headers
 #include "gz/msgs/discovery.pb.h"
 
 // Data Headers
 #include <string>
+#include <string_view>
 
 namespace gz::msgs {
 // Inline bracket to help doxygen filtering.
 inline namespace GZ_MSGS_VERSION_NAMESPACE {
 
+/////////////////////////////////////////////
+inline bool ConvertDiscoveryType(std::string_view _str,
+    msgs::Discovery::Type &_type)
+{
+  int value = 0;
+  if (!detail::kDiscoveryTypeTable.Find(_str, value))
+    return false;
+  _type = static_cast<msgs::Discovery::Type>(value);
+  return true;
+}
+
 /////////////////////////////////////////////
 inline msgs::Discovery::Type ConvertDiscoveryType(const std::string &_str)
 {
   msgs::Discovery::Type result = msgs::Discovery::UNINITIALIZED;
 
-  if (_str == "UNINITIALIZED")
-  {
-    result = msgs::Discovery::UNINITIALIZED;
-  }
-  else if (_str == "ADVERTISE")
-  {
-    result = msgs::Discovery::ADVERTISE;
-  }
-  else if (_str == "SUBSCRIBE")
-  {
-    result = msgs::Discovery::SUBSCRIBE;
-  }
-  else if (_str == "UNADVERTISE")
-  {
-    result = msgs::Discovery::UNADVERTISE;
-  }
-  else if (_str == "HEARTBEAT")
-  {
-    result = msgs::Discovery::HEARTBEAT;
-  }
-  else if (_str == "BYE")
-  {
-    result = msgs::Discovery::BYE;
-  }
-  else if (_str == "NEW_CONNECTION")
-  {
-    result = msgs::Discovery::NEW_CONNECTION;
-  }
-  else if (_str == "END_CONNECTION")
-  {
-    result = msgs::Discovery::END_CONNECTION;
-  }
-  else if (_str == "SUBSCRIBERS_REQ")
-  {
-    result = msgs::Discovery::SUBSCRIBERS_REQ;
-  }
-  else if (_str == "SUBSCRIBERS_REP")
-  {
-    result = msgs::Discovery::SUBSCRIBERS_REP;
-  }
-  else
+  if (!ConvertDiscoveryType(_str, result))
   {
     std::cerr << "Unrecognized DiscoveryType["
               << _str
@@ -19,12 +19,18 @@
 
 #include <gz/msgs/config.hh>
 
+#include "gz/msgs/detail/ParallelFor.hh"
+#include "gz/msgs/detail/XmlReader.hh"
+
 // Message Headers
 #include "gz/msgs/fuel_metadata.pb.h"
 
 // Data Headers
+#include <limits>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <vector>
 #include <tinyxml2.h>
 
 #include <gz/math/SemanticVersion.hh>
@@ -34,7 +40,7 @@ namespace gz::msgs {
 inline namespace GZ_MSGS_VERSION_NAMESPACE {
 
 /////////////////////////////////////////////////
-inline bool ConvertFuelMetadata(const std::string &_modelConfigStr,
+inline bool ConvertFuelMetadata(std::string_view _modelConfigStr,
                                 msgs::FuelMetadata &_meta)
 {
   gz::msgs::FuelMetadata meta;
@@ -53,8 +59,8 @@ inline bool ConvertFuelMetadata(const std::string &_modelConfigStr,
 
   // Load the model config into tinyxml
   tinyxml2::XMLDocument modelConfigDoc;
-  if (modelConfigDoc.Parse(_modelConfigStr.c_str()) !=
-      tinyxml2::XML_SUCCESS)
+  if (modelConfigDoc.Parse(_modelConfigStr.data(),
+        _modelConfigStr.size()) != tinyxml2::XML_SUCCESS)
   {
     std::cerr << "Unable to parse model config XML string.\n";
     return false;
@@ -147,6 +153,7 @@ inline bool ConvertFuelMetadata(const std::string &_modelConfigStr,
       math::SemanticVersion ver(trimmed(verStr));
       if (ver > maxVer)
       {
+        maxVer = ver;
         gz::msgs::Version *verMsg;
 
         if (isModel)
@@ -180,10 +187,371 @@ inline bool ConvertFuelMetadata(const std::string &_modelConfigStr,
     return false;
   }
 
-  _meta.CopyFrom(meta);
+  _meta.Swap(&meta);
   return true;
 }
 
+/////////////////////////////////////////////////
+/// \brief Same as ConvertFuelMetadata, reading the config in a single
+/// pass without building an XML document. It is several times faster,
+/// which matters when indexing many configs. A <version> that is not a
+/// number is reported as an error instead of throwing std::stoi's
+/// exception.
+/// \param[in] _modelConfigStr A model.config or world.config XML string.
+/// \param[out] _meta The metadata, unchanged on failure.
+/// \return True on success.
+inline bool ConvertFuelMetadataStreaming(std::string_view _modelConfigStr,
+                                         msgs::FuelMetadata &_meta)
+{
+  // Character data of an element. Like tinyxml2's GetText, only text that
+  // comes before the first child element counts.
+  struct Text
+  {
+    std::string_view raw;
+    bool cdata = false;
+    bool found = false;
+    bool hasText = false;
+  };
+
+  struct Author
+  {
+    Text name;
+    Text email;
+  };
+
+  // Elements of the first <model> or <world> root element.
+  struct Config
+  {
+    bool found = false;
+    Text name;
+    Text version;
+    Text description;
+    std::vector<Author> authors;
+    std::vector<Text> dependencies;
+    Text sdf;
+    math::SemanticVersion sdfVersion;
+  };
+
+  Config configs[2];
+  Config *config = nullptr;
+
+  // Element whose text is being read.
+  Text *capture = nullptr;
+  size_t captureDepth = 0;
+  bool captureOpen = false;
+  auto first = [&](Text &_text, size_t _depth)
+  {
+    if (_text.found)
+      return;
+    _text.found = true;
+    capture = &_text;
+    captureDepth = _depth;
+    captureOpen = true;
+  };
+
+  // State of the current <author>, <depend> and <sdf> elements.
+  Author *author = nullptr;
+  bool inDepend = false;
+  bool dependModelSeen = false;
+  bool inDependModel = false;
+  bool uriSeen = false;
+  Text sdf;
+  bool inSdf = false;
+  bool sdfHasVersion = false;
+  std::string_view sdfVersion;
+
+  std::string value;
+  detail::XmlReader reader(_modelConfigStr);
+  for (detail::XmlToken token = reader.Next();
+       token != detail::XmlToken::DONE; token = reader.Next())
+  {
+    if (token == detail::XmlToken::ERROR)
+    {
+      std::cerr << "Unable to parse model config XML string: "
+                << reader.Error() << ".\n";
+      return false;
+    }
+
+    const size_t depth = reader.Depth();
+    if (token == detail::XmlToken::TEXT)
+    {
+      if (capture && captureOpen && depth == captureDepth &&
+          (reader.CData() || !detail::TrimXmlSpace(reader.Text()).empty()))
+      {
+        capture->raw = reader.Text();
+        capture->cdata = reader.CData();
+        capture->hasText = true;
+        captureOpen = false;
+      }
+      continue;
+    }
+
+    if (token == detail::XmlToken::END)
+    {
+      if (capture && depth == captureDepth)
+        capture = nullptr;
+      if (depth == 1)
+      {
+        config = nullptr;
+      }
+      else if (depth == 2 && config)
+      {
+        if (inSdf && sdf.hasText && sdfHasVersion)
+        {
+          detail::XmlText(sdfVersion, true, true, value);
+          math::SemanticVersion ver(value);
+          if (ver > config->sdfVersion)
+          {
+            config->sdfVersion = ver;
+            config->sdf = sdf;
+          }
+        }
+        author = nullptr;
+        inDepend = false;
+        inSdf = false;
+      }
+      else if (depth == 3)
+      {
+        inDependModel = false;
+      }
+      continue;
+    }
+
+    // Children of an element whose text is being read end its text.
+    if (capture)
+    {
+      captureOpen = false;
+      continue;
+    }
+
+    const std::string_view name = reader.Name();
+    if (depth == 1)
+    {
+      config = nullptr;
+      if (name == "model" && !configs[0].found)
+        config = &configs[0];
+      else if (name == "world" && !configs[1].found)
+        config = &configs[1];
+      if (config)
+        config->found = true;
+    }
+    else if (!config)
+    {
+      continue;
+    }
+    else if (depth == 2)
+    {
+      if (name == "name")
+      {
+        first(config->name, depth);
+      }
+      else if (name == "version")
+      {
+        first(config->version, depth);
+      }
+      else if (name == "description")
+      {
+        first(config->description, depth);
+      }
+      else if (name == "author")
+      {
+        config->authors.emplace_back();
+        author = &config->authors.back();
+      }
+      else if (name == "depend")
+      {
+        inDepend = true;
+        dependModelSeen = false;
+      }
+      else if (name == "sdf")
+      {
+        inSdf = true;
+        sdf = Text();
+        sdfHasVersion = reader.Attribute("version", sdfVersion);
+        first(sdf, depth);
+      }
+    }
+    else if (depth == 3 && author)
+    {
+      if (name == "name")
+        first(author->name, depth);
+      else if (name == "email")
+        first(author->email, depth);
+    }
+    else if (depth == 3 && inDepend && name == "model" && !dependModelSeen)
+    {
+      dependModelSeen = true;
+      inDependModel = true;
+      uriSeen = false;
+    }
+    else if (depth == 4 && inDependModel && name == "uri" && !uriSeen)
+    {
+      uriSeen = true;
+      config->dependencies.emplace_back();
+      first(config->dependencies.back(), depth);
+    }
+  }
+
+  // The first <model> element wins over any <world> element.
+  const bool isModel = configs[0].found;
+  config = isModel ? &configs[0] : &configs[1];
+  if (!config->found)
+  {
+    std::cerr << "Model config string does not contain a "
+              << "<model> or <world> element\n";
+    return false;
+  }
+  if (!config->name.hasText)
+  {
+    std::cerr << "Model config string does not contain a <name> element\n";
+    return false;
+  }
+
+  auto text = [&](const Text &_text, bool _trim, std::string &_out)
+  {
+    if (_text.hasText)
+      detail::XmlText(_text.raw, !_text.cdata, _trim, _out);
+    else
+      _out.clear();
+  };
+
+  // Same prefix that std::stoi accepts.
+  int version = 0;
+  if (config->version.hasText)
+  {
+    text(config->version, true, value);
+    const char *c = value.c_str();
+    const bool negative = *c == '-';
+    if (*c == '-' || *c == '+')
+      ++c;
+    if (*c < '0' || *c > '9')
+    {
+      std::cerr << "Model config <version> [" << value
+                << "] is not a number\n";
+      return false;
+    }
+    long long number = 0;
+    for (; *c >= '0' && *c <= '9'; ++c)
+    {
+      number = number * 10 + (*c - '0');
+      if (number > std::numeric_limits<int>::max() + 1ll)
+        break;
+    }
+    number = negative ? -number : number;
+    if (number < std::numeric_limits<int>::min() ||
+        number > std::numeric_limits<int>::max())
+    {
+      std::cerr << "Model config <version> [" << value
+                << "] is out of range\n";
+      return false;
+    }
+    version = static_cast<int>(number);
+  }
+
+  text(config->sdf, true, value);
+  if (value.empty())
+  {
+    std::cerr << "Model config string does not contain an <sdf> element\n";
+    return false;
+  }
+
+  _meta.Clear();
+  msgs::VersionedName *format;
+  if (isModel)
+  {
+    _meta.mutable_model()->set_file(value);
+    format = _meta.mutable_model()->mutable_file_format();
+  }
+  else
+  {
+    _meta.mutable_world()->set_file(value);
+    format = _meta.mutable_world()->mutable_file_format();
+  }
+  const math::SemanticVersion &ver = config->sdfVersion;
+  format->set_name("sdf");
+  format->mutable_version()->set_major(ver.Major());
+  format->mutable_version()->set_minor(ver.Minor());
+  format->mutable_version()->set_patch(ver.Patch());
+  format->mutable_version()->set_prerelease(ver.Prerelease());
+  format->mutable_version()->set_build(ver.Build());
+
+  text(config->name, true, *_meta.mutable_name());
+  if (config->version.hasText)
+    _meta.set_version(version);
+  if (config->description.hasText)
+    text(config->description, true, *_meta.mutable_description());
+
+  for (const Author &a : config->authors)
+  {
+    msgs::FuelMetadata::Contact *contact = _meta.add_authors();
+    if (a.name.hasText)
+      text(a.name, true, *contact->mutable_name());
+    if (a.email.hasText)
+      text(a.email, true, *contact->mutable_email());
+  }
+  for (const Text &uri : config->dependencies)
+    text(uri, false, *_meta.add_dependencies()->mutable_uri());
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Convert many configs with ConvertFuelMetadataStreaming, spread
+/// over several threads. The threads are started on every call, so
+/// convert configs in large batches rather than a few at a time.
+/// \param[in] _configs model.config or world.config XML strings.
+/// \param[out] _metas One message per config. A config that fails to
+/// convert leaves its message cleared.
+/// \param[in] _threads Maximum number of threads, zero for all cores.
+/// \param[out] _failed Optional indices of the configs that failed to
+/// convert, in increasing order.
+/// \return Number of configs converted.
+inline size_t ConvertFuelMetadata(
+    const std::vector<std::string_view> &_configs,
+    std::vector<msgs::FuelMetadata> &_metas, unsigned int _threads = 0,
+    std::vector<size_t> *_failed = nullptr)
+{
+  // A config takes microseconds, so a few dozen are worth a thread.
+  const size_t kMinConfigsPerThread = 64;
+
+  _metas.resize(_configs.size());
+  const unsigned int ranges = detail::ParallelRanges(_configs.size(),
+      _threads, kMinConfigsPerThread);
+  std::vector<std::vector<size_t>> failed(ranges);
+  detail::ParallelFor(_configs.size(), ranges,
+      [&](size_t _begin, size_t _end, unsigned int _range)
+      {
+        for (size_t i = _begin; i < _end; ++i)
+        {
+          if (!ConvertFuelMetadataStreaming(_configs[i], _metas[i]))
+          {
+            _metas[i].Clear();
+            failed[_range].push_back(i);
+          }
+        }
+      });
+
+  size_t failedCount = 0;
+  if (_failed)
+    _failed->clear();
+  for (const std::vector<size_t> &rangeFailed : failed)
+  {
+    failedCount += rangeFailed.size();
+    if (_failed)
+      _failed->insert(_failed->end(), rangeFailed.begin(), rangeFailed.end());
+  }
+  return _configs.size() - failedCount;
+}
+
+/////////////////////////////////////////////////
+inline size_t ConvertFuelMetadata(const std::vector<std::string> &_configs,
+    std::vector<msgs::FuelMetadata> &_metas, unsigned int _threads = 0,
+    std::vector<size_t> *_failed = nullptr)
+{
+  const std::vector<std::string_view> views(_configs.begin(),
+      _configs.end());
+  return ConvertFuelMetadata(views, _metas, _threads, _failed);
+}
+
 /////////////////////////////////////////////////
 inline bool ConvertFuelMetadata(const msgs::FuelMetadata &_meta,
                                 std::string &_modelConfigStr)
@@ -19,65 +19,35 @@
 
 #include <gz/msgs/config.hh>
 
+#include "gz/msgs/detail/EnumTables.hh"
+
 // Message Headers
 #include "gz/msgs/geometry.pb.h"
 
 // Data Headers
 #include <string>
+#include <string_view>
 
 namespace gz::msgs {
 // Inline bracket to help doxygen filtering.
 inline namespace GZ_MSGS_VERSION_NAMESPACE {
 
+/////////////////////////////////////////////////
+inline bool ConvertGeometryType(std::string_view _str,
+    msgs::Geometry::Type &_type)
+{
+  int value = 0;
+  if (!detail::kGeometryTypeTable.Find(_str, value))
+    return false;
+  _type = static_cast<msgs::Geometry::Type>(value);
+  return true;
+}
+
 /////////////////////////////////////////////////
 inline msgs::Geometry::Type ConvertGeometryType(const std::string &_str)
 {
   msgs::Geometry::Type result = msgs::Geometry::BOX;
-  if (_str == "box")
-  {
-    result = msgs::Geometry::BOX;
-  }
-  else if (_str == "capsule")
-  {
-    result = msgs::Geometry::CAPSULE;
-  }
-  else if (_str == "cone")
-  {
-    result = msgs::Geometry::CONE;
-  }
-  else if (_str == "cylinder")
-  {
-    result = msgs::Geometry::CYLINDER;
-  }
-  else if (_str == "ellipsoid")
-  {
-    result = msgs::Geometry::ELLIPSOID;
-  }
-  else if (_str == "sphere")
-  {
-    result = msgs::Geometry::SPHERE;
-  }
-  else if (_str == "plane")
-  {
-    result = msgs::Geometry::PLANE;
-  }
-  else if (_str == "image")
-  {
-    result = msgs::Geometry::IMAGE;
-  }
-  else if (_str == "heightmap")
-  {
-    result = msgs::Geometry::HEIGHTMAP;
-  }
-  else if (_str == "mesh")
-  {
-    result = msgs::Geometry::MESH;
-  }
-  else if (_str == "polyline")
-  {
-    result = msgs::Geometry::POLYLINE;
-  }
-  else
+  if (!ConvertGeometryType(_str, result))
   {
     std::cerr << "Unrecognized Geometry::Type ["
               << _str
@@ -22,6 +22,8 @@
 #include <gz/msgs/convert/Vector3.hh>
 
 // Message Headers
+#include <google/protobuf/arena.h>
+#include "gz/msgs/detail/ArenaUtils.hh"
 #include "gz/msgs/inertial.pb.h"
 
 // Data Headers
@@ -63,35 +65,31 @@ inline gz::msgs::Inertial Convert(const gz::math::MassMatrix3d &_data)
   return ret;
 }
 
+inline gz::msgs::Inertial *Convert(const gz::math::MassMatrix3d &_data,
+                                   google::protobuf::Arena *_arena)
+{
+  auto *ret = detail::CreateOnArena<gz::msgs::Inertial>(_arena);
+  Set(ret, _data);
+  return ret;
+}
+
 /////////////////////////////////
 inline void Set(gz::msgs::Inertial *_msg, const gz::math::Inertiald &_data)
 {
   Set(_msg, _data.MassMatrix());
   Set(_msg->mutable_pose(), _data.Pose());
 
+  _msg->clear_fluid_added_mass();
   if (_data.FluidAddedMass().has_value())
   {
-    _msg->add_fluid_added_mass(_data.FluidAddedMass().value()(0, 0));
-    _msg->add_fluid_added_mass(_data.FluidAddedMass().value()(0, 1));
-    _msg->add_fluid_added_mass(_data.FluidAddedMass().value()(0, 2));
-    _msg->add_fluid_added_mass(_data.FluidAddedMass().value()(0, 3));
-    _msg->add_fluid_added_mass(_data.FluidAddedMass().value()(0, 4));
-    _msg->add_fluid_added_mass(_data.FluidAddedMass().value()(0, 5));
-    _msg->add_fluid_added_mass(_data.FluidAddedMass().value()(1, 1));
-    _msg->add_fluid_added_mass(_data.FluidAddedMass().value()(1, 2));
-    _msg->add_fluid_added_mass(_data.FluidAddedMass().value()(1, 3));
-    _msg->add_fluid_added_mass(_data.FluidAddedMass().value()(1, 4));
-    _msg->add_fluid_added_mass(_data.FluidAddedMass().value()(1, 5));
-    _msg->add_fluid_added_mass(_data.FluidAddedMass().value()(2, 2));
-    _msg->add_fluid_added_mass(_data.FluidAddedMass().value()(2, 3));
-    _msg->add_fluid_added_mass(_data.FluidAddedMass().value()(2, 4));
-    _msg->add_fluid_added_mass(_data.FluidAddedMass().value()(2, 5));
-    _msg->add_fluid_added_mass(_data.FluidAddedMass().value()(3, 3));
-    _msg->add_fluid_added_mass(_data.FluidAddedMass().value()(3, 4));
-    _msg->add_fluid_added_mass(_data.FluidAddedMass().value()(3, 5));
-    _msg->add_fluid_added_mass(_data.FluidAddedMass().value()(4, 4));
-    _msg->add_fluid_added_mass(_data.FluidAddedMass().value()(4, 5));
-    _msg->add_fluid_added_mass(_data.FluidAddedMass().value()(5, 5));
+    // Upper triangle of the symmetric 6x6 matrix, row by row.
+    const math::Matrix6d addedMass = _data.FluidAddedMass().value();
+    _msg->mutable_fluid_added_mass()->Reserve(21);
+    for (size_t row = 0; row < 6; ++row)
+    {
+      for (size_t col = row; col < 6; ++col)
+        _msg->add_fluid_added_mass(addedMass(row, col));
+    }
   }
 }
 
@@ -161,6 +159,14 @@ inline gz::msgs::Inertial Convert(const gz::math::Inertiald &_data)
   return ret;
 }
 
+inline gz::msgs::Inertial *Convert(const gz::math::Inertiald &_data,
+                                   google::protobuf::Arena *_arena)
+{
+  auto *ret = detail::CreateOnArena<gz::msgs::Inertial>(_arena);
+  Set(ret, _data);
+  return ret;
+}
+
 inline gz::math::Inertiald Convert(const gz::msgs::Inertial &_msg)
 {
   gz::math::Inertiald ret;
@@ -19,57 +19,34 @@
 
 #include <gz/msgs/config.hh>
 
+#include "gz/msgs/detail/EnumTables.hh"
+
 // Message Headers
 #include "gz/msgs/joint.pb.h"
 
 // Data Headers
 #include <string>
+#include <string_view>
 
 namespace gz::msgs {
 // Inline bracket to help doxygen filtering.
 inline namespace GZ_MSGS_VERSION_NAMESPACE {
 
+/////////////////////////////////////////////
+inline bool ConvertJointType(std::string_view _str, msgs::Joint::Type &_type)
+{
+  int value = 0;
+  if (!detail::kJointTypeTable.Find(_str, value))
+    return false;
+  _type = static_cast<msgs::Joint::Type>(value);
+  return true;
+}
+
 /////////////////////////////////////////////
 inline msgs::Joint::Type ConvertJointType(const std::string &_str)
 {
   msgs::Joint::Type result = msgs::Joint::REVOLUTE;
-  if (_str == "revolute")
-  {
-    result = msgs::Joint::REVOLUTE;
-  }
-  else if (_str == "revolute2")
-  {
-    result = msgs::Joint::REVOLUTE2;
-  }
-  else if (_str == "prismatic")
-  {
-    result = msgs::Joint::PRISMATIC;
-  }
-  else if (_str == "universal")
-  {
-    result = msgs::Joint::UNIVERSAL;
-  }
-  else if (_str == "ball")
-  {
-    result = msgs::Joint::BALL;
-  }
-  else if (_str == "screw")
-  {
-    result = msgs::Joint::SCREW;
-  }
-  else if (_str == "gearbox")
-  {
-    result = msgs::Joint::GEARBOX;
-  }
-  else if (_str == "fixed")
-  {
-    result = msgs::Joint::FIXED;
-  }
-  else if (_str == "continuous")
-  {
-    result = msgs::Joint::CONTINUOUS;
-  }
-  else
+  if (!ConvertJointType(_str, result))
   {
     std::cerr << "Unrecognized JointType ["
               << _str
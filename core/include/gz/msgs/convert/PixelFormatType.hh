@@ -19,93 +19,36 @@
 
 #include <gz/msgs/config.hh>
 
+#include "gz/msgs/detail/EnumTables.hh"
+
 // Message Headers
 #include "gz/msgs/image.pb.h"
 
 // Data Headers
 #include <string>
+#include <string_view>
 
 namespace gz::msgs {
 // Inline bracket to help doxygen filtering.
 inline namespace GZ_MSGS_VERSION_NAMESPACE {
 
 /////////////////////////////////////////////
-inline msgs::PixelFormatType ConvertPixelFormatType(const std::string &_str)
+inline bool ConvertPixelFormatType(std::string_view _str,
+    msgs::PixelFormatType &_type)
 {
-  if (_str == "L_INT8")
-  {
-    return msgs::PixelFormatType::L_INT8;
-  }
-  else if (_str == "L_INT16")
-  {
-    return msgs::PixelFormatType::L_INT16;
-  }
-  else if (_str == "RGB_INT8")
-  {
-    return msgs::PixelFormatType::RGB_INT8;
-  }
-  else if (_str == "RGBA_INT8")
-  {
-    return msgs::PixelFormatType::RGBA_INT8;
-  }
-  else if (_str == "BGRA_INT8")
-  {
-    return msgs::PixelFormatType::BGRA_INT8;
-  }
-  else if (_str == "RGB_INT16")
-  {
-    return msgs::PixelFormatType::RGB_INT16;
-  }
-  else if (_str == "RGB_INT32")
-  {
-    return msgs::PixelFormatType::RGB_INT32;
-  }
-  else if (_str == "BGR_INT8")
-  {
-    return msgs::PixelFormatType::BGR_INT8;
-  }
-  else if (_str == "BGR_INT16")
-  {
-    return msgs::PixelFormatType::BGR_INT16;
-  }
-  else if (_str == "BGR_INT32")
-  {
-    return msgs::PixelFormatType::BGR_INT32;
-  }
-  else if (_str == "R_FLOAT16")
-  {
-    return msgs::PixelFormatType::R_FLOAT16;
-  }
-  else if (_str == "RGB_FLOAT16")
-  {
-    return msgs::PixelFormatType::RGB_FLOAT16;
-  }
-  else if (_str == "R_FLOAT32")
-  {
-    return msgs::PixelFormatType::R_FLOAT32;
-  }
-  else if (_str == "RGB_FLOAT32")
-  {
-    return msgs::PixelFormatType::RGB_FLOAT32;
-  }
-  else if (_str == "BAYER_RGGB8")
-  {
-    return msgs::PixelFormatType::BAYER_RGGB8;
-  }
-  else if (_str == "BAYER_BGGR8")
-  {
-    return msgs::PixelFormatType::BAYER_BGGR8;
-  }
-  else if (_str == "BAYER_GBRG8")
-  {
-    return msgs::PixelFormatType::BAYER_GBRG8;
-  }
-  else if (_str == "BAYER_GRBG8")
-  {
-    return msgs::PixelFormatType::BAYER_GRBG8;
-  }
+  int value = 0;
+  if (!detail::kPixelFormatTypeTable.Find(_str, value))
+    return false;
+  _type = static_cast<msgs::PixelFormatType>(value);
+  return true;
+}
 
-  return msgs::PixelFormatType::UNKNOWN_PIXEL_FORMAT;
+/////////////////////////////////////////////
+inline msgs::PixelFormatType ConvertPixelFormatType(const std::string &_str)
+{
+  msgs::PixelFormatType result = msgs::PixelFormatType::UNKNOWN_PIXEL_FORMAT;
+  ConvertPixelFormatType(_str, result);
+  return result;
 }
 
 /////////////////////////////////////////////
@@ -22,6 +22,8 @@
 #include <gz/msgs/convert/Vector3.hh>
 
 // Message Headers
+#include <google/protobuf/arena.h>
+#include "gz/msgs/detail/ArenaUtils.hh"
 #include "gz/msgs/planegeom.pb.h"
 
 // Data Headers
@@ -56,6 +58,14 @@ inline gz::msgs::PlaneGeom Convert(const gz::math::Planed &_data)
   return ret;
 }
 
+inline gz::msgs::PlaneGeom *Convert(const gz::math::Planed &_data,
+                                    google::protobuf::Arena *_arena)
+{
+  auto *ret = detail::CreateOnArena<gz::msgs::PlaneGeom>(_arena);
+  Set(ret, _data);
+  return ret;
+}
+
 inline gz::math::Planed Convert(const gz::msgs::PlaneGeom &_msg)
 {
   gz::math::Planed ret;
@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_MSGS_CONVERT_POINTCLOUD_HH_
+#define GZ_MSGS_CONVERT_POINTCLOUD_HH_
+
+#include <gz/msgs/config.hh>
+#include <gz/msgs/detail/PointCloudPackedUtils.hh>
+
+// Message Headers
+#include <google/protobuf/arena.h>
+#include "gz/msgs/detail/ArenaUtils.hh"
+#include "gz/msgs/pointcloud.pb.h"
+#include "gz/msgs/pointcloud_packed.pb.h"
+
+// Data Headers
+#include <cmath>
+#include <string>
+#include <vector>
+#include <gz/math/Vector3.hh>
+
+namespace gz::msgs {
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_MSGS_VERSION_NAMESPACE {
+
+/////////////////////////////////
+inline void Set(gz::msgs::PointCloud *_msg,
+                const std::vector<gz::math::Vector3d> &_data)
+{
+  auto *points = _msg->mutable_points();
+  const int size = static_cast<int>(_data.size());
+  if (points->size() > size)
+    points->DeleteSubrange(size, points->size() - size);
+  points->Reserve(size);
+
+  const int reused = points->size();
+  for (int i = 0; i < size; ++i)
+  {
+    gz::msgs::Vector3d *point = i < reused ? points->Mutable(i) : points->Add();
+    point->set_x(_data[i].X());
+    point->set_y(_data[i].Y());
+    point->set_z(_data[i].Z());
+  }
+}
+
+inline void Set(std::vector<gz::math::Vector3d> *_data,
+                const gz::msgs::PointCloud &_msg)
+{
+  _data->clear();
+  _data->reserve(_msg.points_size());
+  for (const gz::msgs::Vector3d &point : _msg.points())
+    _data->emplace_back(point.x(), point.y(), point.z());
+}
+
+inline gz::msgs::PointCloud Convert(
+    const std::vector<gz::math::Vector3d> &_data)
+{
+  gz::msgs::PointCloud ret;
+  Set(&ret, _data);
+  return ret;
+}
+
+inline gz::msgs::PointCloud *Convert(
+    const std::vector<gz::math::Vector3d> &_data,
+    google::protobuf::Arena *_arena)
+{
+  auto *ret = detail::CreateOnArena<gz::msgs::PointCloud>(_arena);
+  Set(ret, _data);
+  return ret;
+}
+
+inline std::vector<gz::math::Vector3d> Convert(
+    const gz::msgs::PointCloud &_msg)
+{
+  std::vector<gz::math::Vector3d> ret;
+  Set(&ret, _msg);
+  return ret;
+}
+
+/////////////////////////////////
+inline void Set(gz::msgs::PointCloudPacked *_msg,
+                const std::vector<gz::math::Vector3d> &_data)
+{
+  size_t offsets[3];
+  gz::msgs::PointCloudPacked::Field::DataType type{
+      gz::msgs::PointCloudPacked::Field::FLOAT32};
+  detail::InitXyzCloud(*_msg, _data.size(), offsets, type);
+  if (_data.empty())
+    return;
+
+  bool dense = true;
+  auto xyz = [&](size_t _i, double (&_xyz)[3])
+  {
+    _xyz[0] = _data[_i].X();
+    _xyz[1] = _data[_i].Y();
+    _xyz[2] = _data[_i].Z();
+    dense &= std::isfinite(_xyz[0] + _xyz[1] + _xyz[2]);
+  };
+  char *data = &(*_msg->mutable_data())[0];
+  if (type == gz::msgs::PointCloudPacked::Field::FLOAT32)
+    detail::StoreXyz<float>(data, _msg->point_step(), offsets, _data.size(),
+        xyz);
+  else
+    detail::StoreXyz<double>(data, _msg->point_step(), offsets, _data.size(),
+        xyz);
+  _msg->set_is_dense(dense);
+}
+
+inline void Set(std::vector<gz::math::Vector3d> *_data,
+                const gz::msgs::PointCloudPacked &_msg)
+{
+  static const std::string kXyzNames[3] = {"x", "y", "z"};
+  _data->clear();
+
+  size_t offsets[3];
+  gz::msgs::PointCloudPacked::Field::DataType type{
+      gz::msgs::PointCloudPacked::Field::FLOAT32};
+  if (!detail::FindVectorFields(_msg, kXyzNames, offsets, type))
+    return;
+
+  const detail::PointCloudPackedLayout layout = detail::Layout(_msg);
+  _data->resize(layout.rows * layout.cols);
+  auto xyz = [&](size_t _i, double _x, double _y, double _z)
+  {
+    (*_data)[_i].Set(_x, _y, _z);
+  };
+  if (type == gz::msgs::PointCloudPacked::Field::FLOAT32)
+    detail::LoadXyz<float>(_msg.data().data(), layout, offsets, xyz);
+  else
+    detail::LoadXyz<double>(_msg.data().data(), layout, offsets, xyz);
+}
+
+inline std::vector<gz::math::Vector3d> Convert(
+    const gz::msgs::PointCloudPacked &_msg)
+{
+  std::vector<gz::math::Vector3d> ret;
+  Set(&ret, _msg);
+  return ret;
+}
+
+/////////////////////////////////
+inline void Set(gz::msgs::PointCloudPacked *_msg,
+                const gz::msgs::PointCloud &_data)
+{
+  *_msg->mutable_header() = _data.header();
+
+  size_t offsets[3];
+  gz::msgs::PointCloudPacked::Field::DataType type{
+      gz::msgs::PointCloudPacked::Field::FLOAT32};
+  const size_t size = _data.points_size();
+  detail::InitXyzCloud(*_msg, size, offsets, type);
+  if (size == 0)
+    return;
+
+  bool dense = true;
+  auto xyz = [&](size_t _i, double (&_xyz)[3])
+  {
+    const gz::msgs::Vector3d &point = _data.points(static_cast<int>(_i));
+    _xyz[0] = point.x();
+    _xyz[1] = point.y();
+    _xyz[2] = point.z();
+    dense &= std::isfinite(_xyz[0] + _xyz[1] + _xyz[2]);
+  };
+  char *data = &(*_msg->mutable_data())[0];
+  if (type == gz::msgs::PointCloudPacked::Field::FLOAT32)
+    detail::StoreXyz<float>(data, _msg->point_step(), offsets, size, xyz);
+  else
+    detail::StoreXyz<double>(data, _msg->point_step(), offsets, size, xyz);
+  _msg->set_is_dense(dense);
+}
+
+inline void Set(gz::msgs::PointCloud *_msg,
+                const gz::msgs::PointCloudPacked &_data)
+{
+  static const std::string kXyzNames[3] = {"x", "y", "z"};
+  *_msg->mutable_header() = _data.header();
+
+  size_t offsets[3];
+  gz::msgs::PointCloudPacked::Field::DataType type{
+      gz::msgs::PointCloudPacked::Field::FLOAT32};
+  const bool hasXyz = detail::FindVectorFields(_data, kXyzNames, offsets,
+      type);
+  const detail::PointCloudPackedLayout layout = detail::Layout(_data);
+  const int size = hasXyz ? static_cast<int>(layout.rows * layout.cols) : 0;
+
+  auto *points = _msg->mutable_points();
+  if (points->size() > size)
+    points->DeleteSubrange(size, points->size() - size);
+  points->Reserve(size);
+  while (points->size() < size)
+    points->Add();
+  if (size == 0)
+    return;
+
+  auto xyz = [&](size_t _i, double _x, double _y, double _z)
+  {
+    gz::msgs::Vector3d *point = points->Mutable(static_cast<int>(_i));
+    point->set_x(_x);
+    point->set_y(_y);
+    point->set_z(_z);
+  };
+  if (type == gz::msgs::PointCloudPacked::Field::FLOAT32)
+    detail::LoadXyz<float>(_data.data().data(), layout, offsets, xyz);
+  else
+    detail::LoadXyz<double>(_data.data().data(), layout, offsets, xyz);
+}
+}  // namespace
+}  // namespace gz::msgs
+#endif  // GZ_MSGS_CONVERT_POINTCLOUD_HH_
@@ -22,10 +22,16 @@
 #include <gz/msgs/convert/Quaternion.hh>
 
 // Message Headers
+#include <google/protobuf/arena.h>
+#include "gz/msgs/detail/ArenaUtils.hh"
 #include "gz/msgs/quaternion.pb.h"
 #include "gz/msgs/pose.pb.h"
+#include "gz/msgs/pose_v.pb.h"
 
 // Data Headers
+#include <algorithm>
+#include <cstddef>
+#include <vector>
 #include <gz/math/Pose3.hh>
 
 namespace gz::msgs {
@@ -41,18 +47,21 @@ inline void Set(gz::msgs::Pose *_msg, const gz::math::Pose3d &_data)
 
 inline void Set(gz::math::Pose3d *_data, const gz::msgs::Pose &_msg)
 {
-  gz::math::Vector3d pos;
-  gz::math::Quaterniond orientation;
-
-  if (_msg.has_position())
-    pos = Convert(_msg.position());
+  // A missing position reads as the default message, i.e. zero.
+  const gz::msgs::Vector3d &pos = _msg.position();
+  _data->Pos().Set(pos.x(), pos.y(), pos.z());
 
   // This bit is critical.  If orientation hasn't been set in the message,
   // then we want the quaternion to default to identity.
   if (_msg.has_orientation())
-    orientation = Convert(_msg.orientation());
-
-  _data->Set(pos, orientation);
+  {
+    const gz::msgs::Quaternion &rot = _msg.orientation();
+    _data->Rot().Set(rot.w(), rot.x(), rot.y(), rot.z());
+  }
+  else
+  {
+    _data->Rot() = gz::math::Quaterniond::Identity;
+  }
 }
 
 inline gz::msgs::Pose Convert(const gz::math::Pose3d &_data)
@@ -62,12 +71,91 @@ inline gz::msgs::Pose Convert(const gz::math::Pose3d &_data)
   return ret;
 }
 
+inline gz::msgs::Pose *Convert(const gz::math::Pose3d &_data,
+                               google::protobuf::Arena *_arena)
+{
+  auto *ret = detail::CreateOnArena<gz::msgs::Pose>(_arena);
+  Set(ret, _data);
+  return ret;
+}
+
 inline gz::math::Pose3d Convert(const gz::msgs::Pose &_msg)
 {
   gz::math::Pose3d ret;
   Set(&ret, _msg);
   return ret;
 }
+
+/////////////////////////////////
+inline void Set(gz::msgs::Pose_V *_msg, const gz::math::Pose3d *_data,
+                size_t _size)
+{
+  auto *poses = _msg->mutable_pose();
+  const int size = static_cast<int>(_size);
+  if (poses->size() > size)
+    poses->DeleteSubrange(size, poses->size() - size);
+  poses->Reserve(size);
+
+  const int reused = poses->size();
+  for (int i = 0; i < size; ++i)
+  {
+    gz::msgs::Pose *pose = i < reused ? poses->Mutable(i) : poses->Add();
+    const gz::math::Vector3d &pos = _data[i].Pos();
+    const gz::math::Quaterniond &rot = _data[i].Rot();
+    gz::msgs::Vector3d *position = pose->mutable_position();
+    position->set_x(pos.X());
+    position->set_y(pos.Y());
+    position->set_z(pos.Z());
+    gz::msgs::Quaternion *orientation = pose->mutable_orientation();
+    orientation->set_w(rot.W());
+    orientation->set_x(rot.X());
+    orientation->set_y(rot.Y());
+    orientation->set_z(rot.Z());
+  }
+}
+
+inline void Set(gz::msgs::Pose_V *_msg,
+                const std::vector<gz::math::Pose3d> &_data)
+{
+  Set(_msg, _data.data(), _data.size());
+}
+
+inline void Set(gz::math::Pose3d *_data, size_t _size,
+                const gz::msgs::Pose_V &_msg)
+{
+  const size_t size = std::min(_size, static_cast<size_t>(_msg.pose_size()));
+  for (size_t i = 0; i < size; ++i)
+    Set(_data + i, _msg.pose(static_cast<int>(i)));
+}
+
+inline void Set(std::vector<gz::math::Pose3d> *_data,
+                const gz::msgs::Pose_V &_msg)
+{
+  _data->resize(_msg.pose_size());
+  Set(_data->data(), _data->size(), _msg);
+}
+
+inline gz::msgs::Pose_V Convert(const std::vector<gz::math::Pose3d> &_data)
+{
+  gz::msgs::Pose_V ret;
+  Set(&ret, _data);
+  return ret;
+}
+
+inline gz::msgs::Pose_V *Convert(const std::vector<gz::math::Pose3d> &_data,
+                                 google::protobuf::Arena *_arena)
+{
+  auto *ret = detail::CreateOnArena<gz::msgs::Pose_V>(_arena);
+  Set(ret, _data);
+  return ret;
+}
+
+inline std::vector<gz::math::Pose3d> Convert(const gz::msgs::Pose_V &_msg)
+{
+  std::vector<gz::math::Pose3d> ret;
+  Set(&ret, _msg);
+  return ret;
+}
 }  // namespace
 }  // namespace gz::msgs
 
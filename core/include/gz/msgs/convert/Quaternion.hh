@@ -20,6 +20,8 @@
 #include <gz/msgs/config.hh>
 
 // Message Headers
+#include <google/protobuf/arena.h>
+#include "gz/msgs/detail/ArenaUtils.hh"
 #include "gz/msgs/quaternion.pb.h"
 
 // Data Headers
@@ -50,6 +52,14 @@ inline gz::msgs::Quaternion Convert(const gz::math::Quaterniond &_data)
   return ret;
 }
 
+inline gz::msgs::Quaternion *Convert(const gz::math::Quaterniond &_data,
+                                     google::protobuf::Arena *_arena)
+{
+  auto *ret = detail::CreateOnArena<gz::msgs::Quaternion>(_arena);
+  Set(ret, _data);
+  return ret;
+}
+
 inline gz::math::Quaterniond Convert(const gz::msgs::Quaternion &_msg)
 {
   gz::math::Quaterniond ret;
@@ -19,37 +19,35 @@
 
 #include <gz/msgs/config.hh>
 
+#include "gz/msgs/detail/EnumTables.hh"
+
 // Message Headers
 #include "gz/msgs/material.pb.h"
 
 // Data Headers
 #include <string>
+#include <string_view>
 
 namespace gz::msgs {
 // Inline bracket to help doxygen filtering.
 inline namespace GZ_MSGS_VERSION_NAMESPACE {
 
+/////////////////////////////////////////////////
+inline bool ConvertShaderType(std::string_view _str,
+    msgs::Material::ShaderType &_type)
+{
+  int value = 0;
+  if (!detail::kShaderTypeTable.Find(_str, value))
+    return false;
+  _type = static_cast<msgs::Material::ShaderType>(value);
+  return true;
+}
+
 /////////////////////////////////////////////////
 inline msgs::Material::ShaderType ConvertShaderType(const std::string &_str)
 {
   auto result = msgs::Material::VERTEX;
-  if (_str == "vertex")
-  {
-    result = msgs::Material::VERTEX;
-  }
-  else if (_str == "pixel")
-  {
-    result = msgs::Material::PIXEL;
-  }
-  else if (_str == "normal_map_object_space")
-  {
-    result = msgs::Material::NORMAL_MAP_OBJECT_SPACE;
-  }
-  else if (_str == "normal_map_tangent_space")
-  {
-    result = msgs::Material::NORMAL_MAP_TANGENT_SPACE;
-  }
-  else
+  if (!ConvertShaderType(_str, result))
   {
     std::cerr << "Unrecognized Material::ShaderType ["
               << _str
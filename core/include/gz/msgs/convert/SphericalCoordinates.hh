@@ -20,6 +20,8 @@
 #include <gz/msgs/config.hh>
 
 // Message Headers
+#include <google/protobuf/arena.h>
+#include "gz/msgs/detail/ArenaUtils.hh"
 #include "gz/msgs/spherical_coordinates.pb.h"
 
 // Data Headers
@@ -154,6 +156,15 @@ Convert(const gz::math::SphericalCoordinates &_data)
   return ret;
 }
 
+inline gz::msgs::SphericalCoordinates *Convert(
+    const gz::math::SphericalCoordinates &_data,
+    google::protobuf::Arena *_arena)
+{
+  auto *ret = detail::CreateOnArena<gz::msgs::SphericalCoordinates>(_arena);
+  Set(ret, _data);
+  return ret;
+}
+
 inline gz::math::SphericalCoordinates
   Convert(const gz::msgs::SphericalCoordinates &_msg)
 {
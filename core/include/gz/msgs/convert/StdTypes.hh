@@ -21,6 +21,8 @@
 #include <gz/msgs/config.hh>
 
 // Message Headers
+#include <google/protobuf/arena.h>
+#include "gz/msgs/detail/ArenaUtils.hh"
 #include "gz/msgs/boolean.pb.h"
 #include "gz/msgs/double.pb.h"
 #include "gz/msgs/float.pb.h"
@@ -34,6 +36,7 @@
 // Data Headers
 #include <chrono>
 #include <string>
+#include <string_view>
 #include <utility>
 
 namespace gz::msgs {
@@ -46,7 +49,6 @@ inline void Set(gz::msgs::Time *_msg,
 {
   std::pair<uint64_t, uint64_t> timeSecAndNsecs =
         gz::math::durationToSecNsec(_data);
-  msgs::Time msg;
   _msg->set_sec(timeSecAndNsecs.first);
   _msg->set_nsec(static_cast<int32_t>(timeSecAndNsecs.second));
 }
@@ -66,6 +68,14 @@ inline gz::msgs::Time Convert(const std::chrono::steady_clock::duration &_data)
   return ret;
 }
 
+inline gz::msgs::Time *Convert(const std::chrono::steady_clock::duration &_data,
+                               google::protobuf::Arena *_arena)
+{
+  auto *ret = detail::CreateOnArena<gz::msgs::Time>(_arena);
+  Set(ret, _data);
+  return ret;
+}
+
 inline std::chrono::steady_clock::duration
 Convert(const gz::msgs::Time &_msg)
 {
@@ -85,11 +95,26 @@ inline void Set(gz::msgs::StringMsg *_msg, const char *_data)
   _msg->set_data(_data);
 }
 
+inline void Set(gz::msgs::StringMsg *_msg, std::string &&_data)
+{
+  _msg->set_data(std::move(_data));
+}
+
+inline void Set(gz::msgs::StringMsg *_msg, std::string_view _data)
+{
+  _msg->mutable_data()->assign(_data.data(), _data.size());
+}
+
 inline void Set(std::string *_data, const gz::msgs::StringMsg &_msg)
 {
   *_data = _msg.data();
 }
 
+inline void Set(std::string *_data, gz::msgs::StringMsg &&_msg)
+{
+  *_data = std::move(*_msg.mutable_data());
+}
+
 inline gz::msgs::StringMsg Convert(const std::string &_data)
 {
   gz::msgs::StringMsg ret;
@@ -97,6 +122,44 @@ inline gz::msgs::StringMsg Convert(const std::string &_data)
   return ret;
 }
 
+inline gz::msgs::StringMsg *Convert(const std::string &_data,
+                                    google::protobuf::Arena *_arena)
+{
+  auto *ret = detail::CreateOnArena<gz::msgs::StringMsg>(_arena);
+  Set(ret, _data);
+  return ret;
+}
+
+inline gz::msgs::StringMsg Convert(std::string &&_data)
+{
+  gz::msgs::StringMsg ret;
+  Set(&ret, std::move(_data));
+  return ret;
+}
+
+inline gz::msgs::StringMsg *Convert(std::string &&_data,
+                                    google::protobuf::Arena *_arena)
+{
+  auto *ret = detail::CreateOnArena<gz::msgs::StringMsg>(_arena);
+  Set(ret, std::move(_data));
+  return ret;
+}
+
+inline gz::msgs::StringMsg Convert(std::string_view _data)
+{
+  gz::msgs::StringMsg ret;
+  Set(&ret, _data);
+  return ret;
+}
+
+inline gz::msgs::StringMsg *Convert(std::string_view _data,
+                                    google::protobuf::Arena *_arena)
+{
+  auto *ret = detail::CreateOnArena<gz::msgs::StringMsg>(_arena);
+  Set(ret, _data);
+  return ret;
+}
+
 inline std::string Convert(const gz::msgs::StringMsg &_msg)
 {
   std::string ret;
@@ -104,6 +167,13 @@ inline std::string Convert(const gz::msgs::StringMsg &_msg)
   return ret;
 }
 
+inline std::string Convert(gz::msgs::StringMsg &&_msg)
+{
+  std::string ret;
+  Set(&ret, std::move(_msg));
+  return ret;
+}
+
 /////////////////////////////////
 inline void Set(gz::msgs::Boolean *_msg, const bool &_data)
 {
@@ -122,6 +192,14 @@ inline gz::msgs::Boolean Convert(const bool &_data)
   return ret;
 }
 
+inline gz::msgs::Boolean *Convert(const bool &_data,
+                                  google::protobuf::Arena *_arena)
+{
+  auto *ret = detail::CreateOnArena<gz::msgs::Boolean>(_arena);
+  Set(ret, _data);
+  return ret;
+}
+
 inline bool Convert(const gz::msgs::Boolean &_msg)
 {
   bool ret;
@@ -147,6 +225,14 @@ inline gz::msgs::Int32 Convert(const int32_t &_data)
   return ret;
 }
 
+inline gz::msgs::Int32 *Convert(const int32_t &_data,
+                                google::protobuf::Arena *_arena)
+{
+  auto *ret = detail::CreateOnArena<gz::msgs::Int32>(_arena);
+  Set(ret, _data);
+  return ret;
+}
+
 inline int32_t Convert(const gz::msgs::Int32 &_msg)
 {
   int32_t ret;
@@ -172,6 +258,14 @@ inline gz::msgs::UInt32 Convert(const uint32_t &_data)
   return ret;
 }
 
+inline gz::msgs::UInt32 *Convert(const uint32_t &_data,
+                                 google::protobuf::Arena *_arena)
+{
+  auto *ret = detail::CreateOnArena<gz::msgs::UInt32>(_arena);
+  Set(ret, _data);
+  return ret;
+}
+
 inline uint32_t Convert(const gz::msgs::UInt32 &_msg)
 {
   uint32_t ret;
@@ -197,6 +291,14 @@ inline gz::msgs::Int64 Convert(const int64_t &_data)
   return ret;
 }
 
+inline gz::msgs::Int64 *Convert(const int64_t &_data,
+                                google::protobuf::Arena *_arena)
+{
+  auto *ret = detail::CreateOnArena<gz::msgs::Int64>(_arena);
+  Set(ret, _data);
+  return ret;
+}
+
 inline int64_t Convert(const gz::msgs::Int64 &_msg)
 {
   int64_t ret;
@@ -222,6 +324,14 @@ inline gz::msgs::UInt64 Convert(const uint64_t &_data)
   return ret;
 }
 
+inline gz::msgs::UInt64 *Convert(const uint64_t &_data,
+                                 google::protobuf::Arena *_arena)
+{
+  auto *ret = detail::CreateOnArena<gz::msgs::UInt64>(_arena);
+  Set(ret, _data);
+  return ret;
+}
+
 inline uint64_t Convert(const gz::msgs::UInt64 &_msg)
 {
   uint64_t ret;
@@ -247,6 +357,14 @@ inline gz::msgs::Float Convert(const float &_data)
   return ret;
 }
 
+inline gz::msgs::Float *Convert(const float &_data,
+                                google::protobuf::Arena *_arena)
+{
+  auto *ret = detail::CreateOnArena<gz::msgs::Float>(_arena);
+  Set(ret, _data);
+  return ret;
+}
+
 inline float Convert(const gz::msgs::Float &_msg)
 {
   float ret;
@@ -272,6 +390,14 @@ inline gz::msgs::Double Convert(const double &_data)
   return ret;
 }
 
+inline gz::msgs::Double *Convert(const double &_data,
+                                 google::protobuf::Arena *_arena)
+{
+  auto *ret = detail::CreateOnArena<gz::msgs::Double>(_arena);
+  Set(ret, _data);
+  return ret;
+}
+
 inline double Convert(const gz::msgs::Double &_msg)
 {
   double ret;
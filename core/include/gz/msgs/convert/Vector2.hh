@@ -20,6 +20,8 @@
 #include <gz/msgs/config.hh>
 
 // Message Headers
+#include <google/protobuf/arena.h>
+#include "gz/msgs/detail/ArenaUtils.hh"
 #include "gz/msgs/vector2d.pb.h"
 
 // Data Headers
@@ -48,6 +50,14 @@ inline gz::msgs::Vector2d Convert(const gz::math::Vector2d &_data)
   return ret;
 }
 
+inline gz::msgs::Vector2d *Convert(const gz::math::Vector2d &_data,
+                                   google::protobuf::Arena *_arena)
+{
+  auto *ret = detail::CreateOnArena<gz::msgs::Vector2d>(_arena);
+  Set(ret, _data);
+  return ret;
+}
+
 inline gz::math::Vector2d Convert(const gz::msgs::Vector2d &_msg)
 {
   gz::math::Vector2d ret;
@@ -20,6 +20,8 @@
 #include <gz/msgs/config.hh>
 
 // Message Headers
+#include <google/protobuf/arena.h>
+#include "gz/msgs/detail/ArenaUtils.hh"
 #include "gz/msgs/vector3d.pb.h"
 
 // Data Headers
@@ -49,6 +51,14 @@ inline gz::msgs::Vector3d Convert(const gz::math::Vector3d &_data)
   return ret;
 }
 
+inline gz::msgs::Vector3d *Convert(const gz::math::Vector3d &_data,
+                                   google::protobuf::Arena *_arena)
+{
+  auto *ret = detail::CreateOnArena<gz::msgs::Vector3d>(_arena);
+  Set(ret, _data);
+  return ret;
+}
+
 inline gz::math::Vector3d Convert(const gz::msgs::Vector3d &_msg)
 {
   gz::math::Vector3d ret;
@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+#
+# Generates ../detail/EnumTables.hh, the perfect hash tables used by the
+# string to enum conversions of this directory, from the enums of the proto
+# files. Run it again after changing one of these enums.
+
+import os
+import re
+import sys
+
+root = os.path.dirname(os.path.abspath(__file__))
+proto_dir = os.path.join(root, '..', '..', '..', '..', '..', 'proto', 'gz',
+                         'msgs')
+output = os.path.join(root, '..', 'detail', 'EnumTables.hh')
+
+# Table name, proto file, enum name, case of the strings, excluded values
+data = [
+    ["GeometryType", "geometry.proto", "Type", "lower",
+     ["TRIANGLE_FAN", "LINE_STRIP", "EMPTY", "ARROW", "AXIS"]],
+    ["JointType", "joint.proto", "Type", "lower", []],
+    ["ShaderType", "material.proto", "ShaderType", "lower", []],
+    ["DiscoveryType", "discovery.proto", "Type", "upper", []],
+    ["PixelFormatType", "image.proto", "PixelFormatType", "upper", []],
+]
+
+template = """/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Generated by convert/make_enum_tables.py, do not edit.
+
+#ifndef GZ_MSGS_DETAIL_ENUMTABLES_HH_
+#define GZ_MSGS_DETAIL_ENUMTABLES_HH_
+
+#include "gz/msgs/config.hh"
+#include "gz/msgs/detail/EnumNameTable.hh"
+
+namespace gz
+{{
+namespace msgs
+{{
+namespace detail
+{{
+{tables}
+}}  // namespace detail
+}}
+}}
+#endif
+"""
+
+table_template = """/// \\brief Names of the values of enum {enum} in {proto}.
+constexpr EnumName k{name}Names[] = {{
+{entries}
+}};
+
+/// \\brief Perfect hash table of k{name}Names.
+constexpr auto k{name}Table =
+    MakeEnumNameTable<{slots}>({seed}u, k{name}Names);
+static_assert(k{name}Table.perfect,
+    "k{name}Table has collisions");
+"""
+
+
+def enum_key(name):
+    """Length and sampled bytes of a name, as read by detail::EnumNameHash."""
+    b = name.encode()
+    n = len(b)
+
+    def back(i):
+        return b[n - 1 - i] if n > i else b[0]
+    return n, b[0] | (back(0) << 8) | (back(1) << 16) | (back(3) << 24)
+
+
+def enum_hash(name, seed):
+    """Same hash as detail::EnumNameHash."""
+    if not name:
+        return seed
+    n, key = enum_key(name)
+    h = (((key ^ seed) * 0x9E3779B1) + n) & 0xFFFFFFFF
+    h ^= h >> 16
+    h = (h * 0x85EBCA6B) & 0xFFFFFFFF
+    return h ^ (h >> 13)
+
+
+def find_seed(names):
+    """Smallest table and seed without collisions."""
+    if len(set(enum_key(n) for n in names)) != len(names):
+        sys.exit('Names share their length and sampled bytes, '
+                 'update detail::EnumNameHash: ' + ' '.join(names))
+    slots = 8
+    while slots < 2 * len(names):
+        slots *= 2
+    while True:
+        for seed in range(100000):
+            used = set(enum_hash(n, seed) & (slots - 1) for n in names)
+            if len(used) == len(names):
+                return slots, seed
+        slots *= 2
+
+
+def enum_values(proto, enum):
+    with open(os.path.join(proto_dir, proto)) as f:
+        text = f.read()
+    body = re.search(r'enum\s+' + enum + r'\s*\{(.*?)\}', text, re.S).group(1)
+    body = re.sub(r'//.*', '', body)
+    return [(m.group(1), int(m.group(2)))
+            for m in re.finditer(r'(\w+)\s*=\s*(-?\d+)\s*;', body)]
+
+
+tables = []
+for name, proto, enum, case, excluded in data:
+    values = [(n.lower() if case == 'lower' else n, v)
+              for n, v in enum_values(proto, enum) if n not in excluded]
+    slots, seed = find_seed([n for n, _ in values])
+    entries = ',\n'.join(f'    {{"{n}", {v}}}' for n, v in values)
+    tables.append(table_template.format(**locals()))
+
+with open(output, 'w') as f:
+    f.write(template.format(tables='\n'.join(tables).rstrip('\n')))
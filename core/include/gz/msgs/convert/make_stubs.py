@@ -45,10 +45,11 @@ template = """/*
 #ifndef GZ_MSGS_CONVERT_{header}_HH_
 #define GZ_MSGS_CONVERT_{header}_HH_
 
-#include <gz/msgs/Converter.hh>
 #include <gz/msgs/config.hh>
 
 // Message Headers
+#include <google/protobuf/arena.h>
+#include "gz/msgs/detail/ArenaUtils.hh"
 {msg_headers}
 
 // Data Headers
@@ -67,24 +68,71 @@ inline namespace GZ_MSGS_VERSION_NAMESPACE {{
 """
 
 convert_template = """/////////////////////////////////
-template<>
-inline void Converter<{msg_type}, {data_type}>::Set({msg_type} *_msg, const {data_type} &_data)
+inline void Set({msg_type} *_msg, const {data_type} &_data)
 {{
 }}
 
-template<>
-inline void Converter<{msg_type}, {data_type}>::Set({data_type} *_data, const {msg_type} &_msg)
+inline void Set({data_type} *_data, const {msg_type} &_msg)
 {{
 }}
 
 inline {msg_type} Convert(const {data_type} &_data)
 {{
-  return Converter<{msg_type}, {data_type}>::Convert(_data);
+  {msg_type} ret;
+  Set(&ret, _data);
+  return ret;
+}}
+
+inline {msg_type} *Convert(const {data_type} &_data,
+    google::protobuf::Arena *_arena)
+{{
+  auto *ret = detail::CreateOnArena<{msg_type}>(_arena);
+  Set(ret, _data);
+  return ret;
 }}
 
 inline {data_type} Convert(const {msg_type} &_msg)
 {{
-  return Converter<{msg_type}, {data_type}>::Convert(_msg);
+  {data_type} ret;
+  Set(&ret, _msg);
+  return ret;
+}}
+"""
+
+# Extra overloads for string data, which can be moved or viewed instead of
+# copied.
+string_template = """
+inline void Set({msg_type} *_msg, std::string &&_data)
+{{
+}}
+
+inline void Set({msg_type} *_msg, std::string_view _data)
+{{
+}}
+
+inline void Set({data_type} *_data, {msg_type} &&_msg)
+{{
+}}
+
+inline {msg_type} Convert(std::string &&_data)
+{{
+  {msg_type} ret;
+  Set(&ret, std::move(_data));
+  return ret;
+}}
+
+inline {msg_type} Convert(std::string_view _data)
+{{
+  {msg_type} ret;
+  Set(&ret, _data);
+  return ret;
+}}
+
+inline {data_type} Convert({msg_type} &&_msg)
+{{
+  {data_type} ret;
+  Set(&ret, std::move(_msg));
+  return ret;
 }}
 """
 
@@ -108,6 +156,10 @@ for header, v in data.items():
         if len(data_header):
             data_headers.append(f'#include <{data_header}>')
         conversions.append(convert_template.format(**locals()))
+        if data_type == 'std::string':
+            data_headers.append('#include <string_view>')
+            data_headers.append('#include <utility>')
+            conversions.append(string_template.format(**locals()))
 
     msg_headers = '\n'.join(sorted(msg_headers))
     data_headers = '\n'.join(sorted(data_headers))
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_MSGS_DETAIL_ARENAUTILS_HH_
+#define GZ_MSGS_DETAIL_ARENAUTILS_HH_
+
+#include <google/protobuf/arena.h>
+
+#include "gz/msgs/config.hh"
+
+namespace gz
+{
+namespace msgs
+{
+namespace detail
+{
+/// \brief Create a message on an arena, or on the heap when the arena is
+/// null. Protobuf 22 and newer construct messages through Arena::Create.
+/// Older releases need Arena::CreateMessage, because their Arena::Create
+/// allocates the message on the arena without telling it, so its fields
+/// still allocate on the heap.
+/// \param[in] _arena Arena to create the message on, or null.
+/// \return The new message. The arena owns it, unless _arena is null.
+template<typename T>
+T *CreateOnArena(google::protobuf::Arena *_arena)
+{
+#if GOOGLE_PROTOBUF_VERSION >= 4022000
+  return google::protobuf::Arena::Create<T>(_arena);
+#else
+  return google::protobuf::Arena::CreateMessage<T>(_arena);
+#endif
+}
+}  // namespace detail
+}  // namespace msgs
+}  // namespace gz
+
+#endif
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_MSGS_DETAIL_CHUNKUTILS_HH_
+#define GZ_MSGS_DETAIL_CHUNKUTILS_HH_
+
+#include <gz/msgs/header.pb.h>
+#include <gz/msgs/image.pb.h>
+#include <gz/msgs/pointcloud_packed.pb.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+
+#include "gz/msgs/config.hh"
+
+namespace gz
+{
+namespace msgs
+{
+namespace detail
+{
+/// \brief Header data keys that hold the chunk information.
+constexpr const char *kChunkSequenceKey = "chunk_sequence";
+constexpr const char *kChunkIndexKey = "chunk_index";
+constexpr const char *kChunkCountKey = "chunk_count";
+constexpr const char *kChunkOffsetKey = "chunk_offset";
+constexpr const char *kChunkHeightKey = "chunk_height";
+constexpr const char *kChunkWidthKey = "chunk_width";
+
+/// \brief Whether a header data key holds chunk information.
+/// \param[in] _key The key.
+/// \return True for the chunk keys.
+inline bool IsChunkKey(const std::string &_key)
+{
+  return _key == kChunkSequenceKey ||
+      _key == kChunkIndexKey || _key == kChunkCountKey ||
+      _key == kChunkOffsetKey || _key == kChunkHeightKey ||
+      _key == kChunkWidthKey;
+}
+
+/// \brief Get the sequence number of the next message split into chunks.
+/// The first number is random so that a restarted publisher doesn't reuse
+/// the numbers of its previous run.
+/// \return The sequence number.
+inline uint64_t NextChunkSequence()
+{
+  static std::atomic<uint64_t> sequence{[]
+  {
+    std::random_device device;
+    return (static_cast<uint64_t>(device()) << 32) ^ device();
+  }()};
+  return sequence++;
+}
+
+/// \brief Copy a header without its chunk information.
+/// \param[in] _src Header to copy.
+/// \param[out] _dst Copy of the header.
+inline void CopyHeaderWithoutChunkInfo(const Header &_src, Header &_dst)
+{
+  _dst.Clear();
+  if (_src.has_stamp())
+    *_dst.mutable_stamp() = _src.stamp();
+  for (const Header::Map &data : _src.data())
+  {
+    if (!IsChunkKey(data.key()))
+      *_dst.add_data() = data;
+  }
+}
+
+/// \brief Number of units a message is split along. Images and organized
+/// clouds are split into rows, unorganized clouds into points.
+/// \param[in] _msg The message.
+/// \return Number of rows or points.
+inline size_t ChunkUnits(const Image &_msg)
+{
+  return _msg.height();
+}
+
+/// \copydoc ChunkUnits(const Image &)
+inline size_t ChunkUnits(const PointCloudPacked &_msg)
+{
+  return _msg.height() > 1 ? _msg.height() : _msg.width();
+}
+
+/// \brief Size in bytes of a unit that a message is split along.
+/// \param[in] _msg The message, or one of its chunks.
+/// \param[in] _height Height of the whole message.
+/// \return Size of a row or of a point.
+inline size_t ChunkUnitBytes(const Image &_msg, uint32_t /*_height*/)
+{
+  return _msg.step();
+}
+
+/// \copydoc ChunkUnitBytes(const Image &, uint32_t)
+inline size_t ChunkUnitBytes(const PointCloudPacked &_msg, uint32_t _height)
+{
+  return _height > 1 ? _msg.row_step() : _msg.point_step();
+}
+
+/// \brief Copy every field of a message except its header and data.
+/// \param[in] _src Message to copy.
+/// \param[out] _dst Copy of the message.
+inline void CopyChunkMetadata(const Image &_src, Image &_dst)
+{
+  _dst.set_width(_src.width());
+  _dst.set_height(_src.height());
+  _dst.set_step(_src.step());
+  _dst.set_pixel_format_type(_src.pixel_format_type());
+}
+
+/// \copydoc CopyChunkMetadata(const Image &, Image &)
+inline void CopyChunkMetadata(const PointCloudPacked &_src,
+    PointCloudPacked &_dst)
+{
+  *_dst.mutable_field() = _src.field();
+  _dst.set_width(_src.width());
+  _dst.set_height(_src.height());
+  _dst.set_is_bigendian(_src.is_bigendian());
+  _dst.set_point_step(_src.point_step());
+  _dst.set_row_step(_src.row_step());
+  _dst.set_is_dense(_src.is_dense());
+}
+
+/// \brief Set the geometry of a message to hold a number of units.
+/// \param[in,out] _msg The message.
+/// \param[in] _units Number of rows or points.
+/// \param[in] _height Height of the whole message.
+inline void SetChunkUnits(Image &_msg, size_t _units, uint32_t /*_height*/)
+{
+  _msg.set_height(static_cast<uint32_t>(_units));
+}
+
+/// \copydoc SetChunkUnits(Image &, size_t, uint32_t)
+inline void SetChunkUnits(PointCloudPacked &_msg, size_t _units,
+    uint32_t _height)
+{
+  if (_height > 1)
+  {
+    _msg.set_height(static_cast<uint32_t>(_units));
+  }
+  else
+  {
+    _msg.set_width(static_cast<uint32_t>(_units));
+    _msg.set_row_step(static_cast<uint32_t>(_units * _msg.point_step()));
+  }
+}
+}  // namespace detail
+}
+}
+#endif
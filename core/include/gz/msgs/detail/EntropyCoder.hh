@@ -0,0 +1,486 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_MSGS_DETAIL_ENTROPYCODER_HH_
+#define GZ_MSGS_DETAIL_ENTROPYCODER_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gz/msgs/config.hh"
+
+namespace gz
+{
+namespace msgs
+{
+namespace detail
+{
+/// \brief Append an unsigned LEB128 varint to a buffer.
+/// \param[in] _value Value to append.
+/// \param[in, out] _out Buffer to append to.
+inline void WriteVarint(uint64_t _value, std::string &_out)
+{
+  while (_value >= 0x80)
+  {
+    _out.push_back(static_cast<char>((_value & 0x7f) | 0x80));
+    _value >>= 7;
+  }
+  _out.push_back(static_cast<char>(_value));
+}
+
+/// \brief Read an unsigned LEB128 varint from a buffer.
+/// \param[in, out] _ptr Read position, advanced past the varint.
+/// \param[in] _end End of the buffer.
+/// \param[out] _value Value read.
+/// \return False if the buffer ended before the varint did.
+inline bool ReadVarint(const char *&_ptr, const char *_end, uint64_t &_value)
+{
+  _value = 0;
+  for (int shift = 0; shift < 64 && _ptr < _end; shift += 7)
+  {
+    const uint8_t byte = static_cast<uint8_t>(*_ptr++);
+    _value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0)
+      return true;
+  }
+  return false;
+}
+
+/// \brief Append a little endian fixed size value to a buffer.
+/// \param[in] _value Value to append.
+/// \param[in, out] _out Buffer to append to.
+template<typename T>
+void WriteFixed(T _value, std::string &_out)
+{
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &_value, sizeof(T));
+  _out.append(bytes, sizeof(T));
+}
+
+/// \brief Read a little endian fixed size value from a buffer.
+/// \param[in, out] _ptr Read position, advanced past the value.
+/// \param[in] _end End of the buffer.
+/// \param[out] _value Value read.
+/// \return False if the buffer is too short.
+template<typename T>
+bool ReadFixed(const char *&_ptr, const char *_end, T &_value)
+{
+  if (_end - _ptr < static_cast<std::ptrdiff_t>(sizeof(T)))
+    return false;
+  std::memcpy(&_value, _ptr, sizeof(T));
+  _ptr += sizeof(T);
+  return true;
+}
+
+/// \brief Order-0 range asymmetric numeral system (rANS) byte coder.
+///
+/// Every stream is stored either raw or as a normalized frequency table
+/// followed by the output of four interleaved rANS states. Interleaving
+/// breaks the dependency chain between consecutive symbols, which lets the
+/// CPU decode several symbols in parallel.
+class EntropyCoder
+{
+  /// \brief Precision of the normalized frequencies.
+  public: static constexpr uint32_t kScaleBits = 12;
+
+  /// \brief Sum of the normalized frequencies.
+  public: static constexpr uint32_t kScale = 1u << kScaleBits;
+
+  /// \brief Lower bound of the normalized state interval.
+  public: static constexpr uint32_t kLowerBound = 1u << 23;
+
+  /// \brief Number of interleaved states.
+  public: static constexpr size_t kStates = 4;
+
+  /// \brief Stream stored without compression.
+  private: static constexpr uint8_t kRaw = 0;
+
+  /// \brief Stream compressed with rANS.
+  private: static constexpr uint8_t kRans = 1;
+
+  /// \brief Compress a byte sequence and append it to a buffer.
+  /// \param[in] _data Bytes to compress.
+  /// \param[in] _size Number of bytes.
+  /// \param[in, out] _out Buffer to append the stream to.
+  public: static void Encode(const uint8_t *_data, size_t _size,
+              std::string &_out)
+  {
+    WriteVarint(_size, _out);
+    if (_size == 0)
+      return;
+
+    uint32_t freq[256];
+    if (!Normalize(_data, _size, freq))
+    {
+      _out.push_back(static_cast<char>(kRaw));
+      _out.append(reinterpret_cast<const char *>(_data), _size);
+      return;
+    }
+
+    uint32_t start[256];
+    uint32_t cumulative = 0;
+    for (int s = 0; s < 256; ++s)
+    {
+      start[s] = cumulative;
+      cumulative += freq[s];
+    }
+
+    // rANS emits bytes in reverse order, so encode into a scratch buffer
+    // from its end. Every symbol costs at most two bytes at this precision.
+    std::vector<uint8_t> scratch(_size * 2 + kStates * 4 + 16);
+    uint8_t *const bufferEnd = scratch.data() + scratch.size();
+    uint8_t *ptr = bufferEnd;
+
+    uint32_t state[kStates];
+    for (size_t i = 0; i < kStates; ++i)
+      state[i] = kLowerBound;
+
+    for (size_t i = _size; i-- > 0;)
+    {
+      const uint8_t symbol = _data[i];
+      uint32_t &x = state[i % kStates];
+      const uint32_t f = freq[symbol];
+      const uint32_t xMax = ((kLowerBound >> kScaleBits) << 8) * f;
+      while (x >= xMax)
+      {
+        *--ptr = static_cast<uint8_t>(x & 0xff);
+        x >>= 8;
+      }
+      x = ((x / f) << kScaleBits) + (x % f) + start[symbol];
+    }
+
+    // Flush the states so that the decoder reads state 0 first.
+    for (size_t i = kStates; i-- > 0;)
+    {
+      ptr -= 4;
+      ptr[0] = static_cast<uint8_t>(state[i] >> 0);
+      ptr[1] = static_cast<uint8_t>(state[i] >> 8);
+      ptr[2] = static_cast<uint8_t>(state[i] >> 16);
+      ptr[3] = static_cast<uint8_t>(state[i] >> 24);
+    }
+
+    std::string table;
+    WriteTable(freq, table);
+    const size_t encodedSize = static_cast<size_t>(bufferEnd - ptr);
+    if (table.size() + encodedSize + 4 >= _size)
+    {
+      _out.push_back(static_cast<char>(kRaw));
+      _out.append(reinterpret_cast<const char *>(_data), _size);
+      return;
+    }
+
+    _out.push_back(static_cast<char>(kRans));
+    _out.append(table);
+    WriteVarint(encodedSize, _out);
+    _out.append(reinterpret_cast<const char *>(ptr), encodedSize);
+  }
+
+  /// \brief Read the decompressed size of the next stream without
+  /// consuming it.
+  /// \param[in] _ptr Start of the stream.
+  /// \param[in] _end End of the buffer.
+  /// \param[out] _size Decompressed size.
+  /// \return False if the stream is truncated.
+  public: static bool PeekSize(const char *_ptr, const char *_end,
+              uint64_t &_size)
+  {
+    return ReadVarint(_ptr, _end, _size);
+  }
+
+  /// \brief Advance past the next stream without decompressing it, and
+  /// check that the stream is long enough to hold the number of bytes it
+  /// declares.
+  ///
+  /// Every decoded rANS symbol shrinks a state by a minimum factor that
+  /// depends on the most frequent symbol, so a stream can't decompress to
+  /// more than a bounded multiple of its size. Decoders call this on
+  /// untrusted input before allocating memory for the decompressed bytes.
+  /// \param[in, out] _ptr Read position, advanced past the stream.
+  /// \param[in] _end End of the buffer.
+  /// \param[out] _size Decompressed size.
+  /// \return False if the stream is malformed or too short for _size.
+  public: static bool Skip(const char *&_ptr, const char *_end,
+              uint64_t &_size)
+  {
+    if (!ReadVarint(_ptr, _end, _size))
+      return false;
+    if (_size == 0)
+      return true;
+
+    if (_ptr >= _end)
+      return false;
+    const uint8_t method = static_cast<uint8_t>(*_ptr++);
+    if (method == kRaw)
+    {
+      if (static_cast<uint64_t>(_end - _ptr) < _size)
+        return false;
+      _ptr += _size;
+      return true;
+    }
+
+    uint32_t freq[256];
+    uint64_t encodedSize = 0;
+    if (method != kRans || !ReadTable(_ptr, _end, freq) ||
+        !ReadVarint(_ptr, _end, encodedSize) ||
+        static_cast<uint64_t>(_end - _ptr) < encodedSize ||
+        encodedSize < kStates * 4)
+    {
+      return false;
+    }
+    _ptr += encodedSize;
+    return _size <= MaxSymbols(freq, encodedSize);
+  }
+
+  /// \brief Decompress a stream written by Encode.
+  /// \param[in, out] _ptr Read position, advanced past the stream.
+  /// \param[in] _end End of the buffer.
+  /// \param[out] _data Destination of the decompressed bytes.
+  /// \param[in] _size Expected number of decompressed bytes.
+  /// \return False if the stream is malformed or doesn't hold _size bytes.
+  public: static bool Decode(const char *&_ptr, const char *_end,
+              uint8_t *_data, size_t _size)
+  {
+    uint64_t size = 0;
+    if (!ReadVarint(_ptr, _end, size) || size != _size)
+      return false;
+    if (_size == 0)
+      return true;
+
+    if (_ptr >= _end)
+      return false;
+    const uint8_t method = static_cast<uint8_t>(*_ptr++);
+    if (method == kRaw)
+    {
+      if (static_cast<size_t>(_end - _ptr) < _size)
+        return false;
+      std::memcpy(_data, _ptr, _size);
+      _ptr += _size;
+      return true;
+    }
+    if (method != kRans)
+      return false;
+
+    uint32_t freq[256];
+    if (!ReadTable(_ptr, _end, freq))
+      return false;
+
+    uint32_t start[256];
+    uint8_t symbols[kScale];
+    uint32_t cumulative = 0;
+    for (int s = 0; s < 256; ++s)
+    {
+      start[s] = cumulative;
+      std::memset(symbols + cumulative, s, freq[s]);
+      cumulative += freq[s];
+    }
+
+    uint64_t encodedSize = 0;
+    if (!ReadVarint(_ptr, _end, encodedSize) ||
+        static_cast<uint64_t>(_end - _ptr) < encodedSize ||
+        encodedSize < kStates * 4)
+    {
+      return false;
+    }
+    const uint8_t *ptr = reinterpret_cast<const uint8_t *>(_ptr);
+    const uint8_t *const end = ptr + encodedSize;
+    _ptr += encodedSize;
+
+    uint32_t state[kStates];
+    for (size_t i = 0; i < kStates; ++i, ptr += 4)
+    {
+      state[i] = static_cast<uint32_t>(ptr[0]) |
+          (static_cast<uint32_t>(ptr[1]) << 8) |
+          (static_cast<uint32_t>(ptr[2]) << 16) |
+          (static_cast<uint32_t>(ptr[3]) << 24);
+    }
+
+    const uint32_t mask = kScale - 1;
+    for (size_t i = 0; i < _size; ++i)
+    {
+      uint32_t &x = state[i % kStates];
+      const uint8_t symbol = symbols[x & mask];
+      _data[i] = symbol;
+      x = freq[symbol] * (x >> kScaleBits) + (x & mask) - start[symbol];
+      while (x < kLowerBound)
+      {
+        if (ptr >= end)
+          return false;
+        x = (x << 8) | *ptr++;
+      }
+    }
+    return true;
+  }
+
+  /// \brief Upper bound of the number of symbols a rANS stream decodes to.
+  /// \param[in] _freq Normalized frequencies, all below kScale.
+  /// \param[in] _encodedSize Size of the encoded states and bytes.
+  /// \return Maximum number of symbols.
+  private: static uint64_t MaxSymbols(const uint32_t (&_freq)[256],
+               uint64_t _encodedSize)
+  {
+    // Decoding a symbol of frequency f maps a state x >= kLowerBound to at
+    // most x * f / kScale + kScale - f. Each state starts with at most
+    // 32 - 23 bits above kLowerBound and every byte read adds a little more
+    // than 8. The first symbol of a state may be free if the state starts
+    // below kLowerBound.
+    const uint32_t maxFreq = *std::max_element(_freq, _freq + 256);
+    const double ratio = 1.0 - (kScale - maxFreq) *
+        (1.0 / kScale - 1.0 / kLowerBound);
+    const double bytes = static_cast<double>(_encodedSize - kStates * 4);
+    const double bits = 8.001 * bytes + 9.0 * kStates;
+    return static_cast<uint64_t>(bits / -std::log2(ratio)) + kStates;
+  }
+
+  /// \brief Count symbols and scale their frequencies so that they add up
+  /// to kScale while keeping every present symbol representable. No symbol
+  /// gets all of kScale, which would let a stream decode to any size
+  /// without consuming input.
+  /// \param[in] _data Bytes to compress.
+  /// \param[in] _size Number of bytes.
+  /// \param[out] _freq Normalized frequencies.
+  /// \return False if the data can't be compressed (every byte value is
+  /// present with similar probability).
+  private: static bool Normalize(const uint8_t *_data, size_t _size,
+               uint32_t (&_freq)[256])
+  {
+    // Four histograms avoid store to load stalls on runs of equal bytes.
+    uint64_t counts[4][256] = {};
+    size_t i = 0;
+    for (; i + 4 <= _size; i += 4)
+    {
+      ++counts[0][_data[i]];
+      ++counts[1][_data[i + 1]];
+      ++counts[2][_data[i + 2]];
+      ++counts[3][_data[i + 3]];
+    }
+    for (; i < _size; ++i)
+      ++counts[0][_data[i]];
+
+    int64_t sum = 0;
+    int present = 0;
+    for (int s = 0; s < 256; ++s)
+    {
+      const uint64_t count =
+          counts[0][s] + counts[1][s] + counts[2][s] + counts[3][s];
+      if (count == 0)
+      {
+        _freq[s] = 0;
+        continue;
+      }
+      ++present;
+      _freq[s] = std::max<uint32_t>(1u,
+          static_cast<uint32_t>(count * kScale / _size));
+      sum += _freq[s];
+    }
+    if (present == 256)
+      return false;
+    if (present == 1)
+    {
+      // Give an absent neighbor the smallest frequency.
+      const int only = static_cast<int>(
+          std::find_if(_freq, _freq + 256, [](uint32_t _f) { return _f; }) -
+          _freq);
+      _freq[only] = kScale - 1;
+      _freq[(only + 1) % 256] = 1;
+      return true;
+    }
+
+    // Fix rounding errors by adjusting the most frequent symbols.
+    while (sum != kScale)
+    {
+      int best = 0;
+      for (int s = 1; s < 256; ++s)
+      {
+        if (_freq[s] > _freq[best])
+          best = s;
+      }
+      if (sum > kScale)
+      {
+        const uint32_t excess = std::min<uint32_t>(
+            static_cast<uint32_t>(sum - kScale), _freq[best] - 1);
+        if (excess == 0)
+          return false;
+        _freq[best] -= excess;
+        sum -= excess;
+      }
+      else
+      {
+        _freq[best] += static_cast<uint32_t>(kScale - sum);
+        sum = kScale;
+      }
+    }
+    return true;
+  }
+
+  /// \brief Serialize a frequency table as a presence bitmap followed by
+  /// the frequencies of present symbols.
+  /// \param[in] _freq Normalized frequencies.
+  /// \param[in, out] _out Buffer to append to.
+  private: static void WriteTable(const uint32_t (&_freq)[256],
+               std::string &_out)
+  {
+    uint8_t bitmap[32] = {};
+    for (int s = 0; s < 256; ++s)
+    {
+      if (_freq[s] > 0)
+        bitmap[s / 8] |= static_cast<uint8_t>(1u << (s % 8));
+    }
+    _out.append(reinterpret_cast<const char *>(bitmap), sizeof(bitmap));
+    for (int s = 0; s < 256; ++s)
+    {
+      if (_freq[s] > 0)
+        WriteVarint(_freq[s], _out);
+    }
+  }
+
+  /// \brief Deserialize a frequency table written by WriteTable.
+  /// \param[in, out] _ptr Read position, advanced past the table.
+  /// \param[in] _end End of the buffer.
+  /// \param[out] _freq Normalized frequencies.
+  /// \return False if the table is malformed.
+  private: static bool ReadTable(const char *&_ptr, const char *_end,
+               uint32_t (&_freq)[256])
+  {
+    if (_end - _ptr < 32)
+      return false;
+    const uint8_t *bitmap = reinterpret_cast<const uint8_t *>(_ptr);
+    _ptr += 32;
+
+    uint64_t sum = 0;
+    for (int s = 0; s < 256; ++s)
+    {
+      _freq[s] = 0;
+      if ((bitmap[s / 8] & (1u << (s % 8))) == 0)
+        continue;
+      uint64_t value = 0;
+      if (!ReadVarint(_ptr, _end, value) || value == 0 || value >= kScale)
+        return false;
+      _freq[s] = static_cast<uint32_t>(value);
+      sum += value;
+    }
+    return sum == kScale;
+  }
+};
+}  // namespace detail
+}
+}
+#endif
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_MSGS_DETAIL_ENUMNAMETABLE_HH_
+#define GZ_MSGS_DETAIL_ENUMNAMETABLE_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "gz/msgs/config.hh"
+
+namespace gz
+{
+namespace msgs
+{
+namespace detail
+{
+/// \brief Name of an enum value.
+struct EnumName
+{
+  /// \brief The name.
+  std::string_view name;
+
+  /// \brief The value.
+  int value;
+};
+
+/// \brief Seeded hash of an enum name. Only the length and four bytes of
+/// the name are read, the first byte and the last, second to last and
+/// fourth to last bytes, so the cost does not grow with the length of the
+/// name. make_enum_tables.py checks that these distinguish every name.
+/// \param[in] _name The name.
+/// \param[in] _seed The seed of the table.
+/// \return The hash.
+constexpr uint32_t EnumNameHash(std::string_view _name, uint32_t _seed)
+{
+  const size_t n = _name.size();
+  if (n == 0)
+    return _seed;
+
+  auto back = [&](size_t _i) -> uint32_t
+  {
+    return static_cast<unsigned char>(_name[n > _i ? n - 1 - _i : 0]);
+  };
+  const uint32_t key = static_cast<unsigned char>(_name[0]) |
+      (back(0) << 8) | (back(1) << 16) | (back(3) << 24);
+  uint32_t hash = (key ^ _seed) * 0x9E3779B1u + static_cast<uint32_t>(n);
+  hash = (hash ^ (hash >> 16)) * 0x85EBCA6Bu;
+  return hash ^ (hash >> 13);
+}
+
+/// \brief Perfect hash table from enum names to values.
+///
+/// Every name hashes to its own slot, so a lookup hashes the string once
+/// and compares it to a single name. The seed that makes the hash perfect
+/// is found by make_enum_tables.py, and checked at compile time through
+/// the perfect member.
+/// \tparam N Number of names.
+/// \tparam Slots Number of slots, a power of two.
+template<size_t N, size_t Slots>
+struct EnumNameTable
+{
+  static_assert(Slots > 0 && (Slots & (Slots - 1)) == 0,
+      "The number of slots must be a power of two");
+  static_assert(N < Slots && N < 128,
+      "The table must have more slots than names");
+
+  /// \brief Seed of the hash.
+  uint32_t seed{0};
+
+  /// \brief True if every name has its own slot.
+  bool perfect{false};
+
+  /// \brief The names.
+  EnumName names[N]{};
+
+  /// \brief Index in names of the name of every slot, or -1.
+  int8_t slots[Slots]{};
+
+  /// \brief Find the value of a name.
+  /// \param[in] _name The name.
+  /// \param[out] _value The value, unchanged if the name is unknown.
+  /// \return True if the name is known.
+  constexpr bool Find(std::string_view _name, int &_value) const
+  {
+    const int8_t i = this->slots[EnumNameHash(_name, this->seed) &
+        (Slots - 1)];
+    if (i < 0 || this->names[i].name != _name)
+      return false;
+    _value = this->names[i].value;
+    return true;
+  }
+};
+
+/// \brief Build a perfect hash table at compile time.
+/// \tparam Slots Number of slots, a power of two.
+/// \tparam N Number of names.
+/// \param[in] _seed Seed of the hash.
+/// \param[in] _names The names.
+/// \return The table. Its perfect member is false if two names share a
+/// slot with this seed.
+template<size_t Slots, size_t N>
+constexpr EnumNameTable<N, Slots> MakeEnumNameTable(uint32_t _seed,
+    const EnumName (&_names)[N])
+{
+  EnumNameTable<N, Slots> table;
+  table.seed = _seed;
+  table.perfect = true;
+  for (size_t s = 0; s < Slots; ++s)
+    table.slots[s] = -1;
+  for (size_t i = 0; i < N; ++i)
+  {
+    table.names[i] = _names[i];
+    const size_t slot = EnumNameHash(_names[i].name, _seed) & (Slots - 1);
+    if (table.slots[slot] >= 0)
+      table.perfect = false;
+    table.slots[slot] = static_cast<int8_t>(i);
+  }
+  return table;
+}
+}  // namespace detail
+}
+}
+#endif
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Generated by convert/make_enum_tables.py, do not edit.
+
+#ifndef GZ_MSGS_DETAIL_ENUMTABLES_HH_
+#define GZ_MSGS_DETAIL_ENUMTABLES_HH_
+
+#include "gz/msgs/config.hh"
+#include "gz/msgs/detail/EnumNameTable.hh"
+
+namespace gz
+{
+namespace msgs
+{
+namespace detail
+{
+/// \brief Names of the values of enum Type in geometry.proto.
+constexpr EnumName kGeometryTypeNames[] = {
+    {"box", 0},
+    {"cylinder", 1},
+    {"sphere", 2},
+    {"plane", 3},
+    {"image", 4},
+    {"heightmap", 5},
+    {"mesh", 6},
+    {"polyline", 9},
+    {"cone", 10},
+    {"capsule", 14},
+    {"ellipsoid", 15}
+};
+
+/// \brief Perfect hash table of kGeometryTypeNames.
+constexpr auto kGeometryTypeTable =
+    MakeEnumNameTable<32>(0u, kGeometryTypeNames);
+static_assert(kGeometryTypeTable.perfect,
+    "kGeometryTypeTable has collisions");
+
+/// \brief Names of the values of enum Type in joint.proto.
+constexpr EnumName kJointTypeNames[] = {
+    {"revolute", 0},
+    {"revolute2", 1},
+    {"prismatic", 2},
+    {"universal", 3},
+    {"ball", 4},
+    {"screw", 5},
+    {"gearbox", 6},
+    {"fixed", 7},
+    {"continuous", 8}
+};
+
+/// \brief Perfect hash table of kJointTypeNames.
+constexpr auto kJointTypeTable =
+    MakeEnumNameTable<32>(0u, kJointTypeNames);
+static_assert(kJointTypeTable.perfect,
+    "kJointTypeTable has collisions");
+
+/// \brief Names of the values of enum ShaderType in material.proto.
+constexpr EnumName kShaderTypeNames[] = {
+    {"vertex", 0},
+    {"pixel", 1},
+    {"normal_map_object_space", 2},
+    {"normal_map_tangent_space", 3}
+};
+
+/// \brief Perfect hash table of kShaderTypeNames.
+constexpr auto kShaderTypeTable =
+    MakeEnumNameTable<8>(3u, kShaderTypeNames);
+static_assert(kShaderTypeTable.perfect,
+    "kShaderTypeTable has collisions");
+
+/// \brief Names of the values of enum Type in discovery.proto.
+constexpr EnumName kDiscoveryTypeNames[] = {
+    {"UNINITIALIZED", 0},
+    {"ADVERTISE", 1},
+    {"SUBSCRIBE", 2},
+    {"UNADVERTISE", 3},
+    {"HEARTBEAT", 4},
+    {"BYE", 5},
+    {"NEW_CONNECTION", 6},
+    {"END_CONNECTION", 7},
+    {"SUBSCRIBERS_REQ", 8},
+    {"SUBSCRIBERS_REP", 9}
+};
+
+/// \brief Perfect hash table of kDiscoveryTypeNames.
+constexpr auto kDiscoveryTypeTable =
+    MakeEnumNameTable<32>(1u, kDiscoveryTypeNames);
+static_assert(kDiscoveryTypeTable.perfect,
+    "kDiscoveryTypeTable has collisions");
+
+/// \brief Names of the values of enum PixelFormatType in image.proto.
+constexpr EnumName kPixelFormatTypeNames[] = {
+    {"UNKNOWN_PIXEL_FORMAT", 0},
+    {"L_INT8", 1},
+    {"L_INT16", 2},
+    {"RGB_INT8", 3},
+    {"RGBA_INT8", 4},
+    {"BGRA_INT8", 5},
+    {"RGB_INT16", 6},
+    {"RGB_INT32", 7},
+    {"BGR_INT8", 8},
+    {"BGR_INT16", 9},
+    {"BGR_INT32", 10},
+    {"R_FLOAT16", 11},
+    {"RGB_FLOAT16", 12},
+    {"R_FLOAT32", 13},
+    {"RGB_FLOAT32", 14},
+    {"BAYER_RGGB8", 15},
+    {"BAYER_BGGR8", 16},
+    {"BAYER_GBRG8", 17},
+    {"BAYER_GRBG8", 18}
+};
+
+/// \brief Perfect hash table of kPixelFormatTypeNames.
+constexpr auto kPixelFormatTypeTable =
+    MakeEnumNameTable<64>(30u, kPixelFormatTypeNames);
+static_assert(kPixelFormatTypeTable.perfect,
+    "kPixelFormatTypeTable has collisions");
+}  // namespace detail
+}
+}
+#endif
@@ -0,0 +1,787 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_MSGS_DETAIL_IMAGEUTILS_HH_
+#define GZ_MSGS_DETAIL_IMAGEUTILS_HH_
+
+#include <gz/msgs/image.pb.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "gz/msgs/config.hh"
+
+namespace gz
+{
+namespace msgs
+{
+namespace detail
+{
+/// \brief Storage type of the channels of a pixel format.
+enum class ChannelType
+{
+  UINT8,
+  UINT16,
+  UINT32,
+  FLOAT16,
+  FLOAT32
+};
+
+/// \brief Memory layout of a pixel format.
+struct PixelFormatInfo
+{
+  /// \brief Number of channels, zero for unknown formats.
+  int channels{0};
+
+  /// \brief Storage type of every channel.
+  ChannelType type{ChannelType::UINT8};
+
+  /// \brief Index of the red, green, blue and alpha channels in a pixel,
+  /// or -1 if absent. Luminance formats have red, green and blue at 0.
+  int r{-1};
+  int g{-1};
+  int b{-1};
+  int a{-1};
+
+  /// \brief Column and row of the red pixel in a 2x2 Bayer cell, or -1
+  /// for other formats.
+  int bayerRedX{-1};
+  int bayerRedY{-1};
+};
+
+/// \brief Memory layout of a pixel format.
+/// \param[in] _format The pixel format.
+/// \return The layout, with zero channels for unknown formats.
+inline PixelFormatInfo FormatInfo(PixelFormatType _format)
+{
+  auto info = [](int _channels, ChannelType _type, int _r, int _g, int _b,
+      int _a = -1)
+  {
+    PixelFormatInfo result;
+    result.channels = _channels;
+    result.type = _type;
+    result.r = _r;
+    result.g = _g;
+    result.b = _b;
+    result.a = _a;
+    return result;
+  };
+  auto bayer = [&](int _redX, int _redY)
+  {
+    PixelFormatInfo result = info(1, ChannelType::UINT8, 0, 0, 0);
+    result.bayerRedX = _redX;
+    result.bayerRedY = _redY;
+    return result;
+  };
+
+  switch (_format)
+  {
+    case L_INT8:
+      return info(1, ChannelType::UINT8, 0, 0, 0);
+    case L_INT16:
+      return info(1, ChannelType::UINT16, 0, 0, 0);
+    case RGB_INT8:
+      return info(3, ChannelType::UINT8, 0, 1, 2);
+    case RGBA_INT8:
+      return info(4, ChannelType::UINT8, 0, 1, 2, 3);
+    case BGRA_INT8:
+      return info(4, ChannelType::UINT8, 2, 1, 0, 3);
+    case RGB_INT16:
+      return info(3, ChannelType::UINT16, 0, 1, 2);
+    case RGB_INT32:
+      return info(3, ChannelType::UINT32, 0, 1, 2);
+    case BGR_INT8:
+      return info(3, ChannelType::UINT8, 2, 1, 0);
+    case BGR_INT16:
+      return info(3, ChannelType::UINT16, 2, 1, 0);
+    case BGR_INT32:
+      return info(3, ChannelType::UINT32, 2, 1, 0);
+    case R_FLOAT16:
+      return info(1, ChannelType::FLOAT16, 0, 0, 0);
+    case RGB_FLOAT16:
+      return info(3, ChannelType::FLOAT16, 0, 1, 2);
+    case R_FLOAT32:
+      return info(1, ChannelType::FLOAT32, 0, 0, 0);
+    case RGB_FLOAT32:
+      return info(3, ChannelType::FLOAT32, 0, 1, 2);
+    case BAYER_RGGB8:
+      return bayer(0, 0);
+    case BAYER_BGGR8:
+      return bayer(1, 1);
+    case BAYER_GBRG8:
+      return bayer(0, 1);
+    case BAYER_GRBG8:
+      return bayer(1, 0);
+    default:
+      return PixelFormatInfo();
+  }
+}
+
+/// \brief Size of a channel.
+/// \param[in] _type Storage type of the channel.
+/// \return Size in bytes.
+inline int ChannelBytes(ChannelType _type)
+{
+  switch (_type)
+  {
+    case ChannelType::UINT16:
+    case ChannelType::FLOAT16:
+      return 2;
+    case ChannelType::UINT32:
+    case ChannelType::FLOAT32:
+      return 4;
+    default:
+      return 1;
+  }
+}
+
+/// \brief Whether a channel type holds floating point values.
+/// \param[in] _type Storage type of the channel.
+/// \return True for FLOAT16 and FLOAT32.
+inline bool IsFloat(ChannelType _type)
+{
+  return _type == ChannelType::FLOAT16 || _type == ChannelType::FLOAT32;
+}
+
+/// \brief Convert an IEEE 754 half precision value to single precision.
+/// \param[in] _half The half precision bits.
+/// \return The value.
+inline float HalfToFloat(uint16_t _half)
+{
+  const uint32_t sign = static_cast<uint32_t>(_half & 0x8000u) << 16;
+  uint32_t exponent = (_half >> 10) & 0x1fu;
+  uint32_t mantissa = _half & 0x3ffu;
+  uint32_t bits;
+  if (exponent == 0x1fu)
+  {
+    bits = sign | 0x7f800000u | (mantissa << 13);
+  }
+  else if (exponent != 0)
+  {
+    bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+  }
+  else if (mantissa == 0)
+  {
+    bits = sign;
+  }
+  else
+  {
+    // Subnormal half, normal float
+    exponent = 113;
+    while (!(mantissa & 0x400u))
+    {
+      mantissa <<= 1;
+      --exponent;
+    }
+    bits = sign | (exponent << 23) | ((mantissa & 0x3ffu) << 13);
+  }
+  float result;
+  std::memcpy(&result, &bits, sizeof(result));
+  return result;
+}
+
+/// \brief Convert a single precision value to IEEE 754 half precision,
+/// rounding to nearest even.
+/// \param[in] _value The value.
+/// \return The half precision bits.
+inline uint16_t FloatToHalf(float _value)
+{
+  uint32_t bits;
+  std::memcpy(&bits, &_value, sizeof(bits));
+  const uint32_t sign = (bits >> 16) & 0x8000u;
+  const uint32_t magnitude = bits & 0x7fffffffu;
+
+  // Infinity and NaN
+  if (magnitude >= 0x7f800000u)
+  {
+    return static_cast<uint16_t>(
+        sign | 0x7c00u | (magnitude > 0x7f800000u ? 0x200u : 0u));
+  }
+
+  // Rounds to infinity
+  if (magnitude >= 0x477ff000u)
+    return static_cast<uint16_t>(sign | 0x7c00u);
+
+  uint32_t half;
+  uint32_t remainder;
+  uint32_t midpoint;
+  if (magnitude >= 0x38800000u)
+  {
+    // Normal half
+    half = (magnitude - 0x38000000u) >> 13;
+    remainder = magnitude & 0x1fffu;
+    midpoint = 0x1000u;
+  }
+  else if (magnitude >= 0x33000000u)
+  {
+    // Subnormal half
+    const uint32_t shift = 126u - (magnitude >> 23);
+    const uint32_t mantissa = (magnitude & 0x7fffffu) | 0x800000u;
+    half = mantissa >> shift;
+    remainder = mantissa & ((1u << shift) - 1u);
+    midpoint = 1u << (shift - 1u);
+  }
+  else
+  {
+    return static_cast<uint16_t>(sign);
+  }
+
+  if (remainder > midpoint || (remainder == midpoint && (half & 1u)))
+    ++half;
+  return static_cast<uint16_t>(sign | half);
+}
+
+/// \brief Read a channel as a float. Integer channels are normalized to
+/// [0, 1] when _normalize is true.
+/// \param[in] _src Start of the channel.
+/// \param[in] _type Storage type of the channel.
+/// \param[in] _normalize Whether to normalize integers.
+/// \return The value.
+inline float LoadChannel(const unsigned char *_src, ChannelType _type,
+    bool _normalize)
+{
+  switch (_type)
+  {
+    case ChannelType::UINT8:
+      return _src[0] * (_normalize ? 1.0f / 255.0f : 1.0f);
+    case ChannelType::UINT16:
+    {
+      uint16_t v;
+      std::memcpy(&v, _src, sizeof(v));
+      return v * (_normalize ? 1.0f / 65535.0f : 1.0f);
+    }
+    case ChannelType::UINT32:
+    {
+      uint32_t v;
+      std::memcpy(&v, _src, sizeof(v));
+      return static_cast<float>(v * (_normalize ? 1.0 / 4294967295.0 : 1.0));
+    }
+    case ChannelType::FLOAT16:
+    {
+      uint16_t v;
+      std::memcpy(&v, _src, sizeof(v));
+      return HalfToFloat(v);
+    }
+    default:
+    {
+      float v;
+      std::memcpy(&v, _src, sizeof(v));
+      return v;
+    }
+  }
+}
+
+/// \brief Store a float in a channel, rounding and saturating integers.
+/// \param[in] _value The value, in [0, 1] for normalized integers.
+/// \param[in] _type Storage type of the channel.
+/// \param[in] _normalize Whether integers are normalized.
+/// \param[out] _dst Start of the channel.
+inline void StoreChannel(float _value, ChannelType _type, bool _normalize,
+    unsigned char *_dst)
+{
+  auto toInt = [&](double _max) -> double
+  {
+    const double v = _normalize ? _value * _max : _value;
+    // NaN compares false and becomes zero
+    return v > 0 ? std::min(std::floor(v + 0.5), _max) : 0.0;
+  };
+
+  switch (_type)
+  {
+    case ChannelType::UINT8:
+      _dst[0] = static_cast<uint8_t>(toInt(255.0));
+      break;
+    case ChannelType::UINT16:
+    {
+      const uint16_t v = static_cast<uint16_t>(toInt(65535.0));
+      std::memcpy(_dst, &v, sizeof(v));
+      break;
+    }
+    case ChannelType::UINT32:
+    {
+      const uint32_t v = static_cast<uint32_t>(toInt(4294967295.0));
+      std::memcpy(_dst, &v, sizeof(v));
+      break;
+    }
+    case ChannelType::FLOAT16:
+    {
+      const uint16_t v = FloatToHalf(_value);
+      std::memcpy(_dst, &v, sizeof(v));
+      break;
+    }
+    default:
+      std::memcpy(_dst, &_value, sizeof(_value));
+      break;
+  }
+}
+
+/// \brief Whether a Bayer pixel is red, green or blue.
+/// \param[in] _info Layout of a Bayer format.
+/// \param[in] _x Column of the pixel.
+/// \param[in] _y Row of the pixel.
+/// \return 0 for red, 1 for green and 2 for blue.
+inline int BayerColor(const PixelFormatInfo &_info, size_t _x, size_t _y)
+{
+  const bool redRow = static_cast<int>(_y & 1u) == _info.bayerRedY;
+  const bool redCol = static_cast<int>(_x & 1u) == _info.bayerRedX;
+  return redRow == redCol ? (redRow ? 0 : 2) : 1;
+}
+
+/// \brief Decode a row of pixels to normalized RGBA floats.
+/// \param[in] _src Start of the row.
+/// \param[in] _info Layout of the source format.
+/// \param[in] _width Number of pixels.
+/// \param[out] _rgba Four floats per pixel.
+inline void DecodeRow(const unsigned char *_src, const PixelFormatInfo &_info,
+    size_t _width, float *_rgba)
+{
+  const int channelBytes = ChannelBytes(_info.type);
+  const size_t pixelBytes = _info.channels * channelBytes;
+  for (size_t i = 0; i < _width; ++i, _src += pixelBytes, _rgba += 4)
+  {
+    _rgba[0] = LoadChannel(_src + _info.r * channelBytes, _info.type, true);
+    _rgba[1] = LoadChannel(_src + _info.g * channelBytes, _info.type, true);
+    _rgba[2] = LoadChannel(_src + _info.b * channelBytes, _info.type, true);
+    _rgba[3] = _info.a < 0 ? 1.0f :
+        LoadChannel(_src + _info.a * channelBytes, _info.type, true);
+  }
+}
+
+/// \brief Encode a row of normalized RGBA floats.
+/// \param[in] _rgba Four floats per pixel.
+/// \param[in] _info Layout of the destination format.
+/// \param[in] _width Number of pixels.
+/// \param[in] _row Index of the row, for Bayer formats.
+/// \param[out] _dst Start of the row.
+inline void EncodeRow(const float *_rgba, const PixelFormatInfo &_info,
+    size_t _width, size_t _row, unsigned char *_dst)
+{
+  const int channelBytes = ChannelBytes(_info.type);
+  const size_t pixelBytes = _info.channels * channelBytes;
+  for (size_t i = 0; i < _width; ++i, _dst += pixelBytes, _rgba += 4)
+  {
+    if (_info.bayerRedX >= 0)
+    {
+      StoreChannel(_rgba[BayerColor(_info, i, _row)], _info.type, true,
+          _dst);
+    }
+    else if (_info.channels == 1)
+    {
+      const float luma =
+          0.299f * _rgba[0] + 0.587f * _rgba[1] + 0.114f * _rgba[2];
+      StoreChannel(luma, _info.type, true, _dst);
+    }
+    else
+    {
+      StoreChannel(_rgba[0], _info.type, true, _dst + _info.r * channelBytes);
+      StoreChannel(_rgba[1], _info.type, true, _dst + _info.g * channelBytes);
+      StoreChannel(_rgba[2], _info.type, true, _dst + _info.b * channelBytes);
+      if (_info.a >= 0)
+      {
+        StoreChannel(_rgba[3], _info.type, true,
+            _dst + _info.a * channelBytes);
+      }
+    }
+  }
+}
+
+/// \brief Compile time layout of an 8 bit pixel format, for the fast
+/// conversion kernels.
+/// \tparam C Number of channels.
+/// \tparam R Index of red, or of luminance.
+/// \tparam G Index of green, or of luminance.
+/// \tparam B Index of blue, or of luminance.
+/// \tparam A Index of alpha, or -1.
+template<int C, int R, int G, int B, int A>
+struct Format8
+{
+  static constexpr int kChannels = C;
+  static constexpr int kR = R;
+  static constexpr int kG = G;
+  static constexpr int kB = B;
+  static constexpr int kA = A;
+};
+
+/// \brief Convert a row between 8 bit formats. Every channel index is a
+/// compile time constant, so the loop compiles to shuffles.
+/// \tparam S Source Format8.
+/// \tparam D Destination Format8.
+/// \param[in] _src Start of the source row.
+/// \param[out] _dst Start of the destination row.
+/// \param[in] _width Number of pixels.
+template<typename S, typename D>
+void ConvertRow8(const uint8_t *_src, uint8_t *_dst, size_t _width)
+{
+  for (size_t i = 0; i < _width;
+       ++i, _src += S::kChannels, _dst += D::kChannels)
+  {
+    if constexpr (D::kChannels == 1 && S::kChannels > 1)
+    {
+      // BT.601 luma in 8 bit fixed point
+      _dst[0] = static_cast<uint8_t>((77 * _src[S::kR] +
+          150 * _src[S::kG] + 29 * _src[S::kB] + 128) >> 8);
+    }
+    else if constexpr (D::kChannels == 1)
+    {
+      _dst[0] = _src[0];
+    }
+    else
+    {
+      _dst[D::kR] = _src[S::kR];
+      _dst[D::kG] = _src[S::kG];
+      _dst[D::kB] = _src[S::kB];
+      if constexpr (D::kA >= 0 && S::kA >= 0)
+        _dst[D::kA] = _src[S::kA];
+      else if constexpr (D::kA >= 0)
+        _dst[D::kA] = 255;
+    }
+  }
+}
+
+/// \brief Call a function with the Format8 of an 8 bit pixel format.
+/// \param[in] _format The pixel format.
+/// \param[in] _func Generic callable taking a Format8 value.
+/// \return False if the format has no fast kernel.
+template<typename Func>
+bool VisitFormat8(PixelFormatType _format, Func &&_func)
+{
+  switch (_format)
+  {
+    case L_INT8:
+      _func(Format8<1, 0, 0, 0, -1>());
+      return true;
+    case RGB_INT8:
+      _func(Format8<3, 0, 1, 2, -1>());
+      return true;
+    case BGR_INT8:
+      _func(Format8<3, 2, 1, 0, -1>());
+      return true;
+    case RGBA_INT8:
+      _func(Format8<4, 0, 1, 2, 3>());
+      return true;
+    case BGRA_INT8:
+      _func(Format8<4, 2, 1, 0, 3>());
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// \brief Fast kernel to convert a row between two 8 bit formats.
+/// \param[in] _src Source format.
+/// \param[in] _dst Destination format.
+/// \return The kernel, or nullptr if there is none.
+inline void (*Row8Kernel(PixelFormatType _src, PixelFormatType _dst))(
+    const uint8_t *, uint8_t *, size_t)
+{
+  void (*kernel)(const uint8_t *, uint8_t *, size_t) = nullptr;
+  VisitFormat8(_src, [&](auto _s)
+  {
+    VisitFormat8(_dst, [&](auto _d)
+    {
+      kernel = &ConvertRow8<decltype(_s), decltype(_d)>;
+    });
+  });
+  return kernel;
+}
+
+/// \brief Convert a row of single channel depth or range values between
+/// floating point and integer storage.
+/// \param[in] _src Start of the source row.
+/// \param[in] _srcType Source channel type.
+/// \param[out] _dst Start of the destination row.
+/// \param[in] _dstType Destination channel type.
+/// \param[in] _width Number of pixels.
+/// \param[in] _scale Integer units per floating point unit.
+inline void ConvertDepthRow(const unsigned char *_src, ChannelType _srcType,
+    unsigned char *_dst, ChannelType _dstType, size_t _width, double _scale)
+{
+  const int srcBytes = ChannelBytes(_srcType);
+  const int dstBytes = ChannelBytes(_dstType);
+  if (_srcType == ChannelType::FLOAT32 && _dstType == ChannelType::UINT16)
+  {
+    // Most common case, float meters to uint16 millimeters
+    const float scale = static_cast<float>(_scale);
+    for (size_t i = 0; i < _width; ++i)
+    {
+      float v;
+      std::memcpy(&v, _src + i * 4, sizeof(v));
+      v *= scale;
+      const uint16_t d = v > 0 ? static_cast<uint16_t>(
+          std::min(v + 0.5f, 65535.0f)) : 0;
+      std::memcpy(_dst + i * 2, &d, sizeof(d));
+    }
+    return;
+  }
+  if (_srcType == ChannelType::UINT16 && _dstType == ChannelType::FLOAT32)
+  {
+    const float scale = static_cast<float>(1.0 / _scale);
+    for (size_t i = 0; i < _width; ++i)
+    {
+      uint16_t d;
+      std::memcpy(&d, _src + i * 2, sizeof(d));
+      const float v = d * scale;
+      std::memcpy(_dst + i * 4, &v, sizeof(v));
+    }
+    return;
+  }
+
+  const bool toInt = !IsFloat(_dstType);
+  for (size_t i = 0; i < _width; ++i)
+  {
+    float v = LoadChannel(_src + i * srcBytes, _srcType, false);
+    v = static_cast<float>(toInt ? v * _scale : v / _scale);
+    StoreChannel(v, _dstType, false, _dst + i * dstBytes);
+  }
+}
+
+/// \brief Bilinear demosaicing of an 8 bit Bayer image to RGB_INT8.
+/// \param[in] _src Start of the Bayer data.
+/// \param[in] _srcStep Row size of the Bayer data.
+/// \param[in] _info Layout of the Bayer format.
+/// \param[in] _width Image width.
+/// \param[in] _height Image height.
+/// \param[out] _dst Start of the RGB data, with rows of _width * 3 bytes.
+inline void DebayerBilinear(const uint8_t *_src, size_t _srcStep,
+    const PixelFormatInfo &_info, size_t _width, size_t _height,
+    uint8_t *_dst)
+{
+  // Mirror out of bounds neighbors, which keeps their Bayer color
+  auto mirror = [](size_t _i, ptrdiff_t _d, size_t _n) -> size_t
+  {
+    const ptrdiff_t j = static_cast<ptrdiff_t>(_i) + _d;
+    if (j < 0)
+      return _n > 1 ? 1 : 0;
+    if (j >= static_cast<ptrdiff_t>(_n))
+      return _n > 1 ? _n - 2 : 0;
+    return static_cast<size_t>(j);
+  };
+
+  for (size_t y = 0; y < _height; ++y)
+  {
+    const uint8_t *up = _src + mirror(y, -1, _height) * _srcStep;
+    const uint8_t *row = _src + y * _srcStep;
+    const uint8_t *down = _src + mirror(y, 1, _height) * _srcStep;
+    uint8_t *out = _dst + y * _width * 3;
+    for (size_t x = 0; x < _width; ++x, out += 3)
+    {
+      const size_t l = mirror(x, -1, _width);
+      const size_t r = mirror(x, 1, _width);
+      const int self = row[x];
+      const int cross = (up[x] + down[x] + row[l] + row[r] + 2) >> 2;
+      const int diagonal = (up[l] + up[r] + down[l] + down[r] + 2) >> 2;
+      const int horizontal = (row[l] + row[r] + 1) >> 1;
+      const int vertical = (up[x] + down[x] + 1) >> 1;
+
+      const bool redRow = static_cast<int>(y & 1u) == _info.bayerRedY;
+      switch (BayerColor(_info, x, y))
+      {
+        case 0:
+          out[0] = static_cast<uint8_t>(self);
+          out[1] = static_cast<uint8_t>(cross);
+          out[2] = static_cast<uint8_t>(diagonal);
+          break;
+        case 2:
+          out[0] = static_cast<uint8_t>(diagonal);
+          out[1] = static_cast<uint8_t>(cross);
+          out[2] = static_cast<uint8_t>(self);
+          break;
+        default:
+          out[0] = static_cast<uint8_t>(redRow ? horizontal : vertical);
+          out[1] = static_cast<uint8_t>(self);
+          out[2] = static_cast<uint8_t>(redRow ? vertical : horizontal);
+          break;
+      }
+    }
+  }
+}
+
+/// \brief Bayer format with red at a position of the 2x2 pattern.
+/// \param[in] _redX Column of red, 0 or 1.
+/// \param[in] _redY Row of red, 0 or 1.
+/// \return The Bayer format.
+inline PixelFormatType BayerFormat(int _redX, int _redY)
+{
+  if (_redY == 0)
+    return _redX == 0 ? BAYER_RGGB8 : BAYER_GRBG8;
+  return _redX == 0 ? BAYER_GBRG8 : BAYER_BGGR8;
+}
+
+/// \brief Source samples contributing to each destination sample when
+/// resampling one axis. Destination sample i reads the source samples
+/// index[offset[i]] to index[offset[i + 1] - 1] with the matching weights.
+struct ResampleTaps
+{
+  /// \brief Start of the taps of each destination sample, plus the end.
+  std::vector<size_t> offset;
+
+  /// \brief Source sample of each tap.
+  std::vector<size_t> index;
+
+  /// \brief Weight of each tap.
+  std::vector<double> weight;
+};
+
+/// \brief Compute the taps to resample an axis. Shrinking averages the
+/// source samples covered by each destination sample, weighted by their
+/// coverage. Enlarging interpolates linearly between sample centers.
+/// \param[in] _srcSize Number of source samples, at least 1.
+/// \param[in] _dstSize Number of destination samples.
+/// \param[out] _taps The taps.
+inline void ComputeResampleTaps(size_t _srcSize, size_t _dstSize,
+    ResampleTaps &_taps)
+{
+  _taps.offset.assign(1, 0);
+  _taps.index.clear();
+  _taps.weight.clear();
+  const double scale = static_cast<double>(_srcSize) / _dstSize;
+  for (size_t i = 0; i < _dstSize; ++i)
+  {
+    if (scale >= 1.0)
+    {
+      const double begin = i * scale;
+      const double end = (i + 1) * scale;
+      const size_t last = std::min(_srcSize,
+          static_cast<size_t>(std::ceil(end)));
+      for (size_t j = static_cast<size_t>(begin); j < last; ++j)
+      {
+        const double cover = std::min<double>(end, j + 1) -
+            std::max<double>(begin, j);
+        if (cover <= 0)
+          continue;
+        _taps.index.push_back(j);
+        _taps.weight.push_back(cover / scale);
+      }
+    }
+    else
+    {
+      const double center = std::min<double>(_srcSize - 1,
+          std::max(0.0, (i + 0.5) * scale - 0.5));
+      const size_t j = static_cast<size_t>(center);
+      const double frac = center - j;
+      _taps.index.push_back(j);
+      _taps.weight.push_back(1.0 - frac);
+      if (frac > 0)
+      {
+        _taps.index.push_back(j + 1);
+        _taps.weight.push_back(frac);
+      }
+    }
+    _taps.offset.push_back(_taps.index.size());
+  }
+}
+
+/// \brief Average F x F blocks of pixels. The channel type, channel count
+/// and factor are compile time constants, so the loops vectorize.
+/// \tparam T Channel type.
+/// \tparam AccT Type of the sum of F * F channels.
+/// \tparam F Factor, the size of a block.
+/// \tparam C Number of channels.
+/// \param[in] _src Start of the source data, aligned for T.
+/// \param[in] _srcStep Source row size, a multiple of sizeof(T).
+/// \param[in] _width Destination width.
+/// \param[in] _height Destination height.
+/// \param[out] _dst Start of the destination data, aligned for T.
+/// \param[in] _dstStep Destination row size, a multiple of sizeof(T).
+template<typename T, typename AccT, int F, int C>
+void DownscaleBox(const unsigned char *_src, size_t _srcStep,
+    size_t _width, size_t _height, unsigned char *_dst, size_t _dstStep)
+{
+  constexpr int kArea = F * F;
+  for (size_t y = 0; y < _height; ++y)
+  {
+    const T *rows[F];
+    for (int r = 0; r < F; ++r)
+      rows[r] = reinterpret_cast<const T *>(_src + (y * F + r) * _srcStep);
+    T *out = reinterpret_cast<T *>(_dst + y * _dstStep);
+
+    for (size_t x = 0; x < _width; ++x)
+    {
+      for (int c = 0; c < C; ++c)
+      {
+        AccT sum = 0;
+        for (int r = 0; r < F; ++r)
+          for (int k = 0; k < F; ++k)
+            sum += rows[r][(x * F + k) * C + c];
+
+        if constexpr (std::is_floating_point_v<T>)
+          out[x * C + c] = sum * (T(1) / kArea);
+        else
+          out[x * C + c] = static_cast<T>((sum + kArea / 2) / kArea);
+      }
+    }
+  }
+}
+
+/// \brief Box downscaling kernel for a channel type and factor.
+/// \tparam T Channel type.
+/// \tparam AccT Type of the sum of F * F channels.
+/// \tparam F Factor.
+/// \param[in] _channels Number of channels.
+/// \return The kernel, or nullptr if there is none.
+template<typename T, typename AccT, int F>
+void (*DownscaleBoxKernel(int _channels))(const unsigned char *, size_t,
+    size_t, size_t, unsigned char *, size_t)
+{
+  switch (_channels)
+  {
+    case 1:
+      return &DownscaleBox<T, AccT, F, 1>;
+    case 3:
+      return &DownscaleBox<T, AccT, F, 3>;
+    case 4:
+      return &DownscaleBox<T, AccT, F, 4>;
+    default:
+      return nullptr;
+  }
+}
+
+/// \brief Box downscaling kernel for a pixel format and factor.
+/// \tparam F Factor.
+/// \param[in] _info Layout of the pixel format.
+/// \return The kernel, or nullptr if there is none.
+template<int F>
+void (*DownscaleBoxKernel(const PixelFormatInfo &_info))(
+    const unsigned char *, size_t, size_t, size_t, unsigned char *, size_t)
+{
+  if (_info.bayerRedX >= 0)
+    return nullptr;
+
+  switch (_info.type)
+  {
+    case ChannelType::UINT8:
+      return DownscaleBoxKernel<uint8_t, uint32_t, F>(_info.channels);
+    case ChannelType::UINT16:
+      return DownscaleBoxKernel<uint16_t, uint32_t, F>(_info.channels);
+    case ChannelType::UINT32:
+      return DownscaleBoxKernel<uint32_t, uint64_t, F>(_info.channels);
+    case ChannelType::FLOAT32:
+      return DownscaleBoxKernel<float, float, F>(_info.channels);
+    default:
+      return nullptr;
+  }
+}
+}  // namespace detail
+}
+}
+#endif
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_MSGS_DETAIL_PARALLELFOR_HH_
+#define GZ_MSGS_DETAIL_PARALLELFOR_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "gz/msgs/config.hh"
+
+namespace gz
+{
+namespace msgs
+{
+namespace detail
+{
+/// \brief Work items below which splitting work across threads costs more
+/// than it saves.
+constexpr size_t kMinParallelItems = 16384;
+
+/// \brief Number of ranges that ParallelFor splits a workload into.
+/// \param[in] _count Number of work items.
+/// \param[in] _threads Maximum number of threads, or zero to use the
+/// hardware concurrency.
+/// \param[in] _minItems Fewest work items worth a range of their own.
+/// Lower it for work items that are expensive, such as whole messages.
+/// \return Number of ranges, at least one.
+inline unsigned int ParallelRanges(size_t _count, unsigned int _threads,
+    size_t _minItems = kMinParallelItems)
+{
+  if (_threads == 0)
+    _threads = std::max(1u, std::thread::hardware_concurrency());
+  const size_t maxRanges = std::max<size_t>(1u,
+      _count / std::max<size_t>(1u, _minItems));
+  return static_cast<unsigned int>(std::min<size_t>(_threads, maxRanges));
+}
+
+/// \brief Split [0, _count) into _ranges contiguous ranges and process each
+/// range on its own thread. The calling thread processes the first range.
+/// \param[in] _count Number of work items.
+/// \param[in] _ranges Number of ranges, usually from ParallelRanges.
+/// \param[in] _func Callable taking (size_t _begin, size_t _end,
+/// unsigned int _range).
+template<typename Func>
+void ParallelFor(size_t _count, unsigned int _ranges, Func &&_func)
+{
+  _ranges = std::max(1u, _ranges);
+  auto begin = [&](unsigned int _range)
+  {
+    return _count * _range / _ranges;
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(_ranges - 1);
+  for (unsigned int r = 1; r < _ranges; ++r)
+    threads.emplace_back([&, r] { _func(begin(r), begin(r + 1), r); });
+
+  _func(begin(0), begin(1), 0u);
+  for (std::thread &thread : threads)
+    thread.join();
+}
+}  // namespace detail
+}
+}
+#endif
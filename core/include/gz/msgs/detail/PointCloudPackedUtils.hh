@@ -23,8 +23,15 @@
 
 #include <gz/msgs/pointcloud_packed.pb.h>
 
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <limits>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #include "gz/msgs/config.hh"
 
@@ -435,6 +442,493 @@ int PointCloudPackedIteratorBase<
 
   return fieldIter->offset();
 }
+
+namespace detail
+{
+/// \brief Memory layout of the points stored in a PointCloudPacked.
+///
+/// Organized clouds store `height` rows of `width` points, each row
+/// starting `row_step` bytes after the previous one. Clouds that don't
+/// describe a consistent organized layout are treated as a single row
+/// covering all complete points in `data`.
+struct PointCloudPackedLayout
+{
+  /// \brief Number of rows
+  size_t rows{0};
+
+  /// \brief Number of points in each row
+  size_t cols{0};
+
+  /// \brief Distance in bytes between the start of two rows
+  size_t rowStep{0};
+
+  /// \brief Distance in bytes between the start of two points
+  size_t pointStep{0};
+};
+
+/// \brief Compute the layout of the points of a cloud whose data holds a
+/// given number of bytes.
+/// \param[in] _msg The cloud.
+/// \param[in] _size Size of the cloud data in bytes.
+/// \return The cloud layout. The layout is empty if point_step is zero.
+inline PointCloudPackedLayout Layout(const PointCloudPacked &_msg,
+    size_t _size)
+{
+  PointCloudPackedLayout layout;
+  layout.pointStep = _msg.point_step();
+  if (layout.pointStep == 0)
+    return layout;
+
+  const size_t width = _msg.width();
+  const size_t height = _msg.height();
+  const size_t rowStep = _msg.row_step();
+  if (width > 0 && height > 0 && rowStep >= width * layout.pointStep &&
+      (height - 1) * rowStep + width * layout.pointStep <= _size)
+  {
+    layout.rows = height;
+    layout.cols = width;
+    layout.rowStep = rowStep;
+  }
+  else
+  {
+    layout.rows = 1;
+    layout.cols = _size / layout.pointStep;
+    layout.rowStep = layout.cols * layout.pointStep;
+  }
+  return layout;
+}
+
+/// \brief Compute the layout of the points stored in a cloud.
+/// \param[in] _msg The cloud.
+/// \return The cloud layout. The layout is empty if point_step is zero.
+inline PointCloudPackedLayout Layout(const PointCloudPacked &_msg)
+{
+  return Layout(_msg, _msg.data().size());
+}
+
+/// \brief Get a pointer to a point from its row major index.
+/// \tparam CharT char or const char.
+/// \param[in] _data Start of the cloud data.
+/// \param[in] _layout Layout of the cloud.
+/// \param[in] _index Index of the point, in [0, rows * cols).
+/// \return Pointer to the first byte of the point.
+template<typename CharT>
+CharT *PointAt(CharT *_data, const PointCloudPackedLayout &_layout,
+    size_t _index)
+{
+  if (_layout.rows == 1)
+    return _data + _index * _layout.pointStep;
+  return _data + (_index / _layout.cols) * _layout.rowStep +
+      (_index % _layout.cols) * _layout.pointStep;
+}
+
+/// \brief Copy everything but the points from one cloud to another and
+/// make room for an unorganized set of points.
+/// \param[in] _src The source cloud.
+/// \param[in] _points Number of points of the destination cloud.
+/// \param[in] _isDense Value of the is_dense flag of the destination cloud.
+/// \param[out] _dst The destination cloud.
+inline void InitFilteredCloud(const PointCloudPacked &_src, size_t _points,
+    bool _isDense, PointCloudPacked &_dst)
+{
+  *_dst.mutable_header() = _src.header();
+  *_dst.mutable_field() = _src.field();
+  _dst.set_is_bigendian(_src.is_bigendian());
+  _dst.set_point_step(_src.point_step());
+  _dst.set_height(1);
+  _dst.set_width(static_cast<uint32_t>(_points));
+  _dst.set_row_step(static_cast<uint32_t>(_points * _src.point_step()));
+  _dst.set_is_dense(_isDense);
+  _dst.mutable_data()->resize(_points * _src.point_step());
+}
+
+/// \brief Copy points of a cloud to a densely packed buffer, with moves of
+/// a size known at compile time.
+/// \tparam Size Point step of the cloud.
+/// \param[in] _src Start of the source cloud data.
+/// \param[in] _layout Layout of the source cloud.
+/// \param[in] _indices Row major indices of the points to copy.
+/// \param[in] _count Number of indices.
+/// \param[out] _dst Destination buffer of _count points.
+template<size_t Size>
+void GatherPointsFixed(const char *_src, const PointCloudPackedLayout &_layout,
+    const uint32_t *_indices, size_t _count, char *_dst)
+{
+  for (size_t i = 0; i < _count; ++i, _dst += Size)
+    std::memcpy(_dst, PointAt(_src, _layout, _indices[i]), Size);
+}
+
+/// \brief Copy points of a cloud to a densely packed buffer.
+/// \param[in] _src Start of the source cloud data.
+/// \param[in] _layout Layout of the source cloud.
+/// \param[in] _indices Row major indices of the points to copy.
+/// \param[in] _count Number of indices.
+/// \param[out] _dst Destination buffer of _count points.
+inline void GatherPoints(const char *_src,
+    const PointCloudPackedLayout &_layout, const uint32_t *_indices,
+    size_t _count, char *_dst)
+{
+  // Common point steps get a constant size move, which compiles to a few
+  // vector loads and stores instead of a call to memcpy.
+  switch (_layout.pointStep)
+  {
+    case 12:
+      return GatherPointsFixed<12>(_src, _layout, _indices, _count, _dst);
+    case 16:
+      return GatherPointsFixed<16>(_src, _layout, _indices, _count, _dst);
+    case 24:
+      return GatherPointsFixed<24>(_src, _layout, _indices, _count, _dst);
+    case 32:
+      return GatherPointsFixed<32>(_src, _layout, _indices, _count, _dst);
+    case 48:
+      return GatherPointsFixed<48>(_src, _layout, _indices, _count, _dst);
+    case 64:
+      return GatherPointsFixed<64>(_src, _layout, _indices, _count, _dst);
+    default:
+      break;
+  }
+
+  for (size_t i = 0; i < _count; ++i, _dst += _layout.pointStep)
+  {
+    std::memcpy(_dst, PointAt(_src, _layout, _indices[i]),
+        _layout.pointStep);
+  }
+}
+
+/// \brief Call a function with a pointer to every point of a cloud, in row
+/// major order.
+/// \tparam CharT char or const char.
+/// \tparam Func Callable taking (CharT *_point, size_t _index).
+/// \param[in] _data Start of the cloud data.
+/// \param[in] _layout Layout of the cloud.
+/// \param[in] _func Function to call.
+template<typename CharT, typename Func>
+void ForEachPoint(CharT *_data, const PointCloudPackedLayout &_layout,
+    Func &&_func)
+{
+  size_t index = 0;
+  for (size_t row = 0; row < _layout.rows; ++row)
+  {
+    CharT *pt = _data + row * _layout.rowStep;
+    for (size_t col = 0; col < _layout.cols; ++col, ++index)
+      _func(pt + col * _layout.pointStep, index);
+  }
+}
+
+/// \brief Find a field by name.
+/// \param[in] _msg The cloud.
+/// \param[in] _name Name of the field.
+/// \return Pointer to the field, or nullptr if it doesn't exist.
+inline const PointCloudPacked::Field *FindField(
+    const PointCloudPacked &_msg, const std::string &_name)
+{
+  for (const auto &field : _msg.field())
+  {
+    if (field.name() == _name)
+      return &field;
+  }
+  return nullptr;
+}
+
+/// \brief Find three fields that hold the components of a vector
+/// (e.g. x/y/z). All of them must be FLOAT32 or FLOAT64 and share the same
+/// datatype.
+/// \param[in] _msg The cloud.
+/// \param[in] _names Names of the three fields.
+/// \param[out] _offsets Offsets of the three fields.
+/// \param[out] _type Datatype shared by the three fields.
+/// \return True if the three fields were found and are usable.
+inline bool FindVectorFields(const PointCloudPacked &_msg,
+    const std::string (&_names)[3], size_t (&_offsets)[3],
+    PointCloudPacked::Field::DataType &_type)
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    const PointCloudPacked::Field *field = FindField(_msg, _names[i]);
+    if (nullptr == field)
+      return false;
+
+    if (i == 0)
+      _type = field->datatype();
+
+    if (field->datatype() != _type ||
+        (_type != PointCloudPacked::Field::FLOAT32 &&
+         _type != PointCloudPacked::Field::FLOAT64))
+    {
+      return false;
+    }
+
+    const size_t typeSize =
+        _type == PointCloudPacked::Field::FLOAT32 ? 4u : 8u;
+    if (field->offset() + typeSize > _msg.point_step())
+      return false;
+    _offsets[i] = field->offset();
+  }
+  return true;
+}
+
+/// \brief Lay out an unorganized cloud to hold a number of points with x, y
+/// and z coordinates. The x, y and z fields of the cloud are kept if they
+/// are usable, otherwise the cloud gets FLOAT32 x, y and z fields only.
+/// \param[in,out] _msg The cloud.
+/// \param[in] _points Number of points.
+/// \param[out] _offsets Offsets of the x, y and z fields.
+/// \param[out] _type Datatype of the x, y and z fields.
+inline void InitXyzCloud(PointCloudPacked &_msg, size_t _points,
+    size_t (&_offsets)[3], PointCloudPacked::Field::DataType &_type)
+{
+  static const std::string kXyzNames[3] = {"x", "y", "z"};
+  if (!FindVectorFields(_msg, kXyzNames, _offsets, _type))
+  {
+    _msg.clear_field();
+    for (int i = 0; i < 3; ++i)
+    {
+      PointCloudPacked::Field *field = _msg.add_field();
+      field->set_name(kXyzNames[i]);
+      field->set_offset(4 * i);
+      field->set_datatype(PointCloudPacked::Field::FLOAT32);
+      field->set_count(1);
+      _offsets[i] = 4 * i;
+    }
+    _type = PointCloudPacked::Field::FLOAT32;
+    _msg.set_point_step(12);
+  }
+
+  _msg.set_height(1);
+  _msg.set_width(static_cast<uint32_t>(_points));
+  _msg.set_row_step(static_cast<uint32_t>(_points * _msg.point_step()));
+  _msg.mutable_data()->clear();
+  _msg.mutable_data()->resize(_points * _msg.point_step());
+}
+
+/// \brief Write the x, y and z coordinates of every point of a densely
+/// packed cloud.
+/// \tparam T Type of the coordinates in the cloud.
+/// \tparam Func Callable taking (size_t _index, double (&_xyz)[3]) that
+/// provides the coordinates of a point.
+/// \param[out] _data Start of the cloud data.
+/// \param[in] _pointStep Point step of the cloud.
+/// \param[in] _offsets Offsets of the x, y and z fields.
+/// \param[in] _points Number of points.
+/// \param[in] _func The coordinate provider.
+template<typename T, typename Func>
+void StoreXyz(char *_data, size_t _pointStep, const size_t (&_offsets)[3],
+    size_t _points, Func &&_func)
+{
+  for (size_t i = 0; i < _points; ++i, _data += _pointStep)
+  {
+    double xyz[3];
+    _func(i, xyz);
+    for (int j = 0; j < 3; ++j)
+    {
+      const T v = static_cast<T>(xyz[j]);
+      std::memcpy(_data + _offsets[j], &v, sizeof(T));
+    }
+  }
+}
+
+/// \brief Read the x, y and z coordinates of every point of a cloud, in
+/// row major order.
+/// \tparam T Type of the coordinates in the cloud.
+/// \tparam Func Callable taking (size_t _index, double _x, double _y,
+/// double _z).
+/// \param[in] _data Start of the cloud data.
+/// \param[in] _layout Layout of the cloud.
+/// \param[in] _offsets Offsets of the x, y and z fields.
+/// \param[in] _func The coordinate consumer.
+template<typename T, typename Func>
+void LoadXyz(const char *_data, const PointCloudPackedLayout &_layout,
+    const size_t (&_offsets)[3], Func &&_func)
+{
+  ForEachPoint(_data, _layout, [&](const char *_pt, size_t _index)
+  {
+    T xyz[3];
+    for (int j = 0; j < 3; ++j)
+      std::memcpy(&xyz[j], _pt + _offsets[j], sizeof(T));
+    _func(_index, xyz[0], xyz[1], xyz[2]);
+  });
+}
+
+/// \brief Apply a 3x4 row major transform to a vector stored in every point
+/// of a cloud.
+///
+/// The loop is kept free of branches and aliasing so that compilers can
+/// vectorize it, and points are read with memcpy so that unaligned fields
+/// are supported.
+/// \tparam T Scalar type of the vector components (float or double).
+/// \param[in, out] _data Start of the cloud data.
+/// \param[in] _layout Layout of the cloud.
+/// \param[in] _offsets Offsets of the x, y and z components.
+/// \param[in] _m Row major 3x4 transform. The last column is added to the
+/// result, pass zero to only rotate.
+template<typename T>
+void TransformVectors(char *_data, const PointCloudPackedLayout &_layout,
+    const size_t (&_offsets)[3], const T (&_m)[12])
+{
+  const size_t step = _layout.pointStep;
+  const size_t ox = _offsets[0];
+  const size_t oy = _offsets[1];
+  const size_t oz = _offsets[2];
+  for (size_t row = 0; row < _layout.rows; ++row)
+  {
+    char *pt = _data + row * _layout.rowStep;
+    for (size_t col = 0; col < _layout.cols; ++col, pt += step)
+    {
+      T x, y, z;
+      std::memcpy(&x, pt + ox, sizeof(T));
+      std::memcpy(&y, pt + oy, sizeof(T));
+      std::memcpy(&z, pt + oz, sizeof(T));
+      const T tx = _m[0] * x + _m[1] * y + _m[2] * z + _m[3];
+      const T ty = _m[4] * x + _m[5] * y + _m[6] * z + _m[7];
+      const T tz = _m[8] * x + _m[9] * y + _m[10] * z + _m[11];
+      std::memcpy(pt + ox, &tx, sizeof(T));
+      std::memcpy(pt + oy, &ty, sizeof(T));
+      std::memcpy(pt + oz, &tz, sizeof(T));
+    }
+  }
+}
+
+/// \brief Move the points whose vector components are all finite to the
+/// front of a cloud's data, keeping their order.
+/// \tparam T Scalar type of the vector components (float or double).
+/// \param[in, out] _data Start of the cloud data.
+/// \param[in] _layout Layout of the cloud.
+/// \param[in] _offsets Offsets of the x, y and z components.
+/// \param[out] _indices If not null, receives the row major index in the
+/// original layout of every point kept.
+/// \return Number of points kept.
+template<typename T>
+size_t CompactFinite(char *_data, const PointCloudPackedLayout &_layout,
+    const size_t (&_offsets)[3], std::vector<uint32_t> *_indices)
+{
+  const size_t step = _layout.pointStep;
+  char *out = _data;
+  size_t index = 0;
+  for (size_t row = 0; row < _layout.rows; ++row)
+  {
+    char *pt = _data + row * _layout.rowStep;
+    for (size_t col = 0; col < _layout.cols; ++col, ++index, pt += step)
+    {
+      T x, y, z;
+      std::memcpy(&x, pt + _offsets[0], sizeof(T));
+      std::memcpy(&y, pt + _offsets[1], sizeof(T));
+      std::memcpy(&z, pt + _offsets[2], sizeof(T));
+
+      if (!(std::isfinite(x) && std::isfinite(y) && std::isfinite(z)))
+        continue;
+
+      if (out != pt)
+        std::memmove(out, pt, step);
+      out += step;
+      if (_indices)
+        _indices->push_back(static_cast<uint32_t>(index));
+    }
+  }
+  return static_cast<size_t>(out - _data) / step;
+}
+
+/// \brief Call a function with a value of the C++ type that corresponds to
+/// a field datatype.
+/// \param[in] _type The field datatype.
+/// \param[in] _func Generic callable taking a value of the C++ type.
+/// \return False if the datatype is unknown.
+template<typename Func>
+bool VisitFieldType(PointCloudPacked::Field::DataType _type, Func &&_func)
+{
+  switch (_type)
+  {
+    case PointCloudPacked::Field::INT8:
+      _func(int8_t{});
+      return true;
+    case PointCloudPacked::Field::UINT8:
+      _func(uint8_t{});
+      return true;
+    case PointCloudPacked::Field::INT16:
+      _func(int16_t{});
+      return true;
+    case PointCloudPacked::Field::UINT16:
+      _func(uint16_t{});
+      return true;
+    case PointCloudPacked::Field::INT32:
+      _func(int32_t{});
+      return true;
+    case PointCloudPacked::Field::UINT32:
+      _func(uint32_t{});
+      return true;
+    case PointCloudPacked::Field::FLOAT32:
+      _func(float{});
+      return true;
+    case PointCloudPacked::Field::FLOAT64:
+      _func(double{});
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// \brief Convert a value between field types. Floating point values are
+/// rounded to the nearest integer, NaN becomes zero, and integers saturate
+/// at the bounds of the destination type.
+/// \tparam D Destination type.
+/// \tparam S Source type.
+/// \param[in] _value Value to convert.
+/// \return The converted value.
+template<typename D, typename S>
+D SaturateCast(S _value)
+{
+  if constexpr (std::is_floating_point_v<D>)
+  {
+    return static_cast<D>(_value);
+  }
+  else if constexpr (std::is_floating_point_v<S>)
+  {
+    const double v = std::floor(static_cast<double>(_value) + 0.5);
+    const double lo = static_cast<double>(std::numeric_limits<D>::min());
+    const double hi = static_cast<double>(std::numeric_limits<D>::max());
+    return std::isnan(v) ? D(0) :
+        static_cast<D>(v < lo ? lo : (v > hi ? hi : v));
+  }
+  else
+  {
+    // Every field integer type fits in int64_t.
+    const int64_t v = static_cast<int64_t>(_value);
+    const int64_t lo = static_cast<int64_t>(std::numeric_limits<D>::min());
+    const int64_t hi = static_cast<int64_t>(std::numeric_limits<D>::max());
+    return static_cast<D>(v < lo ? lo : (v > hi ? hi : v));
+  }
+}
+
+/// \brief Copy one field element of every point to a densely packed cloud,
+/// converting its type.
+/// \tparam D Destination type.
+/// \tparam S Source type.
+/// \param[in] _src Start of the source cloud data.
+/// \param[in] _layout Layout of the source cloud.
+/// \param[in] _srcOffset Offset of the element in a source point.
+/// \param[out] _dst Start of the destination cloud data.
+/// \param[in] _dstStep Point step of the destination cloud.
+/// \param[in] _dstOffset Offset of the element in a destination point.
+template<typename D, typename S>
+void ConvertFieldElement(const char *_src,
+    const PointCloudPackedLayout &_layout, size_t _srcOffset, char *_dst,
+    size_t _dstStep, size_t _dstOffset)
+{
+  char *out = _dst + _dstOffset;
+  for (size_t row = 0; row < _layout.rows; ++row)
+  {
+    const char *in = _src + row * _layout.rowStep + _srcOffset;
+    for (size_t col = 0; col < _layout.cols; ++col)
+    {
+      S value;
+      std::memcpy(&value, in, sizeof(S));
+      const D converted = SaturateCast<D>(value);
+      std::memcpy(out, &converted, sizeof(D));
+      in += _layout.pointStep;
+      out += _dstStep;
+    }
+  }
+}
+}  // namespace detail
 }
 }
 #endif
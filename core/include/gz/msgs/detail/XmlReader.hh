@@ -0,0 +1,570 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_MSGS_DETAIL_XMLREADER_HH_
+#define GZ_MSGS_DETAIL_XMLREADER_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gz/msgs/config.hh"
+
+namespace gz
+{
+namespace msgs
+{
+namespace detail
+{
+/// \brief Kind of item returned by XmlReader::Next.
+enum class XmlToken
+{
+  /// \brief Start of an element.
+  START,
+
+  /// \brief End of an element. Empty elements, <a/>, also produce one.
+  END,
+
+  /// \brief Character data or a CDATA section.
+  TEXT,
+
+  /// \brief End of the document.
+  DONE,
+
+  /// \brief The document is not well formed.
+  ERROR
+};
+
+/// \brief True for the characters that std::isspace accepts in the
+/// "C" locale.
+/// \param[in] _c The character.
+/// \return True if _c is whitespace.
+inline bool IsXmlSpace(char _c)
+{
+  return _c == ' ' || _c == '\t' || _c == '\n' || _c == '\r' ||
+      _c == '\v' || _c == '\f';
+}
+
+/// \brief Remove leading and trailing whitespace.
+/// \param[in] _s The string.
+/// \return _s without leading and trailing whitespace.
+inline std::string_view TrimXmlSpace(std::string_view _s)
+{
+  while (!_s.empty() && IsXmlSpace(_s.front()))
+    _s.remove_prefix(1);
+  while (!_s.empty() && IsXmlSpace(_s.back()))
+    _s.remove_suffix(1);
+  return _s;
+}
+
+/// \brief Append a code point to a string as UTF-8.
+/// \param[in] _code The code point.
+/// \param[in,out] _out The string.
+inline void AppendUtf8(uint32_t _code, std::string &_out)
+{
+  if (_code < 0x80)
+  {
+    _out += static_cast<char>(_code);
+  }
+  else if (_code < 0x800)
+  {
+    _out += static_cast<char>(0xC0 | (_code >> 6));
+    _out += static_cast<char>(0x80 | (_code & 0x3F));
+  }
+  else if (_code < 0x10000)
+  {
+    _out += static_cast<char>(0xE0 | (_code >> 12));
+    _out += static_cast<char>(0x80 | ((_code >> 6) & 0x3F));
+    _out += static_cast<char>(0x80 | (_code & 0x3F));
+  }
+  else
+  {
+    _out += static_cast<char>(0xF0 | (_code >> 18));
+    _out += static_cast<char>(0x80 | ((_code >> 12) & 0x3F));
+    _out += static_cast<char>(0x80 | ((_code >> 6) & 0x3F));
+    _out += static_cast<char>(0x80 | (_code & 0x3F));
+  }
+}
+
+/// \brief Parse a character reference such as "#65" or "#x41".
+/// \param[in] _ref The reference, without the '&' and ';'.
+/// \param[out] _code The code point.
+/// \return True if _ref is a valid character reference.
+inline bool ParseXmlCharRef(std::string_view _ref, uint32_t &_code)
+{
+  if (_ref.size() < 2 || _ref[0] != '#')
+    return false;
+  _ref.remove_prefix(1);
+  uint32_t base = 10;
+  if (_ref[0] == 'x')
+  {
+    base = 16;
+    _ref.remove_prefix(1);
+  }
+  if (_ref.empty() || _ref.size() > 8)
+    return false;
+
+  _code = 0;
+  for (char c : _ref)
+  {
+    uint32_t digit;
+    if (c >= '0' && c <= '9')
+      digit = c - '0';
+    else if (base == 16 && c >= 'a' && c <= 'f')
+      digit = c - 'a' + 10;
+    else if (base == 16 && c >= 'A' && c <= 'F')
+      digit = c - 'A' + 10;
+    else
+      return false;
+    _code = _code * base + digit;
+  }
+  return _code > 0 && _code <= 0x10FFFF;
+}
+
+/// \brief Get the value of character data the way tinyxml2 reports it:
+/// line ends are normalized to '\n' and, unless disabled, entity and
+/// character references are replaced. Unknown references are kept as is.
+/// \param[in] _raw Character data as it appears in the document.
+/// \param[in] _entities False for CDATA sections, whose references are
+/// not replaced.
+/// \param[in] _trim True to remove leading and trailing whitespace from
+/// the value.
+/// \param[out] _out The value.
+inline void XmlText(std::string_view _raw, bool _entities, bool _trim,
+    std::string &_out)
+{
+  const char *specials = _entities ? "&\r" : "\r";
+  size_t special = _raw.find_first_of(specials);
+  if (special == std::string_view::npos)
+  {
+    _out.assign(_trim ? TrimXmlSpace(_raw) : _raw);
+    return;
+  }
+
+  static constexpr std::string_view kEntities[5][2] = {
+    {"amp", "&"}, {"lt", "<"}, {"gt", ">"}, {"quot", "\""}, {"apos", "'"}};
+
+  _out.clear();
+  _out.reserve(_raw.size());
+  size_t i = 0;
+  while (special != std::string_view::npos)
+  {
+    _out.append(_raw.data() + i, special - i);
+    i = special + 1;
+    if (_raw[special] == '\r')
+    {
+      if (i == _raw.size() || _raw[i] != '\n')
+        _out += '\n';
+    }
+    else
+    {
+      const size_t end = _raw.find(';', i);
+      bool replaced = false;
+      if (end != std::string_view::npos && end - special <= 12)
+      {
+        const std::string_view ref = _raw.substr(i, end - i);
+        uint32_t code;
+        if (ParseXmlCharRef(ref, code))
+        {
+          AppendUtf8(code, _out);
+          replaced = true;
+        }
+        for (size_t e = 0; e < 5 && !replaced; ++e)
+        {
+          if (ref == kEntities[e][0])
+          {
+            _out += kEntities[e][1];
+            replaced = true;
+          }
+        }
+      }
+      if (replaced)
+        i = end + 1;
+      else
+        _out += '&';
+    }
+    special = _raw.find_first_of(specials, i);
+  }
+  _out.append(_raw.data() + i, _raw.size() - i);
+
+  if (_trim)
+  {
+    const std::string_view trimmed = TrimXmlSpace(_out);
+    _out.assign(trimmed.data(), trimmed.size());
+  }
+}
+
+/// \brief Streaming XML reader. Next() walks through the document one
+/// element boundary or text run at a time, without building a document
+/// tree or copying the input, so a caller can pick out the few elements
+/// it needs in a single pass. Comments, processing instructions and
+/// DOCTYPE declarations are skipped. Names are checked for matching
+/// start and end tags, but the reader does not validate everything a
+/// full XML parser would.
+class XmlReader
+{
+  /// \brief Constructor.
+  /// \param[in] _xml The document. Must outlive the reader.
+  public: explicit XmlReader(std::string_view _xml);
+
+  /// \brief Advance to the next item.
+  /// \return Kind of the item. After DONE or ERROR, every call returns
+  /// the same value again.
+  public: XmlToken Next();
+
+  /// \brief Name of the element of the current START or END item.
+  /// \return The name.
+  public: std::string_view Name() const;
+
+  /// \brief Character data of the current TEXT item, as it appears in the
+  /// document. Use XmlText to get its value.
+  /// \return The raw character data.
+  public: std::string_view Text() const;
+
+  /// \brief Whether the current TEXT item is a CDATA section.
+  /// \return True for CDATA sections.
+  public: bool CData() const;
+
+  /// \brief Depth of the current item. For START and END it is the depth
+  /// of the element, 1 for a root element. For TEXT it is the depth of
+  /// the enclosing element.
+  /// \return The depth.
+  public: size_t Depth() const;
+
+  /// \brief Find an attribute of the element of the current START item.
+  /// \param[in] _name Name of the attribute.
+  /// \param[out] _value Raw value of the attribute, without quotes. Use
+  /// XmlText to get its value.
+  /// \return True if the element has the attribute.
+  public: bool Attribute(std::string_view _name,
+              std::string_view &_value) const;
+
+  /// \brief Description of the error, after Next returned ERROR.
+  /// \return The description.
+  public: const char *Error() const;
+
+  /// \brief Stop with an error.
+  /// \param[in] _error Description of the error.
+  /// \return ERROR.
+  private: XmlToken Fail(const char *_error);
+
+  /// \brief Parse the next attribute of a start tag.
+  /// \param[in] _tag Text holding the attribute.
+  /// \param[in,out] _pos Position of the attribute in _tag, moved past
+  /// it.
+  /// \param[out] _name Name of the attribute.
+  /// \param[out] _value Raw value of the attribute.
+  /// \return False if the attribute is malformed.
+  private: static bool NextAttribute(std::string_view _tag, size_t &_pos,
+               std::string_view &_name, std::string_view &_value);
+
+  /// \brief Move past the end of a construct.
+  /// \param[in] _end String that ends the construct.
+  /// \return False if the document ends first.
+  private: bool SkipPast(std::string_view _end);
+
+  /// \brief The document.
+  private: std::string_view xml;
+
+  /// \brief Position of the next character to read.
+  private: size_t pos{0};
+
+  /// \brief Names of the open elements, innermost last.
+  private: std::vector<std::string_view> open;
+
+  /// \brief Name of the current element.
+  private: std::string_view name;
+
+  /// \brief Raw character data of the current TEXT item.
+  private: std::string_view text;
+
+  /// \brief Attributes of the current START item.
+  private: std::string_view attributes;
+
+  /// \brief Whether the current TEXT item is a CDATA section.
+  private: bool cdata{false};
+
+  /// \brief Depth of the current item.
+  private: size_t depth{0};
+
+  /// \brief Whether the current START item is an empty element, whose END
+  /// item comes next.
+  private: bool emptyElement{false};
+
+  /// \brief Token to repeat once the document is done or failed.
+  private: XmlToken last{XmlToken::START};
+
+  /// \brief Description of the error.
+  private: const char *error{""};
+};
+
+/////////////////////////////////////////////////
+inline XmlReader::XmlReader(std::string_view _xml)
+  : xml(_xml)
+{
+  this->open.reserve(16);
+}
+
+/////////////////////////////////////////////////
+inline XmlToken XmlReader::Next()
+{
+  if (this->last == XmlToken::DONE || this->last == XmlToken::ERROR)
+    return this->last;
+
+  if (this->emptyElement)
+  {
+    this->emptyElement = false;
+    this->open.pop_back();
+    return XmlToken::END;
+  }
+
+  const std::string_view doc = this->xml;
+  while (this->pos < doc.size())
+  {
+    // Character data runs to the next markup.
+    if (doc[this->pos] != '<')
+    {
+      size_t end = doc.find('<', this->pos);
+      if (end == std::string_view::npos)
+        end = doc.size();
+      this->text = doc.substr(this->pos, end - this->pos);
+      this->pos = end;
+      if (this->open.empty())
+      {
+        if (!TrimXmlSpace(this->text).empty())
+          return this->Fail("Text outside of the root element");
+        continue;
+      }
+      this->cdata = false;
+      this->depth = this->open.size();
+      return XmlToken::TEXT;
+    }
+
+    const std::string_view markup = doc.substr(this->pos);
+    if (markup.compare(0, 2, "<?") == 0)
+    {
+      if (!this->SkipPast("?>"))
+        return this->Fail("Unterminated processing instruction");
+      continue;
+    }
+    if (markup.compare(0, 4, "<!--") == 0)
+    {
+      if (!this->SkipPast("-->"))
+        return this->Fail("Unterminated comment");
+      continue;
+    }
+    if (markup.compare(0, 9, "<![CDATA[") == 0)
+    {
+      const size_t begin = this->pos + 9;
+      if (!this->SkipPast("]]>"))
+        return this->Fail("Unterminated CDATA section");
+      if (this->open.empty())
+        return this->Fail("CDATA section outside of the root element");
+      this->text = doc.substr(begin, this->pos - 3 - begin);
+      this->cdata = true;
+      this->depth = this->open.size();
+      return XmlToken::TEXT;
+    }
+    if (markup.compare(0, 2, "<!") == 0)
+    {
+      // DOCTYPE and other declarations, which may hold an internal subset
+      // in square brackets.
+      int brackets = 0;
+      size_t i = this->pos + 2;
+      for (; i < doc.size(); ++i)
+      {
+        if (doc[i] == '[')
+          ++brackets;
+        else if (doc[i] == ']')
+          --brackets;
+        else if (doc[i] == '>' && brackets <= 0)
+          break;
+      }
+      if (i == doc.size())
+        return this->Fail("Unterminated declaration");
+      this->pos = i + 1;
+      continue;
+    }
+
+    if (markup.compare(0, 2, "</") == 0)
+    {
+      const size_t close = doc.find('>', this->pos);
+      if (close == std::string_view::npos)
+        return this->Fail("Unterminated end tag");
+      const std::string_view endName = TrimXmlSpace(
+          doc.substr(this->pos + 2, close - this->pos - 2));
+      if (this->open.empty() || this->open.back() != endName)
+        return this->Fail("Mismatched end tag");
+      this->pos = close + 1;
+      this->name = endName;
+      this->depth = this->open.size();
+      this->open.pop_back();
+      return XmlToken::END;
+    }
+
+    // Start tag.
+    size_t i = this->pos + 1;
+    while (i < doc.size() && !IsXmlSpace(doc[i]) && doc[i] != '/' &&
+        doc[i] != '>' && doc[i] != '<')
+    {
+      ++i;
+    }
+    if (i == this->pos + 1)
+      return this->Fail("Missing element name");
+    this->name = doc.substr(this->pos + 1, i - this->pos - 1);
+
+    const size_t attributesBegin = i;
+    while (true)
+    {
+      while (i < doc.size() && IsXmlSpace(doc[i]))
+        ++i;
+      if (i >= doc.size())
+        return this->Fail("Unterminated start tag");
+      if (doc[i] == '>' || doc[i] == '/')
+        break;
+      std::string_view attributeName, attributeValue;
+      if (!NextAttribute(doc, i, attributeName, attributeValue))
+        return this->Fail("Malformed attribute");
+    }
+    this->attributes = doc.substr(attributesBegin, i - attributesBegin);
+    if (doc[i] == '/')
+    {
+      if (i + 1 >= doc.size() || doc[i + 1] != '>')
+        return this->Fail("Malformed empty element tag");
+      this->emptyElement = true;
+      ++i;
+    }
+    this->pos = i + 1;
+    this->open.push_back(this->name);
+    this->depth = this->open.size();
+    return XmlToken::START;
+  }
+
+  if (!this->open.empty())
+    return this->Fail("Unclosed element");
+  this->last = XmlToken::DONE;
+  return this->last;
+}
+
+/////////////////////////////////////////////////
+inline std::string_view XmlReader::Name() const
+{
+  return this->name;
+}
+
+/////////////////////////////////////////////////
+inline std::string_view XmlReader::Text() const
+{
+  return this->text;
+}
+
+/////////////////////////////////////////////////
+inline bool XmlReader::CData() const
+{
+  return this->cdata;
+}
+
+/////////////////////////////////////////////////
+inline size_t XmlReader::Depth() const
+{
+  return this->depth;
+}
+
+/////////////////////////////////////////////////
+inline bool XmlReader::Attribute(std::string_view _name,
+    std::string_view &_value) const
+{
+  size_t i = 0;
+  while (true)
+  {
+    while (i < this->attributes.size() && IsXmlSpace(this->attributes[i]))
+      ++i;
+    if (i >= this->attributes.size())
+      return false;
+
+    std::string_view attributeName, attributeValue;
+    if (!NextAttribute(this->attributes, i, attributeName, attributeValue))
+      return false;
+    if (attributeName == _name)
+    {
+      _value = attributeValue;
+      return true;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+inline const char *XmlReader::Error() const
+{
+  return this->error;
+}
+
+/////////////////////////////////////////////////
+inline XmlToken XmlReader::Fail(const char *_error)
+{
+  this->error = _error;
+  this->last = XmlToken::ERROR;
+  return this->last;
+}
+
+/////////////////////////////////////////////////
+inline bool XmlReader::NextAttribute(std::string_view _tag, size_t &_pos,
+    std::string_view &_name, std::string_view &_value)
+{
+  size_t i = _pos;
+  while (i < _tag.size() && !IsXmlSpace(_tag[i]) && _tag[i] != '=' &&
+      _tag[i] != '>' && _tag[i] != '/')
+  {
+    ++i;
+  }
+  if (i == _pos)
+    return false;
+  _name = _tag.substr(_pos, i - _pos);
+
+  while (i < _tag.size() && IsXmlSpace(_tag[i]))
+    ++i;
+  if (i >= _tag.size() || _tag[i] != '=')
+    return false;
+  ++i;
+  while (i < _tag.size() && IsXmlSpace(_tag[i]))
+    ++i;
+  if (i >= _tag.size() || (_tag[i] != '"' && _tag[i] != '\''))
+    return false;
+
+  const size_t close = _tag.find(_tag[i], i + 1);
+  if (close == std::string_view::npos)
+    return false;
+  _value = _tag.substr(i + 1, close - i - 1);
+  _pos = close + 1;
+  return true;
+}
+
+/////////////////////////////////////////////////
+inline bool XmlReader::SkipPast(std::string_view _end)
+{
+  const size_t end = this->xml.find(_end, this->pos);
+  if (end == std::string_view::npos)
+    return false;
+  this->pos = end + _end.size();
+  return true;
+}
+}  // namespace detail
+}
+}
+#endif
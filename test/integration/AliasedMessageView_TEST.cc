@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/dataframe.pb.h>
+#include <gz/msgs/image.pb.h>
+#include <gz/msgs/occupancy_grid.pb.h>
+#include <gz/msgs/pointcloud_packed.pb.h>
+
+#include <string>
+#include <string_view>
+
+#include "gz/msgs/AliasedMessageView.hh"
+
+using namespace gz;
+using namespace msgs;
+
+/////////////////////////////////////////////////
+TEST(AliasedMessageViewTest, Image)
+{
+  Image image;
+  image.mutable_header()->mutable_stamp()->set_sec(5);
+  image.set_width(20);
+  image.set_height(10);
+  image.set_step(60);
+  image.set_pixel_format_type(RGB_INT8);
+  image.mutable_data()->assign(600, 'p');
+  (*image.mutable_data())[599] = 'q';
+  const std::string buffer = image.SerializeAsString();
+
+  AliasedMessageView<Image> view;
+  ASSERT_TRUE(view.Parse(buffer));
+  EXPECT_EQ(5, view.Fields().header().stamp().sec());
+  EXPECT_EQ(20u, view.Fields().width());
+  EXPECT_EQ(RGB_INT8, view.Fields().pixel_format_type());
+  EXPECT_TRUE(view.Fields().data().empty());
+
+  // The field points into the buffer
+  ASSERT_EQ(600u, view.Data().size());
+  EXPECT_GE(view.Data().data(), buffer.data());
+  EXPECT_LE(view.Data().data() + view.Data().size(),
+      buffer.data() + buffer.size());
+  EXPECT_EQ(image.data(), view.Data());
+
+  Image copy;
+  view.CopyTo(copy);
+  EXPECT_EQ(buffer, copy.SerializeAsString());
+
+  // Parsing again forgets the previous message
+  Image other;
+  other.set_width(3);
+  ASSERT_TRUE(view.Parse(other.SerializeAsString()));
+  EXPECT_EQ(3u, view.Fields().width());
+  EXPECT_EQ(0, view.Fields().header().stamp().sec());
+  EXPECT_TRUE(view.Data().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(AliasedMessageViewTest, OtherMessages)
+{
+  PointCloudPacked cloud;
+  cloud.set_point_step(16);
+  cloud.add_field()->set_name("x");
+  cloud.mutable_data()->assign(64, '\x01');
+  std::string buffer = cloud.SerializeAsString();
+  AliasedMessageView<PointCloudPacked> cloudView;
+  ASSERT_TRUE(cloudView.Parse(buffer.data(), buffer.size()));
+  EXPECT_EQ(16u, cloudView.Fields().point_step());
+  EXPECT_EQ("x", cloudView.Fields().field(0).name());
+  EXPECT_EQ(cloud.data(), cloudView.Data());
+
+  OccupancyGrid grid;
+  grid.mutable_info()->set_resolution(0.05);
+  grid.mutable_info()->set_width(8);
+  grid.mutable_data()->assign(64, '\x64');
+  buffer = grid.SerializeAsString();
+  AliasedMessageView<OccupancyGrid> gridView;
+  ASSERT_TRUE(gridView.Parse(buffer));
+  EXPECT_DOUBLE_EQ(0.05, gridView.Fields().info().resolution());
+  EXPECT_EQ(grid.data(), gridView.Data());
+
+  Dataframe frame;
+  frame.set_src_address("a");
+  frame.set_dst_address("b");
+  frame.set_data(std::string("\0\1\2", 3));
+  buffer = frame.SerializeAsString();
+  AliasedMessageView<Dataframe> frameView;
+  ASSERT_TRUE(frameView.Parse(buffer));
+  EXPECT_EQ("a", frameView.Fields().src_address());
+  EXPECT_EQ("b", frameView.Fields().dst_address());
+  EXPECT_EQ(frame.data(), frameView.Data());
+
+  // Any bytes or string field can be aliased
+  AliasedMessageView<Dataframe> addressView("src_address");
+  ASSERT_TRUE(addressView.Parse(buffer));
+  EXPECT_EQ("a", addressView.Data());
+  EXPECT_TRUE(addressView.Fields().src_address().empty());
+  EXPECT_EQ(frame.data(), addressView.Fields().data());
+}
+
+/////////////////////////////////////////////////
+TEST(AliasedMessageViewTest, WireFormat)
+{
+  Image first;
+  first.set_width(1);
+  first.set_data("first");
+  Image second;
+  second.set_height(2);
+  second.set_data("second");
+
+  // Concatenated messages merge, and the last data wins
+  const std::string buffer =
+      first.SerializeAsString() + second.SerializeAsString();
+  AliasedMessageView<Image> view;
+  ASSERT_TRUE(view.Parse(buffer));
+  EXPECT_EQ(1u, view.Fields().width());
+  EXPECT_EQ(2u, view.Fields().height());
+  EXPECT_EQ("second", view.Data());
+
+  Image parsed;
+  ASSERT_TRUE(parsed.ParseFromString(buffer));
+  Image copy;
+  view.CopyTo(copy);
+  EXPECT_EQ(parsed.SerializeAsString(), copy.SerializeAsString());
+
+  // Empty message
+  ASSERT_TRUE(view.Parse(std::string_view()));
+  EXPECT_TRUE(view.Data().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(AliasedMessageViewTest, Errors)
+{
+  Image image;
+  image.set_width(4);
+  image.set_data(std::string(100, 'x'));
+  const std::string buffer = image.SerializeAsString();
+
+  AliasedMessageView<Image> view;
+  for (size_t size : {size_t(1), size_t(3), buffer.size() - 1})
+  {
+    EXPECT_FALSE(view.Parse(buffer.data(), size)) << size;
+    EXPECT_TRUE(view.Data().empty());
+    EXPECT_EQ(0u, view.Fields().width());
+  }
+  EXPECT_FALSE(view.Parse(std::string("\xff\xff\xff", 3)));
+
+  AliasedMessageView<Image> noField("pixels");
+  EXPECT_FALSE(noField.Parse(buffer));
+  AliasedMessageView<Image> notBytes("width");
+  EXPECT_FALSE(notBytes.Parse(buffer));
+  AliasedMessageView<Image> message("header");
+  EXPECT_FALSE(message.Parse(buffer));
+}
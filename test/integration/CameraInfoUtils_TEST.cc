@@ -0,0 +1,512 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/camera_info.pb.h>
+#include <gz/msgs/image.pb.h>
+#include <gz/msgs/pointcloud_packed.pb.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "gz/msgs/CameraInfoUtils.hh"
+
+using namespace gz;
+using namespace msgs;
+
+/////////////////////////////////////////////////
+/// \brief Create the calibration of a 64x48 camera.
+CameraInfo MakeCameraInfo(CameraInfo::Distortion::DistortionModelType _model,
+    const std::vector<double> &_k)
+{
+  CameraInfo info;
+  info.mutable_header()->mutable_stamp()->set_sec(1);
+  info.set_width(64);
+  info.set_height(48);
+  info.mutable_distortion()->set_model(_model);
+  for (double k : _k)
+    info.mutable_distortion()->add_k(k);
+  for (double k : {50.0, 0.0, 31.5, 0.0, 52.0, 23.5, 0.0, 0.0, 1.0})
+    info.mutable_intrinsics()->add_k(k);
+  return info;
+}
+
+/////////////////////////////////////////////////
+/// \brief Create an image whose first channels hold the column and row of
+/// every pixel.
+Image MakeCoordinateImage(uint32_t _width, uint32_t _height)
+{
+  Image image;
+  image.mutable_header()->mutable_stamp()->set_sec(7);
+  image.set_width(_width);
+  image.set_height(_height);
+  image.set_pixel_format_type(RGB_FLOAT32);
+  image.set_step(_width * 12 + 4);
+  image.mutable_data()->resize(image.step() * _height);
+  for (uint32_t y = 0; y < _height; ++y)
+  {
+    for (uint32_t x = 0; x < _width; ++x)
+    {
+      const float pixel[3] = {static_cast<float>(x), static_cast<float>(y),
+          1.0f};
+      std::memcpy(&(*image.mutable_data())[y * image.step() + x * 12],
+          pixel, sizeof(pixel));
+    }
+  }
+  return image;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a float channel of a densely packed image.
+float Channel(const Image &_image, size_t _x, size_t _y, int _c)
+{
+  float v;
+  std::memcpy(&v, _image.data().data() + _y * _image.step() +
+      (_x * 3 + _c) * sizeof(float), sizeof(v));
+  return v;
+}
+
+/////////////////////////////////////////////////
+TEST(CameraInfoUtilsTest, Identity)
+{
+  const CameraInfo info = MakeCameraInfo(CameraInfo::Distortion::PLUMB_BOB,
+      {});
+  ImageRectifier rectifier;
+  ASSERT_TRUE(rectifier.SetCameraInfo(info));
+
+  for (PixelFormatType format : {L_INT8, L_INT16, RGB_INT8, RGBA_INT8,
+       BGR_INT16, RGB_INT32, R_FLOAT16, RGB_FLOAT16, R_FLOAT32,
+       RGB_FLOAT32})
+  {
+    Image image;
+    image.set_width(64);
+    image.set_height(48);
+    image.set_pixel_format_type(format);
+    image.set_step(64 * BytesPerPixel(format));
+    image.mutable_data()->resize(image.step() * 48);
+    for (size_t i = 0; i < image.data().size(); ++i)
+      (*image.mutable_data())[i] = static_cast<char>((i * 7) % 61);
+
+    Image rectified;
+    ASSERT_TRUE(rectifier.Rectify(image, rectified, 1)) << format;
+    EXPECT_EQ(format, rectified.pixel_format_type());
+    EXPECT_TRUE(image.data() == rectified.data()) << format;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(CameraInfoUtilsTest, DistortionModels)
+{
+  struct Case
+  {
+    CameraInfo::Distortion::DistortionModelType model;
+    std::vector<double> k;
+  };
+  const Case cases[] = {
+      {CameraInfo::Distortion::PLUMB_BOB, {-0.2, 0.05, 0.001, -0.002, 0.01}},
+      {CameraInfo::Distortion::RATIONAL_POLYNOMIAL,
+       {-0.2, 0.05, 0.001, -0.002, 0.01, 0.1, -0.02, 0.003}},
+      {CameraInfo::Distortion::EQUIDISTANT, {0.05, -0.01, 0.002, 0.0}}};
+
+  const Image image = MakeCoordinateImage(64, 48);
+  for (const Case &test : cases)
+  {
+    const CameraInfo info = MakeCameraInfo(test.model, test.k);
+    ImageRectifier rectifier;
+    Image rectified;
+    ASSERT_TRUE(rectifier.Rectify(info, image, rectified));
+    EXPECT_EQ(7, rectified.header().stamp().sec());
+    ASSERT_EQ(64u * 12u, rectified.step());
+
+    double k[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    for (size_t i = 0; i < test.k.size(); ++i)
+      k[i] = test.k[i];
+
+    int checked = 0;
+    for (uint32_t v = 0; v < 48; ++v)
+    {
+      for (uint32_t u = 0; u < 64; ++u)
+      {
+        // Expected source position of the rectified pixel
+        const double x = (u - 31.5) / 50.0;
+        const double y = (v - 23.5) / 52.0;
+        const double r2 = x * x + y * y;
+        double xd;
+        double yd;
+        if (test.model == CameraInfo::Distortion::EQUIDISTANT)
+        {
+          const double theta = std::atan(std::sqrt(r2));
+          const double t2 = theta * theta;
+          const double thetaD = theta * (1 + k[0] * t2 + k[1] * t2 * t2 +
+              k[2] * t2 * t2 * t2 + k[3] * t2 * t2 * t2 * t2);
+          const double scale = r2 > 0 ? thetaD / std::sqrt(r2) : 1.0;
+          xd = x * scale;
+          yd = y * scale;
+        }
+        else
+        {
+          double radial = 1 + k[0] * r2 + k[1] * r2 * r2 +
+              k[4] * r2 * r2 * r2;
+          if (test.model == CameraInfo::Distortion::RATIONAL_POLYNOMIAL)
+            radial /= 1 + k[5] * r2 + k[6] * r2 * r2 + k[7] * r2 * r2 * r2;
+          xd = x * radial + 2 * k[2] * x * y + k[3] * (r2 + 2 * x * x);
+          yd = y * radial + k[2] * (r2 + 2 * y * y) + 2 * k[3] * x * y;
+        }
+        const double sx = 50.0 * xd + 31.5;
+        const double sy = 52.0 * yd + 23.5;
+
+        if (sx < 0 || sx > 63 || sy < 0 || sy > 47)
+          continue;
+        ++checked;
+        EXPECT_NEAR(sx, Channel(rectified, u, v, 0), 1.0 / 128)
+            << test.model << " " << u << ", " << v;
+        EXPECT_NEAR(sy, Channel(rectified, u, v, 1), 1.0 / 128)
+            << test.model << " " << u << ", " << v;
+        EXPECT_FLOAT_EQ(1.0f, Channel(rectified, u, v, 2));
+      }
+    }
+    EXPECT_GT(checked, 64 * 48 / 2);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(CameraInfoUtilsTest, ProjectionAndOutside)
+{
+  CameraInfo info = MakeCameraInfo(CameraInfo::Distortion::PLUMB_BOB, {});
+
+  // The rectified image is shifted 10 pixels to the right, so the first
+  // columns have no source
+  for (double p : {50.0, 0.0, 41.5, 0.0, 0.0, 52.0, 23.5, 0.0,
+       0.0, 0.0, 1.0, 0.0})
+  {
+    info.mutable_projection()->add_p(p);
+  }
+
+  const Image image = MakeCoordinateImage(64, 48);
+  ImageRectifier rectifier;
+  Image rectified;
+  ASSERT_TRUE(rectifier.Rectify(info, image, rectified));
+  for (uint32_t v = 0; v < 48; ++v)
+  {
+    for (uint32_t u = 0; u < 64; ++u)
+    {
+      if (u < 10)
+      {
+        EXPECT_FLOAT_EQ(0.0f, Channel(rectified, u, v, 2)) << u;
+        continue;
+      }
+      EXPECT_NEAR(u - 10.0, Channel(rectified, u, v, 0), 1e-4);
+      EXPECT_NEAR(v, Channel(rectified, u, v, 1), 1e-4);
+    }
+  }
+
+  // A rotation about the optical axis by 180 degrees flips the image
+  info.clear_projection();
+  for (double r : {-1.0, 0.0, 0.0, 0.0, -1.0, 0.0, 0.0, 0.0, 1.0})
+    info.add_rectification_matrix(r);
+  ASSERT_TRUE(rectifier.Rectify(info, image, rectified));
+  EXPECT_NEAR(63.0, Channel(rectified, 0, 0, 0), 1e-4);
+  EXPECT_NEAR(47.0, Channel(rectified, 0, 0, 1), 1e-4);
+  EXPECT_NEAR(0.0, Channel(rectified, 63, 47, 0), 1e-4);
+}
+
+/////////////////////////////////////////////////
+TEST(CameraInfoUtilsTest, Cache)
+{
+  CameraInfo info = MakeCameraInfo(CameraInfo::Distortion::PLUMB_BOB,
+      {-0.1, 0.01, 0.0, 0.0, 0.0});
+  ImageRectifier rectifier;
+  EXPECT_EQ(0u, rectifier.CalibrationHash());
+  EXPECT_TRUE(rectifier.RemapTable().empty());
+
+  ASSERT_TRUE(rectifier.SetCameraInfo(info));
+  const size_t hash = rectifier.CalibrationHash();
+  EXPECT_NE(0u, hash);
+  EXPECT_EQ(64u * 48u, rectifier.RemapTable().size());
+
+  // The header doesn't change the calibration
+  info.mutable_header()->mutable_stamp()->set_sec(2);
+  ASSERT_TRUE(rectifier.SetCameraInfo(info));
+  EXPECT_EQ(hash, rectifier.CalibrationHash());
+
+  info.mutable_distortion()->set_k(0, -0.2);
+  ASSERT_TRUE(rectifier.SetCameraInfo(info));
+  EXPECT_NE(hash, rectifier.CalibrationHash());
+
+  // Invalid calibrations
+  CameraInfo bad = info;
+  bad.mutable_intrinsics()->clear_k();
+  EXPECT_FALSE(rectifier.SetCameraInfo(bad));
+  EXPECT_EQ(0u, rectifier.CalibrationHash());
+  bad = info;
+  bad.mutable_intrinsics()->set_k(0, 0.0);
+  EXPECT_FALSE(rectifier.SetCameraInfo(bad));
+  bad = info;
+  bad.set_width(0);
+  EXPECT_FALSE(rectifier.SetCameraInfo(bad));
+
+  Image image = MakeCoordinateImage(64, 48);
+  Image rectified;
+  EXPECT_FALSE(rectifier.Rectify(image, rectified));
+  ASSERT_TRUE(rectifier.SetCameraInfo(info));
+  image = MakeCoordinateImage(64, 47);
+  EXPECT_FALSE(rectifier.Rectify(image, rectified));
+}
+
+/////////////////////////////////////////////////
+TEST(CameraInfoUtilsTest, ThreadsAndBayer)
+{
+  CameraInfo info = MakeCameraInfo(CameraInfo::Distortion::PLUMB_BOB,
+      {-0.25, 0.06, 0.0, 0.0, 0.0});
+  info.set_width(640);
+  info.set_height(480);
+  info.mutable_intrinsics()->set_k(2, 319.5);
+  info.mutable_intrinsics()->set_k(5, 239.5);
+
+  Image image;
+  image.set_width(640);
+  image.set_height(480);
+  image.set_pixel_format_type(RGB_INT8);
+  image.set_step(640 * 3);
+  image.mutable_data()->resize(640 * 480 * 3);
+  for (size_t i = 0; i < image.data().size(); ++i)
+    (*image.mutable_data())[i] = static_cast<char>(i % 251);
+
+  ImageRectifier rectifier;
+  ASSERT_TRUE(rectifier.SetCameraInfo(info));
+  Image single;
+  Image multi;
+  ASSERT_TRUE(rectifier.Rectify(image, single, 1));
+  ASSERT_TRUE(rectifier.Rectify(image, multi, 4));
+  EXPECT_EQ(single.data(), multi.data());
+
+  image.set_pixel_format_type(BAYER_GRBG8);
+  image.set_step(640);
+  image.mutable_data()->resize(640 * 480);
+  ASSERT_TRUE(rectifier.Rectify(image, single));
+  EXPECT_EQ(BAYER_GRBG8, single.pixel_format_type());
+  EXPECT_EQ(640u * 480u, single.data().size());
+}
+
+/////////////////////////////////////////////////
+/// \brief Create a depth image.
+Image MakeDepthImage(uint32_t _width, uint32_t _height,
+    PixelFormatType _format)
+{
+  Image image;
+  image.mutable_header()->mutable_stamp()->set_sec(9);
+  image.set_width(_width);
+  image.set_height(_height);
+  image.set_pixel_format_type(_format);
+  const size_t bytes = _format == L_INT16 ? 2 : 4;
+  image.set_step(_width * bytes + 2);
+  image.mutable_data()->resize(image.step() * _height);
+  for (uint32_t y = 0; y < _height; ++y)
+  {
+    for (uint32_t x = 0; x < _width; ++x)
+    {
+      char *out = &(*image.mutable_data())[y * image.step() + x * bytes];
+      const uint16_t mm = static_cast<uint16_t>(1000 + 10 * x + y);
+      const float m = mm / 1000.0f;
+      if (_format == L_INT16)
+        std::memcpy(out, &mm, sizeof(mm));
+      else
+        std::memcpy(out, &m, sizeof(m));
+    }
+  }
+  return image;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a float field of a point.
+float PointField(const PointCloudPacked &_cloud, size_t _x, size_t _y,
+    int _field)
+{
+  float v;
+  std::memcpy(&v, _cloud.data().data() + _y * _cloud.row_step() +
+      _x * _cloud.point_step() + _field * sizeof(float), sizeof(v));
+  return v;
+}
+
+/////////////////////////////////////////////////
+TEST(DepthImageProjectorTest, Pinhole)
+{
+  const CameraInfo info = MakeCameraInfo(CameraInfo::Distortion::PLUMB_BOB,
+      {});
+  DepthImageProjector projector;
+  PointCloudPacked cloud;
+  for (PixelFormatType format : {R_FLOAT32, L_INT16})
+  {
+    Image depth = MakeDepthImage(64, 48, format);
+    ASSERT_TRUE(projector.Project(info, depth, cloud));
+    EXPECT_EQ(9, cloud.header().stamp().sec());
+    EXPECT_EQ(64u, cloud.width());
+    EXPECT_EQ(48u, cloud.height());
+    EXPECT_EQ(12u, cloud.point_step());
+    EXPECT_EQ(64u * 12u, cloud.row_step());
+    ASSERT_EQ(3, cloud.field_size());
+    EXPECT_EQ("z", cloud.field(2).name());
+    EXPECT_TRUE(cloud.is_dense());
+    ASSERT_EQ(64u * 48u * 12u, cloud.data().size());
+
+    for (size_t y : {0u, 13u, 47u})
+    {
+      for (size_t x : {0u, 31u, 63u})
+      {
+        const double z = (1000 + 10 * x + y) / 1000.0;
+        EXPECT_NEAR(z, PointField(cloud, x, y, 2), 1e-6);
+        EXPECT_NEAR(z * (x - 31.5) / 50.0, PointField(cloud, x, y, 0), 1e-5);
+        EXPECT_NEAR(z * (y - 23.5) / 52.0, PointField(cloud, x, y, 1), 1e-5);
+      }
+    }
+  }
+
+  // Zero, NaN and infinite depth become NaN points
+  Image depth = MakeDepthImage(64, 48, R_FLOAT32);
+  const float invalid[3] = {0.0f, std::nanf(""), INFINITY};
+  for (int i = 0; i < 3; ++i)
+  {
+    std::memcpy(&(*depth.mutable_data())[5 * depth.step() + i * 4],
+        &invalid[i], sizeof(float));
+  }
+  ASSERT_TRUE(projector.Project(depth, cloud));
+  EXPECT_FALSE(cloud.is_dense());
+  for (size_t x = 0; x < 3; ++x)
+  {
+    for (int f = 0; f < 3; ++f)
+      EXPECT_TRUE(std::isnan(PointField(cloud, x, 5, f)));
+  }
+  EXPECT_FALSE(std::isnan(PointField(cloud, 3, 5, 2)));
+
+  // Depth in other units
+  depth = MakeDepthImage(64, 48, L_INT16);
+  ASSERT_TRUE(projector.Project(depth, cloud, 1, 100.0));
+  EXPECT_NEAR(10.0, PointField(cloud, 0, 0, 2), 1e-5);
+
+  // Invalid input
+  depth.set_pixel_format_type(RGB_INT8);
+  EXPECT_FALSE(projector.Project(depth, cloud));
+  depth = MakeDepthImage(32, 48, L_INT16);
+  EXPECT_FALSE(projector.Project(depth, cloud));
+  depth = MakeDepthImage(64, 48, L_INT16);
+  depth.mutable_data()->resize(100);
+  EXPECT_FALSE(projector.Project(depth, cloud));
+  EXPECT_FALSE(DepthImageProjector().Project(
+      MakeDepthImage(64, 48, L_INT16), cloud));
+}
+
+/////////////////////////////////////////////////
+TEST(DepthImageProjectorTest, Distortion)
+{
+  const CameraInfo info = MakeCameraInfo(CameraInfo::Distortion::PLUMB_BOB,
+      {-0.2, 0.05, 0.001, -0.002, 0.0});
+  DepthImageProjector projector;
+  ASSERT_TRUE(projector.SetCameraInfo(info));
+  const size_t hash = projector.CalibrationHash();
+  EXPECT_NE(0u, hash);
+
+  // The distorted rays project back onto their pixels
+  const std::vector<float> &rays = projector.Rays();
+  ASSERT_EQ(2u * 64u * 48u, rays.size());
+  const double k[8] = {-0.2, 0.05, 0.001, -0.002, 0, 0, 0, 0};
+  for (size_t v : {0u, 20u, 47u})
+  {
+    for (size_t u : {0u, 40u, 63u})
+    {
+      double xd;
+      double yd;
+      detail::Distort(CameraInfo::Distortion::PLUMB_BOB, k,
+          rays[v * 64 + u], rays[64 * 48 + v * 64 + u], xd, yd);
+      EXPECT_NEAR(static_cast<double>(u), 50.0 * xd + 31.5, 1e-3);
+      EXPECT_NEAR(static_cast<double>(v), 52.0 * yd + 23.5, 1e-3);
+    }
+  }
+
+  // The rays are cached while the calibration doesn't change
+  CameraInfo other = info;
+  other.mutable_header()->mutable_stamp()->set_sec(100);
+  const float *data = projector.Rays().data();
+  ASSERT_TRUE(projector.SetCameraInfo(other));
+  EXPECT_EQ(hash, projector.CalibrationHash());
+  EXPECT_EQ(data, projector.Rays().data());
+
+  other.mutable_intrinsics()->set_k(0, 0.0);
+  other.mutable_intrinsics()->set_k(1, 0.0);
+  EXPECT_FALSE(projector.SetCameraInfo(other));
+  EXPECT_EQ(0u, projector.CalibrationHash());
+  EXPECT_TRUE(projector.Rays().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(DepthImageProjectorTest, ColorAndThreads)
+{
+  const CameraInfo info = MakeCameraInfo(CameraInfo::Distortion::PLUMB_BOB,
+      {});
+  DepthImageProjector projector;
+  ASSERT_TRUE(projector.SetCameraInfo(info));
+  const Image depth = MakeDepthImage(64, 48, L_INT16);
+
+  Image rgb;
+  rgb.set_width(64);
+  rgb.set_height(48);
+  rgb.set_pixel_format_type(RGB_INT8);
+  rgb.set_step(64 * 3);
+  rgb.mutable_data()->resize(rgb.step() * 48);
+  for (size_t i = 0; i < rgb.data().size(); ++i)
+    (*rgb.mutable_data())[i] = static_cast<char>(i * 7);
+
+  PointCloudPacked single;
+  ASSERT_TRUE(projector.Project(depth, rgb, single, 1));
+  ASSERT_EQ(4, single.field_size());
+  EXPECT_EQ("rgb", single.field(3).name());
+  EXPECT_EQ(16u, single.point_step());
+  const auto *pixel =
+      reinterpret_cast<const unsigned char *>(rgb.data().data()) +
+      10 * rgb.step() + 20 * 3;
+  const uint32_t expected = static_cast<uint32_t>(pixel[0]) << 16 |
+      static_cast<uint32_t>(pixel[1]) << 8 | pixel[2];
+  uint32_t packed;
+  std::memcpy(&packed, single.data().data() + 10 * single.row_step() +
+      20 * 16 + 12, sizeof(packed));
+  EXPECT_EQ(expected, packed);
+
+  // Threads, and formats that need a conversion, give the same cloud
+  PointCloudPacked threaded;
+  ASSERT_TRUE(projector.Project(depth, rgb, threaded, 4));
+  EXPECT_TRUE(single.data() == threaded.data());
+
+  Image bgr;
+  ASSERT_TRUE(ConvertImage(rgb, BGR_INT8, bgr));
+  ASSERT_TRUE(projector.Project(depth, bgr, threaded, 3));
+  EXPECT_TRUE(single.data() == threaded.data());
+
+  Image wide;
+  ASSERT_TRUE(ConvertImage(rgb, RGB_INT16, wide));
+  ASSERT_TRUE(projector.Project(depth, wide, threaded));
+  EXPECT_TRUE(single.data() == threaded.data());
+
+  // Without color, the layout is reset
+  ASSERT_TRUE(projector.Project(depth, threaded));
+  EXPECT_EQ(3, threaded.field_size());
+  EXPECT_EQ(12u, threaded.point_step());
+
+  rgb.set_width(32);
+  EXPECT_FALSE(projector.Project(depth, rgb, threaded));
+}
@@ -0,0 +1,293 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "gz/msgs/ChunkUtils.hh"
+#include "gz/msgs/PointCloudPackedUtils.hh"
+
+using namespace gz;
+using namespace msgs;
+
+/////////////////////////////////////////////////
+/// \brief Create an image with a distinct value in every byte.
+Image TestImage(unsigned int _width, unsigned int _height)
+{
+  Image image;
+  image.set_width(_width);
+  image.set_height(_height);
+  image.set_step(_width * 3 + 2);
+  image.set_pixel_format_type(RGB_INT8);
+  image.mutable_header()->mutable_stamp()->set_sec(12);
+  Header::Map *frame = image.mutable_header()->add_data();
+  frame->set_key("frame_id");
+  frame->add_value("camera");
+  std::string *data = image.mutable_data();
+  data->resize(image.step() * _height);
+  for (size_t i = 0; i < data->size(); ++i)
+    (*data)[i] = static_cast<char>(i * 7);
+  return image;
+}
+
+/////////////////////////////////////////////////
+TEST(ChunkUtilsTest, Image)
+{
+  const Image image = TestImage(10, 25);
+
+  // 100 bytes hold 3 rows of 32 bytes
+  std::vector<Image> chunks = SplitIntoChunks(image, 100);
+  ASSERT_EQ(9u, chunks.size());
+  for (size_t i = 0; i < chunks.size(); ++i)
+  {
+    const Image &chunk = chunks[i];
+    EXPECT_EQ(10u, chunk.width());
+    EXPECT_EQ(i < 8 ? 3u : 1u, chunk.height());
+    EXPECT_EQ(image.step(), chunk.step());
+    EXPECT_EQ(chunk.height() * chunk.step(), chunk.data().size());
+    EXPECT_EQ(image.data().substr(i * 96, chunk.data().size()),
+              chunk.data());
+    EXPECT_EQ(RGB_INT8, chunk.pixel_format_type());
+    EXPECT_EQ(12, chunk.header().stamp().sec());
+
+    ChunkInfo info;
+    ASSERT_TRUE(ChunkInfoFromHeader(chunk.header(), info));
+    EXPECT_EQ(i, info.index);
+    EXPECT_EQ(9u, info.count);
+    EXPECT_EQ(i * 3, info.offset);
+    EXPECT_EQ(25u, info.height);
+    EXPECT_EQ(10u, info.width);
+  }
+
+  // Reassemble out of order
+  Image dst;
+  ChunkReassembler<Image> reassembler(dst);
+  EXPECT_FALSE(reassembler.Complete());
+  std::reverse(chunks.begin(), chunks.end());
+  for (size_t i = 0; i < chunks.size(); ++i)
+  {
+    EXPECT_FALSE(reassembler.Complete());
+    EXPECT_TRUE(reassembler.Add(chunks[i]));
+    // Duplicates are harmless until the message is complete
+    if (i + 1 < chunks.size())
+    {
+      EXPECT_TRUE(reassembler.Add(chunks[i]));
+    }
+  }
+  EXPECT_TRUE(reassembler.Complete());
+  EXPECT_EQ(image.DebugString(), dst.DebugString());
+
+  // Late chunks of the complete message leave it intact
+  for (const Image &chunk : chunks)
+    EXPECT_FALSE(reassembler.Add(chunk));
+  EXPECT_TRUE(reassembler.Complete());
+  EXPECT_EQ(image.DebugString(), dst.DebugString());
+
+  // A new message reuses the destination buffer
+  Image next = TestImage(10, 25);
+  next.mutable_header()->mutable_stamp()->set_sec(13);
+  const char *buffer = dst.data().data();
+  std::vector<Image> nextChunks = SplitIntoChunks(next, 100);
+  EXPECT_TRUE(reassembler.Add(nextChunks[0]));
+  EXPECT_FALSE(reassembler.Complete());
+  EXPECT_EQ(13, dst.header().stamp().sec());
+  EXPECT_EQ(buffer, dst.data().data());
+  for (const Image &chunk : nextChunks)
+    EXPECT_TRUE(reassembler.Add(chunk));
+  EXPECT_TRUE(reassembler.Complete());
+  EXPECT_EQ(next.DebugString(), dst.DebugString());
+
+  reassembler.Reset();
+  EXPECT_FALSE(reassembler.Complete());
+
+  // Rows larger than the chunk size are not split
+  unsigned int calls = 0;
+  EXPECT_TRUE(SplitIntoChunks(image, 1, [&](const Image &_chunk)
+  {
+    EXPECT_EQ(1u, _chunk.height());
+    ++calls;
+  }));
+  EXPECT_EQ(25u, calls);
+}
+
+/////////////////////////////////////////////////
+TEST(ChunkUtilsTest, SameStampMessages)
+{
+  // Two messages with the same stamp and geometry but different data
+  const Image first = TestImage(4, 8);
+  Image second = first;
+  std::fill(second.mutable_data()->begin(), second.mutable_data()->end(),
+      'B');
+  const std::vector<Image> firstChunks = SplitIntoChunks(first, 30);
+  const std::vector<Image> secondChunks = SplitIntoChunks(second, 30);
+  ASSERT_EQ(4u, firstChunks.size());
+  ASSERT_EQ(4u, secondChunks.size());
+
+  ChunkInfo firstInfo;
+  ChunkInfo secondInfo;
+  ASSERT_TRUE(ChunkInfoFromHeader(firstChunks[0].header(), firstInfo));
+  ASSERT_TRUE(ChunkInfoFromHeader(secondChunks[0].header(), secondInfo));
+  EXPECT_NE(firstInfo.sequence, secondInfo.sequence);
+
+  // Back to back
+  Image dst;
+  ChunkReassembler<Image> reassembler(dst);
+  for (const Image &chunk : firstChunks)
+    EXPECT_TRUE(reassembler.Add(chunk));
+  EXPECT_TRUE(reassembler.Complete());
+  EXPECT_EQ(first.data(), dst.data());
+  for (size_t i = 0; i < secondChunks.size(); ++i)
+  {
+    EXPECT_TRUE(reassembler.Add(secondChunks[i]));
+    EXPECT_EQ(i + 1 == secondChunks.size(), reassembler.Complete());
+  }
+  EXPECT_EQ(second.data(), dst.data());
+
+  // The second message interrupts an incomplete first message
+  EXPECT_TRUE(reassembler.Add(firstChunks[0]));
+  EXPECT_TRUE(reassembler.Add(firstChunks[1]));
+  for (size_t i = 0; i < secondChunks.size(); ++i)
+  {
+    EXPECT_TRUE(reassembler.Add(secondChunks[i]));
+    EXPECT_EQ(i + 1 == secondChunks.size(), reassembler.Complete());
+  }
+  EXPECT_EQ(second.data(), dst.data());
+}
+
+/////////////////////////////////////////////////
+TEST(ChunkUtilsTest, PointCloudPacked)
+{
+  PointCloudPacked organized;
+  InitPointCloudPacked(organized, "lidar", false,
+      {{"xyz", PointCloudPacked::Field::FLOAT32}});
+  organized.set_height(16);
+  organized.set_width(20);
+  organized.set_row_step(20 * organized.point_step() + 8);
+  organized.set_is_dense(true);
+  organized.mutable_data()->resize(16 * organized.row_step());
+  for (size_t i = 0; i < organized.data().size(); ++i)
+    (*organized.mutable_data())[i] = static_cast<char>(i);
+
+  // Organized clouds are split into rows
+  std::vector<PointCloudPacked> chunks = SplitIntoChunks(organized, 1000);
+  ASSERT_EQ(4u, chunks.size());
+  EXPECT_EQ(4u, chunks[0].height());
+  EXPECT_EQ(20u, chunks[0].width());
+  EXPECT_EQ(organized.row_step(), chunks[0].row_step());
+  EXPECT_EQ(organized.field_size(), chunks[0].field_size());
+
+  PointCloudPacked dst;
+  ChunkReassembler<PointCloudPacked> reassembler(dst);
+  for (const PointCloudPacked &chunk : chunks)
+    EXPECT_TRUE(reassembler.Add(chunk));
+  EXPECT_TRUE(reassembler.Complete());
+  EXPECT_EQ(organized.DebugString(), dst.DebugString());
+
+  // Unorganized clouds are split into points
+  PointCloudPacked unorganized = organized;
+  unorganized.set_height(1);
+  unorganized.set_width(100);
+  unorganized.set_row_step(100 * unorganized.point_step());
+  unorganized.mutable_data()->resize(unorganized.row_step());
+
+  chunks = SplitIntoChunks(unorganized, 240);
+  ASSERT_EQ(5u, chunks.size());
+  for (const PointCloudPacked &chunk : chunks)
+  {
+    EXPECT_EQ(1u, chunk.height());
+    EXPECT_EQ(20u, chunk.width());
+    EXPECT_EQ(240u, chunk.row_step());
+    EXPECT_EQ(240u, chunk.data().size());
+  }
+
+  ChunkReassembler<PointCloudPacked> unorganizedReassembler(dst);
+  for (const PointCloudPacked &chunk : chunks)
+    EXPECT_TRUE(unorganizedReassembler.Add(chunk));
+  EXPECT_TRUE(unorganizedReassembler.Complete());
+  EXPECT_EQ(unorganized.DebugString(), dst.DebugString());
+}
+
+/////////////////////////////////////////////////
+TEST(ChunkUtilsTest, Errors)
+{
+  Image image = TestImage(4, 4);
+  EXPECT_TRUE(SplitIntoChunks(image, 0).empty());
+  image.set_step(0);
+  EXPECT_TRUE(SplitIntoChunks(image, 100).empty());
+
+  // Data without rows or points
+  image = TestImage(4, 4);
+  image.set_height(0);
+  EXPECT_TRUE(SplitIntoChunks(image, 100).empty());
+  PointCloudPacked cloud;
+  InitPointCloudPacked(cloud, "frame", false,
+      {{"xyz", PointCloudPacked::Field::FLOAT32}});
+  cloud.mutable_data()->resize(10 * cloud.point_step());
+  EXPECT_TRUE(SplitIntoChunks(cloud, 100).empty());
+
+  // Not a chunk
+  Image dst;
+  ChunkReassembler<Image> reassembler(dst);
+  EXPECT_FALSE(reassembler.Add(TestImage(4, 4)));
+
+  ChunkInfo info;
+  std::vector<Image> chunks = SplitIntoChunks(TestImage(4, 4), 30);
+  ASSERT_EQ(2u, chunks.size());
+  for (Header::Map &data : *chunks[1].mutable_header()->mutable_data())
+  {
+    if (data.key() == "chunk_offset")
+      data.set_value(0, "3x");
+  }
+  EXPECT_FALSE(ChunkInfoFromHeader(chunks[1].header(), info));
+  EXPECT_FALSE(reassembler.Add(chunks[1]));
+
+  // Out of bounds
+  for (Header::Map &data : *chunks[1].mutable_header()->mutable_data())
+  {
+    if (data.key() == "chunk_offset")
+      data.set_value(0, "3");
+  }
+  EXPECT_TRUE(reassembler.Add(chunks[0]));
+  EXPECT_FALSE(reassembler.Add(chunks[1]));
+  EXPECT_FALSE(reassembler.Complete());
+
+  // Forged sizes are rejected before anything is allocated
+  auto forge = [](Image _chunk, const std::string &_key,
+      const std::string &_value)
+  {
+    for (Header::Map &data : *_chunk.mutable_header()->mutable_data())
+    {
+      if (data.key() == _key)
+        data.set_value(0, _value);
+    }
+    return _chunk;
+  };
+  const Image chunk = SplitIntoChunks(TestImage(4, 4), 30)[0];
+  Image forgedDst;
+  ChunkReassembler<Image> forged(forgedDst);
+  EXPECT_FALSE(forged.Add(forge(chunk, "chunk_count", "4000000000")));
+  EXPECT_FALSE(forged.Add(forge(chunk, "chunk_offset", "3")));
+  EXPECT_FALSE(forged.Add(forge(chunk, "chunk_height", "1")));
+  Image wide = forge(chunk, "chunk_height", "4294967295");
+  wide.set_step(4294967295u);
+  EXPECT_FALSE(forged.Add(wide));
+  EXPECT_TRUE(forgedDst.data().empty());
+  EXPECT_FALSE(forged.Complete());
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/header.pb.h>
+
+#include <initializer_list>
+#include <string>
+
+#include "gz/msgs/HeaderView.hh"
+
+using namespace gz;
+using namespace msgs;
+
+/////////////////////////////////////////////////
+/// \brief Add an entry to a header.
+void AddEntry(Header &_header, const std::string &_key,
+    std::initializer_list<std::string> _values)
+{
+  Header::Map *entry = _header.add_data();
+  entry->set_key(_key);
+  for (const std::string &value : _values)
+    entry->add_value(value);
+}
+
+/////////////////////////////////////////////////
+TEST(HeaderViewTest, Lookup)
+{
+  Header header;
+  AddEntry(header, "sensor", {"lidar"});
+  AddEntry(header, "frame_id", {"base_link", "ignored"});
+  AddEntry(header, "seq", {"42"});
+  AddEntry(header, "frame_id", {"duplicate"});
+  AddEntry(header, "empty", {});
+  AddEntry(header, "frame", {"not frame_id"});
+
+  HeaderView view(header);
+  EXPECT_EQ(&header, &view.Data());
+  EXPECT_EQ("base_link", view.FrameId());
+  EXPECT_EQ("base_link", view.Value("frame_id"));
+  EXPECT_EQ("42", view.Value(HeaderKey::SEQ));
+  EXPECT_EQ("lidar", view.Value("sensor"));
+  EXPECT_EQ("not frame_id", view.Value("frame"));
+  EXPECT_EQ(&header.data(1), view.Find(HeaderKey::FRAME_ID));
+  EXPECT_EQ(&header.data(4), view.Find("empty"));
+
+  EXPECT_EQ("", view.Value("empty"));
+  EXPECT_EQ("fallback", view.Value("empty", "fallback"));
+  EXPECT_EQ("fallback", view.Value(HeaderKey::CHILD_FRAME_ID, "fallback"));
+  EXPECT_EQ(nullptr, view.Find("missing"));
+  EXPECT_EQ(nullptr, view.Find(""));
+  EXPECT_EQ(-1, view.Index().Find(HeaderKey::CHILD_FRAME_ID));
+
+  // An empty header
+  Header empty;
+  HeaderView emptyView(empty);
+  EXPECT_EQ("", emptyView.FrameId());
+  EXPECT_EQ(nullptr, emptyView.Find("sensor"));
+
+  // The index is rebuilt in place
+  HeaderIndex index(header);
+  EXPECT_EQ(5, index.Find(header, "frame"));
+  index.Build(empty);
+  EXPECT_EQ(-1, index.Find(HeaderKey::FRAME_ID));
+  EXPECT_EQ(-1, index.Find(empty, "frame"));
+}
+
+/////////////////////////////////////////////////
+TEST(HeaderViewTest, Set)
+{
+  Header header;
+  SetFrameId(header, "map");
+  ASSERT_EQ(1, header.data_size());
+  EXPECT_EQ("frame_id", header.data(0).key());
+  ASSERT_EQ(1, header.data(0).value_size());
+  EXPECT_EQ("map", header.data(0).value(0));
+
+  // Existing entries are updated in place
+  AddEntry(header, "sensor", {"camera"});
+  const Header::Map *entry = &header.data(0);
+  SetFrameId(header, "odom");
+  ASSERT_EQ(2, header.data_size());
+  EXPECT_EQ(entry, &header.data(0));
+  EXPECT_EQ("odom", HeaderView(header).FrameId());
+
+  // Extra values and later duplicates are removed, other entries keep
+  // their order
+  header.mutable_data(0)->add_value("extra");
+  AddEntry(header, "frame_id", {"duplicate"});
+  AddEntry(header, "seq", {"1"});
+  AddEntry(header, "frame_id", {"duplicate"});
+  Header::Map *set = SetHeaderValue(header, HeaderKey::FRAME_ID, "world");
+  EXPECT_EQ(&header.data(0), set);
+  ASSERT_EQ(3, header.data_size());
+  EXPECT_EQ("frame_id", header.data(0).key());
+  EXPECT_EQ("sensor", header.data(1).key());
+  EXPECT_EQ("seq", header.data(2).key());
+  ASSERT_EQ(1, header.data(0).value_size());
+  EXPECT_EQ("world", header.data(0).value(0));
+
+  SetHeaderValue(header, "sensor", "lidar");
+  SetHeaderValue(header, "new", "value");
+  HeaderView view(header);
+  EXPECT_EQ("lidar", view.Value("sensor"));
+  EXPECT_EQ("value", view.Value("new"));
+  EXPECT_EQ(4, header.data_size());
+}
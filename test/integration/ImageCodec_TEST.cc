@@ -0,0 +1,280 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gz/msgs/ImageCodec.hh"
+
+using namespace gz;
+using namespace msgs;
+
+/////////////////////////////////////////////////
+/// \brief Create an image with smooth content, noise and row padding.
+/// \param[in] _width Image width.
+/// \param[in] _height Image height.
+/// \param[in] _format Pixel format.
+/// \param[in] _padding Bytes of padding at the end of every row.
+Image MakeImage(unsigned int _width, unsigned int _height,
+    PixelFormatType _format, unsigned int _padding)
+{
+  Image image;
+  image.set_width(_width);
+  image.set_height(_height);
+  image.set_pixel_format_type(_format);
+  image.set_step(static_cast<uint32_t>(
+      _width * BytesPerPixel(_format) + _padding));
+  image.mutable_data()->resize(image.step() * _height);
+  image.mutable_header()->mutable_stamp()->set_sec(12);
+
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> noise(0, 3);
+  for (size_t i = 0; i < image.data().size(); ++i)
+  {
+    const size_t x = i % image.step();
+    const size_t y = i / image.step();
+    (*image.mutable_data())[i] =
+        static_cast<char>(x / 3 + y * 2 + noise(gen));
+  }
+  return image;
+}
+
+/////////////////////////////////////////////////
+/// \brief Encode, decode and compare an image losslessly.
+void ExpectLossless(const Image &_image)
+{
+  std::string blob;
+  ASSERT_TRUE(EncodeImage(_image, blob));
+  Image decoded;
+  ASSERT_TRUE(DecodeImage(blob, decoded));
+  EXPECT_EQ(_image.SerializeAsString(), decoded.SerializeAsString())
+      << _image.pixel_format_type();
+}
+
+/////////////////////////////////////////////////
+TEST(ImageCodecTest, Lossless)
+{
+  for (auto format : {L_INT8, L_INT16, RGB_INT8, RGBA_INT8, BGRA_INT8,
+      RGB_INT16, RGB_INT32, BGR_INT8, R_FLOAT16, RGB_FLOAT16, R_FLOAT32,
+      RGB_FLOAT32, BAYER_RGGB8, BAYER_GRBG8})
+  {
+    ExpectLossless(MakeImage(37, 23, format, 0));
+    ExpectLossless(MakeImage(37, 23, format, 5));
+    ExpectLossless(MakeImage(1, 1, format, 0));
+    ExpectLossless(MakeImage(2, 3, format, 1));
+  }
+
+  // Bytes after the last row don't match step * height
+  Image image = MakeImage(8, 4, L_INT16, 4);
+  image.mutable_data()->append("tail");
+  std::string blob;
+  EXPECT_FALSE(EncodeImage(image, blob));
+
+  // The last row doesn't need its padding
+  image = MakeImage(8, 4, L_INT16, 4);
+  image.mutable_data()->resize(image.data().size() - 3);
+  ExpectLossless(image);
+
+  Image empty;
+  empty.set_pixel_format_type(RGB_INT8);
+  ExpectLossless(empty);
+}
+
+/////////////////////////////////////////////////
+TEST(ImageCodecTest, Compression)
+{
+  // A smooth 16 bit depth image compresses well
+  Image depth;
+  depth.set_width(320);
+  depth.set_height(240);
+  depth.set_step(640);
+  depth.set_pixel_format_type(L_INT16);
+  depth.mutable_data()->resize(640 * 240);
+  std::vector<uint16_t> values(320 * 240);
+  for (size_t y = 0; y < 240; ++y)
+  {
+    for (size_t x = 0; x < 320; ++x)
+    {
+      values[y * 320 + x] = static_cast<uint16_t>(
+          1500 + 3 * x + 2 * y + (x > 200 ? 800 : 0));
+    }
+  }
+  std::memcpy(&(*depth.mutable_data())[0], values.data(), 640 * 240);
+
+  std::string blob;
+  ASSERT_TRUE(EncodeImage(depth, blob));
+  EXPECT_LT(blob.size() * 10, depth.data().size());
+  ExpectLossless(depth);
+}
+
+/////////////////////////////////////////////////
+TEST(ImageCodecTest, Depth)
+{
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const float inf = std::numeric_limits<float>::infinity();
+  const std::vector<float> depths{
+      1.0f, 1.0004f, 1.0006f, 2.5f, nan, inf, -inf, -0.25f, 0.0f, 1e12f,
+      3.3333f, 3.3334f};
+
+  Image image;
+  image.set_width(4);
+  image.set_height(3);
+  image.set_step(20);
+  image.set_pixel_format_type(R_FLOAT32);
+  image.mutable_data()->assign(60, '\x55');
+  for (size_t i = 0; i < depths.size(); ++i)
+  {
+    std::memcpy(&(*image.mutable_data())[(i / 4) * 20 + (i % 4) * 4],
+        &depths[i], sizeof(float));
+  }
+
+  std::string blob;
+  ASSERT_TRUE(EncodeImage(image, 0.001, blob));
+  Image decoded;
+  ASSERT_TRUE(DecodeImage(blob, decoded));
+  EXPECT_EQ(image.header().stamp().sec(), decoded.header().stamp().sec());
+  EXPECT_EQ(image.step(), decoded.step());
+  ASSERT_EQ(image.data().size(), decoded.data().size());
+  EXPECT_EQ('\x55', decoded.data()[17]);
+
+  const float expected[] = {1.0f, 1.0f, 1.001f, 2.5f, nan, inf, -inf, -0.25f,
+      0.0f, 2147483.646f, 3.333f, 3.333f};
+  for (size_t i = 0; i < depths.size(); ++i)
+  {
+    float value;
+    std::memcpy(&value,
+        decoded.data().data() + (i / 4) * 20 + (i % 4) * 4, sizeof(value));
+    if (std::isnan(expected[i]))
+      EXPECT_TRUE(std::isnan(value)) << i;
+    else
+      EXPECT_FLOAT_EQ(expected[i], value) << i;
+  }
+
+  // Half floats
+  Image half;
+  ASSERT_TRUE(ConvertImage(image, R_FLOAT16, half));
+  ASSERT_TRUE(EncodeImage(half, 0.01, blob));
+  ASSERT_TRUE(DecodeImage(blob, decoded));
+  EXPECT_EQ(R_FLOAT16, decoded.pixel_format_type());
+  uint16_t bits;
+  std::memcpy(&bits, decoded.data().data() + 6, sizeof(bits));
+  EXPECT_FLOAT_EQ(2.5f, detail::HalfToFloat(bits));
+  std::memcpy(&bits, decoded.data().data() + 8, sizeof(bits));
+  EXPECT_TRUE(std::isnan(detail::HalfToFloat(bits)));
+}
+
+/////////////////////////////////////////////////
+TEST(ImageCodecTest, Errors)
+{
+  std::string blob;
+  Image image = MakeImage(4, 4, L_INT16, 0);
+  EXPECT_FALSE(EncodeImage(image, 0.001, blob));
+  EXPECT_FALSE(EncodeImage(MakeImage(4, 4, R_FLOAT32, 0), 0.0, blob));
+  EXPECT_FALSE(EncodeImage(MakeImage(4, 4, R_FLOAT32, 0), -1.0, blob));
+
+  image.set_pixel_format_type(UNKNOWN_PIXEL_FORMAT);
+  EXPECT_FALSE(EncodeImage(image, blob));
+  image.set_pixel_format_type(L_INT16);
+  image.mutable_data()->resize(10);
+  EXPECT_FALSE(EncodeImage(image, blob));
+
+  image = MakeImage(16, 16, RGB_INT8, 2);
+  ASSERT_TRUE(EncodeImage(image, blob));
+  Image decoded;
+  EXPECT_FALSE(DecodeImage("GZPC", decoded));
+  EXPECT_FALSE(DecodeImage(std::string(blob.data(), 4), decoded));
+  for (size_t size : {size_t(6), size_t(10), blob.size() / 2,
+      blob.size() - 1})
+  {
+    EXPECT_FALSE(DecodeImage(blob.substr(0, size), decoded)) << size;
+  }
+
+  std::string wrongVersion = blob;
+  wrongVersion[4] = 2;
+  EXPECT_FALSE(DecodeImage(wrongVersion, decoded));
+  std::string wrongMode = blob;
+  wrongMode[5] = 2;
+  EXPECT_FALSE(DecodeImage(wrongMode, decoded));
+  EXPECT_TRUE(DecodeImage(blob, decoded));
+}
+
+/////////////////////////////////////////////////
+/// \brief Build an encoded image whose gap stream holds _size zeros,
+/// compressed as if it held _actualSize of them.
+std::string CraftedBlob(const Image &_header, uint64_t _size,
+    size_t _actualSize)
+{
+  const std::string zeros(_actualSize, '\0');
+  std::string stream;
+  detail::EntropyCoder::Encode(
+      reinterpret_cast<const uint8_t *>(zeros.data()), zeros.size(), stream);
+  const char *ptr = stream.data();
+  uint64_t size = 0;
+  detail::ReadVarint(ptr, stream.data() + stream.size(), size);
+
+  std::string blob("GZIM\x01\x00", 6);
+  const std::string metadata = _header.SerializeAsString();
+  detail::WriteVarint(metadata.size(), blob);
+  blob.append(metadata);
+  detail::WriteVarint(_size, blob);
+  detail::WriteVarint(_size, blob);
+  blob.append(stream, ptr - stream.data(), std::string::npos);
+  return blob;
+}
+
+/////////////////////////////////////////////////
+TEST(ImageCodecTest, MalformedInput)
+{
+  Image decoded;
+
+  // Truncated header
+  std::string blob;
+  ASSERT_TRUE(EncodeImage(MakeImage(8, 8, L_INT16, 0), blob));
+  for (size_t size = 0; size < 16; ++size)
+    EXPECT_FALSE(DecodeImage(blob.substr(0, size), decoded));
+
+  // An image without pixels is all gap bytes
+  Image header;
+  header.set_pixel_format_type(L_INT8);
+  ASSERT_TRUE(DecodeImage(CraftedBlob(header, 4096, 4096), decoded));
+  EXPECT_EQ(std::string(4096, '\0'), decoded.data());
+
+  // A data size that the streams can't hold fails without allocating it
+  const uint64_t huge = uint64_t{1} << 50;
+  EXPECT_FALSE(DecodeImage(CraftedBlob(header, huge, 4096), decoded));
+  EXPECT_FALSE(DecodeImage(CraftedBlob(header, huge, 0), decoded));
+
+  // Huge header without pixel data
+  header.set_width(1u << 30);
+  header.set_height(1u << 30);
+  header.set_step(1u << 30);
+  const uint64_t headerSize = uint64_t{1} << 60;
+  EXPECT_FALSE(DecodeImage(CraftedBlob(header, headerSize, 0), decoded));
+
+  // Data size larger than step * height
+  header.set_width(4);
+  header.set_height(2);
+  header.set_step(4);
+  EXPECT_FALSE(DecodeImage(CraftedBlob(header, 9, 0), decoded));
+}
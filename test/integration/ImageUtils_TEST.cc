@@ -0,0 +1,529 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "gz/msgs/ImageUtils.hh"
+
+using namespace gz;
+using namespace msgs;
+
+/////////////////////////////////////////////////
+/// \brief Create an image with two bytes of row padding.
+/// \param[in] _width Image width.
+/// \param[in] _height Image height.
+/// \param[in] _format Pixel format.
+/// \param[in] _pixels Densely packed pixel data.
+Image MakeImage(unsigned int _width, unsigned int _height,
+    PixelFormatType _format, const std::vector<uint8_t> &_pixels)
+{
+  Image image;
+  image.set_width(_width);
+  image.set_height(_height);
+  image.set_pixel_format_type(_format);
+  const size_t rowBytes = _width * BytesPerPixel(_format);
+  image.set_step(static_cast<uint32_t>(rowBytes + 2));
+  image.mutable_data()->assign(image.step() * _height, '\x7f');
+  for (size_t y = 0; y < _height; ++y)
+  {
+    std::memcpy(&(*image.mutable_data())[y * image.step()],
+        _pixels.data() + y * rowBytes, rowBytes);
+  }
+  image.mutable_header()->mutable_stamp()->set_sec(3);
+  return image;
+}
+
+/////////////////////////////////////////////////
+/// \brief Bytes of an image as unsigned values.
+std::vector<uint8_t> Bytes(const Image &_image)
+{
+  return std::vector<uint8_t>(_image.data().begin(), _image.data().end());
+}
+
+/////////////////////////////////////////////////
+/// \brief Values of a densely packed image of type T.
+template<typename T>
+std::vector<T> Values(const Image &_image)
+{
+  std::vector<T> values(_image.data().size() / sizeof(T));
+  std::memcpy(values.data(), _image.data().data(), _image.data().size());
+  return values;
+}
+
+/////////////////////////////////////////////////
+TEST(ImageUtilsTest, BytesPerPixel)
+{
+  EXPECT_EQ(0u, BytesPerPixel(UNKNOWN_PIXEL_FORMAT));
+  EXPECT_EQ(1u, BytesPerPixel(L_INT8));
+  EXPECT_EQ(2u, BytesPerPixel(L_INT16));
+  EXPECT_EQ(3u, BytesPerPixel(RGB_INT8));
+  EXPECT_EQ(4u, BytesPerPixel(RGBA_INT8));
+  EXPECT_EQ(4u, BytesPerPixel(BGRA_INT8));
+  EXPECT_EQ(6u, BytesPerPixel(RGB_INT16));
+  EXPECT_EQ(12u, BytesPerPixel(RGB_INT32));
+  EXPECT_EQ(3u, BytesPerPixel(BGR_INT8));
+  EXPECT_EQ(6u, BytesPerPixel(BGR_INT16));
+  EXPECT_EQ(12u, BytesPerPixel(BGR_INT32));
+  EXPECT_EQ(2u, BytesPerPixel(R_FLOAT16));
+  EXPECT_EQ(6u, BytesPerPixel(RGB_FLOAT16));
+  EXPECT_EQ(4u, BytesPerPixel(R_FLOAT32));
+  EXPECT_EQ(12u, BytesPerPixel(RGB_FLOAT32));
+  EXPECT_EQ(1u, BytesPerPixel(BAYER_RGGB8));
+  EXPECT_EQ(1u, BytesPerPixel(BAYER_BGGR8));
+  EXPECT_EQ(1u, BytesPerPixel(BAYER_GBRG8));
+  EXPECT_EQ(1u, BytesPerPixel(BAYER_GRBG8));
+}
+
+/////////////////////////////////////////////////
+TEST(ImageUtilsTest, Convert8Bit)
+{
+  const Image rgb = MakeImage(2, 2, RGB_INT8,
+      {10, 20, 30, 40, 50, 60, 255, 0, 0, 0, 0, 255});
+
+  Image dst;
+  ASSERT_TRUE(ConvertImage(rgb, BGR_INT8, dst));
+  EXPECT_EQ(2u, dst.width());
+  EXPECT_EQ(2u, dst.height());
+  EXPECT_EQ(6u, dst.step());
+  EXPECT_EQ(BGR_INT8, dst.pixel_format_type());
+  EXPECT_EQ(3, dst.header().stamp().sec());
+  EXPECT_EQ(std::vector<uint8_t>(
+      {30, 20, 10, 60, 50, 40, 0, 0, 255, 255, 0, 0}), Bytes(dst));
+
+  ASSERT_TRUE(ConvertImage(rgb, RGBA_INT8, dst));
+  EXPECT_EQ(8u, dst.step());
+  EXPECT_EQ(std::vector<uint8_t>({10, 20, 30, 255, 40, 50, 60, 255,
+      255, 0, 0, 255, 0, 0, 255, 255}), Bytes(dst));
+
+  ASSERT_TRUE(ConvertImage(rgb, L_INT8, dst));
+  EXPECT_EQ(std::vector<uint8_t>({18, 48, 77, 29}), Bytes(dst));
+
+  const Image bgra = MakeImage(1, 2, BGRA_INT8,
+      {1, 2, 3, 4, 5, 6, 7, 8});
+  ASSERT_TRUE(ConvertImage(bgra, RGBA_INT8, dst));
+  EXPECT_EQ(std::vector<uint8_t>({3, 2, 1, 4, 7, 6, 5, 8}), Bytes(dst));
+  ASSERT_TRUE(ConvertImage(bgra, RGB_INT8, dst));
+  EXPECT_EQ(std::vector<uint8_t>({3, 2, 1, 7, 6, 5}), Bytes(dst));
+
+  const Image mono = MakeImage(3, 1, L_INT8, {0, 128, 255});
+  ASSERT_TRUE(ConvertImage(mono, BGRA_INT8, dst));
+  EXPECT_EQ(std::vector<uint8_t>({0, 0, 0, 255, 128, 128, 128, 255,
+      255, 255, 255, 255}), Bytes(dst));
+
+  // Same format removes the row padding
+  ASSERT_TRUE(ConvertImage(mono, L_INT8, dst));
+  EXPECT_EQ(std::vector<uint8_t>({0, 128, 255}), Bytes(dst));
+}
+
+/////////////////////////////////////////////////
+TEST(ImageUtilsTest, ConvertGeneric)
+{
+  const Image rgb = MakeImage(2, 1, RGB_INT8, {0, 1, 255, 128, 64, 32});
+
+  Image wide;
+  ASSERT_TRUE(ConvertImage(rgb, BGR_INT16, wide));
+  EXPECT_EQ(12u, wide.step());
+  EXPECT_EQ(std::vector<uint16_t>({65535, 257, 0, 8224, 16448, 32896}),
+      Values<uint16_t>(wide));
+
+  Image floats;
+  ASSERT_TRUE(ConvertImage(wide, RGB_FLOAT32, floats));
+  std::vector<float> values = Values<float>(floats);
+  ASSERT_EQ(6u, values.size());
+  EXPECT_FLOAT_EQ(0.0f, values[0]);
+  EXPECT_FLOAT_EQ(1.0f / 255.0f, values[1]);
+  EXPECT_FLOAT_EQ(1.0f, values[2]);
+  EXPECT_FLOAT_EQ(128.0f / 255.0f, values[3]);
+
+  Image halves;
+  ASSERT_TRUE(ConvertImage(floats, RGB_FLOAT16, halves));
+  Image back;
+  ASSERT_TRUE(ConvertImage(halves, RGB_INT8, back));
+  EXPECT_EQ(std::vector<uint8_t>({0, 1, 255, 128, 64, 32}), Bytes(back));
+
+  ASSERT_TRUE(ConvertImage(wide, L_INT8, back));
+  EXPECT_EQ(std::vector<uint8_t>({30, 79}), Bytes(back));
+}
+
+/////////////////////////////////////////////////
+TEST(ImageUtilsTest, HalfFloat)
+{
+  using detail::FloatToHalf;
+  using detail::HalfToFloat;
+  EXPECT_EQ(0x0000u, FloatToHalf(0.0f));
+  EXPECT_EQ(0x8000u, FloatToHalf(-0.0f));
+  EXPECT_EQ(0x3c00u, FloatToHalf(1.0f));
+  EXPECT_EQ(0xc000u, FloatToHalf(-2.0f));
+  EXPECT_EQ(0x7bffu, FloatToHalf(65504.0f));
+  EXPECT_EQ(0x7c00u, FloatToHalf(70000.0f));
+  EXPECT_EQ(0x0001u, FloatToHalf(5.96046448e-8f));
+  EXPECT_EQ(0x0400u, FloatToHalf(6.10351562e-5f));
+  EXPECT_EQ(0x3555u, FloatToHalf(1.0f / 3.0f));
+  EXPECT_EQ(0x7c00u,
+      FloatToHalf(std::numeric_limits<float>::infinity()));
+  EXPECT_TRUE(std::isnan(HalfToFloat(
+      FloatToHalf(std::numeric_limits<float>::quiet_NaN()))));
+
+  for (uint32_t h = 0; h < 0x7c00u; ++h)
+  {
+    const uint16_t half = static_cast<uint16_t>(h);
+    EXPECT_EQ(half, FloatToHalf(HalfToFloat(half)));
+  }
+  EXPECT_FLOAT_EQ(5.96046448e-8f, HalfToFloat(0x0001u));
+  EXPECT_FLOAT_EQ(-1.5f, HalfToFloat(0xbe00u));
+}
+
+/////////////////////////////////////////////////
+TEST(ImageUtilsTest, Depth)
+{
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const std::vector<float> depths{1.2345f, nan, -1.0f, 100.0f};
+  std::vector<uint8_t> bytes(depths.size() * sizeof(float));
+  std::memcpy(bytes.data(), depths.data(), bytes.size());
+  const Image depth = MakeImage(2, 2, R_FLOAT32, bytes);
+
+  Image mm;
+  ASSERT_TRUE(ConvertImage(depth, L_INT16, mm));
+  EXPECT_EQ(std::vector<uint16_t>({1235, 0, 0, 65535}),
+      Values<uint16_t>(mm));
+
+  Image meters;
+  ASSERT_TRUE(ConvertImage(mm, R_FLOAT32, meters));
+  EXPECT_EQ(std::vector<float>({1.235f, 0.0f, 0.0f, 65.535f}),
+      Values<float>(meters));
+
+  // Custom scale, through half floats
+  Image half;
+  ASSERT_TRUE(ConvertImage(depth, R_FLOAT16, half));
+  Image cm;
+  ASSERT_TRUE(ConvertImage(half, L_INT8, cm, 100.0));
+  EXPECT_EQ(std::vector<uint8_t>({123, 0, 0, 255}), Bytes(cm));
+}
+
+/////////////////////////////////////////////////
+TEST(ImageUtilsTest, Bayer)
+{
+  // A uniform color is recovered exactly, borders included
+  std::vector<uint8_t> pixels;
+  for (int i = 0; i < 5 * 4; ++i)
+    pixels.insert(pixels.end(), {10, 20, 30});
+  const Image rgb = MakeImage(5, 4, RGB_INT8, pixels);
+
+  for (auto format : {BAYER_RGGB8, BAYER_BGGR8, BAYER_GBRG8, BAYER_GRBG8})
+  {
+    Image bayer;
+    ASSERT_TRUE(ConvertImage(rgb, format, bayer));
+    EXPECT_EQ(5u, bayer.step());
+    EXPECT_EQ(format, bayer.pixel_format_type());
+
+    Image back;
+    ASSERT_TRUE(ConvertImage(bayer, RGB_INT8, back));
+    EXPECT_EQ(pixels, Bytes(back));
+
+    ASSERT_TRUE(ConvertImage(bayer, BGRA_INT8, back));
+    EXPECT_EQ(30u, static_cast<uint8_t>(back.data()[0]));
+    EXPECT_EQ(255u, static_cast<uint8_t>(back.data()[3]));
+  }
+
+  // Bilinear interpolation of an RGGB mosaic
+  const Image mosaic = MakeImage(4, 2, BAYER_RGGB8,
+      {100, 10, 120, 30,
+       40, 200, 60, 220});
+  Image out;
+  ASSERT_TRUE(ConvertImage(mosaic, RGB_INT8, out));
+  const std::vector<uint8_t> expected{
+      // R at (0, 0): green from 10, 10, 40, 40, blue from 200
+      100, 25, 200,
+      // G at (1, 0) on a red row: red from 100, 120, blue from 200
+      110, 10, 200,
+      // R at (2, 0): green from 10, 30, 60, 60
+      120, 40, 210,
+      // G at (3, 0) mirrors red from 120
+      120, 30, 220,
+      // G at (0, 1) on a blue row
+      100, 40, 200,
+      // B at (1, 1): green from 40, 60, 10, 10
+      110, 30, 200,
+      // G at (2, 1)
+      120, 60, 210,
+      // B at (3, 1)
+      120, 45, 220};
+  EXPECT_EQ(expected, Bytes(out));
+}
+
+/////////////////////////////////////////////////
+TEST(ImageUtilsTest, Errors)
+{
+  Image image = MakeImage(2, 2, RGB_INT8, std::vector<uint8_t>(12));
+  Image dst;
+  EXPECT_FALSE(ConvertImage(image, UNKNOWN_PIXEL_FORMAT, dst));
+  EXPECT_FALSE(ConvertImage(image, image.pixel_format_type(), image));
+
+  image.set_step(4);
+  EXPECT_FALSE(ConvertImage(image, L_INT8, dst));
+
+  image.set_step(8);
+  image.mutable_data()->resize(13);
+  EXPECT_FALSE(ConvertImage(image, L_INT8, dst));
+
+  // The last row doesn't need padding
+  image.mutable_data()->resize(14);
+  EXPECT_TRUE(ConvertImage(image, L_INT8, dst));
+
+  image.set_pixel_format_type(UNKNOWN_PIXEL_FORMAT);
+  EXPECT_FALSE(ConvertImage(image, L_INT8, dst));
+
+  Image empty;
+  empty.set_pixel_format_type(RGB_INT8);
+  EXPECT_TRUE(ConvertImage(empty, L_INT8, dst));
+  EXPECT_TRUE(dst.data().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(ImageUtilsTest, Crop)
+{
+  const Image rgb = MakeImage(3, 3, RGB_INT8,
+      {0, 1, 2, 3, 4, 5, 6, 7, 8,
+       9, 10, 11, 12, 13, 14, 15, 16, 17,
+       18, 19, 20, 21, 22, 23, 24, 25, 26});
+
+  Image roi;
+  roi.mutable_data()->assign(100, 'x');
+  ASSERT_TRUE(CropImage(rgb, 1, 1, 2, 2, roi));
+  EXPECT_EQ(2u, roi.width());
+  EXPECT_EQ(2u, roi.height());
+  EXPECT_EQ(6u, roi.step());
+  EXPECT_EQ(RGB_INT8, roi.pixel_format_type());
+  EXPECT_EQ(3, roi.header().stamp().sec());
+  EXPECT_EQ(std::vector<uint8_t>({12, 13, 14, 15, 16, 17,
+      21, 22, 23, 24, 25, 26}), Bytes(roi));
+
+  ASSERT_TRUE(CropImage(rgb, 0, 2, 3, 1, roi));
+  EXPECT_EQ(std::vector<uint8_t>({18, 19, 20, 21, 22, 23, 24, 25, 26}),
+      Bytes(roi));
+
+  ASSERT_TRUE(CropImage(rgb, 3, 3, 0, 0, roi));
+  EXPECT_TRUE(roi.data().empty());
+
+  EXPECT_FALSE(CropImage(rgb, 2, 0, 2, 1, roi));
+  EXPECT_FALSE(CropImage(rgb, 0, 1, 1, 3, roi));
+  EXPECT_FALSE(CropImage(rgb, 0, 0, 1, 1, const_cast<Image &>(rgb)));
+
+  // Odd offsets move the Bayer pattern
+  const Image bayer = MakeImage(4, 4, BAYER_RGGB8,
+      std::vector<uint8_t>(16, 1));
+  ASSERT_TRUE(CropImage(bayer, 1, 0, 2, 2, roi));
+  EXPECT_EQ(BAYER_GRBG8, roi.pixel_format_type());
+  ASSERT_TRUE(CropImage(bayer, 0, 1, 2, 2, roi));
+  EXPECT_EQ(BAYER_GBRG8, roi.pixel_format_type());
+  ASSERT_TRUE(CropImage(bayer, 1, 3, 2, 1, roi));
+  EXPECT_EQ(BAYER_BGGR8, roi.pixel_format_type());
+  ASSERT_TRUE(CropImage(bayer, 2, 2, 2, 2, roi));
+  EXPECT_EQ(BAYER_RGGB8, roi.pixel_format_type());
+}
+
+/////////////////////////////////////////////////
+TEST(ImageUtilsTest, Downscale)
+{
+  // Odd trailing column and row are ignored
+  const Image rgb = MakeImage(5, 3, RGB_INT8,
+      {0, 10, 100, 1, 20, 100, 10, 0, 0, 20, 0, 0, 99, 99, 99,
+       2, 30, 101, 2, 40, 102, 30, 0, 0, 40, 1, 0, 99, 99, 99,
+       99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99});
+
+  Image small;
+  ASSERT_TRUE(DownscaleImage(rgb, 2, small));
+  EXPECT_EQ(2u, small.width());
+  EXPECT_EQ(1u, small.height());
+  EXPECT_EQ(6u, small.step());
+  EXPECT_EQ(3, small.header().stamp().sec());
+  EXPECT_EQ(std::vector<uint8_t>({1, 25, 101, 25, 0, 0}), Bytes(small));
+
+  // Sixteen bit, 4x
+  std::vector<uint16_t> depth(8 * 4);
+  for (size_t i = 0; i < depth.size(); ++i)
+    depth[i] = static_cast<uint16_t>(i < 4 || (i >= 8 && i < 12) ? 1000 : 0);
+  std::vector<uint8_t> bytes(depth.size() * sizeof(uint16_t));
+  std::memcpy(bytes.data(), depth.data(), bytes.size());
+  ASSERT_TRUE(DownscaleImage(MakeImage(8, 4, L_INT16, bytes), 4, small));
+  EXPECT_EQ(std::vector<uint16_t>({500, 0}), Values<uint16_t>(small));
+
+  // Floats, through the generic path for factor 3
+  std::vector<float> floats(6 * 3);
+  for (size_t i = 0; i < floats.size(); ++i)
+    floats[i] = static_cast<float>(i);
+  bytes.resize(floats.size() * sizeof(float));
+  std::memcpy(bytes.data(), floats.data(), bytes.size());
+  ASSERT_TRUE(DownscaleImage(MakeImage(6, 3, R_FLOAT32, bytes), 3, small));
+  EXPECT_EQ(std::vector<float>({7.0f, 10.0f}), Values<float>(small));
+  ASSERT_TRUE(DownscaleImage(MakeImage(6, 3, R_FLOAT32, bytes), 2, small));
+  EXPECT_EQ(std::vector<float>({3.5f, 5.5f, 7.5f}), Values<float>(small));
+
+  // Factor 1 copies
+  ASSERT_TRUE(DownscaleImage(rgb, 1, small));
+  EXPECT_EQ(15u, small.step());
+  EXPECT_EQ(45u, small.data().size());
+
+  EXPECT_FALSE(DownscaleImage(rgb, 0, small));
+  ASSERT_TRUE(DownscaleImage(rgb, 8, small));
+  EXPECT_TRUE(small.data().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(ImageUtilsTest, DownscaleKernels)
+{
+  // The kernels match the generic path
+  std::vector<uint8_t> pixels(64 * 32 * 4);
+  for (size_t i = 0; i < pixels.size(); ++i)
+    pixels[i] = static_cast<uint8_t>((i * 37) % 256);
+
+  for (auto format : {L_INT8, RGB_INT8, BGRA_INT8, L_INT16, RGB_INT16,
+      R_FLOAT32})
+  {
+    const size_t pixelBytes = BytesPerPixel(format);
+    const unsigned int width = static_cast<unsigned int>(
+        64 * 4 / pixelBytes);
+    std::vector<uint8_t> data = pixels;
+    if (format == R_FLOAT32)
+    {
+      for (size_t i = 0; i + 4 <= data.size(); i += 4)
+      {
+        const float value = static_cast<float>(i % 1000) * 0.25f;
+        std::memcpy(&data[i], &value, sizeof(value));
+      }
+    }
+    const Image image = MakeImage(width, 32, format, data);
+
+    for (unsigned int factor : {2u, 4u})
+    {
+      Image fast;
+      ASSERT_TRUE(DownscaleImage(image, factor, fast));
+      Image generic;
+      detail::InitImage(image, format, width / factor, 32 / factor, generic);
+      detail::ResampleImage(image, width / factor * factor, 32, generic);
+      ASSERT_EQ(generic.data().size(), fast.data().size());
+
+      // Exact halves may round differently
+      std::vector<double> a;
+      std::vector<double> b;
+      if (format == R_FLOAT32)
+      {
+        for (float v : Values<float>(fast))
+          a.push_back(v);
+        for (float v : Values<float>(generic))
+          b.push_back(v);
+      }
+      else if (detail::FormatInfo(format).type ==
+          detail::ChannelType::UINT16)
+      {
+        for (uint16_t v : Values<uint16_t>(fast))
+          a.push_back(v);
+        for (uint16_t v : Values<uint16_t>(generic))
+          b.push_back(v);
+      }
+      else
+      {
+        for (uint8_t v : Bytes(fast))
+          a.push_back(v);
+        for (uint8_t v : Bytes(generic))
+          b.push_back(v);
+      }
+      for (size_t i = 0; i < a.size(); ++i)
+        ASSERT_NEAR(b[i], a[i], 1.0) << format << " " << factor << " " << i;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(ImageUtilsTest, Resize)
+{
+  const Image mono = MakeImage(3, 1, L_INT8, {30, 60, 90});
+
+  // Area averaging, with a third of the middle pixel in each
+  Image resized;
+  ASSERT_TRUE(ResizeImage(mono, 2, 1, resized));
+  EXPECT_EQ(2u, resized.step());
+  EXPECT_EQ(std::vector<uint8_t>({40, 80}), Bytes(resized));
+
+  // Linear interpolation between pixel centers
+  ASSERT_TRUE(ResizeImage(mono, 6, 2, resized));
+  EXPECT_EQ(std::vector<uint8_t>({30, 38, 53, 68, 83, 90,
+      30, 38, 53, 68, 83, 90}), Bytes(resized));
+
+  ASSERT_TRUE(ResizeImage(mono, 1, 1, resized));
+  EXPECT_EQ(std::vector<uint8_t>({60}), Bytes(resized));
+
+  // Half floats and sixteen bit integers
+  const Image rgb = MakeImage(2, 2, RGB_INT8,
+      {0, 0, 0, 255, 255, 255, 255, 255, 255, 0, 0, 0});
+  Image half;
+  ASSERT_TRUE(ConvertImage(rgb, RGB_FLOAT16, half));
+  ASSERT_TRUE(ResizeImage(half, 1, 1, resized));
+  const auto halves = Values<uint16_t>(resized);
+  ASSERT_EQ(3u, halves.size());
+  EXPECT_FLOAT_EQ(0.5f, detail::HalfToFloat(halves[0]));
+
+  Image wide;
+  ASSERT_TRUE(ConvertImage(rgb, BGR_INT16, wide));
+  ASSERT_TRUE(ResizeImage(wide, 3, 3, resized));
+  const auto values = Values<uint16_t>(resized);
+  ASSERT_EQ(27u, values.size());
+  EXPECT_EQ(0u, values[0]);
+  EXPECT_EQ(32768u, values[3 * 4]);
+  EXPECT_EQ(65535u, values[3 * 2]);
+
+  // Thirty two bit integers keep every bit
+  const uint32_t large[9] = {4000000001u, 7u, 16777217u,
+                             4000000004u, 8u, 16777219u,
+                             4000000007u, 9u, 16777221u};
+  std::vector<uint8_t> largeBytes(sizeof(large));
+  std::memcpy(largeBytes.data(), large, sizeof(large));
+  ASSERT_TRUE(ResizeImage(MakeImage(3, 1, RGB_INT32, largeBytes), 1, 1,
+      resized));
+  EXPECT_EQ(std::vector<uint32_t>({4000000004u, 8u, 16777219u}),
+      Values<uint32_t>(resized));
+
+  // Factor 2 uses the downscaling kernel
+  ASSERT_TRUE(ResizeImage(rgb, 1, 1, resized));
+  EXPECT_EQ(std::vector<uint8_t>({128, 128, 128}), Bytes(resized));
+
+  // Bayer images keep their pattern
+  std::vector<uint8_t> pixels;
+  for (int i = 0; i < 6 * 6; ++i)
+    pixels.insert(pixels.end(), {10, 20, 30});
+  Image bayer;
+  ASSERT_TRUE(ConvertImage(MakeImage(6, 6, RGB_INT8, pixels), BAYER_GBRG8,
+      bayer));
+  ASSERT_TRUE(ResizeImage(bayer, 4, 4, resized));
+  EXPECT_EQ(BAYER_GBRG8, resized.pixel_format_type());
+  EXPECT_EQ(std::vector<uint8_t>({20, 30, 20, 30, 10, 20, 10, 20,
+      20, 30, 20, 30, 10, 20, 10, 20}), Bytes(resized));
+  ASSERT_TRUE(DownscaleImage(bayer, 2, resized));
+  EXPECT_EQ(9u, resized.data().size());
+
+  Image empty;
+  empty.set_pixel_format_type(L_INT8);
+  EXPECT_FALSE(ResizeImage(empty, 2, 2, resized));
+  EXPECT_FALSE(ResizeImage(mono, 2, 2, const_cast<Image &>(mono)));
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "gz/msgs/ImageView.hh"
+
+using namespace gz;
+using namespace msgs;
+
+/////////////////////////////////////////////////
+TEST(ImageViewTest, Rgb)
+{
+  Image image;
+  image.set_width(3);
+  image.set_height(2);
+  image.set_step(12);
+  image.set_pixel_format_type(RGB_INT8);
+  image.mutable_data()->assign(24, '\0');
+
+  ImageView<RgbPixel<uint8_t>> view(image);
+  ASSERT_TRUE(view.Valid());
+  EXPECT_EQ(2u, view.Height());
+  EXPECT_EQ(3u, view.Width());
+  EXPECT_EQ(12u, view.Step());
+  EXPECT_FALSE(view.Contiguous());
+
+  for (size_t row = 0; row < view.Height(); ++row)
+  {
+    uint8_t value = static_cast<uint8_t>(row * 10);
+    for (auto &pixel : view.RowSpan(row))
+    {
+      pixel.r = value++;
+      pixel.g = 100;
+      pixel.b = 200;
+    }
+  }
+
+  EXPECT_EQ(11u, static_cast<uint8_t>(image.data()[12 + 3]));
+  EXPECT_EQ(100u, static_cast<uint8_t>(image.data()[12 + 4]));
+  EXPECT_EQ(200u, static_cast<uint8_t>(image.data()[12 + 5]));
+  EXPECT_EQ('\0', image.data()[9]);
+
+  const ConstImageView<RgbPixel<uint8_t>> constView(image);
+  ASSERT_TRUE(constView.Valid());
+  EXPECT_EQ(12u, constView(1, 2).r);
+  EXPECT_EQ(2u, constView.Row(0)[2].r);
+  EXPECT_EQ(3u, constView.RowSpan(1).Size());
+  EXPECT_EQ(constView.Row(1), constView.RowSpan(1).Data());
+  static_assert(std::is_const_v<
+      std::remove_reference_t<decltype(constView(0, 0))>>);
+
+  // Channel order is part of the pixel type
+  ConstImageView<BgrPixel<uint8_t>> bgr(image);
+  EXPECT_FALSE(bgr.Valid());
+  ConstImageView<uint8_t> mono(image);
+  EXPECT_FALSE(mono.Valid());
+}
+
+/////////////////////////////////////////////////
+TEST(ImageViewTest, Depth)
+{
+  Image image;
+  image.set_width(4);
+  image.set_height(3);
+  image.set_step(16);
+  image.set_pixel_format_type(R_FLOAT32);
+  image.mutable_data()->assign(48, '\0');
+
+  ImageView<float> view(image);
+  ASSERT_TRUE(view.Valid());
+  EXPECT_TRUE(view.Contiguous());
+  for (size_t i = 0; i < 12; ++i)
+    view.Row(0)[i] = i * 0.5f;
+  EXPECT_FLOAT_EQ(3.5f, view(1, 3));
+
+  float value;
+  std::memcpy(&value, image.data().data() + 20, sizeof(value));
+  EXPECT_FLOAT_EQ(2.5f, value);
+
+  // Half floats
+  image.set_pixel_format_type(R_FLOAT16);
+  image.set_step(8);
+  ImageView<HalfFloat> half(image);
+  ASSERT_TRUE(half.Valid());
+  half(2, 1) = HalfFloat::FromFloat(-1.5f);
+  EXPECT_FLOAT_EQ(-1.5f, half(2, 1).ToFloat());
+  EXPECT_EQ(0xbe00u, half(2, 1).bits);
+
+  // Sixteen bit depth
+  image.set_pixel_format_type(L_INT16);
+  ConstImageView<uint16_t> depth(image);
+  EXPECT_TRUE(depth.Valid());
+  ConstImageView<float> wrongType(image);
+  EXPECT_FALSE(wrongType.Valid());
+}
+
+/////////////////////////////////////////////////
+TEST(ImageViewTest, Invalid)
+{
+  Image image;
+  image.set_width(4);
+  image.set_height(2);
+  image.set_step(16);
+  image.set_pixel_format_type(RGBA_INT8);
+  image.mutable_data()->assign(32, '\0');
+  EXPECT_TRUE(ConstImageView<RgbaPixel<uint8_t>>(image).Valid());
+  EXPECT_FALSE(ConstImageView<BgraPixel<uint8_t>>(image).Valid());
+
+  // Last row doesn't fit
+  image.mutable_data()->resize(31);
+  EXPECT_FALSE(ConstImageView<RgbaPixel<uint8_t>>(image).Valid());
+
+  // Step smaller than a row
+  image.set_step(15);
+  image.mutable_data()->resize(64);
+  EXPECT_FALSE(ConstImageView<RgbaPixel<uint8_t>>(image).Valid());
+
+  // Misaligned step
+  image.set_pixel_format_type(R_FLOAT32);
+  image.set_step(18);
+  EXPECT_FALSE(ConstImageView<float>(image).Valid());
+
+  // Empty image
+  image.set_height(0);
+  ConstImageView<float> empty(image);
+  EXPECT_FALSE(empty.Valid());
+  EXPECT_EQ(0u, empty.Height());
+  EXPECT_EQ(0u, empty.Width());
+
+  // Bayer mosaics are viewed as bytes
+  image.set_height(2);
+  image.set_step(4);
+  image.set_pixel_format_type(BAYER_GRBG8);
+  EXPECT_TRUE(ConstImageView<uint8_t>(image).Valid());
+}
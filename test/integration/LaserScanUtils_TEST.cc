@@ -0,0 +1,326 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/laserscan.pb.h>
+#include <gz/msgs/pointcloud_packed.pb.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include <gz/math/Pose3.hh>
+
+#include "gz/msgs/LaserScanUtils.hh"
+#include "gz/msgs/convert/Pose.hh"
+
+using namespace gz;
+using namespace msgs;
+
+/////////////////////////////////////////////////
+/// \brief Create a scan with the given beam counts and a range of
+/// 1 + index / 100 for every beam.
+LaserScan MakeScan(uint32_t _count, uint32_t _verticalCount)
+{
+  LaserScan scan;
+  scan.mutable_header()->mutable_stamp()->set_sec(4);
+  scan.set_angle_min(-1.0);
+  scan.set_angle_max(1.0);
+  scan.set_angle_step(_count > 1 ? 2.0 / (_count - 1) : 0.0);
+  scan.set_count(_count);
+  scan.set_vertical_angle_min(-0.3);
+  scan.set_vertical_angle_max(0.3);
+  scan.set_vertical_angle_step(
+      _verticalCount > 1 ? 0.6 / (_verticalCount - 1) : 0.0);
+  scan.set_vertical_count(_verticalCount);
+  scan.set_range_min(0.5);
+  scan.set_range_max(10.0);
+  for (uint32_t i = 0; i < _count * std::max(1u, _verticalCount); ++i)
+  {
+    scan.add_ranges(1.0 + i / 100.0);
+    scan.add_intensities(i);
+  }
+  return scan;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a float field of a point.
+float Get(const PointCloudPacked &_cloud, size_t _point, size_t _field)
+{
+  float v;
+  std::memcpy(&v, _cloud.data().data() + _point * _cloud.point_step() +
+      _field * sizeof(float), sizeof(v));
+  return v;
+}
+
+/////////////////////////////////////////////////
+/// \brief Expected point of a beam.
+math::Vector3d Expected(const LaserScan &_scan, uint32_t _h, uint32_t _v)
+{
+  const double a = _scan.angle_min() + _h * _scan.angle_step();
+  const double b =
+      _scan.vertical_angle_min() + _v * _scan.vertical_angle_step();
+  const double r = _scan.ranges(_v * _scan.count() + _h);
+  return math::Vector3d(r * std::cos(b) * std::cos(a),
+      r * std::cos(b) * std::sin(a), r * std::sin(b));
+}
+
+/////////////////////////////////////////////////
+TEST(LaserScanUtilsTest, Planar)
+{
+  LaserScan scan = MakeScan(11, 0);
+  scan.set_ranges(2, std::numeric_limits<double>::quiet_NaN());
+  scan.set_ranges(3, std::numeric_limits<double>::infinity());
+  scan.set_ranges(4, 0.2);
+  scan.set_ranges(5, 10.5);
+
+  LaserScanProjector projector;
+  PointCloudPacked cloud;
+  ASSERT_TRUE(projector.Project(scan, cloud));
+  EXPECT_EQ(4, cloud.header().stamp().sec());
+  EXPECT_EQ(1u, cloud.height());
+  EXPECT_EQ(7u, cloud.width());
+  EXPECT_TRUE(cloud.is_dense());
+  ASSERT_EQ(4, cloud.field_size());
+  EXPECT_EQ("intensity", cloud.field(3).name());
+  EXPECT_EQ(16u, cloud.point_step());
+  EXPECT_EQ(7u * 16u, cloud.row_step());
+  ASSERT_EQ(7u * 16u, cloud.data().size());
+
+  const uint32_t kept[] = {0, 1, 6, 7, 8, 9, 10};
+  for (size_t i = 0; i < 7; ++i)
+  {
+    const math::Vector3d p = Expected(scan, kept[i], 0);
+    EXPECT_NEAR(p.X(), Get(cloud, i, 0), 1e-5) << i;
+    EXPECT_NEAR(p.Y(), Get(cloud, i, 1), 1e-5) << i;
+    EXPECT_NEAR(p.Z(), Get(cloud, i, 2), 1e-5) << i;
+    EXPECT_FLOAT_EQ(static_cast<float>(kept[i]), Get(cloud, i, 3)) << i;
+  }
+
+  // Without intensities
+  LaserScanProjectOptions options;
+  options.intensities = false;
+  ASSERT_TRUE(projector.Project(scan, cloud, options));
+  EXPECT_EQ(3, cloud.field_size());
+  EXPECT_EQ(12u, cloud.point_step());
+  EXPECT_EQ(7u * 12u, cloud.data().size());
+
+  scan.clear_intensities();
+  ASSERT_TRUE(projector.Project(scan, cloud));
+  EXPECT_EQ(3, cloud.field_size());
+
+  scan.add_ranges(1.0);
+  EXPECT_FALSE(projector.Project(scan, cloud));
+}
+
+/////////////////////////////////////////////////
+TEST(LaserScanUtilsTest, Organized)
+{
+  LaserScan scan = MakeScan(20, 5);
+  scan.set_ranges(23, std::numeric_limits<double>::quiet_NaN());
+
+  LaserScanProjector projector;
+  PointCloudPacked cloud;
+  LaserScanProjectOptions options;
+  options.organized = true;
+  ASSERT_TRUE(projector.Project(scan, cloud, options));
+  EXPECT_EQ(5u, cloud.height());
+  EXPECT_EQ(20u, cloud.width());
+  EXPECT_FALSE(cloud.is_dense());
+  EXPECT_EQ(20u * 16u, cloud.row_step());
+  ASSERT_EQ(100u * 16u, cloud.data().size());
+
+  for (uint32_t v = 0; v < 5; ++v)
+  {
+    for (uint32_t h = 0; h < 20; ++h)
+    {
+      const size_t i = v * 20 + h;
+      if (i == 23)
+      {
+        EXPECT_TRUE(std::isnan(Get(cloud, i, 0)));
+        EXPECT_TRUE(std::isnan(Get(cloud, i, 2)));
+        continue;
+      }
+      const math::Vector3d p = Expected(scan, h, v);
+      EXPECT_NEAR(p.X(), Get(cloud, i, 0), 1e-5) << i;
+      EXPECT_NEAR(p.Y(), Get(cloud, i, 1), 1e-5) << i;
+      EXPECT_NEAR(p.Z(), Get(cloud, i, 2), 1e-5) << i;
+    }
+  }
+
+  scan.set_ranges(23, 1.0);
+  ASSERT_TRUE(projector.Project(scan, cloud, options));
+  EXPECT_TRUE(cloud.is_dense());
+}
+
+/////////////////////////////////////////////////
+TEST(LaserScanUtilsTest, WorldPose)
+{
+  LaserScan scan = MakeScan(8, 3);
+  const math::Pose3d pose(1, -2, 3, 0.1, 0.2, 0.3);
+  *scan.mutable_world_pose() = Convert(pose);
+
+  LaserScanProjector projector;
+  PointCloudPacked cloud;
+  LaserScanProjectOptions options;
+  options.applyWorldPose = true;
+  ASSERT_TRUE(projector.Project(scan, cloud, options));
+  ASSERT_EQ(24u, cloud.width());
+  for (uint32_t v = 0; v < 3; ++v)
+  {
+    for (uint32_t h = 0; h < 8; ++h)
+    {
+      const size_t i = v * 8 + h;
+      const math::Vector3d p = pose.Rot() * Expected(scan, h, v) + pose.Pos();
+      EXPECT_NEAR(p.X(), Get(cloud, i, 0), 1e-5) << i;
+      EXPECT_NEAR(p.Y(), Get(cloud, i, 1), 1e-5) << i;
+      EXPECT_NEAR(p.Z(), Get(cloud, i, 2), 1e-5) << i;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(LaserScanUtilsTest, DirectionCache)
+{
+  LaserScanProjector projector;
+  EXPECT_TRUE(projector.Directions().empty());
+
+  LaserScan scan = MakeScan(16, 4);
+  PointCloudPacked cloud;
+  ASSERT_TRUE(projector.Project(scan, cloud));
+  ASSERT_EQ(3u * 64u, projector.Directions().size());
+  const float *directions = projector.Directions().data();
+  const float first = projector.Directions()[0];
+
+  // The same geometry reuses the directions
+  scan.set_ranges(0, 5.0);
+  ASSERT_TRUE(projector.Project(scan, cloud));
+  EXPECT_EQ(directions, projector.Directions().data());
+  EXPECT_FLOAT_EQ(first, projector.Directions()[0]);
+
+  // A different geometry recomputes them
+  scan.set_angle_min(0.0);
+  ASSERT_TRUE(projector.Project(scan, cloud));
+  EXPECT_FLOAT_EQ(1.0f * std::cos(-0.3f), projector.Directions()[0]);
+  EXPECT_NEAR(5.0 * std::cos(-0.3), Get(cloud, 0, 0), 1e-5);
+
+  // Empty scans
+  scan = LaserScan();
+  ASSERT_TRUE(projector.Project(scan, cloud));
+  EXPECT_EQ(0u, cloud.width());
+  EXPECT_TRUE(cloud.data().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(LaserScanUtilsTest, PackFloat32)
+{
+  LaserScan scan = MakeScan(30, 2);
+  scan.set_ranges(1, std::numeric_limits<double>::infinity());
+  scan.set_ranges(2, std::numeric_limits<double>::quiet_NaN());
+  const LaserScan original = scan;
+
+  ASSERT_TRUE(PackLaserScan(scan, LaserScan::Packed::FLOAT32));
+  EXPECT_EQ(0, scan.ranges_size());
+  EXPECT_EQ(0, scan.intensities_size());
+  EXPECT_EQ(LaserScan::Packed::FLOAT32, scan.packed_ranges().encoding());
+  EXPECT_EQ(60u * 4u, scan.packed_ranges().data().size());
+  EXPECT_EQ(60u * 4u, scan.packed_intensities().data().size());
+  EXPECT_LT(scan.ByteSizeLong(), original.ByteSizeLong() * 6 / 10);
+
+  // Packing twice is a no-op
+  ASSERT_TRUE(PackLaserScan(scan, LaserScan::Packed::UINT16));
+  EXPECT_EQ(LaserScan::Packed::FLOAT32, scan.packed_ranges().encoding());
+
+  ASSERT_TRUE(UnpackLaserScan(scan));
+  EXPECT_FALSE(scan.has_packed_ranges());
+  EXPECT_FALSE(scan.has_packed_intensities());
+  ASSERT_EQ(60, scan.ranges_size());
+  ASSERT_EQ(60, scan.intensities_size());
+  EXPECT_TRUE(std::isinf(scan.ranges(1)));
+  EXPECT_TRUE(std::isnan(scan.ranges(2)));
+  for (int i = 3; i < 60; ++i)
+  {
+    EXPECT_FLOAT_EQ(static_cast<float>(original.ranges(i)),
+        static_cast<float>(scan.ranges(i)));
+    EXPECT_DOUBLE_EQ(original.intensities(i), scan.intensities(i));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(LaserScanUtilsTest, PackUint16)
+{
+  LaserScan scan = MakeScan(30, 2);
+  scan.set_ranges(0, 0.0);
+  scan.set_ranges(1, std::numeric_limits<double>::infinity());
+  scan.set_ranges(2, -std::numeric_limits<double>::infinity());
+  scan.set_ranges(3, std::numeric_limits<double>::quiet_NaN());
+  scan.set_ranges(4, 65.532);
+  const LaserScan original = scan;
+
+  ASSERT_TRUE(PackLaserScan(scan, LaserScan::Packed::UINT16, 0.001, 1.0));
+  EXPECT_EQ(LaserScan::Packed::UINT16, scan.packed_ranges().encoding());
+  EXPECT_DOUBLE_EQ(0.001, scan.packed_ranges().resolution());
+  EXPECT_EQ(60u * 2u, scan.packed_ranges().data().size());
+  EXPECT_LT(scan.ByteSizeLong(), original.ByteSizeLong() * 4 / 10);
+
+  LaserScan unpacked = scan;
+  ASSERT_TRUE(UnpackLaserScan(unpacked));
+  ASSERT_EQ(60, unpacked.ranges_size());
+  EXPECT_DOUBLE_EQ(0.0, unpacked.ranges(0));
+  EXPECT_TRUE(std::isinf(unpacked.ranges(1)) && unpacked.ranges(1) > 0);
+  EXPECT_TRUE(std::isinf(unpacked.ranges(2)) && unpacked.ranges(2) < 0);
+  EXPECT_TRUE(std::isnan(unpacked.ranges(3)));
+  EXPECT_NEAR(65.532, unpacked.ranges(4), 1e-9);
+  for (int i = 5; i < 60; ++i)
+  {
+    EXPECT_NEAR(original.ranges(i), unpacked.ranges(i), 0.0005);
+    EXPECT_DOUBLE_EQ(original.intensities(i), unpacked.intensities(i));
+  }
+
+  // The projector reads packed scans
+  LaserScanProjector projector;
+  PointCloudPacked packedCloud;
+  PointCloudPacked cloud;
+  ASSERT_TRUE(projector.Project(scan, packedCloud));
+  ASSERT_TRUE(projector.Project(unpacked, cloud));
+  EXPECT_EQ(4, packedCloud.field_size());
+  EXPECT_EQ(cloud.data(), packedCloud.data());
+
+  // Values that don't fit leave the scan unchanged
+  LaserScan bad = original;
+  bad.set_ranges(7, 65.533);
+  EXPECT_FALSE(PackLaserScan(bad, LaserScan::Packed::UINT16, 0.001));
+  EXPECT_EQ(60, bad.ranges_size());
+  EXPECT_FALSE(bad.has_packed_ranges());
+  bad.set_ranges(7, -0.01);
+  EXPECT_FALSE(PackLaserScan(bad, LaserScan::Packed::UINT16, 0.001));
+  bad.set_ranges(7, 1.0);
+  EXPECT_FALSE(PackLaserScan(bad, LaserScan::Packed::UINT16, 0.0));
+  EXPECT_FALSE(PackLaserScan(bad, LaserScan::Packed::UINT16, 0.001, -1.0));
+  EXPECT_EQ(60, bad.intensities_size());
+
+  // Malformed packed values
+  bad = scan;
+  bad.mutable_packed_ranges()->mutable_data()->pop_back();
+  EXPECT_FALSE(UnpackLaserScan(bad));
+  EXPECT_FALSE(projector.Project(bad, cloud));
+  bad = scan;
+  bad.mutable_packed_ranges()->set_resolution(0.0);
+  EXPECT_FALSE(UnpackLaserScan(bad));
+  EXPECT_TRUE(bad.has_packed_intensities());
+}
@@ -0,0 +1,327 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/occupancy_grid.pb.h>
+#include <gz/msgs/occupancy_grid_delta.pb.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "gz/msgs/OccupancyGridTiles.hh"
+
+using namespace gz;
+using namespace msgs;
+
+/////////////////////////////////////////////////
+/// \brief Check that a map holds the same cells as a tiled map.
+void ExpectSameCells(const TiledOccupancyGrid &_expected,
+    const OccupancyGrid &_map)
+{
+  ASSERT_EQ(_expected.Width(), _map.info().width());
+  ASSERT_EQ(_expected.Height(), _map.info().height());
+  EXPECT_EQ(_expected.Map().data(), _map.data());
+}
+
+/////////////////////////////////////////////////
+TEST(OccupancyGridTilesTest, Tiles)
+{
+  TiledOccupancyGrid grid(100, 70, 32);
+  EXPECT_EQ(100u, grid.Width());
+  EXPECT_EQ(70u, grid.Height());
+  EXPECT_EQ(32u, grid.TileSize());
+  EXPECT_EQ(4u, grid.TilesX());
+  EXPECT_EQ(3u, grid.TilesY());
+  EXPECT_EQ(7000u, grid.Map().data().size());
+  EXPECT_EQ(-1, grid.Cell(99, 69));
+  EXPECT_EQ(0u, grid.DirtyTileCount());
+
+  OccupancyGridDelta delta;
+  EXPECT_FALSE(grid.MakeDelta(delta));
+  EXPECT_EQ(0u, grid.Version());
+
+  grid.SetCell(99, 69, 100);
+  grid.SetCell(0, 0, -1);
+  EXPECT_EQ(100, grid.Cell(99, 69));
+  EXPECT_EQ(1u, grid.DirtyTileCount());
+
+  ASSERT_TRUE(grid.MakeDelta(delta));
+  EXPECT_FALSE(delta.keyframe());
+  EXPECT_EQ(0u, delta.base_version());
+  EXPECT_EQ(1u, delta.version());
+  EXPECT_EQ(32u, delta.tile_size());
+  EXPECT_EQ(100u, delta.info().width());
+  ASSERT_EQ(1, delta.tiles_size());
+  EXPECT_EQ(3u, delta.tiles(0).x());
+  EXPECT_EQ(2u, delta.tiles(0).y());
+
+  // Edge tiles are clipped to the map
+  ASSERT_EQ(4u * 6u, delta.tiles(0).data().size());
+  EXPECT_EQ(100, static_cast<int8_t>(delta.tiles(0).data().back()));
+  EXPECT_EQ(0u, grid.DirtyTileCount());
+  EXPECT_EQ(1u, grid.Version());
+
+  OccupancyGridDelta keyframe;
+  grid.MakeKeyframe(keyframe);
+  EXPECT_TRUE(keyframe.keyframe());
+  EXPECT_EQ(1u, keyframe.version());
+  EXPECT_EQ(12, keyframe.tiles_size());
+
+  // Tile size zero uses the default
+  TiledOccupancyGrid defaultGrid(10, 10, 0);
+  EXPECT_EQ(TiledOccupancyGrid::kDefaultTileSize, defaultGrid.TileSize());
+}
+
+/////////////////////////////////////////////////
+TEST(OccupancyGridTilesTest, FromMap)
+{
+  OccupancyGrid map;
+  map.mutable_header()->mutable_stamp()->set_sec(3);
+  map.mutable_info()->set_resolution(0.05);
+  map.mutable_info()->set_width(5);
+  map.mutable_info()->set_height(4);
+  map.mutable_data()->assign(20, 50);
+
+  TiledOccupancyGrid grid(map, 2);
+  EXPECT_EQ(3, grid.Map().header().stamp().sec());
+  EXPECT_DOUBLE_EQ(0.05, grid.Map().info().resolution());
+  EXPECT_EQ(3u, grid.TilesX());
+  EXPECT_EQ(2u, grid.TilesY());
+  EXPECT_EQ(50, grid.Cell(4, 3));
+
+  // Missing cells are unknown
+  map.mutable_data()->resize(18);
+  TiledOccupancyGrid shortGrid(map, 2);
+  EXPECT_EQ(20u, shortGrid.Map().data().size());
+  EXPECT_EQ(50, shortGrid.Cell(2, 3));
+  EXPECT_EQ(-1, shortGrid.Cell(3, 3));
+  EXPECT_EQ(-1, shortGrid.Cell(4, 3));
+}
+
+/////////////////////////////////////////////////
+TEST(OccupancyGridTilesTest, Rects)
+{
+  TiledOccupancyGrid grid(10, 10, 4);
+  EXPECT_FALSE(grid.FillRect(8, 0, 3, 1, 0));
+  EXPECT_FALSE(grid.FillRect(0, 9, 1, 2, 0));
+  EXPECT_EQ(0u, grid.DirtyTileCount());
+
+  ASSERT_TRUE(grid.FillRect(3, 3, 2, 2, 0));
+  EXPECT_EQ(4u, grid.DirtyTileCount());
+  EXPECT_EQ(0, grid.Cell(3, 3));
+  EXPECT_EQ(0, grid.Cell(4, 4));
+  EXPECT_EQ(-1, grid.Cell(5, 4));
+
+  std::vector<int8_t> cells(6);
+  ASSERT_TRUE(grid.ReadRect(3, 3, 3, 2, cells.data()));
+  EXPECT_EQ((std::vector<int8_t>{0, 0, -1, 0, 0, -1}), cells);
+  EXPECT_FALSE(grid.ReadRect(8, 8, 3, 2, cells.data()));
+
+  OccupancyGridDelta delta;
+  ASSERT_TRUE(grid.MakeDelta(delta));
+
+  // Writing the same cells doesn't dirty the tiles
+  ASSERT_TRUE(grid.WriteRect(3, 3, 3, 2, cells.data()));
+  EXPECT_EQ(0u, grid.DirtyTileCount());
+
+  cells = {1, 2, 3, 4, 5, 6};
+  ASSERT_TRUE(grid.WriteRect(7, 8, 3, 2, cells.data()));
+  EXPECT_EQ(1, grid.Cell(7, 8));
+  EXPECT_EQ(3, grid.Cell(9, 8));
+  EXPECT_EQ(6, grid.Cell(9, 9));
+  EXPECT_EQ(2u, grid.DirtyTileCount());
+
+  ASSERT_TRUE(grid.MakeDelta(delta));
+  ASSERT_TRUE(grid.MarkDirty(0, 0, 5, 1));
+  EXPECT_EQ(2u, grid.DirtyTileCount());
+  ASSERT_TRUE(grid.MarkDirty(0, 0, 0, 0));
+  EXPECT_EQ(2u, grid.DirtyTileCount());
+  EXPECT_FALSE(grid.MarkDirty(0, 0, 11, 1));
+}
+
+/////////////////////////////////////////////////
+TEST(OccupancyGridTilesTest, Threshold)
+{
+  TiledOccupancyGrid grid(6, 1, 2);
+  const int8_t cells[] = {-1, 0, 20, 50, 65, 100};
+  ASSERT_TRUE(grid.WriteRect(0, 0, 6, 1, cells));
+  OccupancyGridDelta delta;
+  ASSERT_TRUE(grid.MakeDelta(delta));
+
+  grid.Threshold(25, 65);
+  EXPECT_EQ(-1, grid.Cell(0, 0));
+  EXPECT_EQ(0, grid.Cell(1, 0));
+  EXPECT_EQ(0, grid.Cell(2, 0));
+  EXPECT_EQ(-1, grid.Cell(3, 0));
+  EXPECT_EQ(100, grid.Cell(4, 0));
+  EXPECT_EQ(100, grid.Cell(5, 0));
+
+  // Only the tiles whose cells changed are dirty
+  ASSERT_TRUE(grid.MakeDelta(delta));
+  ASSERT_EQ(2, delta.tiles_size());
+  EXPECT_EQ(1u, delta.tiles(0).x());
+  EXPECT_EQ(2u, delta.tiles(1).x());
+
+  grid.Threshold(25, 65);
+  EXPECT_FALSE(grid.MakeDelta(delta));
+}
+
+/////////////////////////////////////////////////
+TEST(OccupancyGridTilesTest, Inflate)
+{
+  const uint32_t width = 53;
+  const uint32_t height = 41;
+  std::mt19937 rng(3);
+  std::uniform_int_distribution<int> value(-1, 100);
+  std::uniform_int_distribution<int> obstacle(0, 60);
+
+  for (uint32_t radius : {0u, 1u, 3u, 7u, 100u})
+  {
+    TiledOccupancyGrid grid(width, height, 8);
+    for (uint32_t y = 0; y < height; ++y)
+    {
+      for (uint32_t x = 0; x < width; ++x)
+      {
+        const int cell = value(rng);
+        grid.SetCell(x, y, static_cast<int8_t>(
+            obstacle(rng) == 0 ? 100 : (cell > 80 ? 0 : cell)));
+      }
+    }
+    // A wall, dense enough to change how rows are processed
+    ASSERT_TRUE(grid.FillRect(5, 20, 40, 1, 100));
+    OccupancyGridDelta delta;
+    grid.MakeDelta(delta);
+    const OccupancyGrid before = grid.Map();
+    auto cellBefore = [&](int _x, int _y)
+    {
+      return static_cast<int8_t>(before.data()[_y * width + _x]);
+    };
+
+    grid.Inflate(radius, 90);
+
+    std::vector<bool> changedTiles(grid.TilesX() * grid.TilesY());
+    for (int y = 0; y < static_cast<int>(height); ++y)
+    {
+      for (int x = 0; x < static_cast<int>(width); ++x)
+      {
+        bool near = false;
+        const int r = static_cast<int>(radius);
+        for (int dy = -r; dy <= r && !near; ++dy)
+        {
+          for (int dx = -r; dx <= r && !near; ++dx)
+          {
+            const int nx = x + dx;
+            const int ny = y + dy;
+            near = dx * dx + dy * dy <= r * r && nx >= 0 && ny >= 0 &&
+                nx < static_cast<int>(width) &&
+                ny < static_cast<int>(height) && cellBefore(nx, ny) >= 90;
+          }
+        }
+        const int8_t expected = near ? 100 : cellBefore(x, y);
+        ASSERT_EQ(expected, grid.Cell(x, y))
+            << "radius " << radius << " cell " << x << ", " << y;
+        if (expected != cellBefore(x, y))
+          changedTiles[(y / 8) * grid.TilesX() + x / 8] = true;
+      }
+    }
+
+    size_t changed = 0;
+    for (bool tile : changedTiles)
+      changed += tile;
+    EXPECT_EQ(changed, grid.DirtyTileCount()) << "radius " << radius;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(OccupancyGridTilesTest, Reconstructor)
+{
+  TiledOccupancyGrid grid(37, 29, 8);
+  grid.MutableHeader().mutable_stamp()->set_sec(1);
+  grid.MutableInfo().set_resolution(0.1);
+  ASSERT_TRUE(grid.FillRect(5, 5, 10, 10, 0));
+
+  OccupancyGrid map;
+  OccupancyGridReconstructor reconstructor(map);
+  EXPECT_FALSE(reconstructor.Synced());
+
+  // Deltas are ignored until a keyframe arrives
+  OccupancyGridDelta delta;
+  ASSERT_TRUE(grid.MakeDelta(delta));
+  EXPECT_FALSE(reconstructor.Apply(delta));
+
+  OccupancyGridDelta keyframe;
+  grid.MakeKeyframe(keyframe);
+  ASSERT_TRUE(reconstructor.Apply(keyframe));
+  EXPECT_TRUE(reconstructor.Synced());
+  EXPECT_EQ(1u, reconstructor.Version());
+  EXPECT_EQ(1, map.header().stamp().sec());
+  EXPECT_DOUBLE_EQ(0.1, map.info().resolution());
+  ExpectSameCells(grid, map);
+
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<uint32_t> xs(0, 36);
+  std::uniform_int_distribution<uint32_t> ys(0, 28);
+  for (int i = 0; i < 20; ++i)
+  {
+    for (int j = 0; j < 5; ++j)
+      grid.SetCell(xs(rng), ys(rng), static_cast<int8_t>(i * 5));
+    grid.MutableHeader().mutable_stamp()->set_sec(2 + i);
+    if (!grid.MakeDelta(delta))
+      continue;
+    EXPECT_LT(delta.tiles_size(), 20);
+    ASSERT_TRUE(reconstructor.Apply(delta));
+    EXPECT_EQ(grid.Version(), reconstructor.Version());
+    EXPECT_EQ(2 + i, map.header().stamp().sec());
+    ExpectSameCells(grid, map);
+  }
+
+  // A lost delta requires a new keyframe
+  grid.SetCell(0, 0, 1);
+  ASSERT_TRUE(grid.MakeDelta(delta));
+  grid.SetCell(36, 28, 2);
+  ASSERT_TRUE(grid.MakeDelta(delta));
+  EXPECT_FALSE(reconstructor.Apply(delta));
+  EXPECT_FALSE(reconstructor.Synced());
+  EXPECT_EQ(-1, static_cast<int8_t>(map.data()[36 + 28 * 37]));
+
+  grid.MakeKeyframe(keyframe);
+  ASSERT_TRUE(reconstructor.Apply(keyframe));
+  EXPECT_TRUE(reconstructor.Synced());
+  ExpectSameCells(grid, map);
+
+  // Malformed tiles are rejected without modifying the map
+  grid.SetCell(10, 10, 3);
+  ASSERT_TRUE(grid.MakeDelta(delta));
+  OccupancyGridDelta bad = delta;
+  bad.mutable_tiles(0)->mutable_data()->pop_back();
+  EXPECT_FALSE(reconstructor.Apply(bad));
+  bad = delta;
+  bad.mutable_tiles(0)->set_x(5);
+  EXPECT_FALSE(reconstructor.Apply(bad));
+  bad = delta;
+  bad.set_tile_size(0);
+  EXPECT_FALSE(reconstructor.Apply(bad));
+  EXPECT_NE(3, static_cast<int8_t>(map.data()[10 + 10 * 37]));
+
+  ASSERT_TRUE(reconstructor.Apply(delta));
+  ExpectSameCells(grid, map);
+
+  reconstructor.Reset();
+  EXPECT_FALSE(reconstructor.Synced());
+}
@@ -0,0 +1,305 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+
+#include "gz/msgs/PointCloudPackedCodec.hh"
+#include "gz/msgs/PointCloudPackedUtils.hh"
+
+using namespace gz;
+using namespace msgs;
+
+/////////////////////////////////////////////////
+/// \brief Create a cloud that looks like a spinning lidar scan.
+PointCloudPacked LidarCloud(unsigned int _width, unsigned int _height)
+{
+  PointCloudPacked pcMsg;
+  InitPointCloudPacked(pcMsg, "lidar", true,
+      {{"xyz", PointCloudPacked::Field::FLOAT32},
+       {"intensity", PointCloudPacked::Field::FLOAT32},
+       {"ring", PointCloudPacked::Field::UINT16}});
+  pcMsg.set_width(_width);
+  pcMsg.set_height(_height);
+  pcMsg.set_row_step(_width * pcMsg.point_step());
+  pcMsg.set_is_dense(true);
+  pcMsg.mutable_data()->resize(_height * pcMsg.row_step());
+
+  std::mt19937 gen(42);
+  std::normal_distribution<float> noise(0.0f, 0.01f);
+  PointCloudPackedIterator<float> xIter(pcMsg, "x");
+  PointCloudPackedIterator<float> yIter(pcMsg, "y");
+  PointCloudPackedIterator<float> zIter(pcMsg, "z");
+  PointCloudPackedIterator<float> iIter(pcMsg, "intensity");
+  PointCloudPackedIterator<uint16_t> ringIter(pcMsg, "ring");
+  for (unsigned int i = 0; xIter != xIter.End();
+       ++i, ++xIter, ++yIter, ++zIter, ++iIter, ++ringIter)
+  {
+    const float azimuth = 2.0f * GZ_PI * (i % _width) / _width;
+    const float range = 10.0f + 2.0f * std::sin(azimuth * 3.0f) + noise(gen);
+    *xIter = range * std::cos(azimuth);
+    *yIter = range * std::sin(azimuth);
+    *zIter = 0.05f * (i / _width) + noise(gen);
+    *iIter = std::floor(100.0f + 20.0f * std::cos(azimuth));
+    *ringIter = i / _width;
+  }
+  return pcMsg;
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudPackedCodecTest, Lossless)
+{
+  PointCloudPacked pcMsg = LidarCloud(512, 16);
+
+  // Fill the padding bytes with garbage, which must be preserved
+  for (size_t i = 0; i < pcMsg.data().size(); i += pcMsg.point_step())
+    (*pcMsg.mutable_data())[i + pcMsg.point_step() - 1] = static_cast<char>(i);
+
+  std::string blob;
+  ASSERT_TRUE(EncodePointCloudPacked(pcMsg, blob));
+  EXPECT_LT(blob.size(), pcMsg.data().size());
+
+  PointCloudPacked decoded;
+  ASSERT_TRUE(DecodePointCloudPacked(blob, decoded));
+  EXPECT_EQ(pcMsg.SerializeAsString(), decoded.SerializeAsString());
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudPackedCodecTest, LosslessRandomData)
+{
+  PointCloudPacked pcMsg;
+  InitPointCloudPacked(pcMsg, "frame", false,
+      {{"a", PointCloudPacked::Field::INT8},
+       {"b", PointCloudPacked::Field::FLOAT64},
+       {"c", PointCloudPacked::Field::INT16},
+       {"d", PointCloudPacked::Field::UINT32}});
+
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> byte(0, 255);
+  pcMsg.mutable_data()->resize(1000 * pcMsg.point_step());
+  for (char &c : *pcMsg.mutable_data())
+    c = static_cast<char>(byte(gen));
+
+  std::string blob;
+  ASSERT_TRUE(EncodePointCloudPacked(pcMsg, blob));
+  PointCloudPacked decoded;
+  ASSERT_TRUE(DecodePointCloudPacked(blob, decoded));
+  EXPECT_EQ(pcMsg.data(), decoded.data());
+  EXPECT_EQ(pcMsg.point_step(), decoded.point_step());
+  EXPECT_EQ(4, decoded.field_size());
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudPackedCodecTest, LosslessRowPadding)
+{
+  PointCloudPacked pcMsg = LidarCloud(64, 4);
+
+  // Pad every row with 5 bytes
+  const uint32_t rowStep = pcMsg.row_step() + 5;
+  std::string padded;
+  for (unsigned int row = 0; row < pcMsg.height(); ++row)
+  {
+    padded.append(pcMsg.data(), row * pcMsg.row_step(), pcMsg.row_step());
+    padded.append("abcde");
+  }
+  pcMsg.set_row_step(rowStep);
+  pcMsg.set_data(padded);
+
+  std::string blob;
+  ASSERT_TRUE(EncodePointCloudPacked(pcMsg, blob));
+  PointCloudPacked decoded;
+  ASSERT_TRUE(DecodePointCloudPacked(blob, decoded));
+  EXPECT_EQ(pcMsg.data(), decoded.data());
+
+  // Bytes after the last row don't match row_step * height
+  pcMsg.mutable_data()->append("xyz");
+  EXPECT_FALSE(EncodePointCloudPacked(pcMsg, blob));
+
+  // Clouds without a height keep trailing bytes
+  pcMsg.set_height(0);
+  ASSERT_TRUE(EncodePointCloudPacked(pcMsg, blob));
+  ASSERT_TRUE(DecodePointCloudPacked(blob, decoded));
+  EXPECT_EQ(pcMsg.data(), decoded.data());
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudPackedCodecTest, Quantized)
+{
+  PointCloudPacked pcMsg = LidarCloud(512, 16);
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  PointCloudPackedIterator<float> xIter(pcMsg, "x");
+  *(xIter + 3) = nan;
+
+  const double precision = 0.001;
+  std::string lossless;
+  std::string quantized;
+  ASSERT_TRUE(EncodePointCloudPacked(pcMsg, lossless));
+  ASSERT_TRUE(EncodePointCloudPacked(pcMsg, precision, quantized));
+  EXPECT_LT(quantized.size(), lossless.size());
+
+  PointCloudPacked decoded;
+  ASSERT_TRUE(DecodePointCloudPacked(quantized, decoded));
+  ASSERT_EQ(pcMsg.data().size(), decoded.data().size());
+  EXPECT_EQ(pcMsg.width(), decoded.width());
+  EXPECT_EQ(pcMsg.height(), decoded.height());
+
+  PointCloudPackedConstIterator<float> x(pcMsg, "x");
+  PointCloudPackedConstIterator<float> y(pcMsg, "y");
+  PointCloudPackedConstIterator<float> z(pcMsg, "z");
+  PointCloudPackedConstIterator<float> intensity(pcMsg, "intensity");
+  PointCloudPackedConstIterator<uint16_t> ring(pcMsg, "ring");
+  PointCloudPackedConstIterator<float> xOut(decoded, "x");
+  PointCloudPackedConstIterator<float> yOut(decoded, "y");
+  PointCloudPackedConstIterator<float> zOut(decoded, "z");
+  PointCloudPackedConstIterator<float> intensityOut(decoded, "intensity");
+  PointCloudPackedConstIterator<uint16_t> ringOut(decoded, "ring");
+  for (int i = 0; x != x.End(); ++i, ++x, ++y, ++z, ++intensity, ++ring,
+       ++xOut, ++yOut, ++zOut, ++intensityOut, ++ringOut)
+  {
+    if (i == 3)
+      EXPECT_TRUE(std::isnan(*xOut));
+    else
+      EXPECT_NEAR(*x, *xOut, precision * 0.5 + 1e-6);
+    EXPECT_NEAR(*y, *yOut, precision * 0.5 + 1e-6);
+    EXPECT_NEAR(*z, *zOut, precision * 0.5 + 1e-6);
+
+    // Other fields are lossless
+    EXPECT_EQ(*intensity, *intensityOut);
+    EXPECT_EQ(*ring, *ringOut);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudPackedCodecTest, Errors)
+{
+  PointCloudPacked pcMsg = LidarCloud(16, 1);
+  std::string blob;
+
+  // Precision must be positive
+  EXPECT_FALSE(EncodePointCloudPacked(pcMsg, 0.0, blob));
+  EXPECT_FALSE(EncodePointCloudPacked(pcMsg, -1.0, blob));
+
+  // Quantization requires floating point xyz
+  PointCloudPacked intCloud;
+  InitPointCloudPacked(intCloud, "frame", false,
+      {{"xyz", PointCloudPacked::Field::INT32}});
+  EXPECT_FALSE(EncodePointCloudPacked(intCloud, 0.01, blob));
+  EXPECT_TRUE(EncodePointCloudPacked(intCloud, blob));
+
+  // Malformed blobs
+  PointCloudPacked decoded;
+  EXPECT_FALSE(DecodePointCloudPacked("", decoded));
+  EXPECT_FALSE(DecodePointCloudPacked("not a cloud", decoded));
+
+  ASSERT_TRUE(EncodePointCloudPacked(pcMsg, blob));
+  for (size_t size : {blob.size() / 2, blob.size() - 1})
+    EXPECT_FALSE(DecodePointCloudPacked(blob.substr(0, size), decoded));
+}
+
+/////////////////////////////////////////////////
+/// \brief Build an encoded cloud whose gap stream holds _size zeros,
+/// compressed as if it held _actualSize of them.
+std::string CraftedBlob(const PointCloudPacked &_header, uint64_t _size,
+    size_t _actualSize)
+{
+  const std::string zeros(_actualSize, '\0');
+  std::string stream;
+  detail::EntropyCoder::Encode(
+      reinterpret_cast<const uint8_t *>(zeros.data()), zeros.size(), stream);
+  const char *ptr = stream.data();
+  uint64_t size = 0;
+  detail::ReadVarint(ptr, stream.data() + stream.size(), size);
+
+  std::string blob("GZPC\x01\x00", 6);
+  const std::string metadata = _header.SerializeAsString();
+  detail::WriteVarint(metadata.size(), blob);
+  blob.append(metadata);
+  detail::WriteVarint(_size, blob);
+  detail::WriteVarint(_size, blob);
+  blob.append(stream, ptr - stream.data(), std::string::npos);
+  return blob;
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudPackedCodecTest, MalformedInput)
+{
+  PointCloudPacked pcMsg = LidarCloud(64, 4);
+  std::string blob;
+  ASSERT_TRUE(EncodePointCloudPacked(pcMsg, blob));
+  PointCloudPacked decoded;
+
+  // Truncated header
+  for (size_t size = 0; size < 16; ++size)
+    EXPECT_FALSE(DecodePointCloudPacked(blob.substr(0, size), decoded));
+
+  // Unknown version and mode
+  std::string bad = blob;
+  bad[4] = 9;
+  EXPECT_FALSE(DecodePointCloudPacked(bad, decoded));
+  bad = blob;
+  bad[5] = 2;
+  EXPECT_FALSE(DecodePointCloudPacked(bad, decoded));
+
+  // A cloud without points is all gap bytes
+  PointCloudPacked header;
+  ASSERT_TRUE(DecodePointCloudPacked(CraftedBlob(header, 4096, 4096),
+      decoded));
+  EXPECT_EQ(std::string(4096, '\0'), decoded.data());
+
+  // A data size that the streams can't hold fails without allocating it
+  const uint64_t huge = uint64_t{1} << 50;
+  EXPECT_FALSE(DecodePointCloudPacked(CraftedBlob(header, huge, 4096),
+      decoded));
+  EXPECT_FALSE(DecodePointCloudPacked(CraftedBlob(header, huge, 0),
+      decoded));
+
+  // Huge organized header without point data
+  header = LidarCloud(1, 1);
+  header.clear_data();
+  header.set_width(65535);
+  header.set_height(65535);
+  header.set_row_step(header.width() * header.point_step());
+  const uint64_t headerSize =
+      static_cast<uint64_t>(header.row_step()) * header.height();
+  EXPECT_FALSE(DecodePointCloudPacked(CraftedBlob(header, headerSize, 0),
+      decoded));
+
+  // Data size that doesn't match the header
+  header.set_width(1);
+  header.set_height(1);
+  header.set_row_step(header.point_step());
+  EXPECT_FALSE(DecodePointCloudPacked(
+      CraftedBlob(header, header.point_step() + 1, 0), decoded));
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudPackedCodecTest, Empty)
+{
+  PointCloudPacked pcMsg;
+  std::string blob;
+  ASSERT_TRUE(EncodePointCloudPacked(pcMsg, blob));
+
+  PointCloudPacked decoded;
+  decoded.mutable_data()->assign("stale");
+  ASSERT_TRUE(DecodePointCloudPacked(blob, decoded));
+  EXPECT_TRUE(decoded.data().empty());
+  EXPECT_EQ(0, decoded.field_size());
+}
@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include "gz/msgs/PointCloudPackedFilters.hh"
+#include "gz/msgs/PointCloudPackedUtils.hh"
+
+using namespace gz;
+using namespace msgs;
+
+/////////////////////////////////////////////////
+/// \brief Create a cloud with x = i, y = 0, z = 0 and label = i.
+PointCloudPacked LineCloud(unsigned int _points)
+{
+  PointCloudPacked pcMsg;
+  InitPointCloudPacked(pcMsg, "frame", false,
+      {{"xyz", PointCloudPacked::Field::FLOAT32},
+       {"label", PointCloudPacked::Field::UINT32}});
+  pcMsg.set_width(_points);
+  pcMsg.set_height(1);
+  pcMsg.set_row_step(_points * pcMsg.point_step());
+  pcMsg.mutable_data()->resize(pcMsg.row_step());
+
+  PointCloudPackedIterator<float> xIter(pcMsg, "x");
+  PointCloudPackedIterator<uint32_t> labelIter(pcMsg, "label");
+  for (unsigned int i = 0; xIter != xIter.End(); ++i, ++xIter, ++labelIter)
+  {
+    *xIter = i;
+    *labelIter = i;
+  }
+  return pcMsg;
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudPackedFiltersTest, CropBox)
+{
+  PointCloudPacked pcMsg = LineCloud(10);
+  PointCloudPackedIterator<float> yIter(pcMsg, "y");
+  *(yIter + 4) = std::numeric_limits<float>::quiet_NaN();
+
+  PointCloudPacked cropped;
+  math::AxisAlignedBox box(math::Vector3d(2, -1, -1), math::Vector3d(6, 1, 1));
+  ASSERT_TRUE(CropBoxPointCloudPacked(pcMsg, box, cropped));
+
+  // Bounds are included and NaN points are dropped
+  EXPECT_EQ(4u, cropped.width());
+  EXPECT_EQ(1u, cropped.height());
+  EXPECT_EQ(4u * cropped.point_step(), cropped.row_step());
+  EXPECT_EQ(cropped.row_step(), cropped.data().size());
+  EXPECT_TRUE(cropped.is_dense());
+  EXPECT_EQ("frame", cropped.header().data(0).value(0));
+
+  PointCloudPackedConstIterator<float> xIter(cropped, "x");
+  PointCloudPackedConstIterator<uint32_t> labelIter(cropped, "label");
+  for (uint32_t expected : {2u, 3u, 5u, 6u})
+  {
+    EXPECT_FLOAT_EQ(expected, *xIter);
+    EXPECT_EQ(expected, *labelIter);
+    ++xIter;
+    ++labelIter;
+  }
+
+  // Nothing inside
+  math::AxisAlignedBox far(math::Vector3d(20, 0, 0), math::Vector3d(30, 1, 1));
+  ASSERT_TRUE(CropBoxPointCloudPacked(pcMsg, far, cropped));
+  EXPECT_EQ(0u, cropped.width());
+  EXPECT_TRUE(cropped.data().empty());
+
+  // Needs xyz
+  PointCloudPacked noXyz;
+  EXPECT_FALSE(CropBoxPointCloudPacked(noXyz, box, cropped));
+
+  // Can't filter in place
+  EXPECT_FALSE(CropBoxPointCloudPacked(pcMsg, box, pcMsg));
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudPackedFiltersTest, Decimate)
+{
+  PointCloudPacked pcMsg = LineCloud(10);
+  PointCloudPacked decimated;
+  ASSERT_TRUE(DecimatePointCloudPacked(pcMsg, 3, decimated));
+  EXPECT_EQ(4u, decimated.width());
+  PointCloudPackedConstIterator<uint32_t> labelIter(decimated, "label");
+  for (uint32_t expected : {0u, 3u, 6u, 9u})
+  {
+    EXPECT_EQ(expected, *labelIter);
+    ++labelIter;
+  }
+
+  // Organized clouds stay organized
+  pcMsg.set_width(5);
+  pcMsg.set_height(2);
+  pcMsg.set_row_step(5 * pcMsg.point_step());
+  ASSERT_TRUE(DecimatePointCloudPacked(pcMsg, 2, decimated));
+  EXPECT_EQ(3u, decimated.width());
+  EXPECT_EQ(1u, decimated.height());
+  labelIter = PointCloudPackedConstIterator<uint32_t>(decimated, "label");
+  for (uint32_t expected : {0u, 2u, 4u})
+  {
+    EXPECT_EQ(expected, *labelIter);
+    ++labelIter;
+  }
+  EXPECT_EQ(labelIter, labelIter.End());
+
+  EXPECT_FALSE(DecimatePointCloudPacked(pcMsg, 0, decimated));
+  EXPECT_FALSE(DecimatePointCloudPacked(pcMsg, 2, pcMsg));
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudPackedFiltersTest, VoxelGrid)
+{
+  PointCloudPacked pcMsg = LineCloud(10);
+  PointCloudPacked filtered;
+
+  // Voxels of 4 along x: {0..3}, {4..7}, {8, 9}
+  ASSERT_TRUE(VoxelGridPointCloudPacked(pcMsg, math::Vector3d(4, 1, 1),
+      VoxelGridMode::FIRST_POINT, filtered));
+  EXPECT_EQ(3u, filtered.width());
+  EXPECT_TRUE(filtered.is_dense());
+  PointCloudPackedConstIterator<float> xIter(filtered, "x");
+  PointCloudPackedConstIterator<uint32_t> labelIter(filtered, "label");
+  for (uint32_t expected : {0u, 4u, 8u})
+  {
+    EXPECT_FLOAT_EQ(expected, *xIter);
+    EXPECT_EQ(expected, *labelIter);
+    ++xIter;
+    ++labelIter;
+  }
+
+  ASSERT_TRUE(VoxelGridPointCloudPacked(pcMsg, math::Vector3d(4, 1, 1),
+      VoxelGridMode::CENTROID, filtered));
+  EXPECT_EQ(3u, filtered.width());
+  xIter = PointCloudPackedConstIterator<float>(filtered, "x");
+  labelIter = PointCloudPackedConstIterator<uint32_t>(filtered, "label");
+  for (float expected : {1.5f, 5.5f, 8.5f})
+  {
+    EXPECT_FLOAT_EQ(expected, *xIter);
+    ++xIter;
+  }
+  // Other fields come from the first point
+  EXPECT_EQ(0u, *labelIter);
+
+  EXPECT_FALSE(VoxelGridPointCloudPacked(pcMsg, math::Vector3d(0, 1, 1),
+      VoxelGridMode::CENTROID, filtered));
+  EXPECT_FALSE(VoxelGridPointCloudPacked(pcMsg, math::Vector3d(1e-300, 1, 1),
+      VoxelGridMode::CENTROID, filtered));
+  EXPECT_FALSE(VoxelGridPointCloudPacked(pcMsg, math::Vector3d(1, 1, 1),
+      VoxelGridMode::CENTROID, pcMsg));
+
+  // Voxel edges are multiples of the leaf size whatever the bounds of the
+  // cloud: x = -2..7 falls in {-2, -1}, {0..3}, {4..7}
+  PointCloudPackedIterator<float> shiftIter(pcMsg, "x");
+  for (; shiftIter != shiftIter.End(); ++shiftIter)
+    *shiftIter -= 2;
+  ASSERT_TRUE(VoxelGridPointCloudPacked(pcMsg, math::Vector3d(4, 1, 1),
+      VoxelGridMode::FIRST_POINT, filtered));
+  EXPECT_EQ(3u, filtered.width());
+  xIter = PointCloudPackedConstIterator<float>(filtered, "x");
+  for (float expected : {-2.0f, 0.0f, 4.0f})
+  {
+    EXPECT_FLOAT_EQ(expected, *xIter);
+    ++xIter;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudPackedFiltersTest, Parallel)
+{
+  // Large enough to be split across threads
+  const unsigned int points = 200000;
+  PointCloudPacked pcMsg;
+  InitPointCloudPacked(pcMsg, "frame", true,
+      {{"xyz", PointCloudPacked::Field::FLOAT64},
+       {"label", PointCloudPacked::Field::UINT32}});
+  pcMsg.mutable_data()->resize(points * pcMsg.point_step());
+
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<double> coord(-10.0, 10.0);
+  PointCloudPackedIterator<double> xIter(pcMsg, "x");
+  PointCloudPackedIterator<double> yIter(pcMsg, "y");
+  PointCloudPackedIterator<double> zIter(pcMsg, "z");
+  PointCloudPackedIterator<uint32_t> labelIter(pcMsg, "label");
+  for (unsigned int i = 0; xIter != xIter.End();
+       ++i, ++xIter, ++yIter, ++zIter, ++labelIter)
+  {
+    *xIter = coord(gen);
+    *yIter = coord(gen);
+    *zIter = coord(gen);
+    *labelIter = i;
+  }
+
+  for (VoxelGridMode mode :
+       {VoxelGridMode::FIRST_POINT, VoxelGridMode::CENTROID})
+  {
+    PointCloudPacked serial;
+    PointCloudPacked parallel;
+    ASSERT_TRUE(VoxelGridPointCloudPacked(pcMsg, math::Vector3d(1, 1, 1),
+        mode, serial, 1));
+    ASSERT_TRUE(VoxelGridPointCloudPacked(pcMsg, math::Vector3d(1, 1, 1),
+        mode, parallel, 4));
+    EXPECT_EQ(8000u, serial.width());
+    EXPECT_EQ(serial.data(), parallel.data());
+  }
+
+  PointCloudPacked serial;
+  PointCloudPacked parallel;
+  math::AxisAlignedBox box(math::Vector3d(-5, -5, -5), math::Vector3d(5, 5, 5));
+  ASSERT_TRUE(CropBoxPointCloudPacked(pcMsg, box, serial, 1));
+  ASSERT_TRUE(CropBoxPointCloudPacked(pcMsg, box, parallel, 4));
+  EXPECT_NEAR(points / 8.0, serial.width(), points / 80.0);
+  EXPECT_EQ(serial.data(), parallel.data());
+
+  PointCloudPackedConstIterator<uint32_t> cropLabel(serial, "label");
+  uint32_t prev = 0;
+  for (; cropLabel != cropLabel.End(); ++cropLabel)
+  {
+    EXPECT_LE(prev, *cropLabel);
+    prev = *cropLabel;
+  }
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "gz/msgs/PointCloudPackedSlice.hh"
+#include "gz/msgs/PointCloudPackedUtils.hh"
+
+using namespace gz;
+using namespace msgs;
+
+/////////////////////////////////////////////////
+/// \brief Create an organized 4x3 cloud with one point of row padding,
+/// where label = row * 10 + col.
+PointCloudPacked OrganizedCloud()
+{
+  PointCloudPacked pcMsg;
+  InitPointCloudPacked(pcMsg, "frame", false,
+      {{"xyz", PointCloudPacked::Field::FLOAT32},
+       {"label", PointCloudPacked::Field::UINT32}});
+  pcMsg.set_height(4);
+  pcMsg.set_width(3);
+  pcMsg.set_row_step(4 * pcMsg.point_step());
+  pcMsg.set_is_dense(true);
+  pcMsg.mutable_data()->resize(4 * pcMsg.row_step());
+
+  PointCloudPackedView<uint32_t> label(pcMsg, "label");
+  PointCloudPackedView<float> x(pcMsg, "x");
+  for (size_t row = 0; row < 4; ++row)
+  {
+    for (size_t col = 0; col < 3; ++col)
+    {
+      label(row, col) = static_cast<uint32_t>(row * 10 + col);
+      x(row, col) = row + col * 0.5f;
+    }
+  }
+  return pcMsg;
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudPackedSliceTest, Rows)
+{
+  const PointCloudPacked pcMsg = OrganizedCloud();
+  PointCloudPackedSlice slice(pcMsg, 1, 3);
+  ASSERT_TRUE(slice.Valid());
+  EXPECT_TRUE(slice.IsRowRange());
+  EXPECT_EQ(6u, slice.Size());
+  EXPECT_EQ(3u, slice.Index(0));
+  EXPECT_EQ(&pcMsg, &slice.Cloud());
+
+  // No copy
+  EXPECT_EQ(pcMsg.data().data() + pcMsg.row_step(), slice.Point(0));
+
+  PointCloudPackedSliceIterator<uint32_t> label(slice, "label");
+  const std::vector<uint32_t> expected{10, 11, 12, 20, 21, 22};
+  std::vector<uint32_t> labels;
+  for (; label != label.End(); ++label)
+    labels.push_back(*label);
+  EXPECT_EQ(expected, labels);
+
+  PointCloudPackedSliceIterator<float> x(slice, "x");
+  EXPECT_FLOAT_EQ(2.5f, *(x + 4));
+  EXPECT_FLOAT_EQ(2.5f, *(x += 4));
+  EXPECT_FLOAT_EQ(0.0f, x[1]);
+
+  PointCloudPackedConstView<uint32_t> view = slice.View<uint32_t>("label");
+  EXPECT_EQ(2u, view.Height());
+  EXPECT_EQ(3u, view.Width());
+  EXPECT_EQ(21u, view(1, 1));
+
+  PointCloudPacked dst;
+  ASSERT_TRUE(slice.Materialize(dst));
+  EXPECT_EQ(2u, dst.height());
+  EXPECT_EQ(3u, dst.width());
+  EXPECT_EQ(3u * dst.point_step(), dst.row_step());
+  EXPECT_EQ(dst.row_step() * 2, dst.data().size());
+  EXPECT_TRUE(dst.is_dense());
+  EXPECT_EQ(pcMsg.header().DebugString(), dst.header().DebugString());
+  PointCloudPackedConstIterator<uint32_t> dstLabel(dst, "label");
+  labels.clear();
+  for (; dstLabel != dstLabel.End(); ++dstLabel)
+    labels.push_back(*dstLabel);
+  EXPECT_EQ(expected, labels);
+
+  PointCloudPackedSlice empty(pcMsg, 2, 2);
+  EXPECT_TRUE(empty.Valid());
+  EXPECT_EQ(0u, empty.Size());
+  ASSERT_TRUE(empty.Materialize(dst));
+  EXPECT_TRUE(dst.data().empty());
+
+  PointCloudPackedSlice outside(pcMsg, 2, 5);
+  EXPECT_FALSE(outside.Valid());
+  EXPECT_EQ(0u, outside.Size());
+  EXPECT_FALSE(outside.Materialize(dst));
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudPackedSliceTest, Indices)
+{
+  const PointCloudPacked pcMsg = OrganizedCloud();
+
+  // Indices are row major and skip the row padding
+  PointCloudPackedSlice slice(pcMsg, {11, 0, 4, 4});
+  ASSERT_TRUE(slice.Valid());
+  EXPECT_FALSE(slice.IsRowRange());
+  EXPECT_EQ(4u, slice.Size());
+  EXPECT_EQ(11u, slice.Index(0));
+
+  const std::vector<uint32_t> expected{32, 0, 11, 11};
+  std::vector<uint32_t> labels;
+  for (PointCloudPackedSliceIterator<uint32_t> label(slice, "label");
+       label != label.End(); ++label)
+  {
+    labels.push_back(*label);
+  }
+  EXPECT_EQ(expected, labels);
+
+  // Views are only available for bands of rows
+  EXPECT_EQ(0u, slice.View<uint32_t>("label").Height());
+
+  PointCloudPacked dst;
+  ASSERT_TRUE(slice.Materialize(dst));
+  EXPECT_EQ(1u, dst.height());
+  EXPECT_EQ(4u, dst.width());
+  EXPECT_EQ(4u * dst.point_step(), dst.row_step());
+  EXPECT_EQ(dst.row_step(), dst.data().size());
+  PointCloudPackedConstIterator<uint32_t> dstLabel(dst, "label");
+  PointCloudPackedConstIterator<float> dstX(dst, "x");
+  labels.clear();
+  for (; dstLabel != dstLabel.End(); ++dstLabel, ++dstX)
+  {
+    labels.push_back(*dstLabel);
+    EXPECT_FLOAT_EQ((*dstLabel / 10) + (*dstLabel % 10) * 0.5f, *dstX);
+  }
+  EXPECT_EQ(expected, labels);
+
+  // Point steps without a specialized gather
+  PointCloudPacked odd;
+  InitPointCloudPacked(odd, "frame", false,
+      {{"a", PointCloudPacked::Field::UINT8},
+       {"b", PointCloudPacked::Field::UINT16}});
+  odd.set_height(1);
+  odd.set_width(5);
+  odd.set_row_step(5 * odd.point_step());
+  odd.mutable_data()->assign("abcdefghijklmno");
+  PointCloudPackedSlice oddSlice(odd, {4, 1});
+  ASSERT_TRUE(oddSlice.Materialize(dst));
+  EXPECT_EQ("mnodef", dst.data());
+
+  PointCloudPackedSlice outside(pcMsg, {1, 12});
+  EXPECT_FALSE(outside.Valid());
+  EXPECT_EQ(0u, outside.Size());
+  EXPECT_FALSE(outside.Materialize(dst));
+
+  PointCloudPacked self = pcMsg;
+  PointCloudPackedSlice selfSlice(self, {1});
+  EXPECT_FALSE(selfSlice.Materialize(self));
+}
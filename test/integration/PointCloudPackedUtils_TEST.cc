@@ -17,6 +17,11 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
 #include "gz/msgs/PointCloudPackedUtils.hh"
 #include "gz/msgs/Utility.hh"
 
@@ -316,3 +321,273 @@ TEST(PointCloudPackedUtilsTest, SizeOfPointField)
   EXPECT_EQ(4, sizeOfPointField(PointCloudPacked::Field::FLOAT32));
   EXPECT_EQ(8, sizeOfPointField(PointCloudPacked::Field::FLOAT64));
 }
+
+/////////////////////////////////////////////////
+TEST(PointCloudPackedUtilsTest, Transform)
+{
+  PointCloudPacked pcMsg;
+  InitPointCloudPacked(pcMsg, "my_frame", true,
+      {{"xyz", PointCloudPacked::Field::FLOAT32},
+       {"rgba", PointCloudPacked::Field::FLOAT32},
+       {"normal_x", PointCloudPacked::Field::FLOAT32},
+       {"normal_y", PointCloudPacked::Field::FLOAT32},
+       {"normal_z", PointCloudPacked::Field::FLOAT32}});
+  pcMsg.mutable_data()->resize(10 * pcMsg.point_step());
+
+  PointCloudPackedIterator<float> xIter(pcMsg, "x");
+  PointCloudPackedIterator<float> yIter(pcMsg, "y");
+  PointCloudPackedIterator<float> zIter(pcMsg, "z");
+  PointCloudPackedIterator<float> nxIter(pcMsg, "normal_x");
+  PointCloudPackedIterator<float> nyIter(pcMsg, "normal_y");
+  PointCloudPackedIterator<float> nzIter(pcMsg, "normal_z");
+  PointCloudPackedIterator<uint8_t> rIter(pcMsg, "r");
+  for (unsigned int i = 0; xIter != xIter.End(); ++i, ++xIter, ++yIter,
+       ++zIter, ++nxIter, ++nyIter, ++nzIter, ++rIter)
+  {
+    *xIter = i;
+    *yIter = 2.0f * i;
+    *zIter = 3.0f * i;
+    *nxIter = 1.0f;
+    *nyIter = 0.0f;
+    *nzIter = 0.0f;
+    *rIter = i;
+  }
+
+  // Rotate 90 degrees about z and translate
+  math::Pose3d pose(1, 2, 3, 0, 0, GZ_PI * 0.5);
+  EXPECT_TRUE(TransformPointCloudPacked(pcMsg, pose, true));
+
+  PointCloudPackedConstIterator<float> xConst(pcMsg, "x");
+  PointCloudPackedConstIterator<float> yConst(pcMsg, "y");
+  PointCloudPackedConstIterator<float> zConst(pcMsg, "z");
+  PointCloudPackedConstIterator<float> nxConst(pcMsg, "normal_x");
+  PointCloudPackedConstIterator<float> nyConst(pcMsg, "normal_y");
+  PointCloudPackedConstIterator<float> nzConst(pcMsg, "normal_z");
+  PointCloudPackedConstIterator<uint8_t> rConst(pcMsg, "r");
+  unsigned int i = 0;
+  for (; xConst != xConst.End(); ++i, ++xConst, ++yConst, ++zConst,
+       ++nxConst, ++nyConst, ++nzConst, ++rConst)
+  {
+    EXPECT_NEAR(1.0 - 2.0 * i, *xConst, 1e-4);
+    EXPECT_NEAR(2.0 + i, *yConst, 1e-4);
+    EXPECT_NEAR(3.0 + 3.0 * i, *zConst, 1e-4);
+    EXPECT_NEAR(0.0, *nxConst, 1e-6);
+    EXPECT_NEAR(1.0, *nyConst, 1e-6);
+    EXPECT_NEAR(0.0, *nzConst, 1e-6);
+    EXPECT_EQ(i, *rConst);
+  }
+  EXPECT_EQ(10u, i);
+
+  // Normals can't be transformed if they don't exist
+  PointCloudPacked noNormals;
+  InitPointCloudPacked(noNormals, "my_frame", false,
+      {{"xyz", PointCloudPacked::Field::FLOAT64}});
+  noNormals.mutable_data()->resize(2 * noNormals.point_step());
+  EXPECT_FALSE(TransformPointCloudPacked(noNormals, pose, true));
+  EXPECT_TRUE(TransformPointCloudPacked(noNormals, pose));
+
+  // xyz must be floating point
+  PointCloudPacked intCloud;
+  InitPointCloudPacked(intCloud, "my_frame", false,
+      {{"xyz", PointCloudPacked::Field::INT32}});
+  EXPECT_FALSE(TransformPointCloudPacked(intCloud, pose));
+
+  // Empty cloud without fields
+  PointCloudPacked empty;
+  EXPECT_FALSE(TransformPointCloudPacked(empty, pose));
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudPackedUtilsTest, TransformOrganizedWithPadding)
+{
+  PointCloudPacked pcMsg;
+  InitPointCloudPacked(pcMsg, "my_frame", false,
+      {{"xyz", PointCloudPacked::Field::FLOAT64}});
+
+  // 2 rows of 3 points, with one padding point at the end of every row
+  pcMsg.set_width(3);
+  pcMsg.set_height(2);
+  pcMsg.set_row_step(4 * pcMsg.point_step());
+  pcMsg.mutable_data()->resize(2 * pcMsg.row_step());
+
+  PointCloudPackedIterator<double> xIter(pcMsg, "x");
+  for (unsigned int i = 0; xIter != xIter.End(); ++i, ++xIter)
+    *xIter = i;
+
+  EXPECT_TRUE(TransformPointCloudPacked(pcMsg,
+      math::Pose3d(10, 0, 0, 0, 0, 0)));
+
+  PointCloudPackedConstIterator<double> xConst(pcMsg, "x");
+  for (unsigned int i = 0; xConst != xConst.End(); ++i, ++xConst)
+  {
+    // Padding points are left untouched
+    if (i % 4 == 3)
+      EXPECT_DOUBLE_EQ(i, *xConst);
+    else
+      EXPECT_DOUBLE_EQ(i + 10.0, *xConst);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudPackedUtilsTest, Compact)
+{
+  PointCloudPacked pcMsg;
+  InitPointCloudPacked(pcMsg, "my_frame", true,
+      {{"xyz", PointCloudPacked::Field::FLOAT32},
+       {"intensity", PointCloudPacked::Field::FLOAT32}});
+
+  // Organized cloud of 3 rows of 4 points, padded by one point per row
+  pcMsg.set_width(4);
+  pcMsg.set_height(3);
+  pcMsg.set_row_step(5 * pcMsg.point_step());
+  pcMsg.set_is_dense(false);
+  pcMsg.mutable_data()->resize(3 * pcMsg.row_step());
+
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const float inf = std::numeric_limits<float>::infinity();
+  PointCloudPackedIterator<float> xIter(pcMsg, "x");
+  PointCloudPackedIterator<float> yIter(pcMsg, "y");
+  PointCloudPackedIterator<float> zIter(pcMsg, "z");
+  PointCloudPackedIterator<float> iIter(pcMsg, "intensity");
+  for (unsigned int i = 0; xIter != xIter.End();
+       ++i, ++xIter, ++yIter, ++zIter, ++iIter)
+  {
+    // Points 1, 6 and 8 are invalid, and 4, 9 and 14 are padding
+    const unsigned int row = i / 5;
+    const unsigned int col = i % 5;
+    *xIter = i == 1 ? nan : 1.0f;
+    *yIter = i == 6 ? -inf : 2.0f;
+    *zIter = i == 8 ? nan : 3.0f;
+    *iIter = row * 4 + col;
+  }
+
+  std::vector<uint32_t> indices;
+  ASSERT_TRUE(CompactPointCloudPacked(pcMsg, &indices));
+  EXPECT_EQ(1u, pcMsg.height());
+  EXPECT_EQ(9u, pcMsg.width());
+  EXPECT_EQ(9u * pcMsg.point_step(), pcMsg.row_step());
+  EXPECT_EQ(pcMsg.row_step(), pcMsg.data().size());
+  EXPECT_TRUE(pcMsg.is_dense());
+
+  const std::vector<uint32_t> expected{0, 2, 3, 4, 6, 8, 9, 10, 11};
+  EXPECT_EQ(expected, indices);
+
+  PointCloudPackedConstIterator<float> xConst(pcMsg, "x");
+  PointCloudPackedConstIterator<float> iConst(pcMsg, "intensity");
+  for (unsigned int i = 0; xConst != xConst.End(); ++i, ++xConst, ++iConst)
+  {
+    EXPECT_FLOAT_EQ(1.0f, *xConst);
+    EXPECT_FLOAT_EQ(static_cast<float>(expected[i]), *iConst);
+  }
+
+  // Compacting again is a no-op
+  ASSERT_TRUE(CompactPointCloudPacked(pcMsg));
+  EXPECT_EQ(9u, pcMsg.width());
+
+  PointCloudPacked noXyz;
+  EXPECT_FALSE(CompactPointCloudPacked(noXyz));
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudPackedUtilsTest, ConvertFieldTypes)
+{
+  PointCloudPacked pcMsg;
+  InitPointCloudPacked(pcMsg, "my_frame", true,
+      {{"xyz", PointCloudPacked::Field::FLOAT64},
+       {"intensity", PointCloudPacked::Field::FLOAT32},
+       {"ring", PointCloudPacked::Field::UINT16}});
+  EXPECT_EQ(40u, pcMsg.point_step());
+
+  // Organized 2x3 cloud with one point of row padding
+  pcMsg.set_height(2);
+  pcMsg.set_width(3);
+  pcMsg.set_row_step(4 * pcMsg.point_step());
+  pcMsg.mutable_data()->resize(2 * pcMsg.row_step());
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  for (unsigned int row = 0; row < 2; ++row)
+  {
+    for (unsigned int col = 0; col < 3; ++col)
+    {
+      char *point = &(*pcMsg.mutable_data())[row * pcMsg.row_step() +
+          col * pcMsg.point_step()];
+      const unsigned int i = row * 3 + col;
+      const double xyz[3] = {i + 0.25, -1.0 * i, i == 4 ? nan : 1e9};
+      const float intensity = 100.7f * i;
+      const uint16_t ring = static_cast<uint16_t>(i * 1000);
+      memcpy(point, xyz, sizeof(xyz));
+      memcpy(point + 24, &intensity, sizeof(intensity));
+      memcpy(point + 32, &ring, sizeof(ring));
+    }
+  }
+
+  PointCloudPacked packed;
+  ASSERT_TRUE(ConvertFieldTypes(pcMsg, packed,
+      {{"xyz", PointCloudPacked::Field::FLOAT32},
+       {"intensity", PointCloudPacked::Field::UINT8}}));
+  ASSERT_EQ(5, packed.field_size());
+  EXPECT_EQ(0u, packed.field(0).offset());
+  EXPECT_EQ(4u, packed.field(1).offset());
+  EXPECT_EQ(8u, packed.field(2).offset());
+  EXPECT_EQ(12u, packed.field(3).offset());
+  EXPECT_EQ(PointCloudPacked::Field::UINT8, packed.field(3).datatype());
+  EXPECT_EQ(13u, packed.field(4).offset());
+  EXPECT_EQ(PointCloudPacked::Field::UINT16, packed.field(4).datatype());
+  EXPECT_EQ(15u, packed.point_step());
+  EXPECT_EQ(2u, packed.height());
+  EXPECT_EQ(3u, packed.width());
+  EXPECT_EQ(45u, packed.row_step());
+  EXPECT_EQ(90u, packed.data().size());
+  EXPECT_EQ(pcMsg.header().DebugString(), packed.header().DebugString());
+
+  PointCloudPackedConstIterator<float> xIter(packed, "x");
+  PointCloudPackedConstIterator<float> yIter(packed, "y");
+  PointCloudPackedConstIterator<float> zIter(packed, "z");
+  PointCloudPackedConstIterator<uint8_t> iIter(packed, "intensity");
+  PointCloudPackedConstIterator<uint16_t> rIter(packed, "ring");
+  for (unsigned int i = 0; xIter != xIter.End();
+       ++i, ++xIter, ++yIter, ++zIter, ++iIter, ++rIter)
+  {
+    EXPECT_FLOAT_EQ(i + 0.25f, *xIter);
+    EXPECT_FLOAT_EQ(-1.0f * i, *yIter);
+    if (i == 4)
+      EXPECT_TRUE(std::isnan(*zIter));
+    else
+      EXPECT_FLOAT_EQ(1e9f, *zIter);
+    // Rounded to nearest and saturated
+    const uint8_t intensity[] = {0, 101, 201, 255, 255, 255};
+    EXPECT_EQ(intensity[i], *iIter);
+    EXPECT_EQ(i * 1000u, *rIter);
+  }
+
+  // Aligned layout, and conversion from integer to floating point
+  PointCloudPacked aligned;
+  ASSERT_TRUE(ConvertFieldTypes(pcMsg, aligned,
+      {{"x", PointCloudPacked::Field::FLOAT32},
+       {"y", PointCloudPacked::Field::FLOAT32},
+       {"z", PointCloudPacked::Field::FLOAT32},
+       {"ring", PointCloudPacked::Field::FLOAT32}}, true));
+  EXPECT_EQ(0u, aligned.field(0).offset());
+  EXPECT_EQ(8u, aligned.field(2).offset());
+  EXPECT_EQ(16u, aligned.field(3).offset());
+  EXPECT_EQ(24u, aligned.field(4).offset());
+  EXPECT_EQ(32u, aligned.point_step());
+  PointCloudPackedConstIterator<float> ringIter(aligned, "ring");
+  EXPECT_FLOAT_EQ(5000.0f, *(ringIter + 5));
+
+  // Narrowing to signed integers saturates, NaN becomes zero
+  PointCloudPacked quantized;
+  ASSERT_TRUE(ConvertFieldTypes(pcMsg, quantized,
+      {{"xyz", PointCloudPacked::Field::INT16}}));
+  PointCloudPackedConstIterator<int16_t> qyIter(quantized, "y");
+  PointCloudPackedConstIterator<int16_t> qzIter(quantized, "z");
+  EXPECT_EQ(-5, *(qyIter + 5));
+  EXPECT_EQ(std::numeric_limits<int16_t>::max(), *qzIter);
+  EXPECT_EQ(0, *(qzIter + 4));
+
+  PointCloudPacked bad;
+  EXPECT_FALSE(ConvertFieldTypes(pcMsg, bad,
+      {{"rgb", PointCloudPacked::Field::FLOAT32}}));
+  EXPECT_FALSE(ConvertFieldTypes(pcMsg, bad,
+      {{"x", static_cast<PointCloudPacked::Field::DataType>(100)}}));
+  EXPECT_FALSE(ConvertFieldTypes(pcMsg, pcMsg, {}));
+}
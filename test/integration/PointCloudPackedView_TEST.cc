@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <vector>
+
+#include "gz/msgs/PointCloudPackedUtils.hh"
+#include "gz/msgs/PointCloudPackedView.hh"
+
+using namespace gz;
+using namespace msgs;
+
+/////////////////////////////////////////////////
+/// \brief Create an organized 5x7 cloud with two points of row padding.
+PointCloudPacked OrganizedCloud()
+{
+  PointCloudPacked pcMsg;
+  InitPointCloudPacked(pcMsg, "frame", true,
+      {{"xyz", PointCloudPacked::Field::FLOAT32},
+       {"label", PointCloudPacked::Field::UINT16}});
+  pcMsg.set_height(5);
+  pcMsg.set_width(7);
+  pcMsg.set_row_step(9 * pcMsg.point_step());
+  pcMsg.mutable_data()->resize(5 * pcMsg.row_step());
+  return pcMsg;
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudPackedViewTest, RowColumnAccess)
+{
+  PointCloudPacked pcMsg = OrganizedCloud();
+
+  PointCloudPackedView<uint16_t> label(pcMsg, "label");
+  ASSERT_TRUE(label.Valid());
+  EXPECT_EQ(5u, label.Height());
+  EXPECT_EQ(7u, label.Width());
+  for (size_t row = 0; row < label.Height(); ++row)
+  {
+    for (size_t col = 0; col < label.Width(); ++col)
+      label(row, col) = static_cast<uint16_t>(row * 100 + col);
+  }
+
+  // Padding is skipped
+  const char *point = pcMsg.data().data() + 2 * pcMsg.row_step() +
+      3 * pcMsg.point_step() + 16;
+  EXPECT_EQ(203u, *reinterpret_cast<const uint16_t *>(point));
+
+  const PointCloudPacked &constMsg = pcMsg;
+  PointCloudPackedConstView<uint16_t> constLabel(constMsg, "label");
+  EXPECT_EQ(406u, constLabel(4, 6));
+
+  PointCloudPackedView<float> x(pcMsg, "x");
+  x.At(1, 1, 2) = 5.0f;
+  PointCloudPackedConstView<float> z(constMsg, "z");
+  EXPECT_FLOAT_EQ(5.0f, z(1, 1));
+
+  // Unorganized clouds are a single row
+  pcMsg.set_height(1);
+  pcMsg.set_width(45);
+  pcMsg.set_row_step(45 * pcMsg.point_step());
+  PointCloudPackedConstView<uint16_t> flat(pcMsg, "label");
+  EXPECT_EQ(1u, flat.Height());
+  EXPECT_EQ(45u, flat.Width());
+  EXPECT_EQ(203u, flat(0, 21));
+
+  PointCloudPackedConstView<float> missing(pcMsg, "intensity");
+  EXPECT_FALSE(missing.Valid());
+  EXPECT_EQ(0u, missing.Height());
+  EXPECT_EQ(0u, missing.Width());
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudPackedViewTest, Tiles)
+{
+  PointCloudPacked pcMsg = OrganizedCloud();
+  PointCloudPackedView<uint16_t> label(pcMsg, "label");
+
+  std::vector<PointCloudPackedTile> tiles;
+  label.ForEachTile(2, 3, 1, [&](const PointCloudPackedTile &_tile)
+  {
+    tiles.push_back(_tile);
+    for (size_t row = _tile.rowBegin; row < _tile.rowEnd; ++row)
+    {
+      for (size_t col = _tile.colBegin; col < _tile.colEnd; ++col)
+        ++label(row, col);
+    }
+  });
+
+  // 3 rows of 3 tiles
+  ASSERT_EQ(9u, tiles.size());
+  EXPECT_EQ(0u, tiles[0].rowBegin);
+  EXPECT_EQ(2u, tiles[0].rowEnd);
+  EXPECT_EQ(0u, tiles[0].haloRowBegin);
+  EXPECT_EQ(3u, tiles[0].haloRowEnd);
+  EXPECT_EQ(0u, tiles[0].haloColBegin);
+  EXPECT_EQ(4u, tiles[0].haloColEnd);
+
+  EXPECT_EQ(0u, tiles[1].rowBegin);
+  EXPECT_EQ(3u, tiles[1].colBegin);
+  EXPECT_EQ(6u, tiles[1].colEnd);
+  EXPECT_EQ(2u, tiles[1].haloColBegin);
+  EXPECT_EQ(7u, tiles[1].haloColEnd);
+
+  EXPECT_EQ(4u, tiles[8].rowBegin);
+  EXPECT_EQ(5u, tiles[8].rowEnd);
+  EXPECT_EQ(6u, tiles[8].colBegin);
+  EXPECT_EQ(7u, tiles[8].colEnd);
+  EXPECT_EQ(3u, tiles[8].haloRowBegin);
+  EXPECT_EQ(5u, tiles[8].haloRowEnd);
+  EXPECT_EQ(5u, tiles[8].haloColBegin);
+  EXPECT_EQ(7u, tiles[8].haloColEnd);
+
+  // Every point is in exactly one core
+  for (size_t row = 0; row < label.Height(); ++row)
+  {
+    for (size_t col = 0; col < label.Width(); ++col)
+      EXPECT_EQ(1u, label(row, col));
+  }
+
+  // Parallel visit covers the same tiles
+  std::mutex mutex;
+  size_t count = 0;
+  label.ForEachTile(1, 1, 0, [&](const PointCloudPackedTile &_tile)
+  {
+    ++label(_tile.rowBegin, _tile.colBegin);
+    std::lock_guard<std::mutex> lock(mutex);
+    ++count;
+  }, 4);
+  EXPECT_EQ(35u, count);
+  EXPECT_EQ(2u, label(4, 6));
+}
@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/navsat.pb.h>
+#include <gz/msgs/pose_v.pb.h>
+#include <gz/msgs/spherical_coordinates.pb.h>
+
+#include <cmath>
+#include <vector>
+
+#include <gz/math/Angle.hh>
+#include <gz/math/CoordinateVector3.hh>
+#include <gz/math/SphericalCoordinates.hh>
+#include <gz/math/Vector3.hh>
+
+#include "gz/msgs/SphericalCoordinatesUtils.hh"
+#include "gz/msgs/convert/SphericalCoordinates.hh"
+
+using namespace gz;
+using namespace msgs;
+
+/////////////////////////////////////////////////
+/// \brief Convert one position with math::SphericalCoordinates.
+math::Vector3d ScalarLocal(const math::SphericalCoordinates &_sc,
+    double _latitude, double _longitude, double _altitude)
+{
+  math::Angle lat, lon;
+  lat.SetDegree(_latitude);
+  lon.SetDegree(_longitude);
+  const auto local = _sc.LocalFromSphericalPosition(
+      math::CoordinateVector3::Spherical(lat, lon, _altitude));
+  return {*local->X(), *local->Y(), *local->Z()};
+}
+
+/////////////////////////////////////////////////
+/// \brief Fixes around a reference, some of them far away.
+std::vector<math::Vector3d> MakeFixes(const SphericalCoordinates &_ref)
+{
+  std::vector<math::Vector3d> fixes;
+  for (int i = 0; i < 1000; ++i)
+  {
+    // Within a few kilometers, then tens and hundreds of kilometers.
+    const double spread = i < 600 ? 0.05 : (i < 900 ? 2.0 : 40.0);
+    fixes.emplace_back(
+        _ref.latitude_deg() + spread * std::sin(i * 0.37),
+        _ref.longitude_deg() + spread * std::cos(i * 0.91),
+        _ref.elevation() + 50.0 * std::sin(i * 0.13));
+  }
+  return fixes;
+}
+
+/////////////////////////////////////////////////
+TEST(SphericalToLocalConverterTest, MatchesMath)
+{
+  std::vector<SphericalCoordinates> references(4);
+  references[0].set_latitude_deg(37.3861);
+  references[0].set_longitude_deg(-122.0839);
+  references[0].set_elevation(30.0);
+  references[1].set_latitude_deg(-33.8688);
+  references[1].set_longitude_deg(151.2093);
+  references[1].set_heading_deg(30.0);
+  references[2].set_surface_model(SphericalCoordinates::MOON_SCS);
+  references[2].set_latitude_deg(0.6875);
+  references[2].set_longitude_deg(23.4333);
+  references[3].set_surface_model(SphericalCoordinates::CUSTOM_SURFACE);
+  references[3].set_surface_axis_equatorial(3396190.0);
+  references[3].set_surface_axis_polar(3376200.0);
+  references[3].set_latitude_deg(-4.5895);
+  references[3].set_longitude_deg(137.4417);
+  references[3].set_elevation(-4500.0);
+  references[3].set_heading_deg(-75.0);
+
+  for (const SphericalCoordinates &reference : references)
+  {
+    const math::SphericalCoordinates sc = msgs::Convert(reference);
+    SphericalToLocalConverter converter(reference);
+    const std::vector<math::Vector3d> fixes = MakeFixes(reference);
+
+    std::vector<math::Vector3d> local;
+    converter.Convert(fixes, local);
+    ASSERT_EQ(fixes.size(), local.size());
+    for (size_t i = 0; i < fixes.size(); ++i)
+    {
+      const math::Vector3d expected = ScalarLocal(sc, fixes[i].X(),
+          fixes[i].Y(), fixes[i].Z());
+      EXPECT_NEAR(expected.X(), local[i].X(), 1e-6) << i;
+      EXPECT_NEAR(expected.Y(), local[i].Y(), 1e-6) << i;
+      EXPECT_NEAR(expected.Z(), local[i].Z(), 1e-6) << i;
+    }
+
+    const math::Vector3d one = converter.Convert(fixes[3].X(), fixes[3].Y(),
+        fixes[3].Z());
+    EXPECT_EQ(local[3], one);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(SphericalToLocalConverterTest, Reference)
+{
+  SphericalCoordinates reference;
+  reference.set_latitude_deg(48.8566);
+  reference.set_longitude_deg(2.3522);
+  reference.set_elevation(35.0);
+  SphericalToLocalConverter converter(reference);
+  EXPECT_DOUBLE_EQ(48.8566, converter.Reference().latitude_deg());
+
+  // The reference itself is the origin, and up is +z.
+  const math::Vector3d origin = converter.Convert(48.8566, 2.3522, 35.0);
+  EXPECT_NEAR(0.0, origin.Length(), 1e-8);
+  const math::Vector3d up = converter.Convert(48.8566, 2.3522, 135.0);
+  EXPECT_NEAR(0.0, up.X(), 1e-8);
+  EXPECT_NEAR(0.0, up.Y(), 1e-8);
+  EXPECT_NEAR(100.0, up.Z(), 1e-8);
+
+  // North and east, and the same after a heading of 90 degrees.
+  const math::Vector3d north = converter.Convert(48.8576, 2.3522, 35.0);
+  EXPECT_NEAR(0.0, north.X(), 1e-6);
+  EXPECT_NEAR(111.2, north.Y(), 0.1);
+  const math::Vector3d east = converter.Convert(48.8566, 2.3532, 35.0);
+  EXPECT_NEAR(73.3, east.X(), 0.1);
+  EXPECT_NEAR(0.0, east.Y(), 0.01);
+
+  reference.set_heading_deg(90.0);
+  EXPECT_TRUE(converter.SetReference(reference));
+  const math::Vector3d rotated = converter.Convert(48.8576, 2.3522, 35.0);
+  EXPECT_NEAR(north.Length(), rotated.Length(), 1e-6);
+  EXPECT_NEAR(north.Z(), rotated.Z(), 1e-6);
+  EXPECT_NEAR(north.Y(), std::abs(rotated.X()), 1e-6);
+
+  // Invalid custom surfaces fall back to WGS84.
+  reference.set_surface_model(SphericalCoordinates::CUSTOM_SURFACE);
+  reference.set_surface_axis_equatorial(1.0);
+  reference.set_surface_axis_polar(2.0);
+  EXPECT_FALSE(converter.SetReference(reference));
+  reference.set_surface_model(SphericalCoordinates::EARTH_WGS84);
+  SphericalToLocalConverter wgs84(reference);
+  EXPECT_EQ(wgs84.Convert(48.8576, 2.3522, 35.0),
+            converter.Convert(48.8576, 2.3522, 35.0));
+}
+
+/////////////////////////////////////////////////
+TEST(SphericalToLocalConverterTest, NavSat)
+{
+  SphericalCoordinates reference;
+  reference.set_latitude_deg(-22.9068);
+  reference.set_longitude_deg(-43.1729);
+  SphericalToLocalConverter converter(reference);
+
+  std::vector<NavSat> fixes(50000);
+  std::vector<math::Vector3d> latLonAlt;
+  for (size_t i = 0; i < fixes.size(); ++i)
+  {
+    fixes[i].set_latitude_deg(-22.9068 + 1e-6 * i);
+    fixes[i].set_longitude_deg(-43.1729 - 2e-6 * i);
+    fixes[i].set_altitude(i * 0.01);
+    latLonAlt.emplace_back(fixes[i].latitude_deg(),
+        fixes[i].longitude_deg(), fixes[i].altitude());
+  }
+  // The antimeridian and the poles take the slower path.
+  fixes[17].set_longitude_deg(179.5);
+  fixes[40000].set_latitude_deg(90.0);
+  latLonAlt[17].Y(179.5);
+  latLonAlt[40000].X(90.0);
+
+  std::vector<math::Vector3d> expected;
+  converter.Convert(latLonAlt, expected, 1);
+
+  std::vector<math::Vector3d> local;
+  converter.Convert(fixes, local, 4);
+  EXPECT_EQ(expected, local);
+
+  Pose_V poses;
+  for (int i = 0; i < 60000; ++i)
+    poses.add_pose();
+  converter.Convert(fixes, poses, 4);
+  ASSERT_EQ(static_cast<int>(fixes.size()), poses.pose_size());
+  for (size_t i = 0; i < fixes.size(); i += 997)
+  {
+    const Pose &pose = poses.pose(static_cast<int>(i));
+    EXPECT_DOUBLE_EQ(expected[i].X(), pose.position().x());
+    EXPECT_DOUBLE_EQ(expected[i].Y(), pose.position().y());
+    EXPECT_DOUBLE_EQ(expected[i].Z(), pose.position().z());
+    EXPECT_DOUBLE_EQ(1.0, pose.orientation().w());
+  }
+
+  std::vector<double> lat, lon, alt;
+  for (const math::Vector3d &fix : latLonAlt)
+  {
+    lat.push_back(fix.X());
+    lon.push_back(fix.Y());
+    alt.push_back(fix.Z());
+  }
+  std::vector<math::Vector3d> arrays(lat.size());
+  converter.Convert(lat.data(), lon.data(), alt.data(), lat.size(),
+      arrays.data());
+  EXPECT_EQ(expected, arrays);
+}
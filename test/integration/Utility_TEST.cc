@@ -16,7 +16,14 @@
 */
 
 #include <gtest/gtest.h>
+#include <google/protobuf/arena.h>
+#include <cmath>
 #include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 #include <gz/math/Helpers.hh>
 
 #include "gz/msgs/Utility.hh"
@@ -289,6 +296,11 @@ TEST(MsgsTest, ConvertMathInertialAddedMassToMsgs)
   EXPECT_DOUBLE_EQ(1.9, msg.fluid_added_mass(18));
   EXPECT_DOUBLE_EQ(2.0, msg.fluid_added_mass(19));
   EXPECT_DOUBLE_EQ(2.1, msg.fluid_added_mass(20));
+
+  // Setting an existing message replaces its added mass
+  msgs::Set(&msg, msgs::Convert(msg));
+  EXPECT_EQ(21, msg.fluid_added_mass().size());
+  EXPECT_DOUBLE_EQ(2.1, msg.fluid_added_mass(20));
 }
 
 /////////////////////////////////////////////////
@@ -481,6 +493,22 @@ TEST(UtilityTest, ConvertStringMsg)
 
   std::string s = msgs::Convert(msg);
   EXPECT_EQ(s, "a string msg");
+
+  // Moved strings keep their buffer
+  std::string data(1000, 'x');
+  const char *buffer = data.data();
+  msgs::Set(&msg, std::move(data));
+  EXPECT_EQ(1000u, msg.data().size());
+  EXPECT_EQ(buffer, msg.data().data());
+
+  std::string out = msgs::Convert(std::move(msg));
+  EXPECT_EQ(buffer, out.data());
+
+  // Views are copied into the existing message
+  const std::string_view view("a string view", 8);
+  msgs::Set(&msg, view);
+  EXPECT_EQ("a string", msg.data());
+  EXPECT_EQ("a string", msgs::Convert(view).data());
 }
 
 /////////////////////////////////////////////////
@@ -634,6 +662,21 @@ TEST(UtilityTest, ConvertFuelMetadata)
     EXPECT_EQ(7, metaMsg.world().file_format().version().minor());
     EXPECT_EQ(0, metaMsg.authors().size());
     EXPECT_EQ(0, metaMsg.dependencies().size());
+
+    // The newest sdf version wins, wherever it appears.
+    metaMsg.Clear();
+    const std::string sdfVersionsInput = R"(<?xml version='1.0'?>
+  <world>
+    <sdf version='1.6'>old.sdf</sdf>
+    <sdf version='1.9'>newest.sdf</sdf>
+    <sdf version='1.8'>new.sdf</sdf>
+    <name>test_world</name>
+  </world>
+)";
+    EXPECT_TRUE(msgs::ConvertFuelMetadata(sdfVersionsInput, metaMsg));
+    EXPECT_EQ("newest.sdf", metaMsg.world().file());
+    EXPECT_EQ(1, metaMsg.world().file_format().version().major());
+    EXPECT_EQ(9, metaMsg.world().file_format().version().minor());
   }
 
   // test ConvertFuelMetadata(msgs::FuelMetadata, string)
@@ -680,6 +723,105 @@ TEST(UtilityTest, ConvertFuelMetadata)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(UtilityTest, ConvertFuelMetadataStreaming)
+{
+  const std::vector<std::string> configs = {
+    R"(<?xml version='1.0'?>
+  <model>
+    <sdf version='1.7'>model.sdf</sdf>
+    <name>test_model</name>
+    <version>3</version>
+    <description>A model for testing</description>
+    <author>
+      <name>Foo Bar</name>
+      <email>foo@bar.org</email>
+    </author>
+    <depend>
+      <model>
+        <uri>model://some_model</uri>
+      </model>
+    </depend>
+  </model>
+)",
+    R"(<?xml version='1.0'?>
+  <!-- A comment -->
+  <world>
+    <name> A &amp; B &lt;world&gt; </name>
+    <sdf version="1.6">old.sdf</sdf>
+    <sdf version="1.9">newest.sdf</sdf>
+    <sdf version="1.8">new.sdf</sdf>
+    <description><![CDATA[Uses <tags> & entities]]></description>
+    <author><name>First</name></author>
+    <author>
+      <email>second@bar.org</email>
+      <!-- <name>Commented</name> -->
+    </author>
+    <depend><model><uri>model://a</uri><uri>model://b</uri></model></depend>
+    <depend/>
+    <ignored><name>not the name</name></ignored>
+  </world>
+)"};
+
+  // The streaming converter agrees with the tinyxml2 based one.
+  for (const std::string &config : configs)
+  {
+    msgs::FuelMetadata dom, streaming;
+    EXPECT_TRUE(msgs::ConvertFuelMetadata(config, dom));
+    EXPECT_TRUE(msgs::ConvertFuelMetadataStreaming(config, streaming));
+    EXPECT_EQ(dom.DebugString(), streaming.DebugString());
+  }
+
+  msgs::FuelMetadata meta;
+  EXPECT_TRUE(msgs::ConvertFuelMetadataStreaming(configs[1], meta));
+  EXPECT_EQ("A & B <world>", meta.name());
+  EXPECT_EQ(0, meta.version());
+  EXPECT_EQ("Uses <tags> & entities", meta.description());
+  EXPECT_EQ("newest.sdf", meta.world().file());
+  EXPECT_EQ(1, meta.world().file_format().version().major());
+  EXPECT_EQ(9, meta.world().file_format().version().minor());
+  ASSERT_EQ(2, meta.authors_size());
+  EXPECT_EQ("First", meta.authors(0).name());
+  EXPECT_EQ("", meta.authors(0).email());
+  EXPECT_EQ("", meta.authors(1).name());
+  EXPECT_EQ("second@bar.org", meta.authors(1).email());
+  ASSERT_EQ(1, meta.dependencies_size());
+  EXPECT_EQ("model://a", meta.dependencies(0).uri());
+
+  // Failures leave the message unchanged.
+  for (const std::string &config : {std::string(), std::string("<test/>"),
+       std::string("<model>test</model>"),
+       std::string("<model><name>a</name></model>"),
+       std::string("<model><name>a</name><sdf>m.sdf</sdf></model>"),
+       std::string("<model><name>a</name><sdf version='1.7'>m.sdf</model>"),
+       std::string("<model><name>a</name><sdf version='1.7>m.sdf</sdf>"),
+       std::string("<model><name>a</name><version>x</version>"
+                   "<sdf version='1.7'>m.sdf</sdf></model>")})
+  {
+    EXPECT_FALSE(msgs::ConvertFuelMetadataStreaming(config, meta)) << config;
+    EXPECT_EQ("A & B <world>", meta.name());
+  }
+
+  // Batch conversion, with failures reported by index.
+  std::vector<std::string> batch;
+  for (int i = 0; i < 300; ++i)
+    batch.push_back(i % 100 == 7 ? "<model/>" : configs[i % 2]);
+  std::vector<msgs::FuelMetadata> metas;
+  std::vector<size_t> failed;
+  EXPECT_EQ(297u, msgs::ConvertFuelMetadata(batch, metas, 4, &failed));
+  ASSERT_EQ(300u, metas.size());
+  EXPECT_EQ((std::vector<size_t>{7, 107, 207}), failed);
+  EXPECT_EQ("test_model", metas[0].name());
+  EXPECT_EQ("A & B <world>", metas[299].name());
+  EXPECT_EQ("", metas[107].name());
+
+  // Output messages can be reused.
+  const std::vector<std::string_view> views(batch.begin(), batch.begin() + 4);
+  EXPECT_EQ(4u, msgs::ConvertFuelMetadata(views, metas));
+  ASSERT_EQ(4u, metas.size());
+  EXPECT_EQ("test_model", metas[2].name());
+}
+
 /////////////////////////////////////////////////
 TEST(UtilityTest, ConvertTimePoint)
 {
@@ -1065,6 +1207,48 @@ TEST(MsgsTest, ConvertMsgsPixelFormatTypeToString)
       "UNKNOWN_PIXEL_FORMAT");
 }
 
+/////////////////////////////////////////////////
+TEST(UtilityTest, ConvertEnumStringWithStatus)
+{
+  msgs::Geometry::Type geometry = msgs::Geometry::BOX;
+  EXPECT_TRUE(msgs::ConvertGeometryType("heightmap", geometry));
+  EXPECT_EQ(msgs::Geometry::HEIGHTMAP, geometry);
+  EXPECT_FALSE(msgs::ConvertGeometryType("Heightmap", geometry));
+  EXPECT_FALSE(msgs::ConvertGeometryType("heightma", geometry));
+  EXPECT_FALSE(msgs::ConvertGeometryType("", geometry));
+  EXPECT_EQ(msgs::Geometry::HEIGHTMAP, geometry);
+
+  msgs::Joint::Type joint = msgs::Joint::REVOLUTE;
+  EXPECT_TRUE(msgs::ConvertJointType("gearbox", joint));
+  EXPECT_EQ(msgs::Joint::GEARBOX, joint);
+  EXPECT_FALSE(msgs::ConvertJointType("revolute3", joint));
+  EXPECT_EQ(msgs::Joint::GEARBOX, joint);
+
+  msgs::Material::ShaderType shader = msgs::Material::VERTEX;
+  EXPECT_TRUE(msgs::ConvertShaderType("pixel", shader));
+  EXPECT_EQ(msgs::Material::PIXEL, shader);
+  EXPECT_FALSE(msgs::ConvertShaderType("normal_map", shader));
+  EXPECT_EQ(msgs::Material::PIXEL, shader);
+
+  msgs::Discovery::Type discovery = msgs::Discovery::UNINITIALIZED;
+  EXPECT_TRUE(msgs::ConvertDiscoveryType("HEARTBEAT", discovery));
+  EXPECT_EQ(msgs::Discovery::HEARTBEAT, discovery);
+  EXPECT_FALSE(msgs::ConvertDiscoveryType("heartbeat", discovery));
+  EXPECT_EQ(msgs::Discovery::HEARTBEAT, discovery);
+
+  msgs::PixelFormatType format = msgs::PixelFormatType::UNKNOWN_PIXEL_FORMAT;
+  EXPECT_TRUE(msgs::ConvertPixelFormatType("BAYER_GRBG8", format));
+  EXPECT_EQ(msgs::PixelFormatType::BAYER_GRBG8, format);
+  EXPECT_FALSE(msgs::ConvertPixelFormatType("BAYER_GRBG16", format));
+  EXPECT_EQ(msgs::PixelFormatType::BAYER_GRBG8, format);
+
+  // Strings that are not null terminated are matched by their length.
+  const std::string text = "meshes";
+  EXPECT_TRUE(msgs::ConvertGeometryType(
+      std::string_view(text.data(), 4), geometry));
+  EXPECT_EQ(msgs::Geometry::MESH, geometry);
+}
+
 /////////////////////////////////////////////////
 TEST(UtilityTest, CovertMathAxisAlignedBox)
 {
@@ -1249,3 +1433,167 @@ TEST(UtilityTest, DiscoveryTypeString)
       msgs::Discovery::Type_MAX);
   EXPECT_EQ(10, msgs::Discovery::Type_ARRAYSIZE);
 }
+
+/////////////////////////////////////////////////
+TEST(UtilityTest, ConvertPointCloud)
+{
+  const std::vector<math::Vector3d> points{
+      {1, 2, 3}, {-4, 5.5, 6}, {7, 8, 9.25}};
+
+  msgs::PointCloud msg = msgs::Convert(points);
+  ASSERT_EQ(3, msg.points_size());
+  EXPECT_DOUBLE_EQ(5.5, msg.points(1).y());
+  EXPECT_EQ(points, msgs::Convert(msg));
+
+  // Existing points are reused, and extra ones removed
+  const msgs::Vector3d *first = &msg.points(0);
+  msgs::Set(&msg, std::vector<math::Vector3d>{{0, 1, 2}});
+  ASSERT_EQ(1, msg.points_size());
+  EXPECT_EQ(first, &msg.points(0));
+  EXPECT_DOUBLE_EQ(2, msg.points(0).z());
+
+  // Arena allocated messages allocate points from the arena
+  google::protobuf::Arena arena;
+  auto *arenaMsg = msgs::detail::CreateOnArena<msgs::PointCloud>(&arena);
+  msgs::Set(arenaMsg, points);
+  EXPECT_EQ(&arena, arenaMsg->points(2).GetArena());
+  EXPECT_EQ(points, msgs::Convert(*arenaMsg));
+}
+
+/////////////////////////////////////////////////
+TEST(UtilityTest, ConvertPointCloudPacked)
+{
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  std::vector<math::Vector3d> points{
+      {1, 2, 3}, {-4, 5.5, 6}, {7, 8, 9.25}};
+
+  // FLOAT32 x, y and z are created by default
+  msgs::PointCloudPacked packed;
+  msgs::Set(&packed, points);
+  ASSERT_EQ(3, packed.field_size());
+  EXPECT_EQ(msgs::PointCloudPacked::Field::FLOAT32,
+            packed.field(0).datatype());
+  EXPECT_EQ(12u, packed.point_step());
+  EXPECT_EQ(1u, packed.height());
+  EXPECT_EQ(3u, packed.width());
+  EXPECT_EQ(36u, packed.data().size());
+  EXPECT_TRUE(packed.is_dense());
+  EXPECT_EQ(points, msgs::Convert(packed));
+
+  // Existing usable x, y and z fields are kept
+  msgs::PointCloudPacked doubles;
+  msgs::InitPointCloudPacked(doubles, "frame", true,
+      {{"xyz", msgs::PointCloudPacked::Field::FLOAT64},
+       {"intensity", msgs::PointCloudPacked::Field::FLOAT32}});
+  points.push_back({nan, 0, 0});
+  points.push_back({0.1, 0.2, 0.3});
+  msgs::Set(&doubles, points);
+  EXPECT_EQ(4, doubles.field_size());
+  EXPECT_EQ(32u, doubles.point_step());
+  EXPECT_EQ(5u, doubles.width());
+  EXPECT_FALSE(doubles.is_dense());
+  std::vector<math::Vector3d> out = msgs::Convert(doubles);
+  ASSERT_EQ(5u, out.size());
+  EXPECT_TRUE(std::isnan(out[3].X()));
+  EXPECT_EQ(points[4], out[4]);
+
+  // Organized clouds are read in row major order without padding
+  msgs::PointCloudPacked organized;
+  msgs::InitPointCloudPacked(organized, "frame", false,
+      {{"xyz", msgs::PointCloudPacked::Field::FLOAT32}});
+  organized.set_height(2);
+  organized.set_width(2);
+  organized.set_row_step(3 * organized.point_step());
+  organized.mutable_data()->resize(2 * organized.row_step());
+  msgs::PointCloudPackedIterator<float> xIter(organized, "x");
+  for (int i = 0; xIter != xIter.End(); ++xIter, ++i)
+    *xIter = static_cast<float>(i);
+  out = msgs::Convert(organized);
+  ASSERT_EQ(4u, out.size());
+  EXPECT_DOUBLE_EQ(0, out[0].X());
+  EXPECT_DOUBLE_EQ(1, out[1].X());
+  EXPECT_DOUBLE_EQ(3, out[2].X());
+  EXPECT_DOUBLE_EQ(4, out[3].X());
+
+  // Message to message
+  msgs::PointCloud cloud;
+  msgs::Set(&cloud, organized);
+  EXPECT_EQ(organized.header().DebugString(), cloud.header().DebugString());
+  ASSERT_EQ(4, cloud.points_size());
+  EXPECT_DOUBLE_EQ(3, cloud.points(2).x());
+
+  msgs::PointCloudPacked repacked;
+  msgs::Set(&repacked, cloud);
+  EXPECT_EQ(4u, repacked.width());
+  EXPECT_EQ(out, msgs::Convert(repacked));
+
+  // Clouds without x, y and z have no points
+  msgs::PointCloudPacked empty;
+  EXPECT_TRUE(msgs::Convert(empty).empty());
+  msgs::Set(&cloud, empty);
+  EXPECT_EQ(0, cloud.points_size());
+}
+
+/////////////////////////////////////////////////
+TEST(UtilityTest, ConvertPoseV)
+{
+  const std::vector<math::Pose3d> poses{
+      {1, 2, 3, 0.1, 0.2, 0.3}, {-4, 5.5, 6, 0, 0, GZ_PI},
+      {7, 8, 9.25, 0, 0, 0}};
+
+  msgs::Pose_V msg = msgs::Convert(poses);
+  ASSERT_EQ(3, msg.pose_size());
+  EXPECT_DOUBLE_EQ(5.5, msg.pose(1).position().y());
+  EXPECT_DOUBLE_EQ(poses[0].Rot().W(), msg.pose(0).orientation().w());
+  EXPECT_EQ(poses, msgs::Convert(msg));
+
+  // Existing poses are reused, and extra ones removed
+  const msgs::Pose *first = &msg.pose(0);
+  msgs::Set(&msg, std::vector<math::Pose3d>{{0, 1, 2, 0, 0, 0}});
+  ASSERT_EQ(1, msg.pose_size());
+  EXPECT_EQ(first, &msg.pose(0));
+  EXPECT_DOUBLE_EQ(2, msg.pose(0).position().z());
+
+  // Poses without orientation get the identity
+  msg.mutable_pose(0)->clear_orientation();
+  std::vector<math::Pose3d> converted(5, poses[0]);
+  msgs::Set(&converted, msg);
+  ASSERT_EQ(1u, converted.size());
+  EXPECT_EQ(math::Pose3d(0, 1, 2, 0, 0, 0), converted[0]);
+
+  // Conversion into an array stops at the smaller size
+  math::Pose3d array[2] = {poses[1], poses[1]};
+  msgs::Set(array, 2, msg);
+  EXPECT_EQ(math::Pose3d(0, 1, 2, 0, 0, 0), array[0]);
+  EXPECT_EQ(poses[1], array[1]);
+
+  // Arena allocated messages allocate poses from the arena
+  google::protobuf::Arena arena;
+  auto *arenaMsg = msgs::detail::CreateOnArena<msgs::Pose_V>(&arena);
+  msgs::Set(arenaMsg, poses.data(), poses.size());
+  EXPECT_EQ(&arena, arenaMsg->pose(2).GetArena());
+  EXPECT_EQ(poses, msgs::Convert(*arenaMsg));
+}
+
+/////////////////////////////////////////////////
+TEST(UtilityTest, ConvertToArena)
+{
+  google::protobuf::Arena arena;
+  msgs::Pose *pose =
+      msgs::Convert(math::Pose3d(1, 2, 3, 0, 0, 0), &arena);
+  EXPECT_EQ(&arena, pose->GetArena());
+  EXPECT_DOUBLE_EQ(2, pose->position().y());
+
+  msgs::StringMsg *str = msgs::Convert(std::string("arena"), &arena);
+  EXPECT_EQ(&arena, str->GetArena());
+  EXPECT_EQ("arena", str->data());
+
+  msgs::Double *value = msgs::Convert(2.5, &arena);
+  EXPECT_DOUBLE_EQ(2.5, value->data());
+
+  // Without an arena, the caller owns the message
+  std::unique_ptr<msgs::Vector3d> vec(
+      msgs::Convert(math::Vector3d(4, 5, 6), nullptr));
+  EXPECT_EQ(nullptr, vec->GetArena());
+  EXPECT_DOUBLE_EQ(6, vec->z());
+}
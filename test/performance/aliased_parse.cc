@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/image.pb.h>
+#include <gz/msgs/pointcloud_packed.pb.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "gz/msgs/AliasedMessageView.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+/// \brief Time a regular parse and an aliasing parse of a message with a
+/// payload of the given size.
+template<typename MsgT>
+void Benchmark(const char *_name, size_t _megabytes)
+{
+  MsgT msg;
+  msg.mutable_header()->mutable_stamp()->set_sec(1);
+  msg.mutable_data()->assign(_megabytes * 1024 * 1024, '\x2a');
+  const std::string buffer = msg.SerializeAsString();
+
+  const int iterations = 20;
+  MsgT parsed;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i)
+    EXPECT_TRUE(parsed.ParseFromString(buffer));
+  const double copy = std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start).count() / iterations;
+
+  msgs::AliasedMessageView<MsgT> view;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i)
+    EXPECT_TRUE(view.Parse(buffer));
+  const double alias = std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start).count() / iterations;
+  EXPECT_EQ(msg.data().size(), view.Data().size());
+
+  std::cout << _name << " " << _megabytes << " MB: ParseFromString "
+            << copy << " ms, AliasedMessageView " << alias << " ms ("
+            << copy / alias << "x)" << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST(AliasedParse, Image)
+{
+  for (size_t megabytes : {1u, 4u, 10u, 30u})
+    Benchmark<msgs::Image>("Image", megabytes);
+}
+
+/////////////////////////////////////////////////
+TEST(AliasedParse, PointCloudPacked)
+{
+  for (size_t megabytes : {1u, 4u, 10u, 30u})
+    Benchmark<msgs::PointCloudPacked>("PointCloudPacked", megabytes);
+}
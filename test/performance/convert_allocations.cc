@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <google/protobuf/arena.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <gz/math/Pose3.hh>
+
+#include "gz/msgs/convert/Pose.hh"
+#include "gz/msgs/convert/StdTypes.hh"
+
+using namespace gz;
+
+/// \brief Number of calls to operator new.
+static std::atomic<size_t> gAllocations{0};
+
+/////////////////////////////////////////////////
+void *operator new(size_t _size)
+{
+  ++gAllocations;
+  if (void *ptr = std::malloc(_size ? _size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr, size_t) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+/// \brief Count the allocations of a callable.
+/// \return Average number of allocations of one call.
+template<typename Func>
+double Allocations(int _iterations, Func &&_func)
+{
+  const size_t start = gAllocations;
+  for (int i = 0; i < _iterations; ++i)
+    _func();
+  return static_cast<double>(gAllocations - start) / _iterations;
+}
+
+/////////////////////////////////////////////////
+TEST(ConvertAllocations, StringMsg)
+{
+  const int iterations = 100;
+  const std::string payload(4096, 'x');
+
+  const double copy = Allocations(iterations, [&]
+  {
+    msgs::StringMsg msg = msgs::Convert(payload);
+    std::string out = msgs::Convert(msg);
+  });
+  const double move = Allocations(iterations, [&]
+  {
+    std::string data = payload;
+    msgs::StringMsg msg = msgs::Convert(std::move(data));
+    std::string out = msgs::Convert(std::move(msg));
+  });
+  msgs::StringMsg reused;
+  msgs::Set(&reused, payload);
+  const double view = Allocations(iterations, [&]
+  {
+    msgs::Set(&reused, std::string_view(payload));
+  });
+
+  // The moving path allocates the copy of the payload only
+  EXPECT_LT(move, copy);
+  EXPECT_EQ(0.0, view);
+  std::cout << "StringMsg round trip allocations: copy " << copy
+            << ", move " << move << " (including the input copy)"
+            << ", string_view into an existing message " << view
+            << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST(ConvertAllocations, Pose)
+{
+  const int iterations = 1000;
+  const math::Pose3d pose(1, 2, 3, 0.1, 0.2, 0.3);
+
+  const double byValue = Allocations(iterations, [&]
+  {
+    msgs::Pose msg = msgs::Convert(pose);
+  });
+  msgs::Pose reused;
+  msgs::Set(&reused, pose);
+  const double existing = Allocations(iterations, [&]
+  {
+    msgs::Set(&reused, pose);
+  });
+
+  std::vector<char> block(1 << 20);
+  google::protobuf::ArenaOptions options;
+  options.initial_block = block.data();
+  options.initial_block_size = block.size();
+  google::protobuf::Arena arena(options);
+  const double onArena = Allocations(iterations, [&]
+  {
+    msgs::Convert(pose, &arena);
+  });
+
+  EXPECT_EQ(0.0, existing);
+  EXPECT_EQ(0.0, onArena);
+  std::cout << "Pose allocations: by value " << byValue
+            << ", into an existing message " << existing
+            << ", on an arena " << onArena << std::endl;
+}
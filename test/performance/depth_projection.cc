@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/camera_info.pb.h>
+#include <gz/msgs/image.pb.h>
+#include <gz/msgs/pointcloud_packed.pb.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+#include "gz/msgs/CameraInfoUtils.hh"
+#include "gz/msgs/PointCloudPackedUtils.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+/// \brief Time a callable.
+/// \return Average time of one call, in milliseconds.
+template<typename Func>
+double Time(int _iterations, Func &&_func)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < _iterations; ++i)
+    _func();
+  return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start).count() / _iterations;
+}
+
+/////////////////////////////////////////////////
+/// \brief Project a depth image one pixel at a time into a new cloud.
+void NaiveProject(const msgs::CameraInfo &_info, const msgs::Image &_depth,
+    msgs::PointCloudPacked &_cloud)
+{
+  _cloud = msgs::PointCloudPacked();
+  msgs::InitPointCloudPacked(_cloud, "", false,
+      {{"xyz", msgs::PointCloudPacked::Field::FLOAT32}});
+  _cloud.set_width(_depth.width());
+  _cloud.set_height(_depth.height());
+  _cloud.set_row_step(_cloud.width() * _cloud.point_step());
+  _cloud.mutable_data()->resize(_cloud.row_step() * _cloud.height());
+
+  msgs::PointCloudPackedIterator<float> x(_cloud, "x");
+  msgs::PointCloudPackedIterator<float> y(_cloud, "y");
+  msgs::PointCloudPackedIterator<float> z(_cloud, "z");
+  for (uint32_t v = 0; v < _depth.height(); ++v)
+  {
+    for (uint32_t u = 0; u < _depth.width(); ++u, ++x, ++y, ++z)
+    {
+      uint16_t mm;
+      std::memcpy(&mm, _depth.data().data() + v * _depth.step() + u * 2, 2);
+      const double fx = _info.intrinsics().k(0);
+      const double fy = _info.intrinsics().k(4);
+      const double cx = _info.intrinsics().k(2);
+      const double cy = _info.intrinsics().k(5);
+      const float d = mm == 0 ?
+          std::numeric_limits<float>::quiet_NaN() : mm / 1000.0f;
+      *x = static_cast<float>(d * (u - cx) / fx);
+      *y = static_cast<float>(d * (v - cy) / fy);
+      *z = d;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(DepthProjection, Vga)
+{
+  msgs::CameraInfo info;
+  info.set_width(640);
+  info.set_height(480);
+  for (double k : {525.0, 0.0, 319.5, 0.0, 525.0, 239.5, 0.0, 0.0, 1.0})
+    info.mutable_intrinsics()->add_k(k);
+
+  msgs::Image depth;
+  depth.set_width(640);
+  depth.set_height(480);
+  depth.set_pixel_format_type(msgs::L_INT16);
+  depth.set_step(640 * 2);
+  depth.mutable_data()->resize(depth.step() * 480);
+  for (size_t i = 0; i < 640 * 480; ++i)
+  {
+    const uint16_t mm = static_cast<uint16_t>(i % 13 == 0 ? 0 : 500 + i % 4000);
+    std::memcpy(&(*depth.mutable_data())[i * 2], &mm, 2);
+  }
+
+  msgs::Image color;
+  color.set_width(640);
+  color.set_height(480);
+  color.set_pixel_format_type(msgs::RGB_INT8);
+  color.set_step(640 * 3);
+  color.mutable_data()->resize(color.step() * 480, 'a');
+
+  const int iterations = 50;
+  msgs::PointCloudPacked cloud;
+  const double naive = Time(iterations, [&]
+  {
+    NaiveProject(info, depth, cloud);
+  });
+
+  msgs::DepthImageProjector projector;
+  ASSERT_TRUE(projector.Project(info, depth, cloud));
+  const double single = Time(iterations, [&]
+  {
+    projector.Project(info, depth, cloud, 1);
+  });
+  const double threaded = Time(iterations, [&]
+  {
+    projector.Project(info, depth, cloud, 0);
+  });
+  const double withColor = Time(iterations, [&]
+  {
+    projector.Project(depth, color, cloud, 0);
+  });
+
+  std::cout << "640x480 depth: per pixel " << naive << " ms, projector "
+            << single << " ms, all cores " << threaded << " ms, with color "
+            << withColor << " ms" << std::endl;
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "gz/msgs/convert/GeometryType.hh"
+#include "gz/msgs/convert/PixelFormatType.hh"
+#include "gz/msgs/detail/EnumTables.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+/// \brief Time a callable.
+/// \return Average time of one call, in nanoseconds.
+template<typename Func>
+double Time(int _iterations, Func &&_func)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < _iterations; ++i)
+    _func();
+  return std::chrono::duration<double, std::nano>(
+      std::chrono::steady_clock::now() - start).count() / _iterations;
+}
+
+/////////////////////////////////////////////////
+/// \brief Find a name with string comparisons in declaration order, the
+/// way the if/else chains in the convert headers did.
+template<size_t N>
+bool LinearFind(const msgs::detail::EnumName (&_names)[N],
+    const std::string &_str, int &_value)
+{
+  for (const msgs::detail::EnumName &name : _names)
+  {
+    if (_str == name.name)
+    {
+      _value = name.value;
+      return true;
+    }
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+/// \brief Compare a linear scan against the hash table for every name of
+/// an enum plus a few strings that are not names.
+template<size_t N, typename Table>
+void Compare(const std::string &_label,
+    const msgs::detail::EnumName (&_names)[N], const Table &_table)
+{
+  std::vector<std::string> inputs;
+  for (const msgs::detail::EnumName &name : _names)
+    inputs.emplace_back(name.name);
+  const size_t known = inputs.size();
+  inputs.emplace_back("bad type");
+  inputs.emplace_back("");
+  inputs.emplace_back(std::string(_names[N - 1].name) + "_");
+
+  const int iterations = 200000;
+  int sink = 0;
+  const double linear = Time(iterations, [&]
+  {
+    for (const std::string &input : inputs)
+    {
+      int value = 0;
+      sink += LinearFind(_names, input, value) ? value + 1 : 0;
+    }
+  });
+  const int linearSink = sink;
+  sink = 0;
+  const double hashed = Time(iterations, [&]
+  {
+    for (const std::string &input : inputs)
+    {
+      int value = 0;
+      sink += _table.Find(input, value) ? value + 1 : 0;
+    }
+  });
+  EXPECT_EQ(linearSink, sink);
+
+  std::cout << _label << ", " << known << " names + "
+            << inputs.size() - known << " unknown: linear scan "
+            << linear / inputs.size() << " ns, hash table "
+            << hashed / inputs.size() << " ns per lookup" << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST(EnumConvert, Lookup)
+{
+  Compare("Geometry::Type", msgs::detail::kGeometryTypeNames,
+      msgs::detail::kGeometryTypeTable);
+  Compare("Joint::Type", msgs::detail::kJointTypeNames,
+      msgs::detail::kJointTypeTable);
+  Compare("Material::ShaderType", msgs::detail::kShaderTypeNames,
+      msgs::detail::kShaderTypeTable);
+  Compare("Discovery::Type", msgs::detail::kDiscoveryTypeNames,
+      msgs::detail::kDiscoveryTypeTable);
+  Compare("PixelFormatType", msgs::detail::kPixelFormatTypeNames,
+      msgs::detail::kPixelFormatTypeTable);
+}
+
+/////////////////////////////////////////////////
+TEST(EnumConvert, PublicApi)
+{
+  const std::string name = "BAYER_GRBG8";
+  const int iterations = 1000000;
+  int sink = 0;
+  const double convert = Time(iterations, [&]
+  {
+    sink += msgs::ConvertPixelFormatType(name);
+  });
+  EXPECT_GT(sink, 0);
+
+  std::cout << "ConvertPixelFormatType(\"" << name << "\") " << convert
+            << " ns" << std::endl;
+}
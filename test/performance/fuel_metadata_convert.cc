@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/fuel_metadata.pb.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gz/msgs/convert/FuelMetadata.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+/// \brief Time a callable.
+/// \return Average time of one call, in milliseconds.
+template<typename Func>
+double Time(int _iterations, Func &&_func)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < _iterations; ++i)
+    _func();
+  return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start).count() / _iterations;
+}
+
+/////////////////////////////////////////////////
+/// \brief A model.config or world.config like the ones on Fuel, with a
+/// few authors and dependencies depending on _i.
+std::string MakeConfig(size_t _i)
+{
+  const bool world = _i % 5 == 0;
+  const std::string root = world ? "world" : "model";
+  std::string config = "<?xml version='1.0'?>\n<" + root + ">\n";
+  config += "  <name>Resource " + std::to_string(_i) + "</name>\n";
+  config += "  <version>" + std::to_string(_i % 7 + 1) + "</version>\n";
+  config += "  <sdf version='1.5'>" + root + "-1_5.sdf</sdf>\n";
+  config += "  <sdf version='1.6'>" + root + ".sdf</sdf>\n";
+  for (size_t a = 0; a <= _i % 3; ++a)
+  {
+    config += "  <author>\n    <name>Author " + std::to_string(a) +
+        "</name>\n    <email>author" + std::to_string(a) +
+        "@example.org</email>\n  </author>\n";
+  }
+  config += "  <description>\n    Resource " + std::to_string(_i) +
+      " for testing, with &lt;escaped&gt; text. Lorem ipsum dolor sit"
+      " amet, consectetur adipiscing elit, sed do eiusmod tempor"
+      " incididunt ut labore et dolore magna aliqua.\n  </description>\n";
+  for (size_t d = 0; d < _i % 4; ++d)
+  {
+    config += "  <depend>\n    <model>\n      <uri>model://dependency_" +
+        std::to_string(d) + "</uri>\n    </model>\n  </depend>\n";
+  }
+  config += "</" + root + ">\n";
+  return config;
+}
+
+/////////////////////////////////////////////////
+TEST(FuelMetadataConvert, Corpus)
+{
+  const size_t count = 20000;
+  std::vector<std::string> configs;
+  size_t bytes = 0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    configs.push_back(MakeConfig(i));
+    bytes += configs.back().size();
+  }
+
+  const int iterations = 3;
+  std::vector<msgs::FuelMetadata> dom(count);
+  size_t domConverted = 0;
+  const double domTime = Time(iterations, [&]
+  {
+    domConverted = 0;
+    for (size_t i = 0; i < count; ++i)
+      domConverted += msgs::ConvertFuelMetadata(configs[i], dom[i]);
+  });
+
+  std::vector<msgs::FuelMetadata> streaming(count);
+  size_t streamingConverted = 0;
+  const double streamingTime = Time(iterations, [&]
+  {
+    streamingConverted = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+      streamingConverted += msgs::ConvertFuelMetadataStreaming(configs[i],
+          streaming[i]);
+    }
+  });
+
+  std::vector<msgs::FuelMetadata> batch;
+  size_t batchConverted = 0;
+  const double batchTime = Time(iterations, [&]
+  {
+    batchConverted = msgs::ConvertFuelMetadata(configs, batch);
+  });
+
+  EXPECT_EQ(count, domConverted);
+  EXPECT_EQ(count, streamingConverted);
+  EXPECT_EQ(count, batchConverted);
+  for (size_t i = 0; i < count; i += 997)
+  {
+    EXPECT_EQ(dom[i].DebugString(), streaming[i].DebugString());
+    EXPECT_EQ(streaming[i].DebugString(), batch[i].DebugString());
+  }
+
+  auto report = [&](const std::string &_label, double _ms)
+  {
+    std::cout << "  " << _label << ": " << _ms << " ms, "
+              << count / _ms * 1e3 << " configs/s, "
+              << bytes / _ms * 1e-3 << " MB/s" << std::endl;
+  };
+  std::cout << count << " configs, " << bytes / count
+            << " bytes on average" << std::endl;
+  report("tinyxml2", domTime);
+  report("streaming", streamingTime);
+  report("streaming batch on " +
+      std::to_string(std::thread::hardware_concurrency()) + " threads",
+      batchTime);
+}
@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef GZ_MSGS_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#include "gz/msgs/ImageCodec.hh"
+#include "gz/msgs/ImageUtils.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+/// \brief Create a 640x480 depth image in meters of a room with a few
+/// boxes, sensor noise and missing returns, as published by common RGB-D
+/// cameras.
+msgs::Image DepthImage()
+{
+  const unsigned int width = 640;
+  const unsigned int height = 480;
+  msgs::Image image;
+  image.set_width(width);
+  image.set_height(height);
+  image.set_step(width * sizeof(float));
+  image.set_pixel_format_type(msgs::R_FLOAT32);
+
+  std::mt19937 gen(42);
+  std::normal_distribution<float> noise(0.0f, 0.002f);
+  std::uniform_real_distribution<float> holes(0.0f, 1.0f);
+  std::vector<float> depths(width * height);
+  for (unsigned int y = 0; y < height; ++y)
+  {
+    for (unsigned int x = 0; x < width; ++x)
+    {
+      // Floor and back wall, with two boxes in front
+      float depth = y > 300 ? 1.2f + 900.0f / (y - 250.0f) : 4.0f;
+      if (x > 100 && x < 250 && y > 150 && y < 400)
+        depth = 2.0f + 0.001f * x;
+      if (x > 380 && x < 560 && y > 200 && y < 420)
+        depth = 1.5f + 0.002f * y;
+      depth += noise(gen) * depth * depth;
+      if (holes(gen) < 0.02f || (x > 248 && x < 256))
+        depth = std::numeric_limits<float>::quiet_NaN();
+      depths[y * width + x] = depth;
+    }
+  }
+  image.mutable_data()->resize(depths.size() * sizeof(float));
+  std::memcpy(&(*image.mutable_data())[0], depths.data(),
+      image.data().size());
+  return image;
+}
+
+/////////////////////////////////////////////////
+/// \brief Time a compressor and its decompressor and print the ratio and
+/// throughput.
+/// \param[in] _name Name of the compressor.
+/// \param[in] _size Size of the uncompressed data.
+/// \param[in] _encode Callable returning the compressed size.
+/// \param[in] _decode Callable decompressing the last compressed data.
+void Benchmark(const std::string &_name, size_t _size,
+    const std::function<size_t()> &_encode,
+    const std::function<void()> &_decode)
+{
+  const int iterations = 10;
+  const double megabytes = _size / (1024.0 * 1024.0);
+
+  size_t compressed = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i)
+    compressed = _encode();
+  const double encodeSeconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count() / iterations;
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i)
+    _decode();
+  const double decodeSeconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count() / iterations;
+
+  std::cout << _name << ": ratio "
+            << static_cast<double>(_size) / compressed << ", encode "
+            << megabytes / encodeSeconds << " MB/s, decode "
+            << megabytes / decodeSeconds << " MB/s" << std::endl;
+}
+
+/////////////////////////////////////////////////
+/// \brief Compare the image codec with zlib on an image.
+/// \param[in] _image The image.
+/// \param[in] _precision Depth precision, or zero for lossless.
+void Compare(const msgs::Image &_image, double _precision)
+{
+  const std::string format =
+      msgs::PixelFormatType_Name(_image.pixel_format_type());
+  std::string blob;
+  msgs::Image decoded;
+  Benchmark(format + (_precision > 0 ? " EncodeImage 1 mm" :
+      " EncodeImage lossless"), _image.data().size(),
+      [&]
+      {
+        if (_precision > 0)
+          EXPECT_TRUE(msgs::EncodeImage(_image, _precision, blob));
+        else
+          EXPECT_TRUE(msgs::EncodeImage(_image, blob));
+        return blob.size();
+      },
+      [&]
+      {
+        EXPECT_TRUE(msgs::DecodeImage(blob, decoded));
+      });
+
+#ifdef GZ_MSGS_HAVE_ZLIB
+  if (_precision > 0)
+    return;
+  for (int level : {1, 6})
+  {
+    std::vector<Bytef> compressed(compressBound(_image.data().size()));
+    uLongf compressedSize = 0;
+    std::vector<Bytef> uncompressed(_image.data().size());
+    Benchmark(format + " zlib level " + std::to_string(level),
+        _image.data().size(),
+        [&]
+        {
+          compressedSize = compressed.size();
+          EXPECT_EQ(Z_OK, compress2(compressed.data(), &compressedSize,
+              reinterpret_cast<const Bytef *>(_image.data().data()),
+              _image.data().size(), level));
+          return static_cast<size_t>(compressedSize);
+        },
+        [&]
+        {
+          uLongf size = uncompressed.size();
+          EXPECT_EQ(Z_OK, uncompress(uncompressed.data(), &size,
+              compressed.data(), compressedSize));
+        });
+  }
+#endif
+}
+
+/////////////////////////////////////////////////
+TEST(ImageCodec, Depth)
+{
+  const msgs::Image depth = DepthImage();
+  Compare(depth, 0.0);
+  Compare(depth, 0.001);
+
+  msgs::Image millimeters;
+  ASSERT_TRUE(msgs::ConvertImage(depth, msgs::L_INT16, millimeters));
+  Compare(millimeters, 0.0);
+}
+
+/////////////////////////////////////////////////
+TEST(ImageCodec, Color)
+{
+  // Shade the depth image, which gives smooth regions and sharp edges
+  const msgs::Image depth = DepthImage();
+  msgs::Image rgb;
+  rgb.set_width(depth.width());
+  rgb.set_height(depth.height());
+  rgb.set_step(depth.width() * 3);
+  rgb.set_pixel_format_type(msgs::RGB_INT8);
+  rgb.mutable_data()->resize(rgb.step() * rgb.height());
+  for (size_t i = 0; i < rgb.width() * rgb.height(); ++i)
+  {
+    float d;
+    std::memcpy(&d, depth.data().data() + i * 4, sizeof(d));
+    const float shade = std::isnan(d) ? 0.0f : 255.0f / (1.0f + d * 0.3f);
+    (*rgb.mutable_data())[i * 3] = static_cast<char>(shade);
+    (*rgb.mutable_data())[i * 3 + 1] = static_cast<char>(shade * 0.8f);
+    (*rgb.mutable_data())[i * 3 + 2] = static_cast<char>(shade * 0.5f);
+  }
+  Compare(rgb, 0.0);
+}
@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "gz/msgs/ImageUtils.hh"
+
+using namespace gz;
+
+/// \brief Benchmark image width.
+constexpr unsigned int kWidth = 1920;
+
+/// \brief Benchmark image height.
+constexpr unsigned int kHeight = 1080;
+
+/////////////////////////////////////////////////
+/// \brief Create a 1080p image filled with a repeating byte pattern.
+msgs::Image MakeImage(msgs::PixelFormatType _format)
+{
+  msgs::Image image;
+  image.set_width(kWidth);
+  image.set_height(kHeight);
+  image.set_pixel_format_type(_format);
+  image.set_step(kWidth * msgs::BytesPerPixel(_format));
+  image.mutable_data()->resize(image.step() * kHeight);
+  for (size_t i = 0; i < image.data().size(); ++i)
+    (*image.mutable_data())[i] = static_cast<char>((i * 7) % 251);
+  return image;
+}
+
+/////////////////////////////////////////////////
+/// \brief Convert through normalized RGBA floats one row at a time, which is
+/// the path ConvertImage takes for pairs without a specialized kernel.
+void ConvertGeneric(const msgs::Image &_src, msgs::PixelFormatType _format,
+    msgs::Image &_dst)
+{
+  const auto srcInfo = msgs::detail::FormatInfo(_src.pixel_format_type());
+  const auto dstInfo = msgs::detail::FormatInfo(_format);
+  _dst.set_width(_src.width());
+  _dst.set_height(_src.height());
+  _dst.set_pixel_format_type(_format);
+  _dst.set_step(_src.width() * msgs::BytesPerPixel(_format));
+  _dst.mutable_data()->resize(_dst.step() * _src.height());
+
+  std::vector<float> rgba(_src.width() * 4);
+  auto src = reinterpret_cast<const unsigned char *>(_src.data().data());
+  auto dst = reinterpret_cast<unsigned char *>(&(*_dst.mutable_data())[0]);
+  for (size_t y = 0; y < _src.height(); ++y)
+  {
+    msgs::detail::DecodeRow(src + y * _src.step(), srcInfo, _src.width(),
+        rgba.data());
+    msgs::detail::EncodeRow(rgba.data(), dstInfo, _src.width(), y,
+        dst + y * _dst.step());
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Time ConvertImage against the generic path and print the
+/// throughput of each, in megabytes of source data per second. Bayer sources
+/// have no generic equivalent and only report ConvertImage.
+void Benchmark(msgs::PixelFormatType _src, msgs::PixelFormatType _dst,
+    const char *_name)
+{
+  const int iterations = 20;
+  const msgs::Image src = MakeImage(_src);
+  msgs::Image dst;
+
+  const double megabytes = src.data().size() / 1e6;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i)
+    EXPECT_TRUE(msgs::ConvertImage(src, _dst, dst));
+  auto kernel = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count() / iterations;
+
+  if (msgs::detail::FormatInfo(_src).bayerRedX >= 0)
+  {
+    std::cout << _name << ": ConvertImage " << megabytes / kernel
+              << " MB/s" << std::endl;
+    return;
+  }
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i)
+    ConvertGeneric(src, _dst, dst);
+  auto generic = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count() / iterations;
+
+  std::cout << _name << ": generic " << megabytes / generic
+            << " MB/s, ConvertImage " << megabytes / kernel << " MB/s ("
+            << generic / kernel << "x)" << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST(ImageConvert, Color8)
+{
+  Benchmark(msgs::RGB_INT8, msgs::BGR_INT8, "RGB_INT8 -> BGR_INT8");
+  Benchmark(msgs::RGB_INT8, msgs::RGBA_INT8, "RGB_INT8 -> RGBA_INT8");
+  Benchmark(msgs::BGRA_INT8, msgs::RGB_INT8, "BGRA_INT8 -> RGB_INT8");
+  Benchmark(msgs::RGBA_INT8, msgs::BGRA_INT8, "RGBA_INT8 -> BGRA_INT8");
+}
+
+/////////////////////////////////////////////////
+TEST(ImageConvert, Mono8)
+{
+  Benchmark(msgs::RGB_INT8, msgs::L_INT8, "RGB_INT8 -> L_INT8");
+  Benchmark(msgs::BGRA_INT8, msgs::L_INT8, "BGRA_INT8 -> L_INT8");
+  Benchmark(msgs::L_INT8, msgs::RGB_INT8, "L_INT8 -> RGB_INT8");
+}
+
+/////////////////////////////////////////////////
+TEST(ImageConvert, Depth)
+{
+  Benchmark(msgs::R_FLOAT32, msgs::L_INT16, "R_FLOAT32 -> L_INT16");
+  Benchmark(msgs::L_INT16, msgs::R_FLOAT32, "L_INT16 -> R_FLOAT32");
+}
+
+/////////////////////////////////////////////////
+TEST(ImageConvert, Bayer)
+{
+  for (auto format : {msgs::BAYER_RGGB8, msgs::BAYER_BGGR8,
+      msgs::BAYER_GBRG8, msgs::BAYER_GRBG8})
+  {
+    const std::string name =
+        msgs::PixelFormatType_Name(format) + " -> RGB_INT8";
+    Benchmark(format, msgs::RGB_INT8, name.c_str());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(ImageConvert, Downscale)
+{
+  const int iterations = 20;
+  for (auto format : {msgs::RGB_INT8, msgs::L_INT16, msgs::R_FLOAT32})
+  {
+    const msgs::Image src = MakeImage(format);
+    msgs::Image dst;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+      EXPECT_TRUE(msgs::ConvertImage(src, format, dst));
+    auto copy = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count() / iterations;
+
+    std::cout << msgs::PixelFormatType_Name(format) << ": copy " << copy
+              << " ms";
+    for (unsigned int factor : {2u, 4u})
+    {
+      start = std::chrono::steady_clock::now();
+      for (int i = 0; i < iterations; ++i)
+        EXPECT_TRUE(msgs::DownscaleImage(src, factor, dst));
+      auto downscale = std::chrono::duration<double, std::milli>(
+          std::chrono::steady_clock::now() - start).count() / iterations;
+      std::cout << ", " << factor << "x " << downscale << " ms";
+    }
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+      EXPECT_TRUE(msgs::ResizeImage(src, 640, 360, dst));
+    auto resize = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count() / iterations;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+      EXPECT_TRUE(msgs::CropImage(src, 640, 360, 640, 360, dst));
+    auto crop = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count() / iterations;
+
+    std::cout << ", 640x360 resize " << resize << " ms, 640x360 crop "
+              << crop << " ms" << std::endl;
+  }
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/laserscan.pb.h>
+
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+
+#include "gz/msgs/LaserScanUtils.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+/// \brief Time a callable.
+/// \return Average time of one call, in milliseconds.
+template<typename Func>
+double Time(int _iterations, Func &&_func)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < _iterations; ++i)
+    _func();
+  return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start).count() / _iterations;
+}
+
+/////////////////////////////////////////////////
+/// \brief Time the round trip of a scan through a buffer.
+/// \param[in] _name Name of the encoding.
+/// \param[in] _scan The scan.
+/// \param[in] _pack Callable that packs the scan before it is serialized.
+template<typename Func>
+void Benchmark(const char *_name, const msgs::LaserScan &_scan,
+    Func &&_pack)
+{
+  const int iterations = 20;
+  msgs::LaserScan scan;
+  std::string buffer;
+  const double encode = Time(iterations, [&]
+  {
+    scan = _scan;
+    _pack(scan);
+    scan.SerializeToString(&buffer);
+  });
+
+  msgs::LaserScan parsed;
+  const double decode = Time(iterations, [&]
+  {
+    ASSERT_TRUE(parsed.ParseFromString(buffer));
+    ASSERT_TRUE(msgs::UnpackLaserScan(parsed));
+  });
+  EXPECT_EQ(_scan.ranges_size(), parsed.ranges_size());
+
+  std::cout << "128x2048 scan, " << _name << ": " << buffer.size()
+            << " bytes, encode " << encode << " ms, decode " << decode
+            << " ms" << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST(LaserScanPacking, Lidar128x2048)
+{
+  msgs::LaserScan scan;
+  scan.set_count(2048);
+  scan.set_vertical_count(128);
+  scan.set_range_min(0.3);
+  scan.set_range_max(100.0);
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<double> range(0.5, 100.0);
+  for (int i = 0; i < 2048 * 128; ++i)
+  {
+    scan.add_ranges(i % 10 == 0 ?
+        std::numeric_limits<double>::infinity() : range(rng));
+    scan.add_intensities(i % 256);
+  }
+
+  Benchmark("repeated double", scan, [](msgs::LaserScan &) {});
+  Benchmark("FLOAT32", scan, [](msgs::LaserScan &_scan)
+  {
+    EXPECT_TRUE(msgs::PackLaserScan(_scan, msgs::LaserScan::Packed::FLOAT32));
+  });
+  Benchmark("UINT16 at 2 mm", scan, [](msgs::LaserScan &_scan)
+  {
+    EXPECT_TRUE(msgs::PackLaserScan(_scan, msgs::LaserScan::Packed::UINT16,
+        0.002));
+  });
+}
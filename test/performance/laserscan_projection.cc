@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/laserscan.pb.h>
+#include <gz/msgs/pointcloud_packed.pb.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "gz/msgs/LaserScanUtils.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+/// \brief Time a callable.
+/// \return Average time of one call, in milliseconds.
+template<typename Func>
+double Time(int _iterations, Func &&_func)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < _iterations; ++i)
+    _func();
+  return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start).count() / _iterations;
+}
+
+/////////////////////////////////////////////////
+TEST(LaserScanProjection, Lidar128x2048)
+{
+  const uint32_t count = 2048;
+  const uint32_t verticalCount = 128;
+  msgs::LaserScan scan;
+  scan.set_angle_min(-M_PI);
+  scan.set_angle_step(2 * M_PI / count);
+  scan.set_count(count);
+  scan.set_vertical_angle_min(-0.4);
+  scan.set_vertical_angle_step(0.8 / (verticalCount - 1));
+  scan.set_vertical_count(verticalCount);
+  scan.set_range_min(0.3);
+  scan.set_range_max(100.0);
+  scan.mutable_world_pose()->mutable_position()->set_z(1.5);
+
+  // About 10% of the beams don't hit anything
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<double> range(0.5, 110.0);
+  for (uint32_t i = 0; i < count * verticalCount; ++i)
+  {
+    scan.add_ranges(range(rng));
+    scan.add_intensities(i % 256);
+  }
+  const size_t points = scan.ranges_size();
+
+  const int iterations = 20;
+  std::vector<float> copy(points * 4);
+  const double memcpyTime = Time(iterations, [&]
+  {
+    std::memcpy(copy.data(), scan.ranges().data(), points * sizeof(double));
+    std::memcpy(copy.data() + points * 2, scan.intensities().data(),
+        points * sizeof(double) / 2);
+  });
+
+  // Trigonometric functions for every beam
+  const double naive = Time(iterations, [&]
+  {
+    size_t kept = 0;
+    for (uint32_t v = 0; v < verticalCount; ++v)
+    {
+      const double b = scan.vertical_angle_min() +
+          v * scan.vertical_angle_step();
+      for (uint32_t h = 0; h < count; ++h)
+      {
+        const double r = scan.ranges(v * count + h);
+        if (!(r >= scan.range_min() && r <= scan.range_max()))
+          continue;
+        const double a = scan.angle_min() + h * scan.angle_step();
+        float *p = &copy[kept++ * 4];
+        p[0] = static_cast<float>(r * std::cos(b) * std::cos(a));
+        p[1] = static_cast<float>(r * std::cos(b) * std::sin(a));
+        p[2] = static_cast<float>(r * std::sin(b));
+        p[3] = static_cast<float>(scan.intensities(v * count + h));
+      }
+    }
+  });
+
+  msgs::LaserScanProjector projector;
+  msgs::PointCloudPacked cloud;
+  msgs::LaserScanProjectOptions options;
+  ASSERT_TRUE(projector.Project(scan, cloud, options));
+  const double dense = Time(iterations, [&]
+  {
+    projector.Project(scan, cloud, options);
+  });
+
+  options.applyWorldPose = true;
+  const double transformed = Time(iterations, [&]
+  {
+    projector.Project(scan, cloud, options);
+  });
+
+  options.organized = true;
+  const double organized = Time(iterations, [&]
+  {
+    projector.Project(scan, cloud, options);
+  });
+
+  std::cout << "128x2048 scan: copy of the ranges and intensities "
+            << memcpyTime << " ms, per-beam trigonometry " << naive
+            << " ms, LaserScanProjector " << dense << " ms, with world pose "
+            << transformed << " ms, organized " << organized << " ms"
+            << std::endl;
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/occupancy_grid.pb.h>
+#include <gz/msgs/occupancy_grid_delta.pb.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "gz/msgs/OccupancyGridTiles.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+/// \brief Time a callable.
+/// \return Average time of one call, in milliseconds.
+template<typename Func>
+double Time(int _iterations, Func &&_func)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < _iterations; ++i)
+    _func();
+  return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start).count() / _iterations;
+}
+
+/////////////////////////////////////////////////
+/// \brief Create a 4000x4000 map of free space with random obstacles.
+msgs::TiledOccupancyGrid MakeMap()
+{
+  const uint32_t size = 4000;
+  msgs::TiledOccupancyGrid grid(size, size);
+  grid.FillRect(0, 0, size, size, 0);
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<uint32_t> pos(0, size - 1);
+  for (int i = 0; i < 20000; ++i)
+    grid.SetCell(pos(rng), pos(rng), 100);
+  msgs::OccupancyGridDelta delta;
+  grid.MakeDelta(delta);
+  return grid;
+}
+
+/////////////////////////////////////////////////
+TEST(OccupancyGridDelta, Publish)
+{
+  msgs::TiledOccupancyGrid grid = MakeMap();
+  std::mt19937 rng(2);
+  std::uniform_int_distribution<uint32_t> pos(0, 3999 - 50);
+
+  const int iterations = 20;
+  std::string buffer;
+  const double full = Time(iterations, [&]
+  {
+    grid.SetCell(pos(rng), pos(rng), 100);
+    grid.Map().SerializeToString(&buffer);
+  });
+  const size_t fullBytes = buffer.size();
+
+  // A robot updating a 50x50 window around it between publications
+  int8_t value = 0;
+  msgs::OccupancyGridDelta delta;
+  const double tiled = Time(iterations, [&]
+  {
+    grid.FillRect(pos(rng), pos(rng), 50, 50, ++value);
+    EXPECT_TRUE(grid.MakeDelta(delta));
+    delta.SerializeToString(&buffer);
+  });
+  const size_t deltaBytes = buffer.size();
+
+  msgs::OccupancyGrid map;
+  msgs::OccupancyGridReconstructor reconstructor(map);
+  msgs::OccupancyGridDelta keyframe;
+  grid.MakeKeyframe(keyframe);
+  ASSERT_TRUE(reconstructor.Apply(keyframe));
+  const double apply = Time(iterations, [&]
+  {
+    grid.FillRect(pos(rng), pos(rng), 50, 50, ++value);
+    EXPECT_TRUE(grid.MakeDelta(delta));
+    EXPECT_TRUE(reconstructor.Apply(delta));
+  });
+  EXPECT_TRUE(grid.Map().data() == map.data());
+
+  std::cout << "4000x4000 map: full serialize " << full << " ms ("
+            << fullBytes << " bytes), delta " << tiled << " ms ("
+            << deltaBytes << " bytes), delta + apply " << apply << " ms"
+            << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST(OccupancyGridDelta, BulkOperations)
+{
+  msgs::TiledOccupancyGrid grid = MakeMap();
+  const double threshold = Time(10, [&] { grid.Threshold(25, 65); });
+
+  for (uint32_t radius : {2u, 5u, 10u})
+  {
+    msgs::TiledOccupancyGrid inflated = MakeMap();
+    const double inflate = Time(1, [&] { inflated.Inflate(radius); });
+    std::cout << "4000x4000 map: inflate radius " << radius << " "
+              << inflate << " ms" << std::endl;
+  }
+  std::cout << "4000x4000 map: threshold " << threshold << " ms"
+            << std::endl;
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "gz/msgs/PointCloudPackedCodec.hh"
+#include "gz/msgs/PointCloudPackedUtils.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+/// \brief Create a 128 beam spinning lidar cloud with 2048 columns, as
+/// published by common automotive sensors.
+msgs::PointCloudPacked LidarCloud()
+{
+  const unsigned int width = 2048;
+  const unsigned int height = 128;
+  msgs::PointCloudPacked cloud;
+  msgs::InitPointCloudPacked(cloud, "lidar", true,
+      {{"xyz", msgs::PointCloudPacked::Field::FLOAT32},
+       {"intensity", msgs::PointCloudPacked::Field::FLOAT32},
+       {"ring", msgs::PointCloudPacked::Field::UINT16}});
+  cloud.set_width(width);
+  cloud.set_height(height);
+  cloud.set_row_step(width * cloud.point_step());
+  cloud.mutable_data()->resize(height * cloud.row_step());
+
+  // Ranges follow a smooth scene with sensor noise, and intensities are
+  // reported as integers like real sensors do.
+  std::mt19937 gen(42);
+  std::normal_distribution<float> noise(0.0f, 0.005f);
+  msgs::PointCloudPackedIterator<float> xIter(cloud, "x");
+  msgs::PointCloudPackedIterator<float> yIter(cloud, "y");
+  msgs::PointCloudPackedIterator<float> zIter(cloud, "z");
+  msgs::PointCloudPackedIterator<float> iIter(cloud, "intensity");
+  msgs::PointCloudPackedIterator<uint16_t> ringIter(cloud, "ring");
+  for (unsigned int i = 0; xIter != xIter.End();
+       ++i, ++xIter, ++yIter, ++zIter, ++iIter, ++ringIter)
+  {
+    const unsigned int ring = i / width;
+    const float azimuth = 2.0f * GZ_PI * (i % width) / width;
+    const float elevation = -0.4f + 0.8f * ring / height;
+    const float range = 5.0f + 20.0f * std::abs(std::sin(azimuth * 2.0f)) +
+        std::sin(azimuth * 40.0f) + noise(gen);
+    *xIter = range * std::cos(elevation) * std::cos(azimuth);
+    *yIter = range * std::cos(elevation) * std::sin(azimuth);
+    *zIter = range * std::sin(elevation);
+    *iIter = std::floor(50.0f + 40.0f * std::sin(azimuth * 7.0f + ring));
+    *ringIter = ring;
+  }
+  return cloud;
+}
+
+/////////////////////////////////////////////////
+/// \brief Measure compression ratio and throughput of one codec mode.
+/// \param[in] _cloud Cloud to compress.
+/// \param[in] _precision Position precision, or zero for lossless.
+void Benchmark(const msgs::PointCloudPacked &_cloud, double _precision)
+{
+  const int iterations = 10;
+  const double megabytes = _cloud.data().size() / (1024.0 * 1024.0);
+
+  std::string blob;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i)
+  {
+    if (_precision > 0)
+      EXPECT_TRUE(msgs::EncodePointCloudPacked(_cloud, _precision, blob));
+    else
+      EXPECT_TRUE(msgs::EncodePointCloudPacked(_cloud, blob));
+  }
+  const double encodeSeconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count() / iterations;
+
+  msgs::PointCloudPacked decoded;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i)
+    EXPECT_TRUE(msgs::DecodePointCloudPacked(blob, decoded));
+  const double decodeSeconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count() / iterations;
+
+  std::cout << (_precision > 0 ? "quantized " : "lossless ");
+  if (_precision > 0)
+    std::cout << _precision * 1000 << " mm";
+  std::cout << ": " << megabytes << " MB -> "
+            << blob.size() / (1024.0 * 1024.0) << " MB (ratio "
+            << static_cast<double>(_cloud.data().size()) / blob.size()
+            << "), encode " << megabytes / encodeSeconds << " MB/s, decode "
+            << megabytes / decodeSeconds << " MB/s" << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudPackedCodec, Lidar)
+{
+  const msgs::PointCloudPacked cloud = LidarCloud();
+  Benchmark(cloud, 0.0);
+  Benchmark(cloud, 0.001);
+  Benchmark(cloud, 0.01);
+}
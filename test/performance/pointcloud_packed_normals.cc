@@ -0,0 +1,253 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+
+#include <gz/math/Helpers.hh>
+
+#include "gz/msgs/PointCloudPackedUtils.hh"
+#include "gz/msgs/PointCloudPackedView.hh"
+
+using namespace gz;
+
+/// \brief Distance, in points, to the farthest neighbors used to estimate
+/// normals. The neighborhood is a (2 * kRadius + 1)^2 window.
+constexpr size_t kRadius = 3;
+
+/////////////////////////////////////////////////
+/// \brief Create an organized cloud sampling a wavy surface.
+msgs::PointCloudPacked MakeCloud(unsigned int _rows, unsigned int _cols)
+{
+  msgs::PointCloudPacked cloud;
+  msgs::InitPointCloudPacked(cloud, "sensor", true,
+      {{"xyz", msgs::PointCloudPacked::Field::FLOAT32},
+       {"normal_x", msgs::PointCloudPacked::Field::FLOAT32},
+       {"normal_y", msgs::PointCloudPacked::Field::FLOAT32},
+       {"normal_z", msgs::PointCloudPacked::Field::FLOAT32}});
+  cloud.set_height(_rows);
+  cloud.set_width(_cols);
+  cloud.set_row_step(_cols * cloud.point_step());
+  cloud.mutable_data()->resize(_rows * cloud.row_step());
+
+  msgs::PointCloudPackedView<float> x(cloud, "x");
+  msgs::PointCloudPackedView<float> y(cloud, "y");
+  msgs::PointCloudPackedView<float> z(cloud, "z");
+  for (size_t row = 0; row < _rows; ++row)
+  {
+    for (size_t col = 0; col < _cols; ++col)
+    {
+      x(row, col) = col * 0.01f;
+      y(row, col) = row * 0.01f;
+      z(row, col) = std::sin(col * 0.05f) * std::cos(row * 0.03f);
+    }
+  }
+  return cloud;
+}
+
+/////////////////////////////////////////////////
+/// \brief Normal of a neighborhood, from its covariance. The normal is the
+/// eigenvector of the smallest eigenvalue, computed in closed form.
+/// \param[in] _sum Sum of the neighbor coordinates.
+/// \param[in] _sq Sum of xx, xy, xz, yy, yz and zz.
+/// \param[in] _n Number of neighbors.
+/// \param[out] _normal The unit normal.
+void NormalFromMoments(const double (&_sum)[3], const double (&_sq)[6],
+    double _n, float (&_normal)[3])
+{
+  const double m[3] = {_sum[0] / _n, _sum[1] / _n, _sum[2] / _n};
+  const double a = _sq[0] / _n - m[0] * m[0];
+  const double b = _sq[1] / _n - m[0] * m[1];
+  const double c = _sq[2] / _n - m[0] * m[2];
+  const double d = _sq[3] / _n - m[1] * m[1];
+  const double e = _sq[4] / _n - m[1] * m[2];
+  const double f = _sq[5] / _n - m[2] * m[2];
+
+  // Smallest eigenvalue of the symmetric matrix [a b c; b d e; c e f]
+  const double q = (a + d + f) / 3.0;
+  const double p1 = b * b + c * c + e * e;
+  const double p2 = (a - q) * (a - q) + (d - q) * (d - q) +
+      (f - q) * (f - q) + 2.0 * p1;
+  const double p = std::sqrt(p2 / 6.0);
+  double lambda = q;
+  if (p > 0)
+  {
+    const double ba = (a - q) / p, bd = (d - q) / p, bf = (f - q) / p;
+    const double bb = b / p, bc = c / p, be = e / p;
+    const double det = ba * (bd * bf - be * be) - bb * (bb * bf - be * bc) +
+        bc * (bb * be - bd * bc);
+    const double phi = std::acos(std::clamp(det / 2.0, -1.0, 1.0)) / 3.0;
+    lambda = q + 2.0 * p * std::cos(phi + 2.0 * GZ_PI / 3.0);
+  }
+
+  // The eigenvector is orthogonal to the rows of (C - lambda I)
+  const double r0[3] = {a - lambda, b, c};
+  const double r1[3] = {b, d - lambda, e};
+  const double n[3] = {r0[1] * r1[2] - r0[2] * r1[1],
+                       r0[2] * r1[0] - r0[0] * r1[2],
+                       r0[0] * r1[1] - r0[1] * r1[0]};
+  const double norm = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+  for (int i = 0; i < 3; ++i)
+    _normal[i] = norm > 0 ? static_cast<float>(n[i] / norm) : 0.0f;
+}
+
+/////////////////////////////////////////////////
+/// \brief Estimate normals with iterators and index arithmetic, which is
+/// what users did before PointCloudPackedView existed. The iterators ignore
+/// row_step, so this only works for clouds without row padding.
+void NormalsIterators(msgs::PointCloudPacked &_cloud)
+{
+  const int rows = static_cast<int>(_cloud.height());
+  const int cols = static_cast<int>(_cloud.width());
+  const int r = static_cast<int>(kRadius);
+  msgs::PointCloudPackedIterator<float> x(_cloud, "x");
+  msgs::PointCloudPackedIterator<float> y(_cloud, "y");
+  msgs::PointCloudPackedIterator<float> z(_cloud, "z");
+  msgs::PointCloudPackedIterator<float> nx(_cloud, "normal_x");
+  msgs::PointCloudPackedIterator<float> ny(_cloud, "normal_y");
+  msgs::PointCloudPackedIterator<float> nz(_cloud, "normal_z");
+  for (int row = r; row < rows - r; ++row)
+  {
+    for (int col = r; col < cols - r; ++col)
+    {
+      double sum[3] = {0, 0, 0};
+      double sq[6] = {0, 0, 0, 0, 0, 0};
+      for (int v = row - r; v <= row + r; ++v)
+      {
+        for (int u = col - r; u <= col + r; ++u)
+        {
+          const int i = v * cols + u;
+          const double p[3] = {*(x + i), *(y + i), *(z + i)};
+          sum[0] += p[0]; sum[1] += p[1]; sum[2] += p[2];
+          sq[0] += p[0] * p[0]; sq[1] += p[0] * p[1]; sq[2] += p[0] * p[2];
+          sq[3] += p[1] * p[1]; sq[4] += p[1] * p[2]; sq[5] += p[2] * p[2];
+        }
+      }
+      float normal[3];
+      NormalFromMoments(sum, sq, (2 * r + 1) * (2 * r + 1), normal);
+      const int i = row * cols + col;
+      *(nx + i) = normal[0];
+      *(ny + i) = normal[1];
+      *(nz + i) = normal[2];
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Estimate normals over a tile with views.
+void NormalsTile(msgs::PointCloudPacked &_cloud,
+    const msgs::PointCloudPackedTile &_tile)
+{
+  const msgs::PointCloudPacked &constCloud = _cloud;
+  msgs::PointCloudPackedConstView<float> x(constCloud, "x");
+  msgs::PointCloudPackedConstView<float> y(constCloud, "y");
+  msgs::PointCloudPackedConstView<float> z(constCloud, "z");
+  msgs::PointCloudPackedView<float> nx(_cloud, "normal_x");
+  msgs::PointCloudPackedView<float> ny(_cloud, "normal_y");
+  msgs::PointCloudPackedView<float> nz(_cloud, "normal_z");
+
+  const size_t rowBegin = std::max(_tile.rowBegin, kRadius);
+  const size_t rowEnd = std::min(_tile.rowEnd, x.Height() - kRadius);
+  const size_t colBegin = std::max(_tile.colBegin, kRadius);
+  const size_t colEnd = std::min(_tile.colEnd, x.Width() - kRadius);
+  for (size_t row = rowBegin; row < rowEnd; ++row)
+  {
+    for (size_t col = colBegin; col < colEnd; ++col)
+    {
+      double sum[3] = {0, 0, 0};
+      double sq[6] = {0, 0, 0, 0, 0, 0};
+      for (size_t v = row - kRadius; v <= row + kRadius; ++v)
+      {
+        for (size_t u = col - kRadius; u <= col + kRadius; ++u)
+        {
+          const double p[3] = {x(v, u), y(v, u), z(v, u)};
+          sum[0] += p[0]; sum[1] += p[1]; sum[2] += p[2];
+          sq[0] += p[0] * p[0]; sq[1] += p[0] * p[1]; sq[2] += p[0] * p[2];
+          sq[3] += p[1] * p[1]; sq[4] += p[1] * p[2]; sq[5] += p[2] * p[2];
+        }
+      }
+      float normal[3];
+      NormalFromMoments(sum, sq, (2 * kRadius + 1) * (2 * kRadius + 1),
+          normal);
+      nx(row, col) = normal[0];
+      ny(row, col) = normal[1];
+      nz(row, col) = normal[2];
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Time a normal estimation function.
+double Time(const std::function<void()> &_func)
+{
+  const int iterations = 3;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i)
+    _func();
+  return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudPackedNormals, Organized)
+{
+  for (auto [rows, cols] : {std::pair(128u, 2048u), std::pair(1024u, 4096u)})
+  {
+    msgs::PointCloudPacked cloud = MakeCloud(rows, cols);
+    msgs::PointCloudPackedView<float> view(cloud, "x");
+
+    const double iterators = Time([&] { NormalsIterators(cloud); });
+    const msgs::PointCloudPacked expected = cloud;
+
+    const double rowMajor = Time([&]
+    {
+      msgs::PointCloudPackedTile all;
+      all.rowEnd = all.haloRowEnd = rows;
+      all.colEnd = all.haloColEnd = cols;
+      NormalsTile(cloud, all);
+    });
+    EXPECT_EQ(expected.data(), cloud.data());
+
+    const double tiled = Time([&]
+    {
+      view.ForEachTile(32, 128, kRadius,
+          [&](const msgs::PointCloudPackedTile &_tile)
+          {
+            NormalsTile(cloud, _tile);
+          });
+    });
+    EXPECT_EQ(expected.data(), cloud.data());
+
+    const double parallel = Time([&]
+    {
+      view.ForEachTile(32, 128, kRadius,
+          [&](const msgs::PointCloudPackedTile &_tile)
+          {
+            NormalsTile(cloud, _tile);
+          }, 0);
+    });
+    EXPECT_EQ(expected.data(), cloud.data());
+
+    std::cout << rows << "x" << cols << " points: iterators " << iterators
+              << " ms, view " << rowMajor << " ms, tiled " << tiled
+              << " ms, tiled parallel " << parallel << " ms" << std::endl;
+  }
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+
+#include <gz/math/Pose3.hh>
+#include <gz/math/Vector3.hh>
+
+#include "gz/msgs/PointCloudPackedUtils.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+/// \brief Create an xyz cloud of the given size and type.
+msgs::PointCloudPacked MakeCloud(unsigned int _points,
+    msgs::PointCloudPacked::Field::DataType _type)
+{
+  msgs::PointCloudPacked cloud;
+  msgs::InitPointCloudPacked(cloud, "sensor", true,
+      {{"xyz", _type}, {"intensity", msgs::PointCloudPacked::Field::FLOAT32}});
+  cloud.set_width(_points);
+  cloud.set_height(1);
+  cloud.set_row_step(_points * cloud.point_step());
+  cloud.mutable_data()->resize(cloud.row_step());
+  return cloud;
+}
+
+/////////////////////////////////////////////////
+/// \brief Transform every point through the iterators and gz::math, which is
+/// what users did before TransformPointCloudPacked existed.
+template<typename T>
+void TransformPerPoint(msgs::PointCloudPacked &_cloud,
+    const math::Pose3d &_pose)
+{
+  msgs::PointCloudPackedIterator<T> xIter(_cloud, "x");
+  msgs::PointCloudPackedIterator<T> yIter(_cloud, "y");
+  msgs::PointCloudPackedIterator<T> zIter(_cloud, "z");
+  for (; xIter != xIter.End(); ++xIter, ++yIter, ++zIter)
+  {
+    math::Vector3d p(*xIter, *yIter, *zIter);
+    p = _pose.Rot().RotateVector(p) + _pose.Pos();
+    *xIter = p.X();
+    *yIter = p.Y();
+    *zIter = p.Z();
+  }
+}
+
+/////////////////////////////////////////////////
+template<typename T>
+void Benchmark(msgs::PointCloudPacked::Field::DataType _type,
+    const char *_typeName)
+{
+  const math::Pose3d pose(1, 2, 3, 0.1, 0.2, 0.3);
+  const int iterations = 5;
+  for (unsigned int points : {1000000u, 4000000u})
+  {
+    msgs::PointCloudPacked cloud = MakeCloud(points, _type);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+      TransformPerPoint<T>(cloud, pose);
+    auto perPoint = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count() / iterations;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+      EXPECT_TRUE(msgs::TransformPointCloudPacked(cloud, pose));
+    auto bulk = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count() / iterations;
+
+    std::cout << _typeName << " " << points << " points: per point "
+              << perPoint << " ms, TransformPointCloudPacked " << bulk
+              << " ms (" << perPoint / bulk << "x)" << std::endl;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudPackedTransform, Float32)
+{
+  Benchmark<float>(msgs::PointCloudPacked::Field::FLOAT32, "FLOAT32");
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudPackedTransform, Float64)
+{
+  Benchmark<double>(msgs::PointCloudPacked::Field::FLOAT64, "FLOAT64");
+}
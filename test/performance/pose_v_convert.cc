@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/pose_v.pb.h>
+
+#include <google/protobuf/arena.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include <gz/math/Pose3.hh>
+
+#include "gz/msgs/convert/Pose.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+/// \brief Time a callable.
+/// \return Average time of one call, in milliseconds.
+template<typename Func>
+double Time(int _iterations, Func &&_func)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < _iterations; ++i)
+    _func();
+  return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start).count() / _iterations;
+}
+
+/////////////////////////////////////////////////
+TEST(PoseVConvert, FiftyThousandPoses)
+{
+  const size_t count = 50000;
+  std::vector<math::Pose3d> poses;
+  poses.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+    poses.emplace_back(i * 0.1, i * 0.2, i * 0.3, i * 1e-3, 0.2, -0.4);
+
+  const int iterations = 20;
+  msgs::Pose_V msg;
+  const double perPose = Time(iterations, [&]
+  {
+    msg.clear_pose();
+    for (const math::Pose3d &pose : poses)
+      *msg.add_pose() = msgs::Convert(pose);
+  });
+  const double batch = Time(iterations, [&]
+  {
+    msgs::Set(&msg, poses);
+  });
+  const double arena = Time(iterations, [&]
+  {
+    google::protobuf::Arena a;
+    auto *arenaMsg = msgs::detail::CreateOnArena<msgs::Pose_V>(&a);
+    msgs::Set(arenaMsg, poses.data(), poses.size());
+  });
+
+  std::vector<math::Pose3d> converted;
+  const double perPoseBack = Time(iterations, [&]
+  {
+    converted.clear();
+    for (const msgs::Pose &pose : msg.pose())
+      converted.push_back(msgs::Convert(pose));
+  });
+  const double batchBack = Time(iterations, [&]
+  {
+    msgs::Set(&converted, msg);
+  });
+  EXPECT_EQ(poses, converted);
+
+  std::cout << count << " poses to Pose_V: per pose " << perPose
+            << " ms, batch " << batch << " ms, batch on arena " << arena
+            << " ms" << std::endl;
+  std::cout << count << " poses from Pose_V: per pose " << perPoseBack
+            << " ms, batch " << batchBack << " ms" << std::endl;
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/navsat.pb.h>
+#include <gz/msgs/pose_v.pb.h>
+#include <gz/msgs/spherical_coordinates.pb.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <gz/math/Angle.hh>
+#include <gz/math/CoordinateVector3.hh>
+#include <gz/math/SphericalCoordinates.hh>
+#include <gz/math/Vector3.hh>
+
+#include "gz/msgs/SphericalCoordinatesUtils.hh"
+#include "gz/msgs/convert/SphericalCoordinates.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+/// \brief Time a callable.
+/// \return Average time of one call, in milliseconds.
+template<typename Func>
+double Time(int _iterations, Func &&_func)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < _iterations; ++i)
+    _func();
+  return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start).count() / _iterations;
+}
+
+/////////////////////////////////////////////////
+TEST(SphericalToLocal, MillionFixes)
+{
+  msgs::SphericalCoordinates reference;
+  reference.set_latitude_deg(37.3861);
+  reference.set_longitude_deg(-122.0839);
+  reference.set_elevation(30.0);
+  reference.set_heading_deg(15.0);
+
+  // A drive around the reference, within about ten kilometers.
+  const size_t count = 1000000;
+  std::vector<math::Vector3d> latLonAlt;
+  std::vector<msgs::NavSat> fixes(count);
+  latLonAlt.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    const double t = i * 1e-4;
+    latLonAlt.emplace_back(37.3861 + 0.09 * std::sin(t),
+        -122.0839 + 0.11 * std::cos(1.3 * t), 30.0 + 20.0 * std::sin(7 * t));
+    fixes[i].set_latitude_deg(latLonAlt[i].X());
+    fixes[i].set_longitude_deg(latLonAlt[i].Y());
+    fixes[i].set_altitude(latLonAlt[i].Z());
+  }
+
+  const int iterations = 3;
+  const math::SphericalCoordinates sc = msgs::Convert(reference);
+  std::vector<math::Vector3d> scalar(count);
+  const double scalarTime = Time(iterations, [&]
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      math::Angle lat, lon;
+      lat.SetDegree(latLonAlt[i].X());
+      lon.SetDegree(latLonAlt[i].Y());
+      const auto local = sc.LocalFromSphericalPosition(
+          math::CoordinateVector3::Spherical(lat, lon, latLonAlt[i].Z()));
+      scalar[i].Set(*local->X(), *local->Y(), *local->Z());
+    }
+  });
+
+  msgs::SphericalToLocalConverter converter(reference);
+  std::vector<math::Vector3d> local;
+  const double oneThread = Time(iterations, [&]
+  {
+    converter.Convert(latLonAlt, local, 1);
+  });
+  double maxError = 0;
+  for (size_t i = 0; i < count; ++i)
+    maxError = std::max(maxError, (scalar[i] - local[i]).Length());
+  EXPECT_LT(maxError, 1e-6);
+
+  const double allThreads = Time(iterations, [&]
+  {
+    converter.Convert(latLonAlt, local);
+  });
+  msgs::Pose_V poses;
+  const double navSat = Time(iterations, [&]
+  {
+    converter.Convert(fixes, poses);
+  });
+
+  std::cout << count << " fixes to local: math::SphericalCoordinates "
+            << scalarTime << " ms, converter " << oneThread
+            << " ms on one thread, " << allThreads << " ms on "
+            << std::thread::hardware_concurrency() << " threads"
+            << std::endl;
+  std::cout << "NavSat to Pose_V " << navSat << " ms, largest difference "
+            << maxError << " m" << std::endl;
+}